@@ -1,4 +1,4 @@
-/*                                                         02.Feb.2010 v.1.1
+/*                                                         16.Oct.2026 v.1.2
    =========================================================================
 
    bs-stats.c
@@ -79,6 +79,8 @@
    02.Feb.2000 v.1.0 Created based on eid-xor.c <simao>
    02.Feb.2010 v.1.1 Modified maximum string length for filenames to
                      avoid buffer overruns (y.hiwasaki)
+   16.Oct.2026 v.1.2 Bitstream read with bs_io.c (memory-mapped); frame
+                     lengths taken from the frame index
 
    ========================================================================= */
 
@@ -107,6 +109,7 @@
 
 /* ..... Module definition files ..... */
 #include "softbit.h"            /* Soft bit definitions and prototypes */
+#include "bs_io.h"              /* Memory-mapped bitstream file I/O */
 
 /* ..... Definitions used by the program ..... */
 
@@ -129,7 +132,7 @@
   --------------------------------------------------------------------------
 */
 void display_usage (int level) {
-  printf ("bs-stats.c - Version 1.1 of 02.Feb.2010\n");
+  printf ("bs-stats.c - Version 1.2 of 16.Oct.2026\n");
 
   if (level) {
     printf ("\nThis example program reports in ASCII format the frame sizes\n");
@@ -222,7 +225,7 @@ int main (int argc, char *argv[]) {
   char sync_header = 1;         /* Flag for input BS */
 
   /* File I/O parameter */
-  FILE *Fibs;                   /* Pointer to input encoded bitstream file */
+  BS_FILE *Fibs;                /* Pointer to input encoded bitstream file */
   FILE *Fout = 0;               /* Pointer to ASCII file with frame sizes */
 #ifdef DEBUG
   FILE *F;
@@ -235,23 +238,19 @@ int main (int argc, char *argv[]) {
   /* Aux. variables */
   long no_sizes = -1;           /* No. of diff. frame sizes found in BS */
   long distr[MAX_FRAME];        /* Array with distrib. of frame sizes */
-  short offset = 0;             /* Where is next frame leng.val. in the BS */
+  long offset;                  /* Frame length of the current frame */
+  BS_INDEX *idx;                /* Index of the frames in the BS */
   long max_fr = 0;              /* Max. frame length found in bitstream */
   long min_fr = 100000;         /* Min. frame length found in bitstream */
   double frame_no = 0;          /* Total # of frames in BS */
   char vbr = 1;                 /* Flag for variable bit rate mode */
-  long ibs_sample_len;          /* Size (bytes) of samples in the BS */
   char tmp_type;
   long i;
-  long items;                   /* Number of output elements */
 #if defined(VMS)
   char mrs[15] = "mrs=512";
 #endif
   char quiet = 0;
 
-  /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
-
   /* ......... GET PARAMETERS ......... */
 
   /* Check options */
@@ -317,7 +316,7 @@ int main (int argc, char *argv[]) {
   start_frame--;
 
   /* Open files */
-  if ((Fibs = fopen (ibs_file, RB)) == NULL)
+  if ((Fibs = bs_open (ibs_file)) == NULL)
     HARAKIRI ("Could not open input bitstream file\n", 1);
   if (strcmp (out_file, "-") == 0)
     Fout = stdout;
@@ -333,7 +332,7 @@ int main (int argc, char *argv[]) {
   /* *** CHECK CONSISTENCY *** */
 
   /* Do preliminary inspection in the INPUT BITSTREAM FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fibs, ibs_file, &tmp_type);
+  i = bs_check_format (Fibs, ibs_file, &tmp_type);
 
   /* Check whether the specified BS format matches with the one in the file */
   if (i != bs_format) {
@@ -349,13 +348,13 @@ int main (int argc, char *argv[]) {
       short tmp[2];
 
       /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next G.192 sync header */
-      fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
+      bs_fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xFFF0) == 0x6B20) && (i == tmp[1])) */
       if ((tmp[0] & 0xFFF0) == 0x6B20) {
@@ -369,13 +368,13 @@ int main (int argc, char *argv[]) {
       char tmp[2];
 
       /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (Fibs, (long) tmp[1], SEEK_CUR);
+      bs_fseek (Fibs, (long) tmp[1], SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) */
       if ((tmp[0] & 0xF0) == 0x20) {
@@ -389,7 +388,7 @@ int main (int argc, char *argv[]) {
       sync_header = 0;
 
     /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
+    bs_fseek (Fibs, 0l, SEEK_SET);
   }
 
   /* Can't work with compact or headerless bitstreams: abort */
@@ -401,20 +400,14 @@ int main (int argc, char *argv[]) {
 
   /* *** FINAL INITIALIZATIONS *** */
 
-  /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
-
-  /* Define BS sample size, in bytes */
-  ibs_sample_len = bs_format == byte ? 1 : (bs_format == g192 ? 2 : 0);
+  /* Find the sync headers of all frames */
+  if ((idx = bs_index (Fibs, bs_format)) == NULL)
+    HARAKIRI ("Can't allocate memory for frame index. Aborted.\n", 6);
 
   /* Inspect the bitstream file for variable frame sizes */
-  while (!feof (Fibs)) {
-    /* Move to position where next frame length value is expected */
-    fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
-
-    /* Get (presumed) next G.192 sync header */
-    if ((items = read_data (&offset, 1l, Fibs)) != 1)
-      break;
+  for (i = 0; i < idx->nframes; i++) {
+    /* Get frame length from the index */
+    offset = idx->length[i];
 
     /* Increment conters in histogram */
     distr[offset]++;
@@ -431,19 +424,14 @@ int main (int argc, char *argv[]) {
 
     /* Write frame length to file, if enabled (default) */
     if (log) {
-      if (fprintf (Fout, "%d\n", offset) <= 0)
+      if (fprintf (Fout, "%ld\n", offset) <= 0)
         HARAKIRI ("Error writing to output ASCII file\n", 5);
     }
 
     /* Increment frame counter */
     frame_no++;
-
-    /* Convert offset number read to no.of bytes */
-    offset *= ibs_sample_len;
   }
-
-  /* Rewind file */
-  fseek (Fibs, 0l, SEEK_SET);
+  bs_free_index (idx);
 
   /* Set the frame length to the maximum possible value */
   fr_len = max_fr;
@@ -499,7 +487,7 @@ int main (int argc, char *argv[]) {
   free (bs);
 
   /* Close the output file and quit *** */
-  fclose (Fibs);
+  bs_close (Fibs);
   if (log)
     fclose (Fout);
 #ifdef DEBUG
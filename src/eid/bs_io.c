@@ -0,0 +1,548 @@
+/*                                                        V.1.1 - 16.Oct.2026
+  ===========================================================================
+
+   BS_IO.C
+   ~~~~~~~
+
+   Bitstream and error pattern file I/O for the EID tools, on files
+   mapped in memory. The file formats (G.192, byte and compact bit) are
+   those of softbit.c, whose read_*() and check_eid_format() functions
+   have the same results as the bs_*() versions here; the latter read
+   from the mapped file, without a system call and a temporary buffer
+   per frame.
+
+   Besides the softbit.c readers, the module provides:
+
+   - bs_fread()/bs_fseek()/bs_feof()/bs_getc(), with the semantics of
+     fread(), fseek(), feof() and getc() on the mapped file;
+   - bs_view(), which returns a pointer to the next items in the
+     mapped file (zero-copy reading, e.g. of G.192 frames and
+     patterns, which need no conversion);
+   - bs_index(), which finds the sync headers of a G.192 or byte
+     bitstream once, giving the offset and length of each frame;
+   - bs_create(), which creates an output file with a large stdio
+     buffer, to be written with the softbit.c save_*() functions, and
+     bs_update(), which opens it again at a given offset, so that
+     several jobs can write their parts of the file.
+
+   On systems without mmap(), the file is loaded in memory instead.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   16.Oct.26  v.1.1  Added bs_update().
+  ===========================================================================
+*/
+
+/* ..... Generic include files ..... */
+#include "ugstdemo.h"           /* general UGST definitions */
+#include <stdio.h>              /* Standard I/O Definitions */
+#include <stdlib.h>
+#include <string.h>             /* memcpy */
+
+/* ..... OS-specific include files ..... */
+#if (defined(unix) || defined(__unix__) || defined(__APPLE__)) && !defined(MSDOS)
+#define BS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+/* Specific includes */
+#include "softbit.h"
+#include "bs_io.h"
+
+
+/*
+   -------------------------------------------------------------------------
+   BS_FILE *bs_open (char *name);
+   ~~~~~~~~~~~~~~~~
+
+   Open a bitstream file for reading, mapping it in memory (or loading
+   it, where mmap() is not available).
+
+   Parameter:
+   ~~~~~~~~~~
+   name .... file name
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns a pointer to the BS_FILE, or NULL if the file could not be
+   opened or mapped.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+BS_FILE *bs_open (char *name) {
+  BS_FILE *F;
+  FILE *fp;
+
+  if ((F = (BS_FILE *) calloc (1, sizeof (BS_FILE))) == NULL)
+    return (NULL);
+
+#ifdef BS_MMAP
+  {
+    int fd;
+    struct stat st;
+    void *p;
+
+    if ((fd = open (name, O_RDONLY)) >= 0) {
+      if (fstat (fd, &st) == 0 && S_ISREG (st.st_mode)) {
+        F->size = (long) st.st_size;
+        if (F->size == 0) {
+          close (fd);
+          return (F);
+        }
+        p = mmap (NULL, (size_t) F->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+          madvise (p, (size_t) F->size, MADV_SEQUENTIAL);
+#endif
+          close (fd);
+          F->data = (unsigned char *) p;
+          F->mapped = 1;
+          return (F);
+        }
+      }
+      close (fd);
+    }
+  }
+#endif
+
+  /* No mapping: load the whole file */
+  if ((fp = fopen (name, RB)) == NULL) {
+    free (F);
+    return (NULL);
+  }
+  fseek (fp, 0L, SEEK_END);
+  F->size = ftell (fp);
+  fseek (fp, 0L, SEEK_SET);
+  if (F->size < 0 || (F->data = (unsigned char *) malloc (F->size + 1)) == NULL) {
+    fclose (fp);
+    free (F);
+    return (NULL);
+  }
+  F->size = (long) fread (F->data, 1, F->size, fp);
+  fclose (fp);
+  return (F);
+}
+
+/* ....................... End of bs_open() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  Release a BS_FILE opened by bs_open(); the pointers returned by
+  bs_view() are no longer valid.
+  -------------------------------------------------------------------------
+ */
+void bs_close (BS_FILE * F) {
+  if (F == NULL)
+    return;
+#ifdef BS_MMAP
+  if (F->mapped)
+    munmap ((void *) F->data, (size_t) F->size);
+  else
+#endif
+    free (F->data);
+  free (F);
+}
+
+/* ....................... End of bs_close() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  Create an output (binary) file with a stdio buffer of BS_IO_BUFFER
+  bytes, so that the frames written by the save_*() functions reach
+  the system in large blocks. Returns NULL on error, as fopen().
+  -------------------------------------------------------------------------
+ */
+FILE *bs_create (char *name) {
+  FILE *F;
+
+  if ((F = fopen (name, WB)) != NULL)
+    setvbuf (F, NULL, _IOFBF, (size_t) BS_IO_BUFFER);
+  return (F);
+}
+
+/* ....................... End of bs_create() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  Open an existing output file for writing from the given byte offset
+  on, with the same stdio buffer as bs_create(). Several jobs may each
+  write their own part of a file created by bs_create() this way.
+  Returns NULL on error.
+  -------------------------------------------------------------------------
+ */
+FILE *bs_update (char *name, long offset) {
+  FILE *F;
+
+  if ((F = fopen (name, "r+b")) == NULL)
+    return (NULL);
+  setvbuf (F, NULL, _IOFBF, (size_t) BS_IO_BUFFER);
+  if (fseek (F, offset, SEEK_SET) != 0) {
+    fclose (F);
+    return (NULL);
+  }
+  return (F);
+}
+
+/* ....................... End of bs_update() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long bs_fread (void *buf, long size, long n, BS_FILE *F);
+   ~~~~~~~~~~~~~
+   int bs_fseek (BS_FILE *F, long offset, int whence);
+   ~~~~~~~~~~~~
+
+   Same as fread() and fseek() for a BS_FILE: bs_fread() copies up to n
+   items of size bytes and returns the number of whole items copied,
+   setting the end-of-file flag (and consuming any trailing partial
+   item) when less than n are available; bs_fseek() moves the read
+   position (SEEK_SET, SEEK_CUR or SEEK_END) and clears the end-of-file
+   flag. A position beyond the end of the file is allowed, as for
+   fseek(), and reading from there returns no items.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   bs_fread() returns the number of items read. bs_fseek() returns 0,
+   or -1 for a negative position.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+*/
+long bs_fread (void *buf, long size, long n, BS_FILE * F) {
+  long items;
+  void *p = bs_view (F, size, n, &items);
+
+  if (items > 0)
+    memcpy (buf, p, (size_t) (items * size));
+  return (items);
+}
+
+int bs_fseek (BS_FILE * F, long offset, int whence) {
+  if (whence == SEEK_CUR)
+    offset += F->pos;
+  else if (whence == SEEK_END)
+    offset += F->size;
+  if (offset < 0)
+    return (-1);
+  F->pos = offset;
+  F->eof = 0;
+  return (0);
+}
+
+/* ................... End of bs_fread()/bs_fseek() ................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void *bs_view (BS_FILE *F, long size, long n, long *items);
+   ~~~~~~~~~~~~~
+
+   Zero-copy read: returns a pointer to the next items of size bytes in
+   the file, and moves the read position over them, as bs_fread()
+   does. The items may not be modified, and are valid until the file is
+   closed. Items of G.192 (short) files are aligned when the reads have
+   been whole shorts from the start of the file.
+
+   Parameter:
+   ~~~~~~~~~~
+   F ....... BS_FILE to read from
+   size .... item size, in bytes
+   n ....... number of items wanted
+   items ... number of items available (up to n)
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns a pointer to the first item, or NULL if none is available.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+*/
+void *bs_view (BS_FILE * F, long size, long n, long *items) {
+  unsigned char *p = F->data + F->pos;
+  long avail = (F->pos < F->size) ? (F->size - F->pos) / size : 0;
+
+  if (avail < n) {
+    /* Short read: like fread(), consume any trailing partial item */
+    *items = avail;
+    F->eof = 1;
+    if (F->pos < F->size)
+      F->pos = F->size;
+  } else {
+    *items = n;
+    F->pos += n * size;
+  }
+  return (*items > 0 ? (void *) p : NULL);
+}
+
+/* ....................... End of bs_view() ....................... */
+
+
+/*
+  -------------------------------------------------------------------------
+  Read functions with the same results as their softbit.c counterparts
+  (read_g192(), read_bit_ber(), read_bit_fer(), read_bit() and
+  read_byte()), converting directly from the mapped file.
+  -------------------------------------------------------------------------
+ */
+long bs_read_g192 (short *patt, long n, BS_FILE * F) {
+  return (bs_fread (patt, (long) sizeof (short), n, F));
+}
+
+long bs_read_bit_ber (short *patt, long n, BS_FILE * F) {
+  return (bs_read_bit (patt, n, F, BER));
+}
+
+long bs_read_bit_fer (short *patt, long n, BS_FILE * F) {
+  return (bs_read_bit (patt, n, F, FER));
+}
+
+long bs_read_bit (short *patt, long n, BS_FILE * F, char type) {
+  unsigned char *bits;
+  short *p, one, zero;
+  long bitno, j, k, nbytes, rbytes;
+
+  /* Skip function if no samples are to be read */
+  if (n == 0)
+    return (0);
+
+  /* Calculate number of bytes necessary in the compact bitstream */
+  if (n % 8) {
+    fprintf (stderr, "The number of errors is not byte-aligned. \n");
+    fprintf (stderr, "Zero insertion is supposed!\n");
+  }
+  nbytes = (n + 7) / 8;
+
+  /* Reset memory to zero */
+  memset (patt, 0, sizeof (short) * n);
+
+  /* Get the bytes from file */
+  bits = (unsigned char *) bs_view (F, 1L, nbytes, &rbytes);
+
+  /* Convert compact bit oriented data to soft bits, frame sync or frame erasure */
+  one = (type == FER) ? G192_FER : G192_ONE;
+  zero = (type == FER) ? G192_SYNC : G192_ZERO;
+  for (p = patt, bitno = j = 0; j < rbytes; j++) {
+    *p++ = (bits[j] & 1) ? one : zero;
+    bitno++;
+    for (k = 1; k < 8 && bitno < n; k++, bitno++)
+      *p++ = ((bits[j] >> k) & 1) ? one : zero;
+  }
+  return (bitno);
+}
+
+long bs_read_byte (short *patt, long n, BS_FILE * F) {
+  unsigned char *byte, tmp;
+  long i;
+
+  /* Skip function if no samples are to be read */
+  if (n == 0)
+    return (0);
+
+  /* Get the bytes from file; the frame may be shorter than expected */
+  if ((byte = (unsigned char *) bs_view (F, 1L, n, &n)) == NULL)
+    return (0);
+
+  /* Convert byte-oriented data to word16-oriented data */
+  for (i = 0; i < n; i++) {
+    tmp = byte[i];
+    if (tmp == 0x20 || tmp == 0x21)     /* It is a frame sync/erasure word */
+      patt[i] = 0x6B00 | tmp;
+    else
+      patt[i] = tmp;
+  }
+  return (n);
+}
+
+/* ..................... End of bs_read_*() ..................... */
+
+
+/*
+  --------------------------------------------------------------------------
+  char bs_check_format (BS_FILE *F, char *file, char *type);
+  ~~~~~~~~~~~~~~~~~~~~
+
+  Same as check_eid_format() of softbit.c, for a BS_FILE: returns the
+  data format (g192, byte, bit) found in the file and its guessed type
+  (FER or BER), and moves the read position to the start of the file.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v.1.0  Created.
+  --------------------------------------------------------------------------
+*/
+char bs_check_format (BS_FILE * F, char *file, char *type) {
+  unsigned short word = 0;
+  char ret_val;
+  unsigned long tmp = 0x41424344;       /* Hex version of the string ABCD */
+  int little_endian;
+
+  /* Find whether the OS is big- or little-endian */
+  little_endian = strncmp ("ABCD", (char *) &tmp, 4);
+
+  /* Get a 16-bit word from the file; as fread(), a 1-byte file gives its first byte */
+  memcpy (&word, F->data, F->size < (long) sizeof (short) ? (size_t) F->size : sizeof (short));
+
+  /* Use the heuristics of check_eid_format() to determine what type of file is this */
+  switch (word) {
+  case 0x7F7F:
+  case 0x7F81:
+  case 0x8181:
+  case 0x817F:
+    /* Byte-oriented G.192 bitstream */
+    *type = BER;
+    ret_val = byte;
+    break;
+
+  case 0x2020:
+  case 0x2021:
+  case 0x2120:
+  case 0x2121:
+    /* Byte-oriented G.192 syncs */
+    *type = FER;
+    ret_val = byte;
+    break;
+
+  case 0x007F:
+  case 0x0081:
+    /* G.192 bitstream in natural order */
+    *type = BER;
+    ret_val = g192;
+    break;
+
+  case 0x6B21:
+  case 0x6B20:
+    /* G.192 sync header in natural order */
+    *type = FER;
+    ret_val = g192;
+    break;
+
+  case 0x7F00:
+  case 0x8100:
+  case 0x216B:
+  case 0x206B:
+    /* G.192 format that needs to be byte-swapped */
+    fprintf (stderr, "File %s needs to be byte-swapped! Aborted.\n", file);
+    exit (8);
+
+  default:
+    /* Assuming it is compact bit mode */
+    *type = nil;                /* Not possible to infer type for binary format! */
+    ret_val = compact;
+  }
+
+  /* Final check for a byte-oriented G.192 bitstream with sync headers: the first byte is 0x2n (n=0..F) */
+  if (little_endian)
+    word = ((word >> 8) & 0xFF) | ((word << 8));
+  if (*type == nil && ((word >> 8) & 0xF0) == 0x20) {
+    *type = FER;
+    ret_val = byte;
+  }
+
+  /* Rewind file & and return format identifier */
+  bs_fseek (F, 0L, SEEK_SET);
+  return (ret_val);
+}
+
+/* ...................... End of bs_check_format() ...................... */
+
+
+/*
+  --------------------------------------------------------------------------
+  BS_INDEX *bs_index (BS_FILE *F, char format);
+  ~~~~~~~~~~~~~~~~~~
+
+  Build the index of the frames of a G.192 (format g192) or byte-oriented
+  G.192 (format byte) bitstream with sync headers, hopping from one sync
+  header to the next from the start of the file. The scan stops at the
+  end of the file, or at a word that is not a sync word (0x6B2n, or
+  0x2n in byte format); the last frame found may be truncated, what is
+  told by the flag "complete". The read position is not changed.
+
+  Parameter:
+  ~~~~~~~~~~
+  F ........ BS_FILE with the bitstream
+  format ... g192 or byte
+
+  Returned value:
+  ~~~~~~~~~~~~~~~
+  Returns a pointer to the index (to be released by bs_free_index()),
+  or NULL for other formats or if there is not enough memory.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v.1.0  Created.
+  --------------------------------------------------------------------------
+*/
+BS_INDEX *bs_index (BS_FILE * F, char format) {
+  BS_INDEX *idx;
+  long o, len, max = 0, *p;
+  short word[2];
+  int sample = (format == g192) ? 2 : 1;
+
+  if ((format != g192 && format != byte) || (idx = (BS_INDEX *) calloc (1, sizeof (BS_INDEX))) == NULL)
+    return (NULL);
+
+  for (o = 0; o + 2 * sample <= F->size; o += (2 + len) * sample) {
+    /* Get the sync word and the frame length */
+    if (format == g192) {
+      memcpy (word, F->data + o, 2 * sizeof (short));
+      if ((word[0] & 0xFFF0) != 0x6B20 || word[1] < 0)
+        break;
+      len = word[1];
+    } else {
+      if ((F->data[o] & 0xF0) != 0x20)
+        break;
+      len = F->data[o + 1];
+    }
+
+    /* Store the frame */
+    if (idx->nframes == max) {
+      max = max ? 2 * max : 1024;
+      if ((p = (long *) realloc (idx->offset, max * sizeof (long))) == NULL) {
+        bs_free_index (idx);
+        return (NULL);
+      }
+      idx->offset = p;
+      if ((p = (long *) realloc (idx->length, max * sizeof (long))) == NULL) {
+        bs_free_index (idx);
+        return (NULL);
+      }
+      idx->length = p;
+    }
+    idx->offset[idx->nframes] = o;
+    idx->length[idx->nframes] = len;
+    if (idx->nframes == 0 || len < idx->min_length)
+      idx->min_length = len;
+    if (len > idx->max_length)
+      idx->max_length = len;
+    idx->nframes++;
+  }
+  idx->complete = (idx->nframes > 0 && o == F->size);
+  return (idx);
+}
+
+void bs_free_index (BS_INDEX * idx) {
+  if (idx == NULL)
+    return;
+  free (idx->offset);
+  free (idx->length);
+  free (idx);
+}
+
+/* ................... End of bs_index()/bs_free_index() ................... */
@@ -0,0 +1,79 @@
+/*
+  ============================================================================
+   File: BS_IO.H                                                     16.OCT.26
+  ============================================================================
+
+			  UGST/ITU-T UTILITY MODULE
+
+	  PROTOTYPES FOR THE MEMORY-MAPPED BITSTREAM FILE I/O
+
+   History:
+   16.Oct.26     1.00   Created
+   16.Oct.26     1.01   Added bs_update() for writing in several jobs
+  ============================================================================
+*/
+#ifndef BS_IO_DEFINED
+#define BS_IO_DEFINED 101
+
+#include <stdio.h>
+
+/* ......... Smart prototypes .......... */
+#ifndef ARGS
+#if (defined(__STDC__) || defined(VMS) || defined(__DECC)  || defined(MSDOS) || defined(__MSDOS__))
+#define ARGS(x) x
+#else
+#define ARGS(x) ()
+#endif
+#endif
+
+/* Size of the stdio buffer of the output files created by bs_create() */
+#define BS_IO_BUFFER 1048576L
+
+/*
+ * ......... Bitstream file open for reading .........
+ * The whole file is mapped in memory (or, where mmap() is not available,
+ * loaded in memory), and read from there without system calls
+ */
+typedef struct {
+  unsigned char *data;          /* file contents */
+  long size;                    /* file size, in bytes */
+  long pos;                     /* read position, in bytes */
+  int eof;                      /* set when a read went past the end */
+  int mapped;                   /* 1 if data is mapped, 0 if allocated */
+} BS_FILE;
+
+/*
+ * ......... Index of the frames in a bitstream with sync headers .........
+ */
+typedef struct {
+  long nframes;                 /* number of sync headers found */
+  long *offset;                 /* byte offset of each sync header */
+  long *length;                 /* frame length (no. of softbits) */
+  long min_length, max_length;  /* shortest and longest frames */
+  int complete;                 /* 1 if the last frame ends at end of file */
+} BS_INDEX;
+
+/* Same as feof() and getc() for a BS_FILE */
+#define bs_feof(F) ((F)->eof)
+#define bs_getc(F) ((F)->pos < (F)->size ? (int) (F)->data[(F)->pos++] : ((F)->eof = 1, EOF))
+
+/* bs_io.c */
+BS_FILE *bs_open ARGS ((char *name));
+void bs_close ARGS ((BS_FILE * F));
+FILE *bs_create ARGS ((char *name));
+FILE *bs_update ARGS ((char *name, long offset));
+long bs_fread ARGS ((void *buf, long size, long n, BS_FILE * F));
+int bs_fseek ARGS ((BS_FILE * F, long offset, int whence));
+void *bs_view ARGS ((BS_FILE * F, long size, long n, long *items));
+long bs_read_g192 ARGS ((short *patt, long n, BS_FILE * F));
+long bs_read_bit_ber ARGS ((short *patt, long n, BS_FILE * F));
+long bs_read_bit_fer ARGS ((short *patt, long n, BS_FILE * F));
+long bs_read_bit ARGS ((short *patt, long n, BS_FILE * F, char type));
+long bs_read_byte ARGS ((short *patt, long n, BS_FILE * F));
+char bs_check_format ARGS ((BS_FILE * F, char *file, char *type));
+BS_INDEX *bs_index ARGS ((BS_FILE * F, char format));
+void bs_free_index ARGS ((BS_INDEX * idx));
+
+#endif /* BS_IO_DEFINED */
+
+/* ************************* END OF BS_IO.H ************************* */
@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010 v1.1
+/*                                                            16.Oct.2026 v1.2
   ============================================================================
 
   CVT-HEAD.C
@@ -41,6 +41,7 @@
   ~~~~~~~
   18.Jan.99 v1.0 Created
   02.Feb.10 v1.1 Modified maximum string length for filenames (y.hiwasaki)
+  16.Oct.26 v1.2 Input file read with bs_io.c (memory-mapped)
   ============================================================================
 */
 
@@ -74,11 +75,12 @@
 
 /* ..... Module definition files ..... */
 #include "softbit.h"            /* Soft bit definitions and prototypes */
+#include "bs_io.h"              /* Memory-mapped bitstream file I/O */
 
 
 /* ... Local function prototypes ... */
-char check_bs_format ARGS ((FILE * F, char *file, char *type));
-int check_sync ARGS ((FILE * F, char *file, char *bs_type, long *fr_len, char *bs_format));
+char check_bs_format ARGS ((BS_FILE * F, char *file, char *type));
+int check_sync ARGS ((BS_FILE * F, char *file, char *bs_type, long *fr_len, char *bs_format));
 void display_usage ARGS ((int level));
 /* ......... End of local function prototypes ......... */
 
@@ -96,7 +98,7 @@ enum STL_versions { raw, STL92, STL96 };
 
 /*
   --------------------------------------------------------------------------
-  char check_bs_format (FILE *F, char *file, char *type);
+  char check_bs_format (BS_FILE *F, char *file, char *type);
   ~~~~~~~~~~~~~~~~~~~~
 
   Function that checks the format (g192, byte, bit) in a given
@@ -105,7 +107,7 @@ enum STL_versions { raw, STL92, STL96 };
 
   Parameter:
   ~~~~~~~~~~
-  F ...... FILE * structure to file to be checked
+  F ...... BS_FILE * structure to file to be checked
   file ... name of file to be checked
 
   type ... pointer to guessed data type in file:
@@ -126,12 +128,12 @@ enum STL_versions { raw, STL92, STL96 };
   18.Jan.99  v.1.1  Added case for HAS_FLAG_ONLY <simao>
   --------------------------------------------------------------------------
 */
-char check_bs_format (FILE * F, char *file, char *type) {
-  short word;
+char check_bs_format (BS_FILE * F, char *file, char *type) {
+  short word = 0;
   char ret_val;
 
   /* Get a 16-bit word from the file */
-  fread (&word, sizeof (short), 1, F);
+  bs_fread (&word, (long) sizeof (short), 1L, F);
 
   /* Use some heuristics to determine what type of file is this */
   switch ((unsigned) word) {
@@ -187,7 +189,7 @@ char check_bs_format (FILE * F, char *file, char *type) {
     ret_val = byte;
   }
   /* Rewind file & and return format identifier */
-  fseek (F, 0l, SEEK_SET);
+  bs_fseek (F, 0l, SEEK_SET);
   return (ret_val);
 }
 
@@ -196,7 +198,7 @@ char check_bs_format (FILE * F, char *file, char *type) {
 
 /*
   ------------------------------------------------------------------------
-  int check_sync (FILE *F, char *file, char *bs_type,
+  int check_sync (BS_FILE *F, char *file, char *bs_type,
                  long *fr_len, *bs_format);
 
   Check that the bit stream has a synchronization flag and header,
@@ -205,7 +207,7 @@ char check_bs_format (FILE * F, char *file, char *type) {
 
   Parameter:
   ~~~~~~~~~~
-  F ...... FILE * structure to file to be checked
+  F ...... BS_FILE * structure to file to be checked
   file ... name of file to be checked
   bs_type  .... pointer to type of bitstream (G192, BYTE, or COMPACT)
   fr_len ...... pointer to frame length, in number of (soft)bits
@@ -233,7 +235,7 @@ char check_bs_format (FILE * F, char *file, char *type) {
   18.Jan.99  v.1.1  Added case for HAS_FLAG_ONLY <simao>
   --------------------------------------------------------------------------
 */
-int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_format) {
+int check_sync (BS_FILE * F, char *file, char *bs_type, long *fr_len, char *bs_format) {
   long i;
   char sync_header, sync_flag;
 
@@ -253,13 +255,13 @@ int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_form
       short tmp[2];
 
       /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, F);
+      bs_fread (tmp, (long) sizeof (short), 2L, F);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next G.192 sync header */
-      fseek (F, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
+      bs_fseek (F, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, F);
+      bs_fread (tmp, (long) sizeof (short), 2L, F);
       /* Verify whether ... */
       if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) {
         /* ... found a sync header */
@@ -272,13 +274,13 @@ int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_form
       char tmp[2];
 
       /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, F);
+      bs_fread (tmp, (long) sizeof (char), 2L, F);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (F, (long) tmp[1], SEEK_CUR);
+      bs_fseek (F, (long) tmp[1], SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, F);
+      bs_fread (tmp, (long) sizeof (char), 2L, F);
       /* Verify */
       if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) {
         *fr_len = i;
@@ -290,7 +292,7 @@ int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_form
       sync_header = sync_flag = 0;
 
     /* Rewind file */
-    fseek (F, 0l, SEEK_SET);
+    bs_fseek (F, 0l, SEEK_SET);
   } else
     /* BS type is COMPACT; return 0 */
     return (0);
@@ -301,9 +303,9 @@ int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_form
     long flen = -1;
 
     /* Search first occurence of LSB of sync flag in BS */
-    while ((getc (F) & 0xF0) != tmp && !feof (F));
+    while ((bs_getc (F) & 0xF0) != tmp && !bs_feof (F));
     /* Search next occurence of LSB of sync flag in BS */
-    while ((getc (F) & 0xF0) != tmp && !feof (F))
+    while ((bs_getc (F) & 0xF0) != tmp && !bs_feof (F))
       flen++;                   /* Increase counter */
 
     /* Use the one found; use as no.of bytes read if BYTE of no.of words if G192 */
@@ -311,7 +313,7 @@ int check_sync (FILE * F, char *file, char *bs_type, long *fr_len, char *bs_form
     *bs_type = HAS_FLAG_ONLY;
 
     /* Rewind file */
-    fseek (F, 0l, SEEK_SET);
+    bs_fseek (F, 0l, SEEK_SET);
   }
 
   /* Return info on whether or not a frame sync header was found */
@@ -372,7 +374,8 @@ int main (int argc, char *argv[]) {
   long Ninp, Nout;              /* Frame length for input and input files */
   short *bs_inp, *bs_out;       /* bit-stream data */
   char inpfil[MAX_STRLEN], outfil[MAX_STRLEN];
-  FILE *Fibs, *Fobs;
+  BS_FILE *Fibs;
+  FILE *Fobs;
   long start_byte, flags_fixed = 0;
   char sync_inp = 2, sync_out = 1, fer = 1;
   short overhead_inp = OVERHEAD_STL96;
@@ -384,7 +387,7 @@ int main (int argc, char *argv[]) {
   char quiet = 0;
 
   /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
+  long (*read_data) () = bs_read_g192;  /* To read input bitstream */
   long (*save_data) () = save_g192;     /* To save output bitstream */
 
 
@@ -474,18 +477,18 @@ int main (int argc, char *argv[]) {
 #endif
 
   /* Open input file */
-  if ((Fibs = fopen (inpfil, RB)) == NULL)
+  if ((Fibs = bs_open (inpfil)) == NULL)
     KILL (inpfil, 2);
 
   /* Open (create) output file */
-  if ((Fobs = fopen (outfil, WB)) == NULL)
+  if ((Fobs = bs_create (outfil)) == NULL)
     KILL (outfil, 3);
 
   /* Define 1st byte to process */
   start_byte = N * (--N1) * sizeof (short);
 
   /* Move file's pointer to 1st desired block */
-  if (fseek (Fibs, start_byte, 0) < 0l)
+  if (bs_fseek (Fibs, start_byte, 0) < 0l)
     KILL (inpfil, 4);
 
   /* ***** DEFINE FRAME SIZES AND FILE TYPES ***** */
@@ -572,7 +575,7 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions; format of output file is the same as that of the input file */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
+  read_data = bs_format == byte ? bs_read_byte : (bs_format == g192 ? bs_read_g192 : bs_read_bit_ber);
   save_data = bs_format == byte ? save_byte : (bs_format == g192 ? save_g192 : save_bit);
 
 
@@ -586,12 +589,8 @@ int main (int argc, char *argv[]) {
 
 
   /* Check if is to process the whole file */
-  if (N2 == 0) {
-    struct stat st;
-
-    stat (inpfil, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (Ninp * size));
-  }
+  if (N2 == 0)
+    N2 = ceil ((Fibs->size - start_byte) / (double) (Ninp * size));
 
 
   /* ***** PRINT PRELIMINARY INFORMATION ***** */
@@ -606,7 +605,7 @@ int main (int argc, char *argv[]) {
   /* ***** CARRY OUT CONVERSION ***** */
 
   /* Move file's pointer to 1st desired block (since the BS probing has changed the FILE pointer) */
-  if (fseek (Fibs, start_byte, 0) < 0l)
+  if (bs_fseek (Fibs, start_byte, 0) < 0l)
     KILL (inpfil, 4);
 
   /* Inits */
@@ -666,7 +665,7 @@ int main (int argc, char *argv[]) {
 
   /* And close files! */
   fclose (Fobs);
-  fclose (Fibs);
+  bs_close (Fibs);
 
   /* Return OK when not VMS */
 #ifndef VMS
@@ -1,4 +1,4 @@
-/*                                                       02.Feb.2010 v1.1
+/*                                                       16.Oct.2026 v1.3
 =========================================================================
 
 eid-ev.c
@@ -79,6 +79,7 @@ Options:
 -ep mode ... Mode for error pattern (g192, byte)
 -layers .....Layer boundaries in absolute bits (comma separated list) (default layer setup is -layers 160,240,320,480,640 )
 -ind ....... Treat layers individually, do not truncate intermediate layers, set erased layer softbits to zero
+-jobs # .... Process # ranges of frames at the same time
 -q ......... Quiet operation, skip statistics
 -h ......... Displays this message
 -help ...... Displays a complete help message
@@ -93,6 +94,13 @@ History:
 6 May 2006, v.1.0  eid-ev C-code (converted from eid-xor v.1.1) <Nicklas S./Jonas Sv. L.M. Ericsson>
 2 Feb 2010, v.1.1  modified maximum string length for filenames to
                    avoid buffer overruns (y.hiwasaki)
+16 Oct 2026, v.1.2 input files read with bs_io.c (memory-mapped); frame
+                   lengths taken from the frame index
+16 Oct 2026, v.1.3 added option -jobs to process ranges of frames at the
+                   same time; the layer error application of a frame
+                   moved to apply_layer_errors(), shared by main() and
+                   the jobs; the output is identical to the one of a
+                   single job
 
 ========================================================================= */
 
@@ -136,6 +144,11 @@ static void noprintf (char *dummy, ...) {
 
 /* ..... Module definition files ..... */
 #include "softbit.h"            /* Soft bit definitions and prototypes */
+#include "bs_io.h"              /* Memory-mapped bitstream file I/O */
+
+#ifdef EID_THREADS
+#include <pthread.h>
+#endif
 
 /* ..... Definitions used by the program ..... */
 
@@ -144,11 +157,56 @@ static void noprintf (char *dummy, ...) {
 #define LAY 1                   /* layered/truncating error application */
 #define IND 0                   /* indidvidual layer error application, only high layers are truncated */
 #define MAX_STR MAX_STRLEN
+#define EV_CHUNK 1024           /* frames taken by a job at a time (-jobs) */
+
+/* Layering setup and error application type */
+typedef struct {
+  long n_layers;                /* number of active layers */
+  long *layer_b;                /* layering boundaries information */
+  long *layer_b_low;            /* lower boundaries of the layers */
+  long ev_app_type;             /* LAY or IND */
+} EV_LAYERS;
+
+/* Statistics of the error application */
+typedef struct {
+  double disturbed;             /* # of distorted frames (error applied) */
+  double dist_layer[MAX_FILES]; /* # of distorted layers incoming and outgoing */
+  double dist_layer_new[MAX_FILES];     /* # of distorted layers during this eid proces */
+  double sum_in_bits;           /* input stream rate accumulator */
+  double sum_out_bits;          /* output stream rate accumulator */
+  double sum_in_fer;            /* input stream fer accumulator */
+  double sum_out_fer;           /* output stream fer accumulator */
+  double sum_in_nodata;         /* input stream no_data accumulator */
+  double sum_out_nodata;        /* output stream no_data accumulator */
+  double processed;             /* # of processed frames */
+  long max_fr_len_out;          /* Maximum frame length found in outp file */
+} EV_STATS;
+
+/* Frames processed by one job (-jobs), into a buffer written by main() */
+typedef struct {
+  EV_LAYERS *lay;
+  BS_INDEX *idx;                /* frames of the input bitstream */
+  BS_FILE ibs;                  /* private read position in the bitstream */
+  BS_FILE ep[MAX_FILES];        /* private read positions in the patterns */
+  long ep_sample;               /* bytes per pattern item */
+  long (*read_data) ();         /* to read the input bitstream */
+  long (*read_patt) ();         /* to read the error patterns */
+  long first, last;             /* frames first to last-1 */
+  short *bs;                    /* input frame */
+  short *outp;                  /* output frames of the range */
+  long nout;                    /* number of items in outp */
+  EV_STATS st;                  /* statistics of the job */
+#ifdef EID_THREADS
+  pthread_t thread;
+#endif
+} EV_JOB;
 
 /* Local function prototypes */
 void display_usage ARGS ((int level));
 long parse_layers (char *inp_str, long *bound);
 long all_zeros (short *vector, long low, long high);
+long apply_layer_errors ARGS ((EV_LAYERS * lay, EV_STATS * st, short *bs, long fr_len, short *layer_error, short *outp_frame));
+void *ev_frames ARGS ((void *arg));
 
 
 
@@ -219,12 +277,261 @@ long all_zeros (short *vector, long low, long high) {
 /* ....................... End of all_zeros() ....................... */
 
 
+/*
+   -------------------------------------------------------------------------
+   long apply_layer_errors (EV_LAYERS *lay, EV_STATS *st, short *bs,
+   ~~~~~~~~~~~~~~~~~~~~~~~  long fr_len, short *layer_error, short *outp_frame);
+
+   Build the output frame for an input frame bs (with its sync header)
+   and the erasure flags of its layers, and update the statistics.
+
+   Parameter:
+   ~~~~~~~~~~
+   lay .......... layer boundaries and error application type
+   st ........... (In/Out) statistics of the frames processed
+   bs ........... input frame, with its sync header
+   fr_len ....... length of the input frame, header excluded
+   layer_error .. G.192 erasure flag of each layer for the frame
+   outp_frame ... (Out) output frame, with its sync header
+
+   Return value:
+   ~~~~~~~~~~~~~
+   The length of the output frame, header included.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Taken out of main(), to be shared with the jobs.
+   -------------------------------------------------------------------------
+ */
+long apply_layer_errors (EV_LAYERS * lay, EV_STATS * st, short *bs, long fr_len, short *layer_error, short *outp_frame) {
+  long i, k;
+  long first_trunc_layer = -1;  /* lowest removed layer */
+
+  /* collect statistics */
+  st->sum_in_bits += fr_len;
+  if (bs[0] == G192_FER) {
+    st->sum_in_fer++;
+  }
+  if ((fr_len == 0) && (bs[0] == G192_SYNC)) {
+    st->sum_in_nodata++;
+    TRACE ("NODATA input\n");
+  }
+
+  /* output frame, from the input one */
+  memset (outp_frame, 0, (fr_len + 2) * sizeof (short));  /* ... set the frame samples to zero (total uncertainty) */
+  outp_frame[0] = bs[0];    /* incoming frame type indication, may change */
+  outp_frame[1] = fr_len;   /* The incoming fr_len ; may change */
+
+  if ((bs[0] != G192_SYNC) && (bs[0] != G192_FER)) {
+    TRACE ("Illegal input sync_header, setting frame to Erasure\n");
+    outp_frame[0] = G192_FER;
+    outp_frame[1] = 0;
+  }
+
+  for (i = 0; i < lay->n_layers; i++) {  /* copy good bits to output frame as appropriate */
+    if (layer_error[i] == G192_FER) {
+      /* that some layers have FER */
+      if (fr_len >= lay->layer_b[i]) {
+        outp_frame[0] = G192_FER;
+        TRACE ("FER in layer[%ld]\n", i);
+        st->dist_layer_new[i]++;        /* it is actually an applied layer error in this EID session */
+      } else {
+        TRACE ("FER in layer[%ld], no input for that layer \n", i);
+      }
+    } else {                /* good layer, copy input layer bits, if available */
+      if (fr_len >= lay->layer_b[i]) {
+        for (k = lay->layer_b_low[i]; k < lay->layer_b[i]; k++) {
+          outp_frame[k + 2] = bs[k + 2];
+        }
+        TRACE ("Good layer[%ld, copying input]\n", i);
+      } else {
+        TRACE ("Good layer[%ld], no input for that layer \n", i);
+      }
+    }
+  }
+
+  if (lay->ev_app_type == LAY) {
+    TRACE ("ev_app_type=LAY\n");
+    /* truncate rest of frame if in layered mode */
+    for (i = (lay->n_layers - 1); i >= 0; i--) {
+      if (outp_frame[1] >= lay->layer_b[i]) {
+        if (layer_error[i] == G192_FER) {
+          outp_frame[1] = lay->layer_b_low[i];   /* actual truncation */
+          TRACE ("layer_error[%ld] outp_frame[1]=>%d\n", i, outp_frame[1]);
+          first_trunc_layer = i;
+        }
+      }
+    }                       /* a totally truncated frame should be set to a G192_FER frame */
+
+    /* update statistics based on layered truncation */
+    if (first_trunc_layer >= 0) {
+      for (i = (first_trunc_layer + 1); i < lay->n_layers; i++) {
+        if ((layer_error[i] != G192_FER) && (fr_len >= lay->layer_b[i])) {
+          TRACE ("Added FER stat in layer[%ld] due to layered error application \n", i);
+          st->dist_layer_new[i]++;      /* it is actually an additional applied layer error in this EID session */
+        }
+      }
+    }
+
+  } else {                  /* ev_ app_type=IND, truncate only the top layers from frame length */
+    TRACE ("ev_app_type=IND\n");
+    i = lay->n_layers - 1;
+    while ((i > 0) && (layer_error[i] == G192_FER)) {
+      TRACE ("layer_error[%ld]\n", i);
+      if (outp_frame[1] >= lay->layer_b[i]) {
+        outp_frame[1] = lay->layer_b_low[i];
+        first_trunc_layer = i;
+      }
+      i--;
+    }
+  }
+  TRACE ("first_trunc layer=[%ld]\n", first_trunc_layer);
+  TRACE ("outp_frame size=[%d]\n", outp_frame[1]);
+
+  /* if no remaining erased bits remain after truncation, re-declare frame as good truncated frame with synch */
+  if (outp_frame[1] != 0) {
+    i = 0;
+    while (i < outp_frame[1]) {
+      if (outp_frame[i + 2] == 0) {
+        outp_frame[0] = G192_FER;   /* erased bit exists, declare as FER frame */
+        TRACE ("Frame has some remaining zeroes, set to G192_FER\n");
+        break;
+      } else {
+        outp_frame[0] = G192_SYNC;  /* declare as good frame with synch */
+      }
+      i++;
+    }
+    if (fr_len > outp_frame[1]) {
+      TRACE ("Layer errors truncated, frame is set to %s\n", outp_frame[0] == G192_FER ? "G192_FER" : "G192_SYNC");
+    }
+  } else {
+    /* zero frame size */
+    TRACE ("Zero length frame is  %s\n", outp_frame[0] == G192_FER ? "G192_FER" : "G192_SYNC");
+  }
+
+  /* count affected frames in this application process */
+  i = 0;
+  while (i < lay->n_layers) {
+    if (layer_error[i] == G192_FER) {
+      st->disturbed++;
+      break;
+    }
+    i++;
+  }
+
+  /* analyze output file */
+  /* Count total errors for each layer, assuming input is originally all available layers */
+  /* Note: incoming NoData frames (synch, zero length) are not treated as errored frames */
+  /* truncated frames and layers with zeros are counted as errored layers */
+  TRACE ("Counting Total FER \n");
+  if (!((outp_frame[0] == G192_SYNC) && (outp_frame[1] == 0))) {
+    if (outp_frame[0] == G192_FER) {
+      /* account for truncated layers */
+      i = lay->n_layers - 1;
+      while ((i >= 0) && (outp_frame[1] < lay->layer_b[i])) {
+        TRACE ("FER frame:: Total FER counted in layer[%ld]\n", i);
+        st->dist_layer[i]++;    /* a layer error in this output file */
+        i--;
+      }
+      /* check remaining non-truncated bitstream for erased individual layers */
+      for (k = i; k >= 0; k--) {
+        /* check if individual layer contains all zero bits */
+        if (all_zeros (&outp_frame[2], lay->layer_b_low[k], lay->layer_b[k])) {
+          TRACE ("FER frame:: Total FER counted in layer[%ld] All zeros\n", k);
+          st->dist_layer[k]++;  /* a layer error present in this output file */
+        }
+      }
+    } else {                /* G192_SYNC */
+      i = lay->n_layers - 1;
+      while ((i >= 0) && (outp_frame[1] < lay->layer_b[i])) {
+        TRACE ("Sync frame:: Total FER counted in layer[%ld]\n", i);
+        st->dist_layer[i]++;    /* a layer error in this output file */
+        i--;
+      }
+    }
+  } else {
+    TRACE ("NoData frame not counted\n");
+  }
+
+  /* Update frame counter */
+  st->sum_out_bits += outp_frame[1];
+  st->processed++;
+
+  if (outp_frame[0] == G192_FER) {
+    st->sum_out_fer++;
+  }
+  if ((outp_frame[1] == 0) && (outp_frame[0] == G192_SYNC)) {
+    st->sum_out_nodata++;
+    TRACE ("NODATA out\n");
+  }
+  if (st->max_fr_len_out < outp_frame[1]) {
+    st->max_fr_len_out = outp_frame[1];
+  }
+  return (outp_frame[1] + 2);
+}
+
+/* ..................... End of apply_layer_errors() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void *ev_frames (void *arg);
+   ~~~~~~~~~~~~~~~
+
+   Process the range of frames of a job (an EV_JOB pointed by arg), as
+   the serial loop of main() does, appending the output frames to the
+   buffer of the job. The job reads the input files through its own
+   copies of the BS_FILEs; each pattern is taken cyclically, from where
+   the serial loop would be at the first frame of the range.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   NULL
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void *ev_frames (void *arg) {
+  EV_JOB *job = (EV_JOB *) arg;
+  short layer_error[MAX_FILES]; /* FER flag of each layer */
+  long f, i;
+
+  job->nout = 0;
+  if (job->first >= job->last)
+    return NULL;
+
+  /* Position the input files at the first frame */
+  bs_fseek (&job->ibs, job->idx->offset[job->first], SEEK_SET);
+  for (i = 0; i < job->lay->n_layers; i++)
+    bs_fseek (&job->ep[i], (job->first % (job->ep[i].size / job->ep_sample)) * job->ep_sample, SEEK_SET);
+
+  for (f = job->first; f < job->last; f++) {
+    job->read_data (job->bs, job->idx->length[f] + 2, &job->ibs);
+
+    /* Erasure flag of each layer, wrapping at the end of the pattern */
+    memset (layer_error, 0, MAX_FILES * sizeof (short));
+    for (i = 0; i < job->lay->n_layers; i++)
+      if (job->read_patt (&layer_error[i], 1L, &job->ep[i]) < 1) {
+        bs_fseek (&job->ep[i], 0L, SEEK_SET);
+        job->read_patt (&layer_error[i], 1L, &job->ep[i]);
+      }
+
+    job->nout += apply_layer_errors (job->lay, &job->st, job->bs, job->idx->length[f], layer_error, job->outp + job->nout);
+  }
+  return NULL;
+}
+
+/* ......................... End of ev_frames() ......................... */
+
+
 
 /*-------------------------------------------------------------------------
 display_usage(int level);  Shows program usage.
 -------------------------------------------------------------------------*/
 void display_usage (int level) {
-  printf ("eid-ev.c - Version 1.1 of 02.Feb.2010 \n\n");
+  printf ("eid-ev.c - Version 1.3 of 16.Oct.2026 \n\n");
 
   if (level) {
     printf ("Program Description:\n");
@@ -286,6 +593,7 @@ void display_usage (int level) {
   printf (" -ep mode ... Mode for error pattern file (g192 or byte)\n");
   printf (" -ind ....... Individual layer error application, (individual intermediate layers may be erased) \n");
   printf (" -layers .... Set layering setup in absolute bits, default is \"-layers 160,240,320,480,640\" \n");
+  printf (" -jobs # .... Process # ranges of frames at the same time\n");
   printf (" -q ......... Quiet operation, skip statistics\n");
   printf (" -h ......... Displays this message\n");
   printf (" -help ...... Displays a complete instructive help message\n");
@@ -313,7 +621,6 @@ int main (int argc, char *argv[]) {
   char ep_file[MAX_FILES][MAX_STR];     /* Error pattern file names */
   long fr_len = 0;              /* Frame length in bits */
   long max_fr_len = -1;         /* Maximum frame length found in inp file */
-  long max_fr_len_out = -1;     /* Maximum frame length found in outp file */
 
   long bs_len, ep_len;          /* BS and EP lengths, with headers */
   long ep_true_len;             /* number of words read in EP file */
@@ -324,13 +631,13 @@ int main (int argc, char *argv[]) {
   long layer_b[MAX_FILES];      /* layering boundaries information */
   long layer_b_low[MAX_FILES];  /* layering boundaries information */
   char layer_str[MAX_STR];      /* layering string for parsing */
-  long first_trunc_layer = -1;  /* lowest removed layer */
   long ev_app_type = LAY;       /* LAY or IND */
+  long jobs = 1;                /* Ranges of frames processed at the same time */
 
   /* File I/O parameter */
-  FILE *Fibs;                   /* Pointer to input encoded bitstream file */
+  BS_FILE *Fibs;                /* Pointer to input encoded bitstream file */
   FILE *Fobs;                   /* Pointer to input encoded bitstream file */
-  FILE *Fep[MAX_FILES];         /* Pointers to frame error pattern files */
+  BS_FILE *Fep[MAX_FILES];      /* Pointers to frame error pattern files */
 
 #ifdef DEBUG
   FILE *F;
@@ -346,21 +653,14 @@ int main (int argc, char *argv[]) {
   short *outp_frame;            /* A totally erased frame */
 
   /* Aux. variables */
-  double disturbed = 0;         /* # of distorted frames (error applied) */
-  double dist_layer[MAX_FILES]; /* # of distorted layers incoming and outgoing */
-  double dist_layer_new[MAX_FILES];     /* # of distorted layers during this eid proces */
-  double sum_in_bits = 0;       /* input stream rate accumulator */
-  double sum_out_bits = 0;      /* output stream rate accumulator */
-  double sum_in_fer = 0;        /* input stream fer accumulator */
-  double sum_out_fer = 0;       /* output stream fer accumulator */
-  double sum_in_nodata = 0;     /* input stream no_data accumulator */
-  double sum_out_nodata = 0;    /* output stream no_data accumulator */
-
-  double processed = 0;         /* # of processed bits/frames */
+  EV_LAYERS lay;                /* Layering setup */
+  EV_STATS st;                  /* Statistics of the error application */
+  BS_INDEX *idx;                /* Frames of the input bitstream */
+  EV_JOB *job;                  /* Ranges of frames of the jobs */
   char vbr = 1;                 /* Flag for variable bit rate mode, always 1 !! */
   long ibs_sample_len;          /* Size (bytes) of samples in the BS */
   char tmp_type;
-  long i, k;
+  long i, j, k;
   long items;                   /* Number of output elements */
 #if defined(VMS)
   char mrs[15] = "mrs=512";
@@ -369,17 +669,19 @@ int main (int argc, char *argv[]) {
   int local_argc = 0;           /* used for reading variable number of ep_files */
 
   /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
-  long (*read_patt) () = read_g192;     /* To read error pattern */
+  long (*read_data) () = bs_read_g192;  /* To read input bitstream */
+  long (*read_patt) () = bs_read_g192;  /* To read error pattern */
   long (*save_data) () = save_g192;     /* To save output bitstream */
 
 
   /* init params */
+  memset (&st, 0, sizeof (st));
+  st.max_fr_len_out = -1;
   for (i = 0; i < MAX_FILES; i++) {
     wraps[i] = 0;
     layer_b[i] = -1;
-    dist_layer[i] = 0.0;        /* applied earlier or thi stime */
-    dist_layer_new[i] = 0.0;    /* applied by this process */
+    st.dist_layer[i] = 0.0;     /* applied earlier or thi stime */
+    st.dist_layer_new[i] = 0.0; /* applied by this process */
   }
   /* default is layer setup for Q.9.EV-VBR */
   layer_b[0] = 160;             /* 8kbps for 20 ms frame */
@@ -446,6 +748,15 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Number of ranges of frames processed at the same time */
+        jobs = atol (argv[2]);
+        if (jobs < 1) {
+          HARAKIRI ("*** The number of jobs should be at least 1. Aborted.\n", 9);
+        }
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Set quiet mode */
         quiet = 1;
@@ -488,15 +799,15 @@ int main (int argc, char *argv[]) {
   start_frame--;
 
   /* Open files */
-  if ((Fibs = fopen (ibs_file, RB)) == NULL) {
+  if ((Fibs = bs_open (ibs_file)) == NULL) {
     HARAKIRI ("Could not open input bitstream file\n", 1);
   }
   for (i = 0; i < n_layers; i++) {
-    if ((Fep[i] = fopen (ep_file[i], RB)) == NULL) {
+    if ((Fep[i] = bs_open (ep_file[i])) == NULL) {
       HARAKIRI ("Could not open error pattern file\n", 1);
     }
   }
-  if ((Fobs = fopen (obs_file, WB)) == NULL) {
+  if ((Fobs = bs_create (obs_file)) == NULL) {
     HARAKIRI ("Could not create output file\n", 1);
   }
 #ifdef DEBUG
@@ -510,6 +821,11 @@ int main (int argc, char *argv[]) {
     layer_b_low[i] = layer_b[i - 1];
   }
 
+  lay.n_layers = n_layers;
+  lay.layer_b = layer_b;
+  lay.layer_b_low = layer_b_low;
+  lay.ev_app_type = ev_app_type;
+
   /* set format/type tags for all EP layers */
   for (k = 0; k < n_layers; k++) {
     ep_format_2[k] = ep_format;
@@ -519,7 +835,7 @@ int main (int argc, char *argv[]) {
   /* *** CHECK CONSISTENCY *** */
 
   /* Do preliminary inspection in the INPUT BITSTREAM FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fibs, ibs_file, &tmp_type);
+  i = bs_check_format (Fibs, ibs_file, &tmp_type);
 
   /* Check whether the specified BS format matches with the one in the file */
   if (i != bs_format) {
@@ -534,13 +850,13 @@ int main (int argc, char *argv[]) {
     if (bs_format == g192) {
       short tmp[2];
       /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next G.192 sync header */
-      fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
+      bs_fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xFFF0) == 0x6B20) && (i == tmp[1])) */
       if ((tmp[0] & 0xFFF0) == 0x6B20) {
@@ -555,14 +871,14 @@ int main (int argc, char *argv[]) {
     } else if (bs_format == byte) {
       char tmp[2];
       /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
 
       /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (Fibs, (long) tmp[1], SEEK_CUR);
+      bs_fseek (Fibs, (long) tmp[1], SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) */
       if ((tmp[0] & 0xF0) == 0x20) {
@@ -582,7 +898,7 @@ int main (int argc, char *argv[]) {
       sync_header = 0;
     }
     /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
+    bs_fseek (Fibs, 0l, SEEK_SET);
   }
 
   if (fr_len == 0 || sync_header == 0) {
@@ -591,7 +907,7 @@ int main (int argc, char *argv[]) {
 
 
   /* Do preliminary inspection in the first ERROR PATTERN FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fep[0], ep_file[0], &tmp_type);
+  i = bs_check_format (Fep[0], ep_file[0], &tmp_type);
   /* Check whether the specified EP format matches with the one in the file */
   if (i == compact) {
     HARAKIRI ("Error::EP format can not be binary compact format. g.192 format or g.192 byte format is required.\n\n", 1);
@@ -615,7 +931,7 @@ int main (int argc, char *argv[]) {
 
   /* check that all EP files have the same types and format */
   for (k = 1; k < n_layers; k++) {
-    i = check_eid_format (Fep[k], ep_file[k], &tmp_type);
+    i = bs_check_format (Fep[k], ep_file[k], &tmp_type);
     if (i != ep_format_2[k]) {
       fprintf (stderr, "*** Switching error pattern[%ld] format from %s to %s ***\n", k, format_str ((int) ep_format_2[k]), format_str (i));
       ep_format_2[k] = i;
@@ -640,8 +956,8 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (read_g192);
-  read_patt = ep_format == byte ? read_byte : (read_g192);
+  read_data = bs_format == byte ? bs_read_byte : (bs_read_g192);
+  read_patt = ep_format == byte ? bs_read_byte : (bs_read_g192);
   save_data = obs_format == byte ? save_byte : (save_g192);
 
   /* Define BS sample size, in bytes */
@@ -649,31 +965,14 @@ int main (int argc, char *argv[]) {
   TRACE ("ibs_sample_len=%ld \n", ibs_sample_len);
   /* Inspect the bitstream file for variable frame sizes */
   {
-    /* Two local variables */
-    short offset = 0;           /* Where is next frame length.value. in the BS */
-
-
     TRACE ("Inspecting input \n");
-    /* Scan file for largest frame size */
-    while (!feof (Fibs)) {
-      /* Move to position where next frame length value is expected */
-      fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
-
-      /* get (presumed) next G.192 sync header */
-      if ((items = read_data (&offset, 1l, Fibs)) != 1) {
-        break;
-      }
-
-      /* We have a different frame length here! */
-      if (offset > max_fr_len) {
-        max_fr_len = offset;
-      }
-      /* Convert offset number read to no.of bytes */
-      offset *= ibs_sample_len;
+    /* Get the largest frame size from the index */
+    if ((idx = bs_index (Fibs, bs_format)) == NULL) {
+      HARAKIRI ("Can't allocate memory for frame index. Aborted.\n", 6);
+    }
+    if (idx->nframes > 0 && idx->max_length > max_fr_len) {
+      max_fr_len = idx->max_length;
     }
-
-    /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
 
     /* For now set the frame length to the maximum possible value */
     fr_len = max_fr_len;
@@ -712,254 +1011,202 @@ int main (int argc, char *argv[]) {
 
 
 
-  /* *** START ACTUAL EP application *** */
-  switch (ep_type) {
-  case FER:                    /* only layered FER is used and allowed for now */
-    memset (read_ok, 0, n_layers * sizeof (short));
-    while (1) {
-      /* Read one frame from input BS */
-      /* Get sync header to see how many samples are in this frame */
-      if ((items = read_data (bs, 2l, Fibs)) != 2)
-        break;
-      fr_len = bs[1];
-      bs_len = fr_len + 2;
-      /* ... and read payload, if not an empty frame */
-      if (fr_len != 0) {
-        items += read_data (payload, fr_len, Fibs);
-      }
-
-      /* Stop while loop when reaching end-of input file */
-      if (items == 0)
-        break;
-      /* Aborts on error */
-      if (items < 0) {
-        KILL (ibs_file, 7);
+  /* Several jobs need a bitstream on which the serial loop would not stop early (complete, with legal frame lengths) and non-empty frame erasure patterns; otherwise, one job is used */
+#ifndef EID_THREADS
+  jobs = 1;
+#endif
+  if (jobs > 1) {
+    k = (ep_type == FER && idx->complete);
+    for (i = 0; k && i < n_layers; i++) {
+      k = (Fep[i]->size >= (ep_format == g192 ? 2 : 1));
+    }
+    for (i = 0; k && i < idx->nframes; i++) {
+      k = (idx->length[i] == 0);
+      for (j = 0; j < n_layers; j++) {
+        k = (k || (idx->length[i] == layer_b[j]));
       }
+    }
+    if (!k) {
+      fprintf (stderr, "*** Bitstream or error patterns not suited to -jobs; using one job ***\n");
+      jobs = 1;
+    }
+  }
 
-      /* Check if read all expected samples; if not, take a special action */
-      if (items < bs_len) {
-        if (sync_header) {
-          /* If the bitstream has sync header, this situation should not occur, since the length of the input bitstream file should be a multiple of the frame size! The file is either invalid otr corrupt. Execution is aborted at this point */
-          fprintf (stderr, "%s\n%s\n", "*** Bits read do not correspond to fram elength Check that the correct  ***", "*** frame size was used and that the bitstream is not corrupted.***");
-          exit (9);
-        } else if (feof (Fibs)) {
-          /* EOF reached. Since the input bitstream is headerless, this maybe a corrupt file, or the user simply specified the wrong frame size. Warn the user and continue */
-          fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
-          bs_len = fr_len = items;
-        } else {                /* An unknown error happened! */
-          TRACE ("unknown error reading input \n");
-          KILL (ibs_file, 7);
-        }
-      }
 
-      /* (check that incoming fr_len hits a valid layer boundary) */
-      k = (fr_len == 0);
+  /* *** START ACTUAL EP application *** */
+  if (jobs > 1) {
+    /* Each job takes EV_CHUNK frames of a window at a time; main() writes the output frames of the window in order */
+    if ((job = (EV_JOB *) calloc (jobs, sizeof (EV_JOB))) == NULL) {
+      HARAKIRI ("Can't allocate memory for the jobs. Aborted.\n", 6);
+    }
+    for (j = 0; j < jobs; j++) {
+      job[j].lay = &lay;
+      job[j].idx = idx;
+      job[j].ibs = *Fibs;
       for (i = 0; i < n_layers; i++) {
-        k = (k || (fr_len == layer_b[i]));
+        job[j].ep[i] = *Fep[i];
       }
-      if (!k) {
-        TRACE ("Bad input frame length, k=%ld, fr_len=%ld\n", k, fr_len);
-        HARAKIRI ("Illegal frame length in input bitstream\n", 1);
-      } else {
-        TRACE ("Good inp length, k=%ld, fr_len=%ld\n", k, fr_len);
+      job[j].ep_sample = (ep_format == g192 ? 2 : 1);
+      job[j].read_data = read_data;
+      job[j].read_patt = read_patt;
+      job[j].st.max_fr_len_out = -1;
+      job[j].bs = (short *) calloc (bs_len, sizeof (short));
+      job[j].outp = (short *) calloc (EV_CHUNK * bs_len, sizeof (short));
+      if (job[j].bs == NULL || job[j].outp == NULL) {
+        HARAKIRI ("Can't allocate memory for the jobs. Aborted.\n", 6);
       }
+    }
 
-      TRACE ("Proc=%6.0f, InpHeader=0x%x,fr_len=%ld, bs_len=%ld, read %ld items\n", processed, bs[0], fr_len, bs_len, items);
+    for (k = 0; k < idx->nframes; k += EV_CHUNK * jobs) {
+      for (j = 0; j < jobs; j++) {
+        job[j].first = k + j * EV_CHUNK < idx->nframes ? k + j * EV_CHUNK : idx->nframes;
+        job[j].last = job[j].first + EV_CHUNK < idx->nframes ? job[j].first + EV_CHUNK : idx->nframes;
+      }
 
-      /* collect statistics */
-      sum_in_bits += fr_len;
-      if (bs[0] == G192_FER) {
-        sum_in_fer++;
+      /* The main thread is one of the jobs; a job whose thread can't be started is run after it */
+#ifdef EID_THREADS
+      for (i = 1; i < jobs; i++) {
+        if (job[i].first >= job[i].last || pthread_create (&job[i].thread, NULL, ev_frames, &job[i]) != 0) {
+          break;
+        }
       }
-      if ((fr_len == 0) && (bs[0] == G192_SYNC)) {
-        sum_in_nodata++;
-        TRACE ("NODATA input\n");
+      for (j = 0; j < jobs; j++) {
+        if (j == 0 || j >= i) {
+          ev_frames (&job[j]);
+        }
       }
+      for (j = 1; j < i; j++) {
+        pthread_join (job[j].thread, NULL);
+      }
+#else
+      for (j = 0; j < jobs; j++) {
+        ev_frames (&job[j]);
+      }
+#endif
 
-      /* fill up error vector from the EP files */
-      memset (layer_error, 0, MAX_FILES * sizeof (short));
-      memset (read_ok, 0, n_layers * sizeof (short));
-      memset (outp_frame, 0, bs_len * sizeof (short));  /* ... set the frame samples to zero (total uncertainty) */
-      outp_frame[0] = bs[0];    /* incoming frame type indication, may change */
-      outp_frame[1] = fr_len;   /* The incoming fr_len ; may change */
-
-      for (i = 0; i < n_layers; i++) {
-        while (read_ok[i] == 0) {
-          ep_true_len = read_ok[i] = read_patt (&layer_error[i], 1, Fep[i]);
-          if (read_ok[i] <= 0) {
-            if (read_ok[i] < 0) {
-              fprintf (stderr, "Error reading EP[%ld]\n", i);
-              KILL (ep_file[i], 7);     /* Error: abort */
-            }
-            fseek (Fep[i], 0l, SEEK_SET);       /* EOF: Rewind */
-            wraps[i]++;         /* Count how many times wrapped EP[i] */
-          }
+      /* Write the output frames of the window */
+      for (j = 0; j < jobs; j++) {
+        if (job[j].nout > 0 && save_data (job[j].outp, job[j].nout, Fobs) < job[j].nout) {
+          KILL (obs_file, 7);
         }
       }
+    }
 
-
-      if ((bs[0] != G192_SYNC) && (bs[0] != G192_FER)) {
-        TRACE ("Illegal input sync_header, setting frame to Erasure\n");
-        outp_frame[0] = G192_FER;
-        outp_frame[1] = 0;
+    /* Add up the statistics of the jobs */
+    for (j = 0; j < jobs; j++) {
+      st.disturbed += job[j].st.disturbed;
+      for (i = 0; i < n_layers; i++) {
+        st.dist_layer[i] += job[j].st.dist_layer[i];
+        st.dist_layer_new[i] += job[j].st.dist_layer_new[i];
       }
-
-      for (i = 0; i < n_layers; i++) {  /* copy good bits to output frame as appropriate */
-        if (layer_error[i] == G192_FER) {
-          /* that some layers have FER */
-          if (fr_len >= layer_b[i]) {
-            outp_frame[0] = G192_FER;
-            TRACE ("FER in layer[%ld]\n", i);
-            dist_layer_new[i]++;        /* it is actually an applied layer error in this EID session */
-          } else {
-            TRACE ("FER in layer[%ld], no input for that layer \n", i);
-          }
-        } else {                /* good layer, copy input layer bits, if available */
-          if (fr_len >= layer_b[i]) {
-            for (k = layer_b_low[i]; k < layer_b[i]; k++) {
-              outp_frame[k + 2] = bs[k + 2];
-            }
-            TRACE ("Good layer[%ld, copying input]\n", i);
-          } else {
-            TRACE ("Good layer[%ld], no input for that layer \n", i);
-          }
-        }
+      st.sum_in_bits += job[j].st.sum_in_bits;
+      st.sum_out_bits += job[j].st.sum_out_bits;
+      st.sum_in_fer += job[j].st.sum_in_fer;
+      st.sum_out_fer += job[j].st.sum_out_fer;
+      st.sum_in_nodata += job[j].st.sum_in_nodata;
+      st.sum_out_nodata += job[j].st.sum_out_nodata;
+      st.processed += job[j].st.processed;
+      if (st.max_fr_len_out < job[j].st.max_fr_len_out) {
+        st.max_fr_len_out = job[j].st.max_fr_len_out;
       }
+      free (job[j].outp);
+      free (job[j].bs);
+    }
+    free (job);
 
-      first_trunc_layer = -1;
-      if (ev_app_type == LAY) {
-        TRACE ("ev_app_type=LAY\n");
-        /* truncate rest of frame if in layered mode */
-        for (i = (n_layers - 1); i >= 0; i--) {
-          if (outp_frame[1] >= layer_b[i]) {
-            if (layer_error[i] == G192_FER) {
-              outp_frame[1] = layer_b_low[i];   /* actual truncation */
-              TRACE ("layer_error[%ld] outp_frame[1]=>%d\n", i, outp_frame[1]);
-              first_trunc_layer = i;
-            }
-          }
-        }                       /* a totally truncated frame should be set to a G192_FER frame */
-
-        /* update statistics based on layered truncation */
-        if (first_trunc_layer >= 0) {
-          for (i = (first_trunc_layer + 1); i < n_layers; i++) {
-            if ((layer_error[i] != G192_FER) && (fr_len >= layer_b[i])) {
-              TRACE ("Added FER stat in layer[%ld] due to layered error application \n", i);
-              dist_layer_new[i]++;      /* it is actually an additional applied layer error in this EID session */
-            }
-          }
+    /* Times the serial loop would have wrapped the patterns */
+    for (i = 0; i < n_layers; i++) {
+      wraps[i] = idx->nframes > 0 ? (idx->nframes - 1) / (Fep[i]->size / (ep_format == g192 ? 2 : 1)) : 0;
+    }
+  } else
+    switch (ep_type) {
+    case FER:                    /* only layered FER is used and allowed for now */
+      memset (read_ok, 0, n_layers * sizeof (short));
+      while (1) {
+        /* Read one frame from input BS */
+        /* Get sync header to see how many samples are in this frame */
+        if ((items = read_data (bs, 2l, Fibs)) != 2)
+          break;
+        fr_len = bs[1];
+        bs_len = fr_len + 2;
+        /* ... and read payload, if not an empty frame */
+        if (fr_len != 0) {
+          items += read_data (payload, fr_len, Fibs);
         }
 
-      } else {                  /* ev_ app_type=IND, truncate only the top layers from frame length */
-        TRACE ("ev_app_type=IND\n");
-        i = n_layers - 1;
-        while ((i > 0) && (layer_error[i] == G192_FER)) {
-          TRACE ("layer_error[%ld]\n", i);
-          if (outp_frame[1] >= layer_b[i]) {
-            outp_frame[1] = layer_b_low[i];
-            first_trunc_layer = i;
-          }
-          i--;
+        /* Stop while loop when reaching end-of input file */
+        if (items == 0)
+          break;
+        /* Aborts on error */
+        if (items < 0) {
+          KILL (ibs_file, 7);
         }
-      }
-      TRACE ("first_trunc layer=[%ld]\n", first_trunc_layer);
-      TRACE ("outp_frame size=[%d]\n", outp_frame[1]);
-
-      /* if no remaining erased bits remain after truncation, re-declare frame as good truncated frame with synch */
-      if (outp_frame[1] != 0) {
-        i = 0;
-        while (i < outp_frame[1]) {
-          if (outp_frame[i + 2] == 0) {
-            outp_frame[0] = G192_FER;   /* erased bit exists, declare as FER frame */
-            TRACE ("Frame has some remaining zeroes, set to G192_FER\n");
-            break;
-          } else {
-            outp_frame[0] = G192_SYNC;  /* declare as good frame with synch */
+
+        /* Check if read all expected samples; if not, take a special action */
+        if (items < bs_len) {
+          if (sync_header) {
+            /* If the bitstream has sync header, this situation should not occur, since the length of the input bitstream file should be a multiple of the frame size! The file is either invalid otr corrupt. Execution is aborted at this point */
+            fprintf (stderr, "%s\n%s\n", "*** Bits read do not correspond to fram elength Check that the correct  ***", "*** frame size was used and that the bitstream is not corrupted.***");
+            exit (9);
+          } else if (bs_feof (Fibs)) {
+            /* EOF reached. Since the input bitstream is headerless, this maybe a corrupt file, or the user simply specified the wrong frame size. Warn the user and continue */
+            fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
+            bs_len = fr_len = items;
+          } else {                /* An unknown error happened! */
+            TRACE ("unknown error reading input \n");
+            KILL (ibs_file, 7);
           }
-          i++;
-        }
-        if (fr_len > outp_frame[1]) {
-          TRACE ("Layer errors truncated, frame is set to %s\n", outp_frame[0] == G192_FER ? "G192_FER" : "G192_SYNC");
         }
-      } else {
-        /* zero frame size */
-        TRACE ("Zero length frame is  %s\n", outp_frame[0] == G192_FER ? "G192_FER" : "G192_SYNC");
-      }
 
-      /* count affected frames in this application process */
-      i = 0;
-      while (i < n_layers) {
-        if (layer_error[i] == G192_FER) {
-          disturbed++;
-          break;
+        /* (check that incoming fr_len hits a valid layer boundary) */
+        k = (fr_len == 0);
+        for (i = 0; i < n_layers; i++) {
+          k = (k || (fr_len == layer_b[i]));
+        }
+        if (!k) {
+          TRACE ("Bad input frame length, k=%ld, fr_len=%ld\n", k, fr_len);
+          HARAKIRI ("Illegal frame length in input bitstream\n", 1);
+        } else {
+          TRACE ("Good inp length, k=%ld, fr_len=%ld\n", k, fr_len);
         }
-        i++;
-      }
 
-      /* analyze output file */
-      /* Count total errors for each layer, assuming input is originally all available layers */
-      /* Note: incoming NoData frames (synch, zero length) are not treated as errored frames */
-      /* truncated frames and layers with zeros are counted as errored layers */
-      TRACE ("Counting Total FER \n");
-      if (!((outp_frame[0] == G192_SYNC) && (outp_frame[1] == 0))) {
-        if (outp_frame[0] == G192_FER) {
-          /* account for truncated layers */
-          i = n_layers - 1;
-          while ((i >= 0) && (outp_frame[1] < layer_b[i])) {
-            TRACE ("FER frame:: Total FER counted in layer[%ld]\n", i);
-            dist_layer[i]++;    /* a layer error in this output file */
-            i--;
-          }
-          /* check remaining non-truncated bitstream for erased individual layers */
-          for (k = i; k >= 0; k--) {
-            /* check if individual layer contains all zero bits */
-            if (all_zeros (&outp_frame[2], layer_b_low[k], layer_b[k])) {
-              TRACE ("FER frame:: Total FER counted in layer[%ld] All zeros\n", k);
-              dist_layer[k]++;  /* a layer error present in this output file */
+        TRACE ("Proc=%6.0f, InpHeader=0x%x,fr_len=%ld, bs_len=%ld, read %ld items\n", st.processed, bs[0], fr_len, bs_len, items);
+
+        /* erasure flag of each layer from the EP files */
+        memset (layer_error, 0, MAX_FILES * sizeof (short));
+        memset (read_ok, 0, n_layers * sizeof (short));
+        for (i = 0; i < n_layers; i++) {
+          while (read_ok[i] == 0) {
+            ep_true_len = read_ok[i] = read_patt (&layer_error[i], 1, Fep[i]);
+            if (read_ok[i] <= 0) {
+              if (read_ok[i] < 0) {
+                fprintf (stderr, "Error reading EP[%ld]\n", i);
+                KILL (ep_file[i], 7);     /* Error: abort */
+              }
+              bs_fseek (Fep[i], 0l, SEEK_SET);    /* EOF: Rewind */
+              wraps[i]++;         /* Count how many times wrapped EP[i] */
             }
           }
-        } else {                /* G192_SYNC */
-          i = n_layers - 1;
-          while ((i >= 0) && (outp_frame[1] < layer_b[i])) {
-            TRACE ("Sync frame:: Total FER counted in layer[%ld]\n", i);
-            dist_layer[i]++;    /* a layer error in this output file */
-            i--;
-          }
         }
-      } else {
-        TRACE ("NoData frame not counted\n");
-      }
-
-      /* Write output frame */
-      items = save_data (outp_frame, (outp_frame[1] + 2), Fobs);
 
+        /* build the output frame */
+        bs_len = apply_layer_errors (&lay, &st, bs, fr_len, layer_error, outp_frame);
 
-      /* Abort on error */
-      if (items < outp_frame[1] + 2) {
-        TRACE ("BAD write of output, bs_len=%d, items=%ld\n", outp_frame[1] + 2, items);
-        KILL (obs_file, 7);
-      }
-      TRACE ("Proc=%6.0f, OutHeader=0x%x,fr_len=%d, bs_len=%d, wrote %ld items\n", processed, outp_frame[0], outp_frame[1], outp_frame[1] + 2, items);
-      /* Update frame counter */
-      sum_out_bits += outp_frame[1];
-      processed++;
+        /* Write output frame */
+        items = save_data (outp_frame, bs_len, Fobs);
 
-      if (outp_frame[0] == G192_FER) {
-        sum_out_fer++;
-      }
-      if ((outp_frame[1] == 0) && (outp_frame[0] == G192_SYNC)) {
-        sum_out_nodata++;
-        TRACE ("NODATA out\n");
-      }
-      if (max_fr_len_out < outp_frame[1]) {
-        max_fr_len_out = outp_frame[1];
+        /* Abort on error */
+        if (items < bs_len) {
+          TRACE ("BAD write of output, bs_len=%ld, items=%ld\n", bs_len, items);
+          KILL (obs_file, 7);
+        }
+        TRACE ("Proc=%6.0f, OutHeader=0x%x,fr_len=%d, bs_len=%ld, wrote %ld items\n", st.processed, outp_frame[0], outp_frame[1], bs_len, items);
       }
+      break;
+    default:
+      HARAKIRI ("BAD(unknown) error application type. Aborted.\n", 6);
+      break;
     }
-    break;
-  default:
-    HARAKIRI ("BAD(unknown) error application type. Aborted.\n", 6);
-    break;
-  }
 
   if (!quiet) {
     /* *** PRINT SUMMARY OF OPTIONS & RESULTS ON SCREEN *** */
@@ -973,20 +1220,20 @@ int main (int argc, char *argv[]) {
 
 
 
-    fprintf (stderr, "# Processed %s.................... : %.0f \n", "frames ", processed);
-    fprintf (stderr, "# Distorted %s........... : %.0f \n", "frames (applied)", disturbed);
-    fprintf (stderr, "# %s.............: %f %%\n", "EP frame disturbance rate", 100.0 * disturbed / processed);
+    fprintf (stderr, "# Processed %s.................... : %.0f \n", "frames ", st.processed);
+    fprintf (stderr, "# Distorted %s........... : %.0f \n", "frames (applied)", st.disturbed);
+    fprintf (stderr, "# %s.............: %f %%\n", "EP frame disturbance rate", 100.0 * st.disturbed / st.processed);
 
-    fprintf (stderr, "# Average rate/frame (input).............: %5.4f\n", sum_in_bits / processed);
-    fprintf (stderr, "# Average rate/frame (output)............: %5.4f\n", sum_out_bits / processed);
+    fprintf (stderr, "# Average rate/frame (input).............: %5.4f\n", st.sum_in_bits / st.processed);
+    fprintf (stderr, "# Average rate/frame (output)............: %5.4f\n", st.sum_out_bits / st.processed);
 
-    fprintf (stderr, "# Erasure rate (input)...................: %f %%\n", 100.0 * sum_in_fer / processed);
-    fprintf (stderr, "# Erasure rate (output)..................: %f %%\n", 100.0 * sum_out_fer / processed);
+    fprintf (stderr, "# Erasure rate (input)...................: %f %%\n", 100.0 * st.sum_in_fer / st.processed);
+    fprintf (stderr, "# Erasure rate (output)..................: %f %%\n", 100.0 * st.sum_out_fer / st.processed);
 
-    fprintf (stderr, "# NoData rate (input)....................: %f %%\n", 100.0 * sum_in_nodata / processed);
-    fprintf (stderr, "# NoData rate (output)...................: %f %%\n", 100.0 * sum_out_nodata / processed);
+    fprintf (stderr, "# NoData rate (input)....................: %f %%\n", 100.0 * st.sum_in_nodata / st.processed);
+    fprintf (stderr, "# NoData rate (output)...................: %f %%\n", 100.0 * st.sum_out_nodata / st.processed);
     fprintf (stderr, "# Max_Frame size (input).................: %ld\n", max_fr_len);
-    fprintf (stderr, "# Max_Frame size (output)................: %ld\n", max_fr_len_out);
+    fprintf (stderr, "# Max_Frame size (output)................: %ld\n", st.max_fr_len_out);
 
 
 
@@ -994,21 +1241,22 @@ int main (int argc, char *argv[]) {
     for (i = 0; i < n_layers; i++) {
       fprintf (stderr, "#################\n");
       fprintf (stderr, "# Error pattern file[%ld] wrapped ...........: %ld times\n", i, wraps[0]);
-      fprintf (stderr, "# Layer[%ld] erasing rate....................: %f %%\n", i, 100.0 * dist_layer_new[i] / processed);
-      fprintf (stderr, "# Layer[%ld] total erasure rate..............: %f %%\n", i, 100.0 * dist_layer[i] / processed);
+      fprintf (stderr, "# Layer[%ld] erasing rate....................: %f %%\n", i, 100.0 * st.dist_layer_new[i] / st.processed);
+      fprintf (stderr, "# Layer[%ld] total erasure rate..............: %f %%\n", i, 100.0 * st.dist_layer[i] / st.processed);
     }
   }
   /* *** FINALIZATIONS *** */
 
   /* Free memory allocated */
+  bs_free_index (idx);
   free (outp_frame);
   /* free(ep); */
   free (bs);
 
   /* Close the output file and quit *** */
-  fclose (Fibs);
+  bs_close (Fibs);
   for (i = 0; i > n_layers; i++) {
-    fclose (Fep[i]);
+    bs_close (Fep[i]);
   }
   fclose (Fobs);
 #ifdef DEBUG
@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.2
+/*                                                          16.Oct.2026 v1.4
    =========================================================================
 
    eid-xor.c
@@ -88,6 +88,7 @@
    -ber ....... Error pattern is a bit error pattern (needed for bit format)
    -fer ....... Error pattern is a frame erasure pattern (for bit format)
    -vbr ....... Enables variable bit rate operation
+   -jobs # .... Disturb # ranges of frames at the same time
    -q ......... Quiet operation
    -? ......... Displays this message
    -help ...... Displays a complete help message
@@ -105,6 +106,14 @@
    09.Jun.05 v.1.1 Bug correction during EP file reading. <Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
    02.Feb.10 v.1.2 Modified maximum string length for filenames to avoid
                    buffer overruns (y.hiwasaki)
+   16.Oct.26 v.1.3 Input files read with bs_io.c (memory-mapped); G.192
+                   frames and patterns used in place, without copies;
+                   VBR frame lengths taken from the frame index
+   16.Oct.26 v.1.4 Added option -jobs to disturb ranges of frames at
+                   the same time, for G.192 and byte bitstreams and
+                   patterns; each job writes its frames at their offset
+                   in the output file, which is identical to the one of
+                   a single job
 
    ========================================================================= */
 
@@ -133,6 +142,11 @@
 
 /* ..... Module definition files ..... */
 #include "softbit.h"            /* Soft bit definitions and prototypes */
+#include "bs_io.h"              /* Memory-mapped bitstream file I/O */
+
+#ifdef EID_THREADS
+#include <pthread.h>
+#endif
 
 /* ..... Definitions used by the program ..... */
 
@@ -140,10 +154,40 @@
 #define EID_BUFFER_LENGTH 256
 #define OUT_RECORD_LENGTH 512
 
+/* Bitstream, pattern and settings shared by the jobs (-jobs) */
+typedef struct {
+  BS_FILE *Fibs;                /* input bitstream */
+  BS_FILE *Fep;                 /* error pattern */
+  char *obs_file;               /* output bitstream, created beforehand */
+  char ep_type;                 /* BER or FER */
+  char sync_header;             /* frames have a G.192 sync header */
+  long sample, ep_sample;       /* bytes per bitstream|pattern item */
+  long fr_len, bs_len, ep_len;  /* as in main(); for a fixed frame size */
+  long nframes;                 /* number of frames in the bitstream */
+  BS_INDEX *idx;                /* frames with a sync header, or NULL */
+  long ep_items;                /* number of items in the pattern file */
+  long (*read_data) ();         /* to read the bitstream */
+  long (*read_patt) ();         /* to read the error pattern */
+  long (*save_data) ();         /* to save the output bitstream */
+} XOR_SETUP;
+
+/* A range of frames disturbed by one job */
+typedef struct {
+  XOR_SETUP *setup;
+  long first, last;             /* frames first to last-1 */
+  double disturbed, processed;  /* counters of the range */
+  int error;                    /* set if the output could not be written */
+#ifdef EID_THREADS
+  pthread_t thread;
+#endif
+} XOR_JOB;
+
 
 /* Local function prototypes */
 short eid_xor ARGS ((int a, int b));
 long insert_errors ARGS ((short *a, short *b, short *c, long n));
+void *xor_frames ARGS ((void *arg));
+void xor_jobs ARGS ((XOR_SETUP * setup, long jobs, double *disturbed, double *processed, long *wraps));
 void display_usage ARGS ((int level));
 
 
@@ -180,6 +224,184 @@ long insert_errors (short *a, short *b, short *c, long n) {
 /* ....................... End of insert_errors() ....................... */
 
 
+/*
+   -------------------------------------------------------------------------
+   void *xor_frames (void *arg);
+   ~~~~~~~~~~~~~~~~
+
+   Disturb the range of frames of a job (an XOR_JOB pointed by arg), as
+   the serial loops of main() do. The job reads the input files through
+   its own copies of the BS_FILEs, starting at the offset of its first
+   frame, and writes the output file from the same offset on: the
+   disturbed frames have the size of the input ones. The pattern is
+   taken cyclically, from where the serial loop would be at the first
+   frame of the range.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   NULL; job->error is set if the output could not be written.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void *xor_frames (void *arg) {
+  XOR_JOB *job = (XOR_JOB *) arg;
+  XOR_SETUP *s = job->setup;
+  BS_FILE ibs, iep;             /* private read positions */
+  FILE *Fobs;
+  short *bs, *payload, *ep, *erased_frame, flag;
+  long i, fr_len, bs_len, items, offset;
+
+  job->disturbed = job->processed = 0;
+  job->error = 0;
+  if (job->first >= job->last)
+    return NULL;
+
+  /* Buffers of the job */
+  bs = (short *) calloc (s->bs_len, sizeof (short));
+  ep = (short *) calloc (s->ep_len, sizeof (short));
+  erased_frame = (short *) calloc (s->bs_len, sizeof (short));
+  if (bs == NULL || ep == NULL || erased_frame == NULL) {
+    job->error = 1;
+    return NULL;
+  }
+  payload = s->sync_header ? bs + 2 : bs;
+  if (s->sync_header)
+    erased_frame[0] = G192_FER;
+
+  /* Position the input and output files at the first frame */
+  offset = s->idx ? s->idx->offset[job->first] : job->first * s->bs_len * s->sample;
+  ibs = *s->Fibs;
+  iep = *s->Fep;
+  bs_fseek (&ibs, offset, SEEK_SET);
+  if (s->ep_type == BER)
+    offset = (long) fmod ((double) job->first * s->ep_len, (double) s->ep_items);
+  else
+    offset = job->first % s->ep_items;
+  bs_fseek (&iep, offset * s->ep_sample, SEEK_SET);
+  if ((Fobs = bs_update (s->obs_file, s->idx ? s->idx->offset[job->first] : job->first * s->bs_len * s->sample)) == NULL)
+    job->error = 1;
+
+  for (i = job->first; i < job->last && !job->error; i++) {
+    /* Frame size; the last headerless frame may be truncated */
+    if (s->idx) {
+      fr_len = s->idx->length[i];
+      bs_len = fr_len + 2;
+    } else {
+      bs_len = ibs.size / s->sample - ibs.pos / s->sample;
+      fr_len = bs_len = bs_len < s->bs_len ? bs_len : s->bs_len;
+    }
+    s->read_data (bs, bs_len, &ibs);
+
+    if (s->ep_type == FER) {
+      /* Erasure flag of the frame */
+      if (s->read_patt (&flag, 1L, &iep) < 1) {
+        bs_fseek (&iep, 0L, SEEK_SET);
+        s->read_patt (&flag, 1L, &iep);
+      }
+      job->processed++;
+
+      /* Save original or erased frame, as appropriate */
+      if (flag == G192_FER) {
+        if (s->sync_header)
+          erased_frame[1] = fr_len;
+        items = s->save_data (erased_frame, bs_len, Fobs);
+        job->disturbed++;
+      } else
+        items = s->save_data (bs, bs_len, Fobs);
+    } else {
+      /* One error pattern frame, wrapping at the end of the file */
+      if ((items = s->read_patt (ep, s->ep_len, &iep)) < s->ep_len) {
+        bs_fseek (&iep, 0L, SEEK_SET);
+        s->read_patt (&ep[items], s->ep_len - items, &iep);
+      }
+      job->disturbed += insert_errors (payload, ep, payload, fr_len);
+      job->processed += fr_len;
+      items = s->save_data (bs, bs_len, Fobs);
+    }
+    if (items < bs_len)
+      job->error = 1;
+  }
+
+  if (Fobs != NULL && fclose (Fobs) != 0)
+    job->error = 1;
+  free (erased_frame);
+  free (ep);
+  free (bs);
+  return NULL;
+}
+
+/* ........................ End of xor_frames() ........................ */
+
+
+/*
+   -------------------------------------------------------------------------
+   void xor_jobs (XOR_SETUP *setup, long jobs, double *disturbed,
+   ~~~~~~~~~~~~~  double *processed, long *wraps);
+
+   Split the frames of the bitstream into jobs ranges and disturb them
+   with xor_frames(), in threads when EID_THREADS is defined. The counters
+   of the ranges are added to *disturbed and *processed, and *wraps is
+   set to the times the serial loop would have wrapped the pattern.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void xor_jobs (XOR_SETUP *setup, long jobs, double *disturbed, double *processed, long *wraps) {
+  XOR_JOB *job;
+  long items, i;
+#ifdef EID_THREADS
+  long k;
+#endif
+
+  if ((job = (XOR_JOB *) calloc (jobs, sizeof (XOR_JOB))) == NULL)
+    HARAKIRI ("Can't allocate memory for the jobs. Aborted.\n", 6);
+  for (i = 0; i < jobs; i++) {
+    job[i].setup = setup;
+    job[i].first = setup->nframes * i / jobs;
+    job[i].last = setup->nframes * (i + 1) / jobs;
+  }
+
+  /* The main thread runs the first range; a range whose thread can't be started is run after it */
+#ifdef EID_THREADS
+  for (k = 1; k < jobs; k++)
+    if (pthread_create (&job[k].thread, NULL, xor_frames, &job[k]) != 0)
+      break;
+  for (i = 0; i < jobs; i++)
+    if (i == 0 || i >= k)
+      xor_frames (&job[i]);
+  for (i = 1; i < k; i++)
+    pthread_join (job[i].thread, NULL);
+#else
+  for (i = 0; i < jobs; i++)
+    xor_frames (&job[i]);
+#endif
+
+  /* Add up the counters of the ranges */
+  for (i = 0; i < jobs; i++) {
+    if (job[i].error)
+      KILL (setup->obs_file, 7);
+    *disturbed += job[i].disturbed;
+    *processed += job[i].processed;
+  }
+  free (job);
+
+  /* Times the serial loop would have wrapped the pattern */
+  items = setup->ep_type == BER ? setup->nframes * setup->ep_len : setup->nframes;
+  *wraps = items > 0 ? (items - 1) / setup->ep_items : 0;
+
+  /* As in the serial loop, warn on a truncated headerless frame */
+  if (setup->ep_type == FER && !setup->sync_header && (setup->Fibs->size / setup->sample) % setup->bs_len != 0)
+    fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
+}
+
+/* ......................... End of xor_jobs() ......................... */
+
+
 /*
    --------------------------------------------------------------------------
    display_usage(int level);
@@ -192,7 +414,7 @@ long insert_errors (short *a, short *b, short *c, long n) {
    --------------------------------------------------------------------------
  */
 void display_usage (int level) {
-  printf ("eid-xor.c - Version 1.2 of 02/Feb/2010 \n\n");
+  printf ("eid-xor.c - Version 1.4 of 16/Oct/2026 \n\n");
 
   if (level) {
     printf ("Program Description:\n");
@@ -284,6 +506,8 @@ void display_usage (int level) {
   printf (" -ber ....... Error pattern is a bit error pattern (needed for bit format)\n");
   printf (" -fer ....... Error pattern is a frame erasure pattern (for bit format)\n");
   printf (" -vbr ....... Enables variable bit rate operation (different frame sizes)\n");
+  printf (" -jobs # .... Disturb # ranges of frames at the same time (G.192 and\n");
+  printf ("              byte bitstreams and patterns)\n");
   printf (" -q ......... Quiet operation\n");
   printf (" -? ......... Displays this message\n");
   printf (" -help ...... Displays a complete help message\n");
@@ -315,11 +539,12 @@ int main (int argc, char *argv[]) {
   long start_frame = 1;         /* Start inserting error from 1st one */
   char sync_header = 1;         /* Flag for input BS */
   long wraps = 0;               /* Count how many times wraps the EP file */
+  long jobs = 1;                /* Ranges of frames disturbed at the same time */
 
   /* File I/O parameter */
-  FILE *Fibs;                   /* Pointer to input encoded bitstream file */
+  BS_FILE *Fibs;                /* Pointer to input encoded bitstream file */
   FILE *Fobs;                   /* Pointer to input encoded bitstream file */
-  FILE *Fep;                    /* Pointer to error pattern file */
+  BS_FILE *Fep;                 /* Pointer to error pattern file */
 #ifdef DEBUG
   FILE *F;
 #endif
@@ -328,13 +553,15 @@ int main (int argc, char *argv[]) {
   short *bs;                    /* Encoded speech bitstream */
   short *payload;               /* Point to payload in bitstream */
   short *ep;                    /* Error pattern buffer */
+  short *ibs, *iep;             /* Input frame and pattern, in place or in bs/ep */
   short *erased_frame;          /* A totally erased frame */
+  BS_INDEX *idx = NULL;         /* Frames of a bitstream with sync headers */
+  XOR_SETUP setup;              /* Settings of the jobs */
 
   /* Aux. variables */
   double disturbed = 0;         /* # of distorted bits/frames */
   double processed = 0;         /* # of processed bits/frames */
   char vbr = 0;                 /* Flag for variable bit rate mode */
-  long ibs_sample_len;          /* Size (bytes) of samples in the BS */
   char tmp_type;
   long i, k;
   long items;                   /* Number of output elements */
@@ -344,8 +571,8 @@ int main (int argc, char *argv[]) {
   char quiet = 0;
 
   /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
-  long (*read_patt) () = read_g192;     /* To read error pattern */
+  long (*read_data) () = bs_read_g192;  /* To read input bitstream */
+  long (*read_patt) () = bs_read_g192;  /* To read error pattern */
   long (*save_data) () = save_g192;     /* To save output bitstream */
 
   /* ......... GET PARAMETERS ......... */
@@ -418,6 +645,15 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Number of ranges of frames disturbed at the same time */
+        jobs = atol (argv[2]);
+        if (jobs < 1)
+          HARAKIRI ("*** The number of jobs should be at least 1. Aborted.\n", 9);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Set quiet mode */
         quiet = 1;
@@ -446,11 +682,11 @@ int main (int argc, char *argv[]) {
   start_frame--;
 
   /* Open files */
-  if ((Fibs = fopen (ibs_file, RB)) == NULL)
+  if ((Fibs = bs_open (ibs_file)) == NULL)
     HARAKIRI ("Could not open input bitstream file\n", 1);
-  if ((Fep = fopen (ep_file, RB)) == NULL)
+  if ((Fep = bs_open (ep_file)) == NULL)
     HARAKIRI ("Could not open error pattern file\n", 1);
-  if ((Fobs = fopen (obs_file, WB)) == NULL)
+  if ((Fobs = bs_create (obs_file)) == NULL)
     HARAKIRI ("Could not create output file\n", 1);
 #ifdef DEBUG
   F = fopen ("ep.g192", WB);    /* File to save the EP in G.192 format */
@@ -460,7 +696,7 @@ int main (int argc, char *argv[]) {
   /* *** CHECK CONSISTENCY *** */
 
   /* Do preliminary inspection in the INPUT BITSTREAM FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fibs, ibs_file, &tmp_type);
+  i = bs_check_format (Fibs, ibs_file, &tmp_type);
 
   /* Check whether the specified BS format matches with the one in the file */
   if (i != bs_format) {
@@ -476,13 +712,13 @@ int main (int argc, char *argv[]) {
       short tmp[2];
 
       /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next G.192 sync header */
-      fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
+      bs_fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (short), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xFFF0) == 0x6B20) && (i == tmp[1])) */
       if ((tmp[0] & 0xFFF0) == 0x6B20) {
@@ -496,13 +732,13 @@ int main (int argc, char *argv[]) {
       char tmp[2];
 
       /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* tmp[1] should have the frame length */
       i = tmp[1];
       /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (Fibs, (long) tmp[1], SEEK_CUR);
+      bs_fseek (Fibs, (long) tmp[1], SEEK_CUR);
       /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
+      bs_fread (tmp, (long) sizeof (char), 2L, Fibs);
       /* Verify */
       /* if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) */
       if ((tmp[0] & 0xF0) == 0x20) {
@@ -516,7 +752,7 @@ int main (int argc, char *argv[]) {
       sync_header = 0;
 
     /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
+    bs_fseek (Fibs, 0l, SEEK_SET);
   }
 
   /* If input BS is headerless, any frame size will do; using default */
@@ -525,7 +761,7 @@ int main (int argc, char *argv[]) {
 
 
   /* Do preliminary inspection in the ERROR PATTERN FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fep, ep_file, &tmp_type);
+  i = bs_check_format (Fep, ep_file, &tmp_type);
 
   /* Check whether the specified EP format matches with the one in the file */
   if (i != ep_format) {
@@ -570,41 +806,19 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
+  read_data = bs_format == byte ? bs_read_byte : (bs_format == g192 ? bs_read_g192 : bs_read_bit_ber);
+  read_patt = ep_format == byte ? bs_read_byte : (ep_format == g192 ? bs_read_g192 : (ep_type == BER ? bs_read_bit_ber : bs_read_bit_fer));
   save_data = obs_format == byte ? save_byte : (obs_format == g192 ? save_g192 : save_bit);
 
-  /* Define BS sample size, in bytes */
-  ibs_sample_len = bs_format == byte ? 1 : (bs_format == g192 ? 2 : 0);
-
   /* Inspect the bitstream file for variable frame sizes (i.e. variable bit rate operation of the codec), if the option vbr is set (NOT the default). NOTE: VBR operation is not possible for compact bitstreams! */
   if (vbr) {
-    /* Two local variables */
-    short offset = 0;           /* Where is next frame leng.val. in the BS */
-    long max_fr_len = fr_len;   /* Maximum frame length found in file */
-
-    /* Scan file for largest frame size */
-    while (!feof (Fibs)) {
-      /* Move to position where next frame length value is expected */
-      fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
-
-      /* get (presumed) next G.192 sync header */
-      if ((items = read_data (&offset, 1l, Fibs)) != 1)
-        break;
-
-      /* We have a different frame length here! */
-      if (offset > max_fr_len)
-        max_fr_len = offset;
-
-      /* Convert offset number read to no.of bytes */
-      offset *= ibs_sample_len;
-    }
-
-    /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
+    /* Index of the frames (sync headers) in file */
+    if ((idx = bs_index (Fibs, bs_format)) == NULL)
+      HARAKIRI ("Can't allocate memory for frame index. Aborted.\n", 6);
 
     /* Set the frame length to the maximum possible value */
-    fr_len = max_fr_len;
+    if (idx->max_length > fr_len)
+      fr_len = idx->max_length;
   }
 
   /* Define how many samples are read for each frame */
@@ -640,164 +854,235 @@ int main (int argc, char *argv[]) {
   }
 
 
+  /* Several jobs need the frames and the pattern items at known offsets in the files, output frames of the size of the input ones, and a bitstream that can be split into whole frames; otherwise, one job is used */
+#ifndef EID_THREADS
+  jobs = 1;
+#endif
+  if (jobs > 1) {
+    setup.sample = bs_format == byte ? 1 : 2;
+    setup.ep_sample = ep_format == byte ? 1 : 2;
+    setup.ep_items = Fep->size / setup.ep_sample;
+    if (sync_header && idx == NULL && (idx = bs_index (Fibs, bs_format)) == NULL)
+      HARAKIRI ("Can't allocate memory for frame index. Aborted.\n", 6);
+    if (bs_format == compact || ep_format == compact)
+      jobs = 1;
+    else if (setup.ep_items < (ep_type == BER ? ep_len : 1))
+      jobs = 1;
+    else if (sync_header && (!idx->complete || (!vbr && (idx->min_length != fr_len || idx->max_length != fr_len))))
+      jobs = 1;
+    if (jobs == 1)
+      fprintf (stderr, "*** Bitstream or error pattern not suited to -jobs; using one job ***\n");
+  }
+
+
   /* *** START ACTUAL WORK *** */
 
-  switch (ep_type) {
-  case FER:
-    k = 0;
-    while (1) {
-      /* Read one frame from BS: two steps for VBR mode, one otherwise */
-      if (vbr) {
-        /* Get sync header to see how many samples are in this frame */
-        if ((items = read_data (bs, 2l, Fibs)) != 2)
+  if (jobs > 1) {
+    /* Jobs write their parts of the output file */
+    setup.Fibs = Fibs;
+    setup.Fep = Fep;
+    setup.obs_file = obs_file;
+    setup.ep_type = ep_type;
+    setup.sync_header = sync_header;
+    setup.fr_len = fr_len;
+    setup.bs_len = bs_len;
+    setup.ep_len = ep_len;
+    setup.idx = idx;
+    setup.nframes = idx ? idx->nframes : (Fibs->size / setup.sample + bs_len - 1) / bs_len;
+    setup.read_data = read_data;
+    setup.read_patt = read_patt;
+    setup.save_data = save_data;
+
+    /* The jobs disturb the whole bitstream */
+    xor_jobs (&setup, jobs, &disturbed, &processed, &wraps);
+  } else {
+    /* One job: disturb the frames one at a time */
+    switch (ep_type) {
+    case FER:
+      k = 0;
+      while (1) {
+        /* Read one frame from BS: two steps for VBR mode, one otherwise */
+        if (vbr) {
+          /* Get sync header to see how many samples are in this frame */
+          if ((items = read_data (bs, 2l, Fibs)) != 2)
+            break;
+          fr_len = bs[1];
+          bs_len = sync_header ? fr_len + 2 : fr_len;
+
+          /* ... and read payload, if not an empty frame */
+          if (fr_len != 0)
+            items += read_data (payload, fr_len, Fibs);
+        } else if (bs_format == g192) {
+          /* Use the whole frame in place; a truncated one is copied to bs */
+          if ((ibs = (short *) bs_view (Fibs, (long) sizeof (short), bs_len, &items)) != NULL && items < bs_len) {
+            memcpy (bs, ibs, items * sizeof (short));
+            ibs = bs;
+          }
+        } else
+          /* Read one whole frame from bitstream */
+          items = read_data (ibs = bs, bs_len, Fibs);
+
+        /* Stop when reaches end-of-file */
+        if (items == 0)
           break;
-        fr_len = bs[1];
-        bs_len = sync_header ? fr_len + 2 : fr_len;
 
-        /* ... and read payload, if not an empty frame */
-        if (fr_len != 0)
-          items += read_data (payload, fr_len, Fibs);
-      } else
-        /* Read one whole frame from bitstream */
-        items = read_data (bs, bs_len, Fibs);
-
-      /* Stop when reaches end-of-file */
-      if (items == 0)
-        break;
-
-      /* Aborts on error */
-      if (items < 0)
-        KILL (ibs_file, 7);
-
-      /* Check if read all expected samples; if not, take a special action */
-      if (items < bs_len) {
-        if (sync_header) {
-          /* If the bitstream has sync header, this situation should not occur, since the length of the input bitstream file should be a multiple of the frame size! The file is either invalid otr corrupt. Execution is aborted at this point */
-          fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
-          exit (9);
-        } else if (feof (Fibs)) {
-          /* EOF reached. Since the input bitstream is headerless, this maybe a corrupt file, or the user simply specified the wrong frame size. Warn the user and continue */
-          fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
-          bs_len = fr_len = items;
-        } else                  /* An unknown error happened! */
+        /* Aborts on error */
+        if (items < 0)
           KILL (ibs_file, 7);
-      }
-      /* Read a number of erasure flags from file */
-      while (k == 0) {
-        /* No EP flags in buffer; read a number of them */
-        ep_true_len = k = read_patt (ep, ep_len, Fep);
 
-        /* No flags read - either error or EOF */
-        /* Go back to beginning of EP & fill up EP buffer */
-        if (k <= 0) {
-          if (k < 0)
-            KILL (ep_file, 7);  /* Error: abort */
-          fseek (Fep, 0l, SEEK_SET);    /* EOF: Rewind */
-          wraps++;              /* Count how many times wrapped EP */
+        /* Check if read all expected samples; if not, take a special action */
+        if (items < bs_len) {
+          if (sync_header) {
+            /* If the bitstream has sync header, this situation should not occur, since the length of the input bitstream file should be a multiple of the frame size! The file is either invalid otr corrupt. Execution is aborted at this point */
+            fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
+            exit (9);
+          } else if (bs_feof (Fibs)) {
+            /* EOF reached. Since the input bitstream is headerless, this maybe a corrupt file, or the user simply specified the wrong frame size. Warn the user and continue */
+            fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
+            bs_len = fr_len = items;
+          } else                  /* An unknown error happened! */
+            KILL (ibs_file, 7);
+        }
+        /* Read a number of erasure flags from file */
+        while (k == 0) {
+          /* No EP flags in buffer; read a number of them */
+          if (ep_format == g192)
+            iep = (short *) bs_view (Fep, (long) sizeof (short), ep_len, &k);
+          else
+            k = read_patt (iep = ep, ep_len, Fep);
+          ep_true_len = k;
+
+          /* No flags read - either error or EOF */
+          /* Go back to beginning of EP & fill up EP buffer */
+          if (k <= 0) {
+            if (k < 0)
+              KILL (ep_file, 7);  /* Error: abort */
+            bs_fseek (Fep, 0l, SEEK_SET); /* EOF: Rewind */
+            wraps++;              /* Count how many times wrapped EP */
+          }
         }
-      }
 
-      /* Update frame counters */
-      processed++;
+        /* Update frame counters */
+        processed++;
+
+        /* Save original or erased frame, as appropriate */
+        if (iep[ep_true_len - k] == G192_FER) {
+          /* If in VBR mode, update frame length value */
+          if (vbr)
+            erased_frame[1] = fr_len;
+          /* Write erased frame */
+          items = save_data (erased_frame, bs_len, Fobs);
+          disturbed++;
+        } else
+          /* Write undisturbed frame */
+          items = save_data (vbr ? bs : ibs, bs_len, Fobs);
 
-      /* Save original or erased frame, as appropriate */
-      if (ep[ep_true_len - k] == G192_FER) {
-        /* If in VBR mode, update frame length value */
-        if (vbr)
-          erased_frame[1] = fr_len;
-        /* Write erased frame */
-        items = save_data (erased_frame, bs_len, Fobs);
-        disturbed++;
-      } else
-        /* Write undisturbed frame */
-        items = save_data (bs, bs_len, Fobs);
+        /* Abort on error */
+        if (items < bs_len)
+          KILL (obs_file, 7);
 
-      /* Abort on error */
-      if (items < bs_len)
-        KILL (obs_file, 7);
+        /* Decrement counter of number of flags in EP buffer */
+        k--;
+      }
+      break;
+
+    case BER:
+      while (1) {
+        /* Read one frame from BS: two steps for VBR mode, one otherwise */
+        if (vbr) {
+          /* Get sync header to see how many samples are in this frame */
+          if ((items = read_data (bs, 2l, Fibs)) != 2)
+            break;
+          fr_len = bs[1];
+          bs_len = sync_header ? fr_len + 2 : fr_len;
+
+          /* ... and read payload, if not an empty frame */
+          if (fr_len != 0)
+            items += read_data (payload, fr_len, Fibs);
+        } else if (bs_format == g192) {
+          /* Use the whole frame in place; a truncated one is copied to bs */
+          if ((ibs = (short *) bs_view (Fibs, (long) sizeof (short), bs_len, &items)) != NULL && items < bs_len) {
+            memcpy (bs, ibs, items * sizeof (short));
+            ibs = bs;
+          }
+        } else
+          /* Read one whole frame from bitstream */
+          items = read_data (ibs = bs, bs_len, Fibs);
 
-      /* Decrement counter of number of flags in EP buffer */
-      k--;
-    }
-    break;
-
-  case BER:
-    while (1) {
-      /* Read one frame from BS: two steps for VBR mode, one otherwise */
-      if (vbr) {
-        /* Get sync header to see how many samples are in this frame */
-        if ((items = read_data (bs, 2l, Fibs)) != 2)
+        /* Stop when reaches end-of-file */
+        if (items == 0)
           break;
-        fr_len = bs[1];
-        bs_len = sync_header ? fr_len + 2 : fr_len;
 
-        /* ... and read payload, if not an empty frame */
-        if (fr_len != 0)
-          items += read_data (payload, fr_len, Fibs);
-      } else
-        /* Read one whole frame from bitstream */
-        items = read_data (bs, bs_len, Fibs);
-
-      /* Stop when reaches end-of-file */
-      if (items == 0)
-        break;
-
-      /* Aborts on error */
-      if (items < 0)
-        KILL (ibs_file, 7);
-
-      /* Check if read all expected samples; if not, probably hit EOF */
-      if (items < bs_len) {
-        if (sync_header) {
-          /* This situation should not occur in a headed BS - Abort */
-          fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
-          exit (9);
-        } else if (feof (Fibs)) {
-          /* Headerless BS is corrupted or wrong frame size was used */
-          /* This is not important for BER, so the msg is not printed */
-#ifdef DEBUG
-          fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
-#endif
-          bs_len = fr_len = items;
-        } else                  /* An unknown error happened! */
+        /* Aborts on error */
+        if (items < 0)
           KILL (ibs_file, 7);
-      }
 
-      /* Read one error pattern frame from file */
-      items = read_patt (ep, ep_len, Fep);
+        /* Check if read all expected samples; if not, probably hit EOF */
+        if (items < bs_len) {
+          if (sync_header) {
+            /* This situation should not occur in a headed BS - Abort */
+            fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
+            exit (9);
+          } else if (bs_feof (Fibs)) {
+            /* Headerless BS is corrupted or wrong frame size was used */
+            /* This is not important for BER, so the msg is not printed */
+#ifdef DEBUG
+            fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
+#endif
+            bs_len = fr_len = items;
+          } else                  /* An unknown error happened! */
+            KILL (ibs_file, 7);
+        }
 
-      /* Treat case when EP finishes before BS: */
-      /* Go back to beginning of EP & fill up EP buffer */
-      if (items < ep_len) {
-        if (items < 0)
-          KILL (ep_file, 7);
-        k = ep_len - items;     /* Number of missing EP samples */
-        fseek (Fep, 0l, SEEK_SET);      /* Rewind */
-        items = read_patt (&ep[items], k, Fep); /* Fill-up EP buffer */
+        /* Read one error pattern frame from file; a G.192 pattern is used in place */
+        if (ep_format == g192)
+          iep = (short *) bs_view (Fep, (long) sizeof (short), ep_len, &items);
+        else
+          items = read_patt (iep = ep, ep_len, Fep);
 
-        /* Count how many times wrapped the EP file */
-        wraps++;
-      }
+        /* Treat case when EP finishes before BS: */
+        /* Go back to beginning of EP & fill up EP buffer */
+        if (items < ep_len) {
+          if (items < 0)
+            KILL (ep_file, 7);
+          if (iep != ep && items > 0)
+            memcpy (ep, iep, items * sizeof (short));
+          iep = ep;
+          k = ep_len - items;     /* Number of missing EP samples */
+          bs_fseek (Fep, 0l, SEEK_SET);   /* Rewind */
+          items = read_patt (&ep[items], k, Fep); /* Fill-up EP buffer */
+
+          /* Count how many times wrapped the EP file */
+          wraps++;
+        }
 #ifdef DEBUG
-      /* Save to a temp file - debugging */
-      fwrite (ep, sizeof (short), ep_len, F);
+        /* Save to a temp file - debugging */
+        fwrite (iep, sizeof (short), ep_len, F);
 #endif
 
-      /* Convolve errors */
-      items = insert_errors (payload, ep, payload, fr_len);
+        /* Convolve errors, from the frame in place to bs */
+        if (!vbr && ibs != bs) {
+          if (sync_header) {
+            bs[0] = ibs[0];
+            bs[1] = ibs[1];
+          }
+          items = insert_errors (ibs + (payload - bs), iep, payload, fr_len);
+        } else
+          items = insert_errors (payload, iep, payload, fr_len);
 
-      /* Update BER counters */
-      disturbed += items;
-      processed += fr_len;
+        /* Update BER counters */
+        disturbed += items;
+        processed += fr_len;
 
-      /* Save disturbed bitstream to file */
-      items = save_data (bs, bs_len, Fobs);
+        /* Save disturbed bitstream to file */
+        items = save_data (bs, bs_len, Fobs);
 
-      /* Abort on error */
-      if (items < bs_len)
-        KILL (obs_file, 7);
+        /* Abort on error */
+        if (items < bs_len)
+          KILL (obs_file, 7);
+      }
+      break;
     }
-    break;
   }
 
 
@@ -823,13 +1108,14 @@ int main (int argc, char *argv[]) {
   /* *** FINALIZATIONS *** */
 
   /* Free memory allocated */
+  bs_free_index (idx);
   free (erased_frame);
   free (ep);
   free (bs);
 
   /* Close the output file and quit *** */
-  fclose (Fibs);
-  fclose (Fep);
+  bs_close (Fibs);
+  bs_close (Fep);
   fclose (Fobs);
 #ifdef DEBUG
   fclose (F);
@@ -98,6 +98,21 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
 		  **  Include the following routine
 		  **  G. Schroeder 04.08.1993
 		  **
+                  - BER_generator_packed (SCD_EID *EID, long lseg,
+                                          EID_WORD *EPbits)
+                  - BER_insertion_packed (long lseg, short *ibuff,
+                                          short *obuff, EID_WORD *EPbits)
+                  - BER_xor_packed (long nbits, EID_WORD *ibits,
+                                    EID_WORD *obits, EID_WORD *EPbits)
+                  - EID_pack_pattern (short *EPbuff, long n,
+                                      EID_WORD *EPbits)
+                  - EID_unpack_pattern (EID_WORD *EPbits, long n,
+                                        short *EPbuff)
+                     Same as BER_generator and BER_insertion, with the
+                     error pattern packed in 64-bit words (1 bit per
+                     bit); conversion of G.192 patterns to and from
+                     this format.
+
                   -  FER_generator_random(SCD_EID *EID)
                      Frame erasure module.
                      Input : EID     = pointer to EID-struct
@@ -124,6 +139,26 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
 		   - FER_generator_burst(BURST_EID *state);
                    - reset_burst_eid(BURST_EID *burst_eid);
 
+                   - EID_random_fill(unsigned long *seed, long n,
+                                     double *RAN);
+                     Draws n random numbers of the generator at a time.
+
+                   - EID_random_skip(unsigned long *seed, unsigned long n);
+                     Skips n draws of the random number generator.
+
+                   - open_eid_segment(long nstates, long maxlen);
+                   - GEC_segment(SCD_EID *EID, EID_SEGMENT *seg);
+                   - get_GEC_segment(SCD_EID *EID, EID_SEGMENT *seg,
+                                                   char *flags);
+                   - burst_segment(BURST_EID *state, EID_SEGMENT *seg);
+                   - get_burst_segment(BURST_EID *state, EID_SEGMENT *seg,
+                                                         char *flags);
+                   - close_eid_segment(EID_SEGMENT *seg);
+                     Generate a segment of a pattern for all the channel
+                     states at its start, so that the segments of a long
+                     pattern can be generated at the same time, and take
+                     them in order with the actual channel state.
+
  HISTORY:
   28.Feb.92 v1.0 1st UGST version
   20.Apr.92 v2.0 Modifications on the RNG
@@ -142,6 +177,14 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                  to extend Bellcore burst model resolution and operating
                  range to [0.5-30%]. <J.Sv. Ericsson>
   02.Feb.10 v2.7 Modified maximum string lenght for filenames (y.hiwasaki)
+  16.Oct.26 v2.8 Added EID_random_skip() and the segment functions, to
+                 generate the parts of a long pattern independently
+  16.Oct.26 v2.9 Added the packed (1 bit per bit) error patterns:
+                 BER_generator_packed(), BER_insertion_packed(),
+                 BER_xor_packed() and the G.192 converters
+  16.Oct.26 v3.0 EID_random() and FER_generator_burst() without pow();
+                 added EID_random_fill(), used by the bit error generators
+                 to draw a block at a time
   =============================================================================
 */
 
@@ -467,12 +510,24 @@ int PORTABILITY_TEST_OPERATION = 1;
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EID_SSE2
+#include <emmintrin.h>
+#endif
 
 /* ......... Include of EID prototypes and definitions .........*/
 #include "eid.h"
 
 /* Local function prototypes and definitions .........*/
 double EID_random ARGS ((unsigned long *seed));
+
+/* Scale of the seed to a random number in 0..1, 2^-(bits in a long), and
+   block length of the random numbers drawn by the bit error generators */
+#define EID_RAN_SCALE (1.0 / ((double) ULONG_MAX + 1.0))
+#define EID_RAN_BLOCK 256
 void update_EID_random ARGS ((long len_register, long *shift_register));
 long GEC_init ARGS ((SCD_EID * EID, double ber, double gamma));
 double bfer_comp (long index);
@@ -638,47 +693,44 @@ double BER_generator (EID, lseg, EPbuff)
      long lseg;
      short *EPbuff;
 {
-  long i, n;                    /* value of random generator */
-  double RAN, ber;              /* aux. for computing bit error rate */
+  long i, k, n, blk;            /* value of random generator */
+  long state, errors, err;      /* aux. for computing bit error rate */
+  double RAN[2 * EID_RAN_BLOCK], *row;
 
 
   /* Return if no samples are to be processed */
   if (lseg == (long) 0)
     return (0.0);
 
-  /* Generate random bits */
-  ber = 0.0;
-  for (i = 0; i < lseg; i++) {
-    /* Get next random number */
-    RAN = EID_random (&(EID->seed));
-
-    /* ... check the new channel state */
-    for (n = 0; n < EID->nstates; n++) {
-      if (RAN < EID->matrix[EID->current_state][n]) {
-        EID->current_state = n; /* goto to the selected state */
-        n = EID->nstates;       /* -> aborts loop */
+  /* Generate random bits, drawing the random numbers a block at a time: 2 per bit, the first for the state transition and the second for the bit error */
+  errors = 0;
+  state = EID->current_state;
+  for (i = 0; i < lseg; i += blk) {
+    blk = (lseg - i < EID_RAN_BLOCK) ? lseg - i : EID_RAN_BLOCK;
+    EID_random_fill (&(EID->seed), 2 * blk, RAN);
+
+    for (k = 0; k < blk; k++) {
+      /* ... check the new channel state */
+      row = EID->matrix[state];
+      for (n = 0; n < EID->nstates; n++) {
+        if (RAN[2 * k] < row[n]) {
+          state = n;            /* goto to the selected state */
+          break;
+        }
       }
-    }
-
-
-    /*
-     * ......... COMPUTE BIT ERROR IN CURRENT STATE .........
-     */
 
-    /* Get next random number */
-    RAN = EID_random (&(EID->seed));
+      /*
+       * ......... COMPUTE BIT ERROR IN CURRENT STATE .........
+       */
 
-    /* If random number is below the threshold (bit error rate in current state), insert soft decision information for 'error' */
-    if (RAN < EID->ber[EID->current_state]) {
-      EPbuff[i] = (short) 0x0081;
-      ber += 1.0;               /* increment number of errors */
-    }
-    /* otherwise insert soft decision information for 'no error' */
-    else {
-      EPbuff[i] = (short) 0x007F;
+      /* If random number is below the threshold (bit error rate in current state), insert soft decision information for 'error' (0x0081), otherwise for 'no error' (0x007F) */
+      err = RAN[2 * k + 1] < EID->ber[state];
+      EPbuff[i + k] = (short) (0x007F + (err << 1));
+      errors += err;            /* increment number of errors */
     }
   }
-  return (ber);                 /* return number of error bits */
+  EID->current_state = state;
+  return ((double) errors);     /* return number of error bits */
 }
 
 /* ....................... End of BER_generator() ....................... */
@@ -916,6 +968,304 @@ void BER_insertion_stl96 (lseg, xbuff, ybuff, EPbuff)
 /* ..................... End of BER_insertion_stl96() ..................... */
 
 
+/*
+  ============================================================================
+
+        long BER_generator_packed (SCD_EID *EID, long lseg,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  EID_WORD *EPbits);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as BER_generator(), but the bit error pattern is packed in
+        EID_WORD words: bit i of the pattern (1 for an error) is bit
+        (i % EID_WORD_BITS) of EPbits[i / EID_WORD_BITS], the first bit
+        in time being the LSb of the first word, as in the compact
+        pattern files. The random numbers drawn are the same as those
+        of BER_generator(), so both functions may be used in turn with
+        the same EID. The unused bits of the last word are set to 0.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ...... (In/Out) struct with channel model
+        lseg: ..... (In)     number of bits to be generated
+        EPbits: ... (Out)    packed bit error pattern, with
+                             EID_WORDS(lseg) words
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of bit errors, as a long.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long BER_generator_packed (EID, lseg, EPbits)
+     SCD_EID *EID;
+     long lseg;
+     EID_WORD *EPbits;
+{
+  long j, k, n, nbits, state, errors = 0;
+  double RAN[2 * EID_WORD_BITS], *row;
+  EID_WORD word;
+
+  state = EID->current_state;
+  for (j = 0; j < EID_WORDS (lseg); j++) {
+    nbits = (lseg - j * EID_WORD_BITS < EID_WORD_BITS) ? lseg - j * EID_WORD_BITS : EID_WORD_BITS;
+    EID_random_fill (&(EID->seed), 2 * nbits, RAN);
+
+    word = 0;
+    for (k = 0; k < nbits; k++) {
+      /* ... check the new channel state, as in BER_generator() */
+      row = EID->matrix[state];
+      for (n = 0; n < EID->nstates; n++) {
+        if (RAN[2 * k] < row[n]) {
+          state = n;
+          break;
+        }
+      }
+
+      /* ... and the bit error in the current state */
+      word |= (EID_WORD) (RAN[2 * k + 1] < EID->ber[state]) << k;
+    }
+    EPbits[j] = word;
+    errors += EID_popcount (word);
+  }
+  EID->current_state = state;
+  return (errors);
+}
+
+/* .................... End of BER_generator_packed() .................... */
+
+
+/*
+  ============================================================================
+
+        void BER_insertion_packed (long lseg, short *xbuff, short *ybuff,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  EID_WORD *EPbits);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as BER_insertion_stl96() for a hard bit error pattern, the
+        pattern being packed as by BER_generator_packed(). A softbit
+        0x007F ('0') becomes 0x0081 if its pattern bit is set, and any
+        other softbit (taken as '1') becomes 0x007F if its pattern bit is
+        set and 0x0081 otherwise, without branches. Where SSE2 is
+        available, 8 softbits are processed at a time, their pattern bits
+        being spread over 16-bit masks.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: ..... length of current frame, including the sync header
+                    (2 words), as for BER_insertion_stl96()
+        xbuff: .... buffer with input G.192 bitstream (length = "lseg")
+        ybuff: .... buffer with output G.192 bitstream (length = "lseg");
+                    may be the same as xbuff
+        EPbits: ... packed error pattern, for the lseg-2 softbits
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void BER_insertion_packed (lseg, xbuff, ybuff, EPbits)
+     long lseg;
+     short *xbuff;
+     short *ybuff;
+     EID_WORD *EPbits;
+{
+  long i, n = lseg - 2;
+  short *x = xbuff + 2, *y = ybuff + 2;
+  int e;
+
+  /* Copy sync header to the output buffer */
+  ybuff[0] = xbuff[0];
+  ybuff[1] = xbuff[1];
+
+  i = 0;
+#ifdef EID_SSE2
+  {
+    __m128i sel = _mm_setr_epi16 (1, 2, 4, 8, 16, 32, 64, 128);
+    __m128i zero = _mm_set1_epi16 (0x007F), one = _mm_set1_epi16 (0x0081), two = _mm_set1_epi16 (2);
+    __m128i err, flip;
+
+    for (; i + 8 <= n; i += 8) {
+      /* 0xFFFF where the pattern has an error */
+      e = (int) (EPbits[i / EID_WORD_BITS] >> (i % EID_WORD_BITS)) & 0xFF;
+      err = _mm_cmpeq_epi16 (_mm_and_si128 (_mm_set1_epi16 ((short) e), sel), sel);
+
+      /* 0xFFFF where the output is '0': input '0' without error, or '1' with error */
+      flip = _mm_xor_si128 (_mm_cmpeq_epi16 (_mm_loadu_si128 ((__m128i *) & x[i]), zero), err);
+      _mm_storeu_si128 ((__m128i *) & y[i], _mm_sub_epi16 (one, _mm_and_si128 (flip, two)));
+    }
+  }
+#endif
+  for (; i < n; i++) {
+    e = (int) (EPbits[i / EID_WORD_BITS] >> (i % EID_WORD_BITS)) & 1;
+    y[i] = (short) (0x0081 - (((x[i] == (short) 0x007F) ^ e) << 1));
+  }
+}
+
+/* .................... End of BER_insertion_packed() .................... */
+
+
+/*
+  ============================================================================
+
+        long BER_xor_packed (long nbits, EID_WORD *xbits, EID_WORD *ybits,
+        ~~~~~~~~~~~~~~~~~~~  EID_WORD *EPbits);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Insert the errors of a packed pattern in a packed (hard bit)
+        bitstream, a word at a time, as eid-xor does for compact
+        bitstreams. The loop has no dependencies between words and is
+        vectorized by the compiler.
+
+        Parameters:
+        ~~~~~~~~~~~
+        nbits: .... number of bits
+        xbits: .... input bitstream, EID_WORDS(nbits) words
+        ybits: .... output bitstream; may be the same as xbits
+        EPbits: ... packed error pattern
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of bits in error, as a long.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long BER_xor_packed (nbits, xbits, ybits, EPbits)
+     long nbits;
+     EID_WORD *xbits;
+     EID_WORD *ybits;
+     EID_WORD *EPbits;
+{
+  long j, nwords = EID_WORDS (nbits), errors = 0;
+
+  for (j = 0; j < nwords; j++)
+    ybits[j] = xbits[j] ^ EPbits[j];
+  for (j = 0; j < nwords; j++)
+    errors += EID_popcount (EPbits[j]);
+  return (errors);
+}
+
+/* ....................... End of BER_xor_packed() ....................... */
+
+
+/*
+  ============================================================================
+
+        long EID_pack_pattern (short *EPbuff, long n, EID_WORD *EPbits);
+        ~~~~~~~~~~~~~~~~~~~~~
+        void EID_unpack_pattern (EID_WORD *EPbits, long n, short *EPbuff);
+        ~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Convert a G.192 bit error pattern to the packed format and back.
+        When packing, softbits 0x0081 ... 0x00FF (disturbed) give a 1 and
+        0x0001 ... 0x007F (undisturbed) a 0, so soft patterns lose their
+        probabilities; when unpacking, hard softbits (0x0081 and 0x007F)
+        are produced, as by BER_generator(). Frame erasure flags are not
+        converted: they are 1 per frame, not per bit.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EPbuff: ... G.192 error pattern (softbits)
+        n: ........ number of bits
+        EPbits: ... packed error pattern, EID_WORDS(n) words
+
+        Return value:
+        ~~~~~~~~~~~~~
+        EID_pack_pattern() returns the number of bit errors as a long.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long EID_pack_pattern (EPbuff, n, EPbits)
+     short *EPbuff;
+     long n;
+     EID_WORD *EPbits;
+{
+  long i, j, k, errors = 0;
+  EID_WORD word;
+
+  for (j = 0, i = 0; i < n; j++) {
+    word = 0;
+    for (k = 0; k < EID_WORD_BITS && i < n; k++, i++)
+      word |= (EID_WORD) ((EPbuff[i] >> 7) & 1) << k;
+    EPbits[j] = word;
+    errors += EID_popcount (word);
+  }
+  return (errors);
+}
+
+void EID_unpack_pattern (EPbits, n, EPbuff)
+     EID_WORD *EPbits;
+     long n;
+     short *EPbuff;
+{
+  long i;
+
+  for (i = 0; i < n; i++)
+    EPbuff[i] = (short) (0x007F + (((EPbits[i / EID_WORD_BITS] >> (i % EID_WORD_BITS)) & 1) << 1));
+}
+
+/* ................. End of EID_{un}pack_pattern() ................. */
+
+
+/*
+  ============================================================================
+
+        long EID_popcount (EID_WORD word);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Number of bits set in a packed pattern word, with the popcount
+        instruction where the compiler provides it.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long EID_popcount (word)
+     EID_WORD word;
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return ((long) __builtin_popcountll (word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return ((long) ((word * 0x0101010101010101ULL) >> 56));
+#endif
+}
+
+/* ....................... End of EID_popcount() ....................... */
+
+
 
 /*
   ============================================================================
@@ -1252,9 +1602,6 @@ double FER_module_stl96 (EID, lseg, xbuff, ybuff)
 double EID_random (seed)
      unsigned long *seed;
 {
-  /* Size in bits (=size in bytes * 8) for long variables */
-  static double bits_in_long = sizeof (long) * 8;
-
   /* Update RNG */
   *seed = ((unsigned long) 69069L * (*seed) + 1L);
 
@@ -1262,13 +1609,64 @@ double EID_random (seed)
 #ifdef WAS
   return (pow ((double) 2.0, (double) -32.0) * (double) (*seed));
 #else
-  return (pow ((double) 2.0, -bits_in_long) * (double) (*seed));
+  return (EID_RAN_SCALE * (double) (*seed));
 #endif
 }
 
 /* ....................... End of EID_random() ....................... */
 
 
+/*
+  ============================================================================
+
+        void EID_random_fill (unsigned long *seed, long n, double *RAN);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fill a buffer with the next n random numbers of EID_random(),
+        which are the same as those of n calls to EID_random(). The loop
+        keeps the seed in a register, and the conversion to double is
+        left to the end, so that it may be vectorized by the compiler.
+
+        Parameters:
+        ~~~~~~~~~~~
+        seed: ... long seed, updated.
+        n: ...... number of random numbers.
+        RAN: .... buffer with n random numbers in the range 0..1.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void EID_random_fill (seed, n, RAN)
+     unsigned long *seed;
+     long n;
+     double *RAN;
+{
+  unsigned long s = *seed, u[EID_RAN_BLOCK];
+  long i, k, blk;
+
+  for (i = 0; i < n; i += blk) {
+    blk = (n - i < EID_RAN_BLOCK) ? n - i : EID_RAN_BLOCK;
+    for (k = 0; k < blk; k++)
+      u[k] = s = (unsigned long) 69069L *s + 1L;
+    for (k = 0; k < blk; k++)
+      RAN[i + k] = EID_RAN_SCALE * (double) u[k];
+  }
+  *seed = s;
+}
+
+/* ...................... End of EID_random_fill() ...................... */
+
+
 /*
   ============================================================================
 
@@ -1825,6 +2223,7 @@ BURST_EID *open_burst_eid (index)
                        longs have 64, not 32 bits). Implemented by
                        <simao.campos@comsat.com>, after bug reported
                        by <claude.lamblin@cnet.francetelecom.fr>
+	16.Oct.26 v3.1 Random number without pow(), as in EID_random().
 
  ============================================================================
 */
@@ -1833,8 +2232,6 @@ double FER_generator_burst (state)
 {
   long in;
   double ran, aux;
-  /* Size in bits (=size in bytes * 8) for long variables */
-  static double bits_in_long = sizeof (long) * 8;
 
   /* UGST Random number generator */
   state->seedptr = ((unsigned long) 69069L * (state->seedptr) + 1L);
@@ -1843,7 +2240,7 @@ double FER_generator_burst (state)
 #ifdef WAS
   ran = (pow ((double) 2.0, (double) -32.0) * (double) (state->seedptr));
 #else
-  ran = (pow ((double) 2.0, -bits_in_long) * (double) (state->seedptr));
+  ran = (EID_RAN_SCALE * (double) (state->seedptr));
 #endif
   aux = prob[state->s_new];
   in = floor (ran + aux);       /* in = 0 indicates good frame */
@@ -1928,6 +2325,404 @@ BURST_EID *reset_burst_eid (burst_eid)
 
 /* ...................... End of reset_burst_eid() ...................... */
 
+
+/*
+   -------------------------------------------------------------------------
+   void EID_random_skip (unsigned long *seed, unsigned long n);
+   ~~~~~~~~~~~~~~~~~~~~
+
+   Advance the seed of EID_random() by n draws, as if EID_random() had
+   been called n times, in about log2(n) steps. The n-fold composition
+   of the LCG x -> a*x+c is again an LCG, x -> A*x+C, with A and C
+   built by repeated squaring; all operations are modulo the size of
+   an unsigned long, as in EID_random() itself.
+
+   Parameter:
+   ~~~~~~~~~~
+   seed: ... (In/Out) seed of the random number generator
+   n: ...... (In)     number of draws to skip
+
+   Return value: None.
+   ~~~~~~~~~~~~~
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void EID_random_skip (seed, n)
+     unsigned long *seed;
+     unsigned long n;
+{
+  unsigned long a = 69069L, c = 1L;     /* 2^k draws: x -> a*x+c */
+  unsigned long A = 1L, C = 0L; /* draws so far: x -> A*x+C */
+
+  for (; n; n >>= 1) {
+    if (n & 1) {
+      A = a * A;
+      C = a * C + c;
+    }
+    c = (a + 1) * c;
+    a = a * a;
+  }
+  *seed = A * (*seed) + C;
+}
+
+/* ...................... End of EID_random_skip() ...................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   EID_SEGMENT *open_eid_segment (long nstates, long maxlen);
+   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Allocate an EID_SEGMENT for patterns of up to maxlen bits/frames of a
+   channel model with nstates states (EID->nstates for the Gilbert model,
+   MODEL_SIZE for the Bellcore model).
+
+   Parameter:
+   ~~~~~~~~~~
+   nstates: ... (In) number of states of the channel model
+   maxlen: .... (In) maximum number of bits/frames in the segment
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns a pointer to the EID_SEGMENT, or a null pointer if memory
+   could not be allocated.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+EID_SEGMENT *open_eid_segment (nstates, maxlen)
+     long nstates;
+     long maxlen;
+{
+  EID_SEGMENT *seg;
+
+  if ((seg = (EID_SEGMENT *) calloc (1, sizeof (EID_SEGMENT))) == 0L)
+    return ((EID_SEGMENT *) 0);
+  seg->nstates = nstates;
+  seg->maxlen = maxlen;
+  seg->flags = (char *) malloc (nstates * maxlen * sizeof (char));
+  seg->last = (long *) malloc (nstates * sizeof (long));
+  seg->count = (long *) malloc (nstates * sizeof (long));
+  seg->internal = (long *) malloc ((nstates + 1) * MODEL_SIZE * sizeof (long));
+  if (seg->flags == 0L || seg->last == 0L || seg->count == 0L || seg->internal == 0L) {
+    close_eid_segment (seg);
+    return ((EID_SEGMENT *) 0);
+  }
+  return (seg);
+}
+
+/* ..................... End of open_eid_segment() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void close_eid_segment (EID_SEGMENT *seg);
+   ~~~~~~~~~~~~~~~~~~~~~~
+
+   Release the memory allocated by open_eid_segment().
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void close_eid_segment (seg)
+     EID_SEGMENT *seg;
+{
+  free (seg->flags);
+  free (seg->last);
+  free (seg->count);
+  free (seg->internal);
+  free (seg);
+}
+
+/* ..................... End of close_eid_segment() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void GEC_segment (SCD_EID *EID, EID_SEGMENT *seg);
+   ~~~~~~~~~~~~~~~~
+
+   Generate seg->lseg bits (as BER_generator) or frame erasure flags (as
+   FER_generator_random) of the Gilbert model EID, starting from the seed
+   seg->seed, for all the possible channel states at the start of the
+   segment. Both generators draw 2 random numbers per item, so the seed of
+   the n-th segment can be obtained from the seed at the start of the
+   pattern with EID_random_skip(). EID is not modified, so that several
+   segments may be generated at the same time.
+
+   Parameter:
+   ~~~~~~~~~~
+   EID: ..... (In)     struct with the channel model
+   seg: ..... (In/Out) segment, opened with EID->nstates states, with
+                       seed and lseg set by the caller
+
+   Return value: None.
+   ~~~~~~~~~~~~~
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void GEC_segment (EID, seg)
+     SCD_EID *EID;
+     EID_SEGMENT *seg;
+{
+  long i, n, s, state, merged;
+  long *last = seg->last;
+  unsigned long seed = seg->seed;
+  double RAN1, RAN2;
+  char *row;
+
+  for (s = 0; s < seg->nstates; s++) {
+    last[s] = s;
+    seg->count[s] = 0;
+  }
+  seg->tail_count = 0;
+
+  /* Follow each start state until all of them have led to the same state */
+  merged = seg->nstates < 2;
+  for (i = 0; i < seg->lseg && !merged; i++) {
+    RAN1 = EID_random (&seed);
+    RAN2 = EID_random (&seed);
+    for (merged = 1, s = 0; s < seg->nstates; s++) {
+      /* Same transition and error as in BER_generator() */
+      state = last[s];
+      for (n = 0; n < EID->nstates; n++) {
+        if (RAN1 < EID->matrix[state][n]) {
+          state = n;
+          n = EID->nstates;
+        }
+      }
+      last[s] = state;
+      row = seg->flags + s * seg->maxlen;
+      row[i] = RAN2 < EID->ber[state];
+      seg->count[s] += row[i];
+      if (state != last[0])
+        merged = 0;
+    }
+  }
+  seg->merge = i;
+
+  /* From then on, a single pattern is generated */
+  state = last[0];
+  for (; i < seg->lseg; i++) {
+    RAN1 = EID_random (&seed);
+    RAN2 = EID_random (&seed);
+    for (n = 0; n < EID->nstates; n++) {
+      if (RAN1 < EID->matrix[state][n]) {
+        state = n;
+        n = EID->nstates;
+      }
+    }
+    seg->flags[i] = RAN2 < EID->ber[state];
+    seg->tail_count += seg->flags[i];
+  }
+  if (merged)
+    for (s = 0; s < seg->nstates; s++)
+      last[s] = state;
+  seg->end_seed = seed;
+}
+
+/* ........................ End of GEC_segment() ........................ */
+
+
+/*
+   -------------------------------------------------------------------------
+   long get_GEC_segment (SCD_EID *EID, EID_SEGMENT *seg, char *flags);
+   ~~~~~~~~~~~~~~~~~~~~
+
+   Take the pattern of a segment generated by GEC_segment() for the
+   current state of EID, and update EID (seed and channel state) as if
+   the segment had been generated by BER_generator() or
+   FER_generator_random(). The segments have to be taken in order.
+
+   Parameter:
+   ~~~~~~~~~~
+   EID: ..... (In/Out) struct with the channel model
+   seg: ..... (In)     segment generated by GEC_segment()
+   flags: ... (Out)    seg->lseg flags, 1 for a bit error/frame erasure
+                       and 0 otherwise
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the number of bit errors/frame erasures in the segment.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+long get_GEC_segment (EID, seg, flags)
+     SCD_EID *EID;
+     EID_SEGMENT *seg;
+     char *flags;
+{
+  long s = EID->current_state;
+
+  memcpy (flags, seg->flags + s * seg->maxlen, seg->merge);
+  memcpy (flags + seg->merge, seg->flags + seg->merge, seg->lseg - seg->merge);
+  EID->current_state = seg->last[s];
+  EID->seed = seg->end_seed;
+  return (seg->count[s] + seg->tail_count);
+}
+
+/* ...................... End of get_GEC_segment() ...................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void burst_segment (BURST_EID *state, EID_SEGMENT *seg);
+   ~~~~~~~~~~~~~~~~~~
+
+   Generate seg->lseg frame erasure flags of the Bellcore model, as
+   FER_generator_burst() would, starting from the seed seg->seed, for
+   all the possible model states at the start of the segment. One random
+   number is drawn per frame. The state is not modified. The transition
+   probabilities are computed from the rate index of the state, not taken
+   from the global prob[] (whose P0 is that of the last open_burst_eid()),
+   so that segments of models of different rates may be generated at the
+   same time.
+
+   Parameter:
+   ~~~~~~~~~~
+   state: ... (In)     BURST_EID structure (for its rate index)
+   seg: ..... (In/Out) segment, opened with MODEL_SIZE states, with seed
+                       and lseg set by the caller
+
+   Return value: None.
+   ~~~~~~~~~~~~~
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   16.Oct.26  v.1.1  Probabilities from the rate index of the state.
+   -------------------------------------------------------------------------
+ */
+void burst_segment (state, seg)
+     BURST_EID *state;
+     EID_SEGMENT *seg;
+{
+  long i, j, s, in, s_new, merged;
+  long *last = seg->last, *internal;
+  unsigned long seed = seg->seed;
+  double ran, p[MODEL_SIZE];
+  char *row;
+
+  /* Transition probabilities of the rate of the model */
+  memcpy (p, prob, sizeof (p));
+  p[0] = bfer_comp (state->index);
+
+  for (s = 0; s < seg->nstates; s++) {
+    last[s] = s;
+    seg->count[s] = 0;
+  }
+  for (j = 0; j < (seg->nstates + 1) * MODEL_SIZE; j++)
+    seg->internal[j] = 0;
+  seg->tail_count = 0;
+
+  /* Follow each start state until all of them have led to the same state */
+  merged = seg->nstates < 2;
+  for (i = 0; i < seg->lseg && !merged; i++) {
+    ran = EID_random (&seed);
+    for (merged = 1, s = 0; s < seg->nstates; s++) {
+      /* Same erasure and counters as in FER_generator_burst() */
+      s_new = last[s];
+      internal = seg->internal + s * MODEL_SIZE;
+      in = floor (ran + p[s_new]);
+      if (in == 0) {
+        internal[s_new]++;
+        if (s_new != 0)
+          internal[0]++;
+        s_new = 0;
+      } else
+        s_new++;
+      last[s] = s_new;
+      row = seg->flags + s * seg->maxlen;
+      row[i] = (char) in;
+      seg->count[s] += in;
+      if (s_new != last[0])
+        merged = 0;
+    }
+  }
+  seg->merge = i;
+
+  /* From then on, a single pattern is generated */
+  s_new = last[0];
+  internal = seg->internal + seg->nstates * MODEL_SIZE;
+  for (; i < seg->lseg; i++) {
+    ran = EID_random (&seed);
+    in = floor (ran + p[s_new]);
+    if (in == 0) {
+      internal[s_new]++;
+      if (s_new != 0)
+        internal[0]++;
+      s_new = 0;
+    } else
+      s_new++;
+    seg->flags[i] = (char) in;
+    seg->tail_count += in;
+  }
+  if (merged)
+    for (s = 0; s < seg->nstates; s++)
+      last[s] = s_new;
+  seg->end_seed = seed;
+}
+
+/* ....................... End of burst_segment() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long get_burst_segment (BURST_EID *state, EID_SEGMENT *seg, char *flags);
+   ~~~~~~~~~~~~~~~~~~~~~~
+
+   Take the pattern of a segment generated by burst_segment() for the
+   current model state, and update the state (seed, model state and
+   counters) as if the segment had been generated by
+   FER_generator_burst(). The segments have to be taken in order.
+
+   Parameter:
+   ~~~~~~~~~~
+   state: ... (In/Out) BURST_EID structure
+   seg: ..... (In)     segment generated by burst_segment()
+   flags: ... (Out)    seg->lseg flags, 1 for a frame erasure and 0
+                       otherwise
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the number of frame erasures in the segment.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+long get_burst_segment (state, seg, flags)
+     BURST_EID *state;
+     EID_SEGMENT *seg;
+     char *flags;
+{
+  long j, s = state->s_new;
+
+  memcpy (flags, seg->flags + s * seg->maxlen, seg->merge);
+  memcpy (flags + seg->merge, seg->flags + seg->merge, seg->lseg - seg->merge);
+  for (j = 0; j < MODEL_SIZE; j++)
+    state->internal[j] += seg->internal[s * MODEL_SIZE + j] + seg->internal[seg->nstates * MODEL_SIZE + j];
+  state->s_new = seg->last[s];
+  state->seedptr = seg->end_seed;
+  return (seg->count[s] + seg->tail_count);
+}
+
+/* ..................... End of get_burst_segment() ..................... */
+
 /* bfer_comp for Bellcore model
    compute steady state value of P0 in state transition prob matrix,
    given that P1..P9 are fixed
@@ -16,6 +16,10 @@
                         <Morgan.Lindqvist@era-t.ericsson.se> comments for the
 		        cc compiler in a DEC Alpha Unix machine.
    10.Oct.97    v2.4    Added prototype for reset_burst_eid() <simao>   
+   16.Oct.26    v2.5    Added EID_random_skip() and the EID_SEGMENT functions
+                        for generating a pattern in independent segments
+   16.Oct.26    v2.6    Added the packed bit error patterns (EID_WORD)
+   16.Oct.26    v2.7    Added EID_random_fill()
   ============================================================================
 */
 
@@ -66,6 +70,40 @@ typedef struct {
   long index;
 } BURST_EID;
 
+/* 
+ * ......... Packed bit error pattern .........
+ * One bit per bit of the bitstream (1 for an error), the first bit in time
+ * being the LSb of the first word, as in the compact pattern files
+ */
+typedef unsigned long long EID_WORD;
+#define EID_WORD_BITS 64
+#define EID_WORDS(n) (((n) + EID_WORD_BITS - 1) / EID_WORD_BITS)
+
+/* 
+ * ......... Segment of a pattern, generated from every channel state .........
+ * The pattern of a segment depends on the channel state at its start, which
+ * is only known once the previous segments have been generated. The segment
+ * is thus generated from all the possible start states at once; since they
+ * are driven by the same random numbers, the states soon coincide, and from
+ * then on (item "merge") a single pattern is kept. 
+ */
+typedef struct {
+  unsigned long seed;           /* seed at the start of the segment */
+  unsigned long end_seed;       /* seed at the end of the segment */
+  long lseg;                    /* number of bits/frames in the segment */
+  long maxlen;                  /* maximum number of bits/frames */
+  long nstates;                 /* number of possible start states */
+  long merge;                   /* first item common to all start states */
+  char *flags;                  /* 1 for an error/erasure, 0 otherwise: */
+  /* row s has the first "merge" items from */
+  /* state s; row 0 also has the common rest */
+  long *last;                   /* state at the end from each start state */
+  long *count;                  /* errors before "merge", per start state */
+  long tail_count;              /* errors from "merge" on */
+  long *internal;               /* Bellcore counters: MODEL_SIZE per start */
+  /* state before "merge", then the rest */
+} EID_SEGMENT;
+
 /* 
  * ......... Definitions for G.192-compliant or non-compliant  ......... 
  * ......... handling of soft bitstreams (post- and pre-STL92) ......... 
@@ -97,5 +135,19 @@ double FER_generator_burst ARGS ((BURST_EID * state));
 double FER_module ARGS ((SCD_EID * EID, long lseg, short *xbuff, short *ybuff));
 double FER_generator_burst ARGS ((BURST_EID * state));
 BURST_EID *reset_burst_eid ARGS ((BURST_EID * burst_eid));
+long BER_generator_packed ARGS ((SCD_EID * EID, long lseg, EID_WORD * EPbits));
+void BER_insertion_packed ARGS ((long lseg, short *xbuff, short *ybuff, EID_WORD * EPbits));
+long BER_xor_packed ARGS ((long nbits, EID_WORD * xbits, EID_WORD * ybits, EID_WORD * EPbits));
+long EID_pack_pattern ARGS ((short *EPbuff, long n, EID_WORD * EPbits));
+void EID_unpack_pattern ARGS ((EID_WORD * EPbits, long n, short *EPbuff));
+long EID_popcount ARGS ((EID_WORD word));
+void EID_random_fill ARGS ((unsigned long *seed, long n, double *RAN));
+void EID_random_skip ARGS ((unsigned long *seed, unsigned long n));
+EID_SEGMENT *open_eid_segment ARGS ((long nstates, long maxlen));
+void close_eid_segment ARGS ((EID_SEGMENT * seg));
+void GEC_segment ARGS ((SCD_EID * EID, EID_SEGMENT * seg));
+long get_GEC_segment ARGS ((SCD_EID * EID, EID_SEGMENT * seg, char *flags));
+void burst_segment ARGS ((BURST_EID * state, EID_SEGMENT * seg));
+long get_burst_segment ARGS ((BURST_EID * state, EID_SEGMENT * seg, char *flags));
 #endif
 /* ........................... End of EID.H ........................... */
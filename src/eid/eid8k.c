@@ -1,4 +1,4 @@
-/*                                                           02.Feb.2010 v3.3
+/*                                                           16.Oct.2026 v3.4
   ============================================================================
 
   eid8k.c
@@ -24,7 +24,7 @@
 
   Usage:
   ~~~~~
-  eid8k err_pat_bs mode frno startfr state_f rate
+  eid8k [-jobs N] err_pat_bs mode frno startfr state_f rate
   Where:
   err_pat_bs ... name of error pattern bitstream file
   mode ......... a letter representing one of 4 operating modes:
@@ -36,6 +36,10 @@
   state_f ...... name of a state variable file
   rate ......... desired BER [R], FER [F], or BFER[B]
 
+  Options:
+  -jobs N ...... generate the pattern in segments, N at the same time
+                 (the pattern is the same as with a single job)
+
   Original Author:
   ~~~~~~~~~~~~~~~~
   Gerhard Schroeder 		Tel: +49 6151 833973
@@ -58,6 +62,10 @@
                     mode <simao.campos@labs.comsat.com>
   02.Feb.2010 v3.3  Modified maximum string length for filenames to avoid
                     buffer overruns (y.hiwasaki)
+  16.Oct.2026 v3.4  Added option -jobs to generate long patterns in segments
+                    of EID8K_SEGMENT records at the same time; the channel
+                    state is carried from one segment to the next, so the
+                    pattern does not depend on the number of jobs.
   ============================================================================
 */
 
@@ -70,6 +78,10 @@
 #include "eid.h"                /* EID functions */
 #include "eid_io.h"             /* EID I/O functions */
 
+#ifdef EID_THREADS
+#include <pthread.h>
+#endif
+
 /* ..... Definitions used by the program ..... */
 #define SYNC_WORD (short)0x6B21
 #define EID_NULL (char)0X7F
@@ -79,6 +91,24 @@
 #define EID_MULTIPLE_BUFFER_LENGTH 2*EID_BUFFER_LENGTH
 #define OUT_RECORD_LENGTH 512
 #define ZERO_VECTOR_LENGTH OUT_RECORD_LENGTH-EID_MULTIPLE_BUFFER_LENGTH
+#define EID8K_SEGMENT 128       /* records per segment */
+#define EID8K_WINDOW 4          /* segments generated per job at a time */
+
+/* Segments of a pattern generated by several jobs */
+typedef struct {
+  EID_SEGMENT **seg;            /* segments being generated */
+  long nseg;                    /* number of segments in the window */
+  long next;                    /* next segment to be generated */
+  long jobs;                    /* number of jobs */
+  long items;                   /* bits or frames per record */
+  SCD_EID *eid;                 /* Gilbert model, or */
+  BURST_EID *burst;             /* Bellcore model */
+  char *flags;                  /* pattern of a segment */
+#ifdef EID_THREADS
+  pthread_t *thread;
+  pthread_mutex_t lock;         /* protects next */
+#endif
+} EID8K_BATCH;
 
 
 /*
@@ -94,7 +124,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("eid8k.c: Version 3.3 of 02.Feb.2010 \n\n");
+  printf ("eid8k.c: Version 3.4 of 16.Oct.2026 \n\n");
 
   printf ("  This example program produces the files which are necessary to \n");
   printf ("  generate all error pattern for performing the Experiment 1 and 3 of\n");
@@ -110,7 +140,7 @@ void display_usage () {
   printf ("  the 3 values 1%%, 3%%, and 5%%.\n");
   printf ("\n");
   printf ("  Usage:\n");
-  printf ("  eid8k err_pat_bs mode startfr frno state_f rate\n");
+  printf ("  eid8k [-jobs N] err_pat_bs mode startfr frno state_f rate\n");
   printf ("  Where:\n");
   printf ("  err_pat_bs ... name of error pattern bitstream file\n");
   printf ("  mode ......... a letter representing one of 4 operating modes: \n");
@@ -120,7 +150,9 @@ void display_usage () {
   printf ("  frno ......... the total number of error-producing frames\n");
   printf ("  startfr ...... the first frame to have bits that may introduce errors\n");
   printf ("  state_f ...... name of a state variable file\n");
-  printf ("  rate ......... desired BER [R], FER [F], or BFER[B]\n\n");
+  printf ("  rate ......... desired BER [R], FER [F], or BFER[B]\n");
+  printf ("  Options:\n");
+  printf ("  -jobs N ...... generate the pattern in segments, N at the same time\n\n");
 
   exit (-128);
 }
@@ -128,6 +160,117 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
+/*
+ -------------------------------------------------------------------------
+ void *segment_worker (void *arg);
+ ~~~~~~~~~~~~~~~~~~~~
+ Generate the segments of a window (an EID8K_BATCH pointed by arg) one
+ after the other, until none is left. Several workers may run at the
+ same time, each taking the next segment of the window.
+
+ History:
+ ~~~~~~~~
+ 16.Oct.26 v1.0 Created.
+ -------------------------------------------------------------------------
+*/
+void *segment_worker (void *arg) {
+  EID8K_BATCH *batch = (EID8K_BATCH *) arg;
+  long j;
+
+  for (;;) {
+#ifdef EID_THREADS
+    pthread_mutex_lock (&batch->lock);
+#endif
+    j = batch->next++;
+#ifdef EID_THREADS
+    pthread_mutex_unlock (&batch->lock);
+#endif
+    if (j >= batch->nseg)
+      return NULL;
+    if (batch->eid)
+      GEC_segment (batch->eid, batch->seg[j]);
+    else
+      burst_segment (batch->burst, batch->seg[j]);
+  }
+}
+
+/* .................... End of segment_worker() ........................... */
+
+
+/*
+ -------------------------------------------------------------------------
+ double run_segments (EID8K_BATCH *batch, long nrec, FILE *F);
+ ~~~~~~~~~~~~~~~~~~~
+ Generate nrec records of pattern with the model of the batch, a window
+ of segments at a time, and save them as the serial loops of main() do:
+ 2 halves of EID_BUFFER_LENGTH bits or 2 frame flags per record, padded
+ with zeros to OUT_RECORD_LENGTH chars.
+
+ Returns the number of bit errors or frame erasures.
+
+ History:
+ ~~~~~~~~
+ 16.Oct.26 v1.0 Created.
+ -------------------------------------------------------------------------
+*/
+double run_segments (EID8K_BATCH * batch, long nrec, FILE * F) {
+  char ybuff[OUT_RECORD_LENGTH];
+  char *flags = batch->flags;
+  unsigned long seed;
+  long i, j, k, n;
+  double disturbed = 0.0;
+#ifdef EID_THREADS
+  long nthreads;
+#endif
+
+  memset (ybuff, 0, OUT_RECORD_LENGTH);
+  while (nrec > 0) {
+    /* Seeds of the segments of the window: Gilbert draws 2 numbers per item, Bellcore 1 */
+    seed = batch->eid ? batch->eid->seed : batch->burst->seedptr;
+    for (batch->nseg = 0; nrec > 0 && batch->nseg < EID8K_WINDOW * batch->jobs; batch->nseg++) {
+      n = nrec < EID8K_SEGMENT ? nrec : EID8K_SEGMENT;
+      batch->seg[batch->nseg]->seed = seed;
+      batch->seg[batch->nseg]->lseg = n * batch->items;
+      EID_random_skip (&seed, batch->eid ? 2 * n * batch->items : n * batch->items);
+      nrec -= n;
+    }
+    batch->next = 0;
+
+#ifdef EID_THREADS
+    /* The main thread is one of the workers */
+    for (nthreads = 0; nthreads < batch->jobs - 1 && nthreads < batch->nseg - 1; nthreads++)
+      if (pthread_create (&batch->thread[nthreads], NULL, segment_worker, batch) != 0)
+        break;
+    segment_worker (batch);
+    for (j = 0; j < nthreads; j++)
+      pthread_join (batch->thread[j], NULL);
+#else
+    segment_worker (batch);
+#endif
+
+    /* Take the segments in order, carrying the channel state */
+    for (j = 0; j < batch->nseg; j++) {
+      if (batch->eid)
+        disturbed += get_GEC_segment (batch->eid, batch->seg[j], flags);
+      else
+        disturbed += get_burst_segment (batch->burst, batch->seg[j], flags);
+      for (i = 0; i < batch->seg[j]->lseg; i += batch->items) {
+        if (batch->items == 2 * EID_BUFFER_LENGTH)
+          for (k = 0; k < batch->items; k++)
+            ybuff[k] = flags[i + k] ? EID_ONE : EID_NULL;
+        else
+          for (k = 0; k < 2; k++)
+            memset (&ybuff[k * EID_BUFFER_LENGTH], flags[i + k] ? EID_FER : EID_NULL, EID_BUFFER_LENGTH);
+        fwrite (&ybuff[0], sizeof (char), OUT_RECORD_LENGTH, F);
+      }
+    }
+  }
+  return (disturbed);
+}
+
+/* .................... End of run_segments() ............................. */
+
+
 /* ************************************************************************* */
 /* ************************** MAIN_PROGRAM ********************************* */
 /* ************************************************************************* */
@@ -182,6 +325,8 @@ int main (int argc, char *argv[]) {
   long items;                   /* Number of output elements */
   long itot;
   long index;
+  long jobs = 1;                /* Segments generated at the same time */
+  EID8K_BATCH batch;
 #if defined(VMS)
   char mrs[15] = "mrs=512";
 #endif
@@ -197,6 +342,18 @@ int main (int argc, char *argv[]) {
   /* ***** PARSE INPUT DATA ***** */
   if (argc == 1)
     display_usage ();
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-jobs") == 0) {
+      /* Number of segments generated at the same time */
+      jobs = atol (argv[2]);
+      if (jobs < 1)
+        HARAKIRI ("The number of jobs should be at least 1\n", 1);
+      argc -= 2;
+      argv += 2;
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
 
   /*
    **  Get command line parameters
@@ -311,6 +468,30 @@ int main (int argc, char *argv[]) {
     HARAKIRI ("Could not allocate memory for error pattern buffer\n", 1);
   }
 
+  /*
+   **  Allocate the segments for the generation in several jobs
+   */
+#ifdef EID_THREADS
+  if ((batch.thread = (pthread_t *) malloc (jobs * sizeof (pthread_t))) == NULL)
+    jobs = 1;
+  pthread_mutex_init (&batch.lock, NULL);
+#else
+  jobs = 1;
+#endif
+  if (jobs > 1) {
+    batch.jobs = jobs;
+    batch.eid = (mode == 'R' || mode == 'r') ? BEReid : ((mode == 'F' || mode == 'f') ? FEReid : (SCD_EID *) 0);
+    batch.burst = batch.eid ? (BURST_EID *) 0 : burst_eid;
+    batch.items = (mode == 'R' || mode == 'r') ? 2 * EID_BUFFER_LENGTH : 2;
+    batch.flags = (char *) malloc (EID8K_SEGMENT * batch.items * sizeof (char));
+    batch.seg = (EID_SEGMENT **) calloc (EID8K_WINDOW * jobs, sizeof (EID_SEGMENT *));
+    if (batch.flags == NULL || batch.seg == NULL)
+      HARAKIRI ("Could not allocate memory for the pattern segments\n", 1);
+    for (i = 0; i < EID8K_WINDOW * jobs; i++)
+      if ((batch.seg[i] = open_eid_segment (batch.eid ? batch.eid->nstates : MODEL_SIZE, EID8K_SEGMENT * batch.items)) == NULL)
+        HARAKIRI ("Could not allocate memory for the pattern segments\n", 1);
+  }
+
   /*
    **  Generate the bit streams
    */
@@ -339,6 +520,12 @@ int main (int argc, char *argv[]) {
         items = fwrite (&ybuff[0], sizeof (char), 512, out_file_ptr);
         genbits += (double) 2 *EID_BUFFER_LENGTH;
       }
+      if (jobs > 1) {
+        dstbits = run_segments (&batch, number_of_frames - start_frame + 1, out_file_ptr);
+        prcbits = (double) 2 *EID_BUFFER_LENGTH * (number_of_frames - start_frame + 1);
+        genbits += prcbits;
+        break;
+      }
       for (i = start_frame; i <= number_of_frames; i++) {
         for (j = 0; j <= 1; j++) {
           ber1 = BER_generator (BEReid, EID_BUFFER_LENGTH, EPbuff);
@@ -365,6 +552,12 @@ int main (int argc, char *argv[]) {
         items = fwrite (&ybuff[0], sizeof (char), 512, out_file_ptr);
         genfrms += 2.0;
       }
+      if (jobs > 1) {
+        ersfrms = run_segments (&batch, number_of_frames - start_frame + 1, out_file_ptr);
+        prcfrms = 2.0 * (number_of_frames - start_frame + 1);
+        genfrms += prcfrms;
+        break;
+      }
       for (i = start_frame; i <= number_of_frames; i++) {
         for (j = 0; j <= 1; j++) {
           ber1 = FER_generator_random (FEReid);
@@ -390,6 +583,12 @@ int main (int argc, char *argv[]) {
         items = fwrite (&ybuff[0], sizeof (char), 512, out_file_ptr);
         genfrms += 2.0;
       }
+      if (jobs > 1) {
+        ersfrms = run_segments (&batch, number_of_frames - start_frame + 1, out_file_ptr);
+        prcfrms = 2.0 * (number_of_frames - start_frame + 1);
+        genfrms += prcfrms;
+        break;
+      }
       for (i = start_frame; i <= number_of_frames; i++) {
         for (j = 0; j <= 1; j++) {
           ber1 = FER_generator_burst (burst_eid);
@@ -476,6 +675,16 @@ int main (int argc, char *argv[]) {
    **  Close the output file and quit
    */
   fclose (out_file_ptr);
+  if (jobs > 1) {
+    for (i = 0; i < EID8K_WINDOW * jobs; i++)
+      close_eid_segment (batch.seg[i]);
+    free (batch.seg);
+    free (batch.flags);
+  }
+#ifdef EID_THREADS
+  pthread_mutex_destroy (&batch.lock);
+  free (batch.thread);
+#endif
 
 #ifndef VMS                     /* return value to OS if not VMS */
   return 0;
@@ -0,0 +1,248 @@
+/*                                                         16/Oct/2026 v1.1 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a benchmark of the bit error generators of eid.c:
+	the generator of the previous versions (EID_random() with pow(), one
+	call per random number), kept here as BER_generator_old(), and
+	BER_generator() and BER_generator_packed() of the current version,
+	which draw the random numbers a block at a time. The generators are
+	started from the same state, and the speeds in bits per second and
+	the agreement of the error patterns and of the final states are
+	reported.
+
+	The packed pattern functions are also checked on each frame:
+	EID_pack_pattern() must give the pattern of BER_generator_packed()
+	from the one of BER_generator(), EID_unpack_pattern() must give it
+	back, and BER_xor_packed() must disturb a bitstream frame as
+	BER_insertion_stl96() does, with the same number of errors. With
+	frames that are not a multiple of EID_WORD_BITS bits, this covers
+	the bit order and the last, partial word.
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+	16.Oct.26 v1.1 Checks of EID_pack_pattern(), EID_unpack_pattern()
+	               and BER_xor_packed()
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "eid.h"
+
+static void display_usage () {
+  printf ("EIDBENCH.C - Version 1.1 of 16.Oct.2026 \n\n");
+
+  printf (" Program to time the bit error generators of the EID\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ eidbench [-options]\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -n N.......... number of bits [default: 10000000]\n");
+  printf ("  -frame L...... bits per call of the generators [default: 256]\n");
+  printf ("  -ber B........ bit error rate [default: 0.01]\n");
+  printf ("  -gamma G...... burst factor [default: 0.5]\n");
+  printf ("  -seed S....... start value of the random generator [default: 1]\n");
+  printf ("\n");
+  exit (2);
+}
+
+
+/* EID_random() and BER_generator() as in eid.c up to v2.9 */
+static double EID_random_old (unsigned long *seed) {
+  static double bits_in_long = sizeof (long) * 8;
+
+  *seed = ((unsigned long) 69069L * (*seed) + 1L);
+  return (pow ((double) 2.0, -bits_in_long) * (double) (*seed));
+}
+
+static double BER_generator_old (SCD_EID * EID, long lseg, short *EPbuff) {
+  long i, n;
+  double RAN, ber = 0.0;
+
+  for (i = 0; i < lseg; i++) {
+    RAN = EID_random_old (&(EID->seed));
+    for (n = 0; n < EID->nstates; n++) {
+      if (RAN < EID->matrix[EID->current_state][n]) {
+        EID->current_state = n;
+        n = EID->nstates;
+      }
+    }
+    RAN = EID_random_old (&(EID->seed));
+    if (RAN < EID->ber[EID->current_state]) {
+      EPbuff[i] = (short) 0x0081;
+      ber += 1.0;
+    } else {
+      EPbuff[i] = (short) 0x007F;
+    }
+  }
+  return (ber);
+}
+
+
+int main (int argc, char *argv[]) {
+  SCD_EID *EID[3];
+  short *EP[2];                 /* patterns of BER_generator_old() and BER_generator() */
+  EID_WORD *EPbits;             /* pattern of BER_generator_packed() */
+  short *xbuff, *ybuff;         /* G.192 frame, before and after BER_insertion_stl96() */
+  EID_WORD *packed[3];          /* packed pattern, input and output frame */
+  long nbits = 10000000, lseg = 256, i, k, count, ndiff = 0, nbad = 0, bad, nerr;
+  unsigned long seed = 1;
+  double ber = 0.01, gamma = 0.5, errors[3], t[3];
+  int m;
+  clock_t t0;
+  static char *name[3] = { "old", "BER_generator", "BER_generator_packed" };
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-n") == 0) {
+      nbits = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-frame") == 0) {
+      lseg = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-ber") == 0) {
+      ber = atof (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-gamma") == 0) {
+      gamma = atof (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-seed") == 0) {
+      seed = strtoul (argv[2], NULL, 0);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
+  if (nbits < 1 || lseg < 1) {
+    fprintf (stderr, "ERROR! Invalid number of bits or frame length\n\n");
+    exit (-1);
+  }
+
+
+  /* ......... INITIALIZATIONS ......... */
+
+  for (m = 0; m < 3; m++) {
+    if ((EID[m] = open_eid (ber, gamma)) == (SCD_EID *) 0) {
+      fprintf (stderr, "\nUnable to create the EID\n");
+      exit (-1);
+    }
+    EID[m]->seed = seed;
+  }
+  EP[0] = (short *) malloc (lseg * sizeof (short));
+  EP[1] = (short *) malloc (lseg * sizeof (short));
+  EPbits = (EID_WORD *) malloc (EID_WORDS (lseg) * sizeof (EID_WORD));
+  xbuff = (short *) malloc ((lseg + 2) * sizeof (short));
+  ybuff = (short *) malloc ((lseg + 2) * sizeof (short));
+  for (m = 0; m < 3; m++)
+    packed[m] = (EID_WORD *) malloc (EID_WORDS (lseg) * sizeof (EID_WORD));
+  if (EP[0] == NULL || EP[1] == NULL || EPbits == NULL || xbuff == NULL || ybuff == NULL || packed[0] == NULL || packed[1] == NULL || packed[2] == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+
+
+  /* ......... TIMING ......... */
+
+  /* each generator runs in turn on the same frame, so that the patterns can be compared */
+  for (m = 0; m < 3; m++)
+    errors[m] = t[m] = 0;
+  for (i = 0; i < nbits; i += count) {
+    count = (nbits - i < lseg) ? nbits - i : lseg;
+
+    t0 = clock ();
+    errors[0] += BER_generator_old (EID[0], count, EP[0]);
+    t[0] += (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock ();
+    errors[1] += BER_generator (EID[1], count, EP[1]);
+    t[1] += (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock ();
+    errors[2] += BER_generator_packed (EID[2], count, EPbits);
+    t[2] += (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+    for (k = 0; k < count; k++)
+      if (EP[1][k] != EP[0][k] || ((EPbits[k / EID_WORD_BITS] >> (k % EID_WORD_BITS)) & 1) != (EP[0][k] == 0x0081))
+        ndiff++;
+
+    /* Packed pattern of BER_generator(), with its number of errors, and back */
+    for (nerr = k = 0; k < count; k++)
+      nerr += (EP[1][k] == 0x0081);
+    bad = (EID_pack_pattern (EP[1], count, packed[0]) != nerr);
+    bad |= (memcmp (packed[0], EPbits, EID_WORDS (count) * sizeof (EID_WORD)) != 0);
+    EID_unpack_pattern (packed[0], count, EP[0]);
+    bad |= (memcmp (EP[0], EP[1], count * sizeof (short)) != 0);
+
+    /* A frame of bits of the old generator's seed, disturbed in G.192 and packed */
+    xbuff[0] = 0x6B21;
+    xbuff[1] = (short) count;
+    for (k = 0; k < count; k++)
+      xbuff[k + 2] = ((EID[0]->seed >> (k % 29)) ^ k) & 1 ? 0x0081 : 0x007F;
+    BER_insertion_stl96 (count + 2, xbuff, ybuff, EP[1]);
+    EID_pack_pattern (xbuff + 2, count, packed[1]);
+    bad |= (BER_xor_packed (count, packed[1], packed[1], EPbits) != nerr);
+    EID_pack_pattern (ybuff + 2, count, packed[2]);
+    bad |= (memcmp (packed[1], packed[2], EID_WORDS (count) * sizeof (EID_WORD)) != 0);
+    nbad += bad;
+  }
+
+
+  /* ......... REPORT ......... */
+
+  printf ("%ld bits in frames of %ld, BER %f, gamma %f\n", nbits, lseg, ber, gamma);
+  for (m = 0; m < 3; m++)
+    printf ("%-21s %8.3f s  %12.0f bits/s  speed-up %5.1f  %.0f errors\n", name[m], t[m], (t[m] > 0) ? nbits / t[m] : 0, (t[m] > 0) ? t[0] / t[m] : 0, errors[m]);
+  printf ("%ld bits differ from the old generator\n", ndiff);
+  printf ("%ld frames fail the checks of the packed pattern functions\n", nbad);
+  for (m = 1; m < 3; m++)
+    if (EID[m]->seed != EID[0]->seed || EID[m]->current_state != EID[0]->current_state) {
+      printf ("%s: final state differs from the old generator\n", name[m]);
+      ndiff++;
+    }
+
+  free (EP[0]);
+  free (EP[1]);
+  free (EPbits);
+  free (xbuff);
+  free (ybuff);
+  for (m = 0; m < 3; m++)
+    free (packed[m]);
+  return (ndiff != 0 || nbad != 0);
+}
@@ -1,4 +1,4 @@
-/*                                                           02.Feb.2010 v3.3
+/*                                                           16.Oct.2026 v3.4
   ============================================================================
 
   EIDDEMO.C
@@ -140,6 +140,8 @@
                     mode <simao.campos@labs.comsat.com>
   02.Feb.2010  3.3  Modified maximum string length for filename to avoid
                     buffer overruns (y.hiwasaki)
+  16.Oct.2026  3.4  Added option -packed, to generate and insert the bit
+                    errors with the packed patterns (1 bit per bit).
   ============================================================================
 */
 
@@ -193,10 +195,11 @@ int main (int argc, char *argv[]) {
 
   short *xbuff, *ybuff;         /* pointer to bit-buffer */
   short *EPbuff;                /* pointer to bit-buffer */
+  EID_WORD *EPbits;             /* packed error pattern */
   short SYNCword, i;
 
   long smpno;                   /* samples read from file */
-  char quiet = 0;
+  char quiet = 0, packed = 0;
   clock_t t1, t2;
   double t;
 
@@ -217,7 +220,7 @@ int main (int argc, char *argv[]) {
 
 
   /* ......... DISPLAY INFOS ......... */
-  printf ("\n ** Error Insertion Device Demo Program - 02/Feb/2010 v3.3 **\n");
+  printf ("\n ** Error Insertion Device Demo Program - 16/Oct/2026 v3.4 **\n");
 
 
   /* ......... GET PARAMETERS ......... */
@@ -231,6 +234,13 @@ int main (int argc, char *argv[]) {
         /* Define resolution */
         quiet = 1;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-packed") == 0) {
+        /* Use packed error patterns */
+        packed = 1;
+
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
@@ -334,6 +344,8 @@ int main (int argc, char *argv[]) {
   /* Buffer for storing the error pattern: */
   if ((EPbuff = (short *) malloc ((lseg) * sizeof (short))) == (short *) 0)
     HARAKIRI ("    Could not allocate memory for error pattern buffer", 1);
+  if ((EPbits = (EID_WORD *) malloc (EID_WORDS (lseg) * sizeof (EID_WORD))) == (EID_WORD *) 0)
+    HARAKIRI ("    Could not allocate memory for packed error pattern buffer", 1);
 
 
 /*
@@ -353,14 +365,17 @@ int main (int argc, char *argv[]) {
       /* Start measuring CPU-time for this round */
       t1 = clock ();
 
-      /* Generate error pattern ('hard'-bits) */
-      ber1 = BER_generator (BEReid, lseg, EPbuff);
+      /* Generate error pattern ('hard'-bits) and modify input bitstream according to it */
+      if (packed) {
+        ber1 = BER_generator_packed (BEReid, lseg, EPbits);
+        BER_insertion_packed (lseg + OVERHEAD, xbuff, ybuff, EPbits);
+      } else {
+        ber1 = BER_generator (BEReid, lseg, EPbuff);
+        BER_insertion (lseg + OVERHEAD, xbuff, ybuff, EPbuff);
+      }
       dstbits += ber1;          /* count number of disturbed bits */
       prcbits += (double) lseg; /* count number of processed bits */
 
-      /* Modify input bitstream according to the stored error pattern */
-      BER_insertion (lseg + OVERHEAD, xbuff, ybuff, EPbuff);
-
       /* Apply frame erasure module if requested */
       if (FER != 0.0) {
         /* Subject bitstream to frame erasure ... */
@@ -463,10 +478,15 @@ void display_usage () {
   prompt = '#';
 #endif
 
-  printf ("eiddemo.c Version 3.3 of 02.Feb.2010\n");
+  printf ("eiddemo.c Version 3.4 of 16.Oct.2026\n");
 
   printf ("  Usage: %c %s%s", prompt, "EID ifile ofile BERfile FERfile ", "[ BER BER_gamma FER FER_gamma]\n\n");
 
+  printf ("\tOptions:\n");
+  printf ("\t-q         : quiet operation\n");
+  printf ("\t-packed    : generate and insert the bit errors with packed\n");
+  printf ("\t             (1 bit per bit) error patterns; same results\n\n");
+
   printf ("\tifile      : binary file with  input bitstream\n");
   printf ("\tofile      : binary file with output bitstream\n");
   printf ("%s%s", "\tBERfile    : File, containing the EID-status ", "for bit error rate \n");
@@ -1,4 +1,4 @@
-/*                                                         02.Feb.2010 v.2.2
+/*                                                         16.Oct.2026 v.2.3
    =========================================================================
 
    ep-stats.c
@@ -70,6 +70,8 @@
                      <Ericsson>
     2.Feb.2010 v.2.2 Modified maximum string length for filename to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026 v.2.3 Pattern file read with bs_io.c (memory-mapped); G.192
+                     patterns used in place, without copies
    ========================================================================= */
 
 /* ..... Generic include files ..... */
@@ -99,6 +101,7 @@
 #include "eid_io.h"             /* EID I/O functions */
 #endif
 #include "softbit.h"            /* Soft bit definitions and prototypes */
+#include "bs_io.h"              /* Memory-mapped bitstream file I/O */
 
 /* ..... Definitions used by the program ..... */
 
@@ -117,7 +120,7 @@
    --------------------------------------------------------------------------
  */
 void display_usage (int level) {
-  printf ("ep-stats.c - Version 2.2 of 02.Feb.2010 \n\n");
+  printf ("ep-stats.c - Version 2.3 of 16.Oct.2026 \n\n");
 
   if (level) {
     printf ("Program Description:\n");
@@ -191,10 +194,11 @@ int main (int argc, char *argv[]) {
   long start_item = 1;          /* Start analyzing errors from 1st one */
   long preamble_items = 0;
   /* File I/O parameter */
-  FILE *Fep;                    /* Pointer to error pattern file */
+  BS_FILE *Fep;                 /* Pointer to error pattern file */
 
   /* Data arrays and structures */
   short *ep;                    /* Error pattern buffer */
+  short *iep;                   /* Error pattern, in place or in ep */
   ep_histogram_state eps;
 
   /* Aux. variables */
@@ -208,7 +212,7 @@ int main (int argc, char *argv[]) {
   float ftmp;
 
   /* Pointer to a function */
-  long (*read_patt) () = read_g192;     /* To read error pattern */
+  long (*read_patt) () = bs_read_g192;  /* To read error pattern */
 
 
   /* ......... GET PARAMETERS ......... */
@@ -298,14 +302,14 @@ int main (int argc, char *argv[]) {
 
 
   /* Open files */
-  if ((Fep = fopen (ep_file, RB)) == NULL)
+  if ((Fep = bs_open (ep_file)) == NULL)
     HARAKIRI ("Could not open error pattern file\n", 1);
 
 
   /* *** CHECK TYPE OF ERROR PATTERN *** */
 
   /* Do preliminary inspection in the ERROR PATTERN FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fep, ep_file, &tmp_type);
+  i = bs_check_format (Fep, ep_file, &tmp_type);
 
   /* Check whether the specified EP format matches with the one in the file */
   if (i != ep_format) {
@@ -330,7 +334,7 @@ int main (int argc, char *argv[]) {
   /* *** FINAL INITIALIZATIONS *** */
 
   /* Use the proper data I/O functions */
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
+  read_patt = ep_format == byte ? bs_read_byte : (ep_format == g192 ? bs_read_g192 : (ep_type == BER ? bs_read_bit_ber : bs_read_bit_fer));
 
   /* Define how many samples are read for each frame */
   /* Bitstream may have sync headers, which are 2 samples-long */
@@ -378,8 +382,11 @@ int main (int argc, char *argv[]) {
 
   /* now finaly analyze target part */
   while (1) {
-    /* Read a block from EP file */
-    items = read_patt (ep, ep_len, Fep);
+    /* Read a block from EP file; a G.192 pattern is used in place */
+    if (ep_format == g192)
+      iep = (short *) bs_view (Fep, (long) sizeof (short), ep_len, &items);
+    else
+      items = read_patt (iep = ep, ep_len, Fep);
 
     /* Aborts on error */
     if (items < 0)
@@ -395,7 +402,7 @@ int main (int argc, char *argv[]) {
       break;
 
     /* Computes histogram */
-    compute_ep_histogram (ep, items, ep_type, &eps, 0);
+    compute_ep_histogram (iep, items, ep_type, &eps, 0);
   }
 
   /* Flushes any pending processing */
@@ -440,7 +447,7 @@ int main (int argc, char *argv[]) {
   free (ep);
 
   /* Close the output file and quit *** */
-  fclose (Fep);
+  bs_close (Fep);
 
 #ifndef VMS                     /* return value to OS if not VMS */
   return 0;
@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.7
+/*                                                          16.Oct.2026 v1.8
    =========================================================================
 
    gen-patt.c
@@ -109,6 +109,8 @@
    -reset ... Reset EID state in between iteractions
    -max # ... Maximum number of iteractions
    -tol # ... Max deviation of specified BER/FER/BFER
+   -jobs # .. Generate the pattern in segments, # at the same time
+              (the pattern is the same as with a single job)
    -q ....... Quiet operation mode
 
    Original Author:
@@ -152,6 +154,13 @@
                        (preamble part may now be excluded for teh iteration target) <Ericsson>
    02.Feb.2010,v1.7  Modified maximum string length for filenames to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026 v1.8  Added option -jobs to generate long patterns in
+                     segments of PATT_SEGMENT bits/frames at the same time.
+                     The seed at the start of each segment is obtained by
+                     skipping the draws of the previous ones, and each
+                     segment is generated from every channel state, so the
+                     pattern and the saved state do not depend on the
+                     number of jobs.
 
   ========================================================================= */
 
@@ -168,6 +177,10 @@
 #include "eid_io.h"             /* EID state variable I/O functions */
 #include "softbit.h"            /* Soft bit definitions */
 
+#ifdef EID_THREADS
+#include <pthread.h>
+#endif
+
 
 #define FER_FIX
 /* ..... Definitions used by the program ..... */
@@ -175,12 +188,32 @@
 /* Buffer size definitions */
 #define EID_BUFFER_LENGTH 256
 #define OUT_RECORD_LENGTH 512
+#define PATT_SEGMENT (256*EID_BUFFER_LENGTH)    /* bits|frames per segment */
+#define PATT_WINDOW 4           /* segments generated per job at a time */
+
+/* Segments of a pattern generated by several jobs */
+typedef struct {
+  EID_SEGMENT **seg;            /* segments being generated */
+  long nseg;                    /* number of segments in the window */
+  long next;                    /* next segment to be generated */
+  long jobs;                    /* number of jobs */
+  SCD_EID *eid;                 /* Gilbert model, or */
+  BURST_EID *burst;             /* Bellcore model */
+  char *flags;                  /* pattern of a segment */
+  short one, zero;              /* disturbed and undisturbed G.192 values */
+#ifdef EID_THREADS
+  pthread_t *thread;
+  pthread_mutex_t lock;         /* protects next */
+#endif
+} PATT_BATCH;
 
 /* Local function prototypes */
 char *mode_str ARGS ((int mode));
 char check_bellcore ARGS ((long index));
 long run_FER_generator_random ARGS ((short *patt, SCD_EID * state, long n));
 long run_FER_generator_burst ARGS ((short *patt, BURST_EID * state, long n));
+void *segment_worker ARGS ((void *arg));
+long run_segments ARGS ((PATT_BATCH * batch, long n, short *patt, long (*save_data) (), FILE * F, double *disturbed));
 void display_usage ARGS ((void));
 
 
@@ -310,6 +343,130 @@ long run_FER_generator_burst (short *patt, BURST_EID * state, long n) {
 /* .................. End of run_FER_generator_burst() .................. */
 
 
+/*
+   -------------------------------------------------------------------------
+   void *segment_worker (void *arg);
+   ~~~~~~~~~~~~~~~~~~~~
+
+   Generate the segments of a window (a PATT_BATCH pointed by arg) one
+   after the other, until none is left. Several workers may run at the
+   same time, each taking the next segment of the window.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   NULL
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+void *segment_worker (void *arg) {
+  PATT_BATCH *batch = (PATT_BATCH *) arg;
+  long j;
+
+  for (;;) {
+#ifdef EID_THREADS
+    pthread_mutex_lock (&batch->lock);
+#endif
+    j = batch->next++;
+#ifdef EID_THREADS
+    pthread_mutex_unlock (&batch->lock);
+#endif
+    if (j >= batch->nseg)
+      return NULL;
+    if (batch->eid)
+      GEC_segment (batch->eid, batch->seg[j]);
+    else
+      burst_segment (batch->burst, batch->seg[j]);
+  }
+}
+
+/* ...................... End of segment_worker() ...................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long run_segments (PATT_BATCH *batch, long n, short *patt,
+   ~~~~~~~~~~~~~~~~~  long (*save_data)(), FILE *F, double *disturbed)
+
+   Generate n bits|frames of pattern with the model of the batch, a
+   window of segments at a time, and save them in blocks of
+   EID_BUFFER_LENGTH, as the serial loops of main() do.
+
+   Parameter:
+   ~~~~~~~~~~
+   batch ...... segments, jobs and channel model
+   n .......... number of bits|frames to generate
+   patt ....... short buffer of EID_BUFFER_LENGTH items
+   save_data .. function saving the pattern in the output format
+   F .......... output file
+   disturbed .. (Out) number of bit errors|frame erasures
+
+   Return value:
+   ~~~~~~~~~~~~~
+   The number of items saved, or -1 on error.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+long run_segments (PATT_BATCH * batch, long n, short *patt, long (*save_data) (), FILE * F, double *disturbed) {
+  unsigned long seed;
+  long i, j, k, m, count, saved = 0;
+#ifdef EID_THREADS
+  long nthreads;
+#endif
+
+  *disturbed = 0;
+  while (n > 0) {
+    /* Seeds of the segments of the window: Gilbert draws 2 numbers per item, Bellcore 1 */
+    seed = batch->eid ? batch->eid->seed : batch->burst->seedptr;
+    for (batch->nseg = 0; n > 0 && batch->nseg < PATT_WINDOW * batch->jobs; batch->nseg++) {
+      k = n < PATT_SEGMENT ? n : PATT_SEGMENT;
+      batch->seg[batch->nseg]->seed = seed;
+      batch->seg[batch->nseg]->lseg = k;
+      EID_random_skip (&seed, batch->eid ? 2 * k : k);
+      n -= k;
+    }
+    batch->next = 0;
+
+#ifdef EID_THREADS
+    /* The main thread is one of the workers */
+    for (nthreads = 0; nthreads < batch->jobs - 1 && nthreads < batch->nseg - 1; nthreads++)
+      if (pthread_create (&batch->thread[nthreads], NULL, segment_worker, batch) != 0)
+        break;
+    segment_worker (batch);
+    for (j = 0; j < nthreads; j++)
+      pthread_join (batch->thread[j], NULL);
+#else
+    segment_worker (batch);
+#endif
+
+    /* Take the segments in order, carrying the channel state */
+    for (j = 0; j < batch->nseg; j++) {
+      if (batch->eid)
+        count = get_GEC_segment (batch->eid, batch->seg[j], batch->flags);
+      else
+        count = get_burst_segment (batch->burst, batch->seg[j], batch->flags);
+      *disturbed += count;
+      for (i = 0; i < batch->seg[j]->lseg; i += EID_BUFFER_LENGTH) {
+        k = batch->seg[j]->lseg - i < EID_BUFFER_LENGTH ? batch->seg[j]->lseg - i : EID_BUFFER_LENGTH;
+        for (m = 0; m < k; m++)
+          patt[m] = batch->flags[i + m] ? batch->one : batch->zero;
+        if (save_data (patt, k, F) < 0)
+          return (-1);
+        saved += k;
+      }
+    }
+  }
+  return (saved);
+}
+
+/* ...................... End of run_segments() ...................... */
+
+
 /*
    --------------------------------------------------------------------------
    display_usage()
@@ -322,7 +479,7 @@ long run_FER_generator_burst (short *patt, BURST_EID * state, long n) {
    --------------------------------------------------------------------------
  */
 void display_usage () {
-  printf ("gen-patt.c Version 1.7 of 02.Feb.2010\n");
+  printf ("gen-patt.c Version 1.8 of 16.Oct.2026\n");
 
   printf ("  This example program produces bit error pattern files for error\n");
   printf ("  insertion in G.192-compliant serial bitstreams encoded files. Error\n");
@@ -363,6 +520,7 @@ void display_usage () {
   printf ("   -reset ... Reset EID state in between iteractions\n");
   printf ("   -max # ... Maximum number of iteractions\n");
   printf ("   -tol # ... Max deviation of specified BER/FER/BFER\n");
+  printf ("   -jobs # .. Generate the pattern in segments, # at the same time\n");
   printf ("   -q ....... Quiet operation mode\n");
 
   /* Quit program */
@@ -382,7 +540,7 @@ int main (int argc, char *argv[]) {
   long number_of_frames = 0;    /* Total no.of frames in pattern */
   long start_frame = 1;         /* Start inserting error from 1st one */
   double ber_rate = -1;         /* Bit error rate: depend on the mode */
-  char state_file[MAX_STRLEN];  /* File for saving BER/FER/BFER state */
+  char state_file[MAX_STRLEN] = "";     /* File for saving BER/FER/BFER state */
 
   /* File I/O parameter */
   FILE *out_file_ptr;
@@ -422,6 +580,8 @@ int main (int argc, char *argv[]) {
   long max_iteraction = 100;
   char quiet = 0, reset = 0, save_format = byte, tailstat = 0;
   long (*save_data) () = save_byte;     /* Pointer to a function */
+  long jobs = 1;                /* Segments generated at the same time */
+  PATT_BATCH batch;
 
 #ifdef PORT_TEST
   extern int PORTABILITY_TEST_OPERATION;
@@ -530,6 +690,15 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Number of segments generated at the same time */
+        jobs = atol (argv[2]);
+        if (jobs < 1)
+          HARAKIRI ("*** The number of jobs should be at least 1. Aborted.\n", 9);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Set quiet mode */
         quiet = 1;
@@ -696,6 +865,31 @@ int main (int argc, char *argv[]) {
     HARAKIRI ("Could not allocate memory for error pattern buffer\n", 1);
   }
 
+  /*
+   **  Allocate the segments for the generation in several jobs
+   */
+#ifdef EID_THREADS
+  if ((batch.thread = (pthread_t *) malloc (jobs * sizeof (pthread_t))) == NULL)
+    jobs = 1;
+  pthread_mutex_init (&batch.lock, NULL);
+#else
+  jobs = 1;
+#endif
+  if (jobs > 1) {
+    batch.jobs = jobs;
+    batch.eid = mode == 'R' ? BEReid : (mode == 'F' ? FEReid : (SCD_EID *) 0);
+    batch.burst = mode == 'B' ? burst_eid : (BURST_EID *) 0;
+    batch.one = mode == 'R' ? G192_ONE : G192_FER;
+    batch.zero = mode == 'R' ? G192_ZERO : G192_SYNC;
+    batch.flags = (char *) malloc (PATT_SEGMENT * sizeof (char));
+    batch.seg = (EID_SEGMENT **) calloc (PATT_WINDOW * jobs, sizeof (EID_SEGMENT *));
+    if (batch.flags == NULL || batch.seg == NULL)
+      HARAKIRI ("Could not allocate memory for the pattern segments\n", 1);
+    for (i = 0; i < PATT_WINDOW * jobs; i++)
+      if ((batch.seg[i] = open_eid_segment (batch.eid ? batch.eid->nstates : MODEL_SIZE, PATT_SEGMENT)) == NULL)
+        HARAKIRI ("Could not allocate memory for the pattern segments\n", 1);
+  }
+
   /*
    ** Initialize arrays
    */
@@ -754,23 +948,33 @@ int main (int argc, char *argv[]) {
           generated += items;
         }
 
-        /* Generate bits subject to disturbance */
-        for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
-          /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
-          k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
-
-          /* Run bit error generator */
-          ber1 = BER_generator (BEReid, k, error_pat);
-
-          /* Save data to file according to the defined format */
-          items = save_data (error_pat, k, out_file_ptr);
+        /* Generate bits subject to disturbance, in segments ... */
+        if (jobs > 1) {
+          items = run_segments (&batch, number_of_frames - start_frame, error_pat, save_data, out_file_ptr, &ber1);
           if (items < 0)
             HARAKIRI ("Error saving data to file\n", 8);
-
-          /* Update counters */
           disturbed += ber1;
           processed += items;
           generated += items;
+        } else {
+          /* ... or a buffer at a time */
+          for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
+            /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
+            k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
+
+            /* Run bit error generator */
+            ber1 = BER_generator (BEReid, k, error_pat);
+
+            /* Save data to file according to the defined format */
+            items = save_data (error_pat, k, out_file_ptr);
+            if (items < 0)
+              HARAKIRI ("Error saving data to file\n", 8);
+
+            /* Update counters */
+            disturbed += ber1;
+            processed += items;
+            generated += items;
+          }
         }
         break;
       }
@@ -793,26 +997,36 @@ int main (int argc, char *argv[]) {
           generated += items;
         }
 
-        /* Generate frame subject to disturbance */
-        for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
-          /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
-          k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
-          /*
-             k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH; */
-
-          /* Run either Gilbert or Bellcore frame erasure model */
-          ber1 = mode == 'F' ? run_FER_generator_random (error_pat, FEReid, k)
-            : run_FER_generator_burst (error_pat, burst_eid, k);
-
-          /* Save intermediate data in buffer */
-          items = save_data (error_pat, k, out_file_ptr);
+        /* Generate frame subject to disturbance, in segments ... */
+        if (jobs > 1) {
+          items = run_segments (&batch, number_of_frames - start_frame, error_pat, save_data, out_file_ptr, &ber1);
           if (items < 0)
             HARAKIRI ("Error saving data to file\n", 8);
-
-          /* Update counters */
           disturbed += ber1;
-          processed += items;   /* does not include preamble frames */
-          generated += items;   /* includes preamble frames */
+          processed += items;
+          generated += items;
+        } else {
+          /* ... or a buffer at a time */
+          for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
+            /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
+            k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
+            /*
+               k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH; */
+
+            /* Run either Gilbert or Bellcore frame erasure model */
+            ber1 = mode == 'F' ? run_FER_generator_random (error_pat, FEReid, k)
+              : run_FER_generator_burst (error_pat, burst_eid, k);
+
+            /* Save intermediate data in buffer */
+            items = save_data (error_pat, k, out_file_ptr);
+            if (items < 0)
+              HARAKIRI ("Error saving data to file\n", 8);
+
+            /* Update counters */
+            disturbed += ber1;
+            processed += items;   /* does not include preamble frames */
+            generated += items;   /* includes preamble frames */
+          }
         }
 
         break;
@@ -926,6 +1140,16 @@ int main (int argc, char *argv[]) {
    **  Close the output file and quit
    */
   fclose (out_file_ptr);
+  if (jobs > 1) {
+    for (i = 0; i < PATT_WINDOW * jobs; i++)
+      close_eid_segment (batch.seg[i]);
+    free (batch.seg);
+    free (batch.flags);
+  }
+#ifdef EID_THREADS
+  pthread_mutex_destroy (&batch.lock);
+  free (batch.thread);
+#endif
 
 #ifndef VMS                     /* return value to OS if not VMS */
   return 0;
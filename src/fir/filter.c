@@ -1,4 +1,4 @@
-/*                                                           02.Feb.2010 v3.5
+/*                                                          16.Oct.2026 v3.10
   ===========================================================================
 
   FILTER.C
@@ -21,10 +21,12 @@
            [BlockSize [1stBlock [NoOfBlocks]]]
 
   where:
-  flt_type: 	is the filter type (see list below)
+  flt_type: 	is the filter type (see list below), or a comma-separated
+                chain of filter types, e.g. irs8,hq2:up,msin, each of
+                them optionally followed by :up or :down
   InpFile       is the name of the file to be processed;
   OutFile       is the name with the processed data;
-  BlockSize     is the block size, in number of samples
+  BlockSize     is the block size, in number of samples (per channel)
   1stBlock      is the number of the first block of the input file
                 to be processed;
   NoOfBlocks    is the number of blocks to be processed, starting on
@@ -40,6 +42,34 @@
                   asynchronous tandeming simulation. For d>0, null
                   samples are inserted in the begining of the file,
                   d<0 causes samples to be dropped. Default is d=0.
+  -kernel k ..... dot-product implementation for FIR filters: scalar
+                  (default, bit-exact reference), sse, avx2, avx512, or
+                  auto (best one supported by the CPU). Other than scalar,
+                  the parallel- and cascade-form IIR filters (PCM, PCM1
+                  and IFLAT) use the SIMD IIR kernel (see iir-lib.c); it
+                  is not used with -channels
+  -fft .......... long 1:1 FIR filters (P341, 5KBP, ...) are computed with
+                  the FFT engine (see fir-fft.c), which is much faster
+                  than the time-domain filtering but differs from the
+                  reference results by float rounding
+  -channels n ... number of interleaved channels in the input file (default
+                  1). All channels are filtered in the same pass, with the
+                  multichannel kernels (not available for the DC filter);
+                  block size and delay count frames of n samples.
+  -float ........ input and output files have 32-bit float samples, in
+                  the native byte order, with the full scale of the
+                  16-bit samples mapped to [-1,1) (as by sh2fl_16bit());
+                  output samples are neither rounded nor saturated.
+  -float-in ..... same, for the input file only
+  -float-out .... same, for the output file only
+  -chain list ... filter with a chain of filters, e.g.
+                  -chain irs8,hq2:up,msin: the intermediate signals stay
+                  in float memory buffers, and the conversions to and
+                  from 16-bit samples are only done at the edges (if at
+                  all). :up and :down set the direction of a stage (the
+                  default is given by -up/-down); block size, delay and
+                  skip count input samples. Same as giving the list as
+                  flt_type. Not available with -async.
   -q ............ quiet processing (no progress flag)
 
   Valid filter specifications:
@@ -152,6 +182,17 @@
 
    02.Feb.2010 v3.5 - Modified maximum string length for filenames to avoid
                       buffer overruns (y.hiwasaki)
+   16.Oct.2026 v3.6 - Added option -kernel to choose the scalar or SIMD
+                      dot-product of the FIR filters
+   16.Oct.2026 v3.7 - Added option -channels to filter interleaved
+                      multichannel files
+   16.Oct.2026 v3.8 - Option -kernel also selects the SIMD kernel of the
+                      parallel- and cascade-form IIR filters
+   16.Oct.2026 v3.9 - Added options -float, -float-in and -float-out for
+                      files of 32-bit float samples, and filter chains
+                      (-chain) filtered in float in a single run
+   16.Oct.2026 v3.10 - Added option -fft to filter long 1:1 FIR filters
+                       with the FFT engine
   ===========================================================================
 */
 
@@ -221,7 +262,7 @@ int valid_filter (char *F_type, char modified_IRS) {
  * Last update: 15.May.2007 <>
  */
 void display_usage () {
-  printf ("FILTER.C - Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("FILTER.C - Version 3.10 of 16.Oct.2026 \n\n");
 
   printf (" Test program to process a given file by one of the possible filter\n");
   printf (" characteristics of the STL. Multiple filterings (as available\n");
@@ -235,10 +276,11 @@ void display_usage () {
   printf (" $ filter   [-options] Flt_type InpFile OutFile \n");
   printf ("            [BlockSize [1stBlock [NoOfBlocks]]]\n");
   printf (" where:\n");
-  printf ("  Flt_type:    is the filter type (see list below)\n");
+  printf ("  Flt_type:    is the filter type (see list below), or a chain of\n");
+  printf ("               filter types such as irs8,hq2:up,msin\n");
   printf ("  InpFile      is the name of the file to be processed;\n");
   printf ("  OutFile      is the name with the processed data;\n");
-  printf ("  BlockSize    is the block size, in number of samples\n");
+  printf ("  BlockSize    is the block size, in number of samples (per channel)\n");
   printf ("  1stBlock     is the number of the first block of the input file\n");
   printf ("               to be processed;\n");
   printf ("  NoOfBlocks   is the number of blocks to be processed, starting on\n");
@@ -254,6 +296,18 @@ void display_usage () {
   printf ("               asynchronous tandeming simulation. For d>0, null\n");
   printf ("               samples are inserted in the begining of the file,\n");
   printf ("               d<0 causes samples to be dropped. Default is d=0.\n");
+  printf ("  -kernel k .. dot-product for FIR filters: scalar [default], sse,\n");
+  printf ("               avx2, avx512, or auto (best supported by the CPU);\n");
+  printf ("               other than scalar, PCM, PCM1 and IFLAT use the\n");
+  printf ("               SIMD IIR kernel\n");
+  printf ("  -fft ....... FFT filtering of long 1:1 FIR filters; faster, but\n");
+  printf ("               not bit-exact with the time-domain filtering\n");
+  printf ("  -channels n  number of interleaved channels in the files [default: 1]\n");
+  printf ("  -float ..... files of 32-bit float samples, full scale [-1,1)\n");
+  printf ("  -float-in .. input file of 32-bit float samples\n");
+  printf ("  -float-out . output file of 32-bit float samples\n");
+  printf ("  -chain list  comma-separated filter types, each optionally followed\n");
+  printf ("               by :up or :down; the intermediate signals stay in float\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
   printf ("\n");
   printf (" Valid filter specifications:\n");
@@ -301,170 +355,50 @@ char *filter_type_str[] = { "FIR", "Parallel-form IIR",
   "Cascade-form IIR", "Direct-form IIR"
 };
 
-/*============================== */
-int main (int argc, char *argv[]) {
-  /* DECLARATIONS */
-
-  /* Algorithm variables */
+/* FIR dot-product kernel names, indexed by FIR_KERNEL_xxx */
+char *fir_kernel_str[] = { "auto", "scalar", "sse", "avx2", "avx512" };
+
+/* One stage of a filter chain, with its own state and output buffer */
+typedef struct {
+  char F_type[MAX_STRLEN];      /* filter type, without the :up/:down suffix */
+  char upsample;                /* direction of the rate change */
+  char modified_IRS;
+  char kernel_type;             /* FIR, IIR_PARALLEL, ... */
+  int fir_kernel, iir_kernel;
+  char fft;                     /* FFT engine for the FIR filter */
+  long factor;                  /* rate change factor */
+  long inp_size, out_size;      /* buffer sizes, in frames of nchan samples */
+  float *OutBuff;
   SCD_FIR *fir_state;
   SCD_IIR *parallel_iir_state;
   CASCADE_IIR *cascade_iir_state;
   DIRECT_IIR *direct_iir_state;
+  SCD_FIR_MC *fir_mc_state;
+  SCD_IIR_MC *parallel_iir_mc_state;
+  CASCADE_IIR_MC *cascade_iir_mc_state;
+} FILTER_STAGE;
 
-  float *InpBuff, *OutBuff;
-  short *TmpBuff;
-  char F_type[MAX_STRLEN], async = 0, upsample = 0;
-  long cur_blk, satur = 0, total = 0, k, N, N1, N2;
-  char modified_IRS = 0, quiet = 0;
-  long inp_size, out_size, factor, smpno;
-  double fs = 8000;
-  char kernel_type = 0;
-  static char funny[9] = "|/-\\|/-\\";
-
-  /* For asynchronous tandem simulation */
-  long delay = 0, skip = 0;
-  short *zero;
-
-  /* File variables */
-  char FileIn[MAX_STRLEN], FileOut[MAX_STRLEN];
-  FILE *Fi, *Fo;
-  long start_byte;
-#ifdef VMS
-  char mrs[15];
-#endif
-
-
-  /* ......... GET PARAMETERS ......... */
-
-  /* Check options */
-  if (argc < 2)
-    display_usage ();
-  else {
-    while (argc > 1 && argv[1][0] == '-')
-      if (strcmp (argv[1], "-mod") == 0) {
-        /* Set modified IRS flag */
-        modified_IRS = 1;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc--;
-        argv++;
-      } else if (strcmp (argv[1], "-fs") == 0) {
-        /* Change sampling frequency */
-        fs = atof (argv[2]);
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc -= 2;
-        argv += 2;
-      } else if (strcmp (argv[1], "-q") == 0) {
-        /* Change sampling frequency */
-        quiet = 1;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc--;
-        argv++;
-      } else if (strcmp (argv[1], "-down") == 0) {
-        /* Filtering is for downsampling */
-        upsample = async = 0;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc--;
-        argv++;
-      } else if (strcmp (argv[1], "-up") == 0) {
-        /* Filtering is for upsampling */
-        upsample = 1;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc--;
-        argv++;
-      } else if (strcmp (argv[1], "-async") == 0) {
-        /* Filtering is an asyncronization process */
-        async = upsample = 1;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc--;
-        argv++;
-      } else if (strcmp (argv[1], "-delay") == 0) {
-        /* Filtering is an asyncronization process */
-        delay = atoi (argv[2]);
-        if (delay < 0)
-          skip = -delay;
-
-        /* Move arg{c,v} over the option to the next argument */
-        argc -= 2;
-        argv += 2;
-      } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
-        /* Display help message */
-        display_usage ();
-      } else {
-        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
-        display_usage ();
-      }
-  }
-
-  /* Read parameters for processing */
-  GET_PAR_S (1, "_Filter type: ................. ", F_type);
-  GET_PAR_S (2, "_Input File: .................. ", FileIn);
-  GET_PAR_S (3, "_Output File: ................. ", FileOut);
-  FIND_PAR_L (4, "_Block Size: .................. ", N, 256);
-  FIND_PAR_L (5, "_Starting Block: .............. ", N1, 1);
-  FIND_PAR_L (6, "_No. of Blocks: ............... ", N2, 0);
-
-
-  /* ......... CHECK CONSISTENCY ......... */
-
-  /* Verify that a valid filter was selected */
-  if (!valid_filter (F_type, modified_IRS)) {
-    if (modified_IRS && (strcmp (F_type, "irs8") == 0 || strcmp (F_type, "IRS8") == 0))
-      fprintf (stderr, "\nModified IRS is NOT available at 8 kHz! Aborted.\n");
-    else
-      fprintf (stderr, "\nInvalid filter chosen! Aborted.\n");
-    exit (2);
-  }
-
-  /* The delay option is only available with asynchronous filtering */
-  if (delay != 0 && !async)
-    HARAKIRI ("\nDelay option only available for ASYNC filtering! Aborted.\n", 5);
-
-
-  /* ......... STARTING ......... */
+/* Maximum number of stages in a filter chain */
+#define MAX_STAGES 16
 
-  /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
 
-#ifdef SKIP_APPROACH_1
-  /* If samples are to be skipped in output file, does it here */
-  if (skip)
-    start_byte += skip * sizeof (short);
-#endif
-
-  /* Check if is to process the whole file */
-  if (N2 == 0) {
-    struct stat st;
-
-    /* ... find the input file size ... */
-    stat (FileIn, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
-  }
-  inp_size = N;                 /* samples */
-
-
-  /* Allocate memory for delay buffer & initialize it */
-  if (delay > 0) {
-    if ((zero = (short *) calloc (delay, sizeof (short))) == NULL) {
-      HARAKIRI ("Error allocating memory for delay buffer\n", 5);
-    } else
-      memset (zero, 0, delay * sizeof (short));
-  }
+/*
+ * Initialize one stage of the chain for blocks of inp_size frames:
+ * filter state, rate change factor and output buffer
+ * By: 16.Oct.2026
+ */
+void init_stage (FILTER_STAGE * st, long nchan) {
+  long k;
 
   /* Set flag to filter type: IIR or FIR; default is FIR */
-  if (strncmp (F_type, "dc", 2) == 0 || strncmp (F_type, "DC", 2) == 0)
-    kernel_type = IIR_DIRECT;
-  else if (strncmp (F_type, "iflat", 5) == 0 || strncmp (F_type, "IFLAT", 5) == 0)
-    kernel_type = IIR_CASCADE;
-  else if (strncmp (F_type, "pcm", 3) == 0 || strncmp (F_type, "PCM", 3) == 0)
-    kernel_type = IIR_PARALLEL;
+  if (strncmp (st->F_type, "dc", 2) == 0 || strncmp (st->F_type, "DC", 2) == 0)
+    st->kernel_type = IIR_DIRECT;
+  else if (strncmp (st->F_type, "iflat", 5) == 0 || strncmp (st->F_type, "IFLAT", 5) == 0)
+    st->kernel_type = IIR_CASCADE;
+  else if (strncmp (st->F_type, "pcm", 3) == 0 || strncmp (st->F_type, "PCM", 3) == 0)
+    st->kernel_type = IIR_PARALLEL;
   else
-    kernel_type = FIR;
+    st->kernel_type = FIR;
 
 
   /* ... CHOOSE CORRECT FILTER INITIALIZATION ... */
@@ -480,65 +414,65 @@ int main (int argc, char *argv[]) {
   *                     . RXIRS8  -> factor: 1:1 (modified) NOT IMPLEMENTED
   *                     . RXIRS16 -> factor: 1:1 (modified) NOT IMPLEMENTED
   */
-  if (strncmp (F_type, "irs", 3) == 0 || strncmp (F_type, "IRS", 3) == 0) {
-    k = atoi (&F_type[3]);
+  if (strncmp (st->F_type, "irs", 3) == 0 || strncmp (st->F_type, "IRS", 3) == 0) {
+    k = atoi (&st->F_type[3]);
     switch (k) {
     case 8:
-      fir_state = irs_8khz_init ();
+      st->fir_state = irs_8khz_init ();
       break;
     case 16:
-      fir_state = modified_IRS ? mod_irs_16khz_init ()
+      st->fir_state = st->modified_IRS ? mod_irs_16khz_init ()
         : irs_16khz_init ();
       break;
     case 48:
-      fir_state = mod_irs_48khz_init ();
+      st->fir_state = mod_irs_48khz_init ();
       break;
     default:
       HARAKIRI ("Unimplemented: IRS rate not 8, 16 or 48 kHz\n", 15);
     }
   }
-  if (strncmp (F_type, "rxirs", 5) == 0 || strncmp (F_type, "RXIRS", 5) == 0) {
-    k = atoi (&F_type[5]);
+  if (strncmp (st->F_type, "rxirs", 5) == 0 || strncmp (st->F_type, "RXIRS", 5) == 0) {
+    k = atoi (&st->F_type[5]);
     switch (k) {
     case 8:
-      modified_IRS = 1;         /* Only modified IRS rcx filter available */
-      fir_state = rx_mod_irs_8khz_init ();
+      st->modified_IRS = 1;         /* Only modified IRS rcx filter available */
+      st->fir_state = rx_mod_irs_8khz_init ();
       break;
     case 16:
-      modified_IRS = 1;         /* Only modified IRS rcx filter available */
-      fir_state = rx_mod_irs_16khz_init ();
+      st->modified_IRS = 1;         /* Only modified IRS rcx filter available */
+      st->fir_state = rx_mod_irs_16khz_init ();
       break;
     default:
       HARAKIRI ("Unimplemented: Receive Mod-IRS rate not 8 or 16 kHz\n", 15);
     }
-  } else if (strncmp (F_type, "hirs16", 6) == 0 || strncmp (F_type, "HIRS16", 6) == 0) {
-    fir_state = ht_irs_16khz_init ();
+  } else if (strncmp (st->F_type, "hirs16", 6) == 0 || strncmp (st->F_type, "HIRS16", 6) == 0) {
+    st->fir_state = ht_irs_16khz_init ();
   }
 
-  else if (strncmp (F_type, "tirs", 4) == 0 || strncmp (F_type, "TIRS", 4) == 0) {
-    fir_state = tia_irs_8khz_init ();
+  else if (strncmp (st->F_type, "tirs", 4) == 0 || strncmp (st->F_type, "TIRS", 4) == 0) {
+    st->fir_state = tia_irs_8khz_init ();
   }
 
 /*
   * Filter type: DSM - Delta-SM: factor 1:1
   */
-  else if (strncmp (F_type, "dsm", 3) == 0 || strncmp (F_type, "DSM", 3) == 0) {
-    fir_state = delta_sm_16khz_init ();
+  else if (strncmp (st->F_type, "dsm", 3) == 0 || strncmp (st->F_type, "DSM", 3) == 0) {
+    st->fir_state = delta_sm_16khz_init ();
   }
 
 /*
   * Filter type: PSO - Psophometric wheighting filter: factor 1:1
   */
-  else if (strncmp (F_type, "pso", 3) == 0 || strncmp (F_type, "PSO", 3) == 0) {
-    fir_state = psophometric_8khz_init ();
+  else if (strncmp (st->F_type, "pso", 3) == 0 || strncmp (st->F_type, "PSO", 3) == 0) {
+    st->fir_state = psophometric_8khz_init ();
   }
 
 /*
   * Filter type: GSM Mobile Station Input - Linear-phase, high-band
   * 1:1 factor added by Simao Campos after Kyrill Fisher [27/Feb/98]
   */
-  else if (strncmp (F_type, "gsm1", 4) == 0 || strncmp (F_type, "GSM1", 4) == 0 || strncmp (F_type, "msin", 4) == 0 || strncmp (F_type, "MSIN", 4) == 0) {
-    fir_state = msin_16khz_init ();
+  else if (strncmp (st->F_type, "gsm1", 4) == 0 || strncmp (st->F_type, "GSM1", 4) == 0 || strncmp (st->F_type, "msin", 4) == 0 || strncmp (st->F_type, "MSIN", 4) == 0) {
+    st->fir_state = msin_16khz_init ();
   }
 
 /*
@@ -547,9 +481,9 @@ int main (int argc, char *argv[]) {
   *                    . fs == 16000 -> downsample: 2:1, or
   *                                     keep rate: 1:1 (treated first)
   */
-  else if (strncmp (F_type, "flat", 4) == 0 || strncmp (F_type, "FLAT", 4) == 0) {
-    fir_state = F_type[4] == '1' ? linear_phase_pb_1_to_1_init ()
-      : (upsample ? linear_phase_pb_1_to_2_init ()
+  else if (strncmp (st->F_type, "flat", 4) == 0 || strncmp (st->F_type, "FLAT", 4) == 0) {
+    st->fir_state = st->F_type[4] == '1' ? linear_phase_pb_1_to_1_init ()
+      : (st->upsample ? linear_phase_pb_1_to_2_init ()
          : linear_phase_pb_2_to_1_init ());
   }
 
@@ -561,95 +495,95 @@ int main (int argc, char *argv[]) {
   *                    . fs ==  8000 -> upsample: 1:3
   *                    . fs == 16000 -> downsample: 3:1
   */
-  else if (strncmp (F_type, "hq", 2) == 0 || strncmp (F_type, "HQ", 2) == 0) {
-    if (upsample)               /* It is up-sampling! */
-      fir_state = F_type[2] == '2' ? hq_up_1_to_2_init ()
+  else if (strncmp (st->F_type, "hq", 2) == 0 || strncmp (st->F_type, "HQ", 2) == 0) {
+    if (st->upsample)           /* It is up-sampling! */
+      st->fir_state = st->F_type[2] == '2' ? hq_up_1_to_2_init ()
         : hq_up_1_to_3_init ();
     else                        /* It is down-sampling! */
-      fir_state = F_type[2] == '2' ? hq_down_2_to_1_init ()
+      st->fir_state = st->F_type[2] == '2' ? hq_down_2_to_1_init ()
         : hq_down_3_to_1_init ();
   }
 
 /*
   * Filter type: P.341 send mask: factor 1:1
   */
-  else if (strncmp (F_type, "p341", 4) == 0 || strncmp (F_type, "P341", 4) == 0) {
-    fir_state = p341_16khz_init ();
+  else if (strncmp (st->F_type, "p341", 4) == 0 || strncmp (st->F_type, "P341", 4) == 0) {
+    st->fir_state = p341_16khz_init ();
   }
 
 /*
   * Filter type: 50-5000 Hz bandpass filter: factor 1:1
   */
-  else if (strncmp (F_type, "5kbp", 4) == 0 || strncmp (F_type, "5KBP", 4) == 0 || strncmp (F_type, "5Kbp", 4) == 0 || strncmp (F_type, "5kBP", 4) == 0) {
-    fir_state = bp5k_16khz_init ();
+  else if (strncmp (st->F_type, "5kbp", 4) == 0 || strncmp (st->F_type, "5KBP", 4) == 0 || strncmp (st->F_type, "5Kbp", 4) == 0 || strncmp (st->F_type, "5kBP", 4) == 0) {
+    st->fir_state = bp5k_16khz_init ();
   }
 
 /*
   * Filter type: 100-5000 Hz bandpass filter: factor 1:1
   */
-  else if (strncmp (F_type, "100_5kbp", 8) == 0 || strncmp (F_type, "100_5KBP", 8) == 0) {
-    fir_state = bp100_5k_16khz_init ();
+  else if (strncmp (st->F_type, "100_5kbp", 8) == 0 || strncmp (st->F_type, "100_5KBP", 8) == 0) {
+    st->fir_state = bp100_5k_16khz_init ();
   }
 
 /*
   * Filter type: 50-14000 Hz bandpass filter (fs=32kHz): factor 1:1
   */
-  else if (strncmp (F_type, "14kbp", 5) == 0 || strncmp (F_type, "14KBP", 5) == 0 || strncmp (F_type, "14Kbp", 5) == 0 || strncmp (F_type, "14kBP", 5) == 0) {
-    fir_state = bp14k_32khz_init ();
+  else if (strncmp (st->F_type, "14kbp", 5) == 0 || strncmp (st->F_type, "14KBP", 5) == 0 || strncmp (st->F_type, "14Kbp", 5) == 0 || strncmp (st->F_type, "14kBP", 5) == 0) {
+    st->fir_state = bp14k_32khz_init ();
   }
 
   /*
    * Filter type: 20-20000 Hz bandpass filter (fs=48kHz): factor 1:1
    */
-  else if (strncmp (F_type, "20kbp", 5) == 0 || strncmp (F_type, "20KBP", 5) == 0 || strncmp (F_type, "20Kbp", 5) == 0 || strncmp (F_type, "20kBP", 5) == 0) {
-    fir_state = bp20k_48khz_init ();
+  else if (strncmp (st->F_type, "20kbp", 5) == 0 || strncmp (st->F_type, "20KBP", 5) == 0 || strncmp (st->F_type, "20Kbp", 5) == 0 || strncmp (st->F_type, "20kBP", 5) == 0) {
+    st->fir_state = bp20k_48khz_init ();
   }
 
 /*
   * Filter type: 1.5kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP1p5", 5) == 0 || strncmp (F_type, "lp1p5", 5) == 0 || strncmp (F_type, "LP1p5", 5) == 0) {
-    fir_state = LP1p5_48kHz_init ();
+  else if (strncmp (st->F_type, "LP1p5", 5) == 0 || strncmp (st->F_type, "lp1p5", 5) == 0 || strncmp (st->F_type, "LP1p5", 5) == 0) {
+    st->fir_state = LP1p5_48kHz_init ();
   }
 
 /*
   * Filter type: 3.5kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP35", 4) == 0 || strncmp (F_type, "lp35", 4) == 0) {
-    fir_state = LP35_48kHz_init ();
+  else if (strncmp (st->F_type, "LP35", 4) == 0 || strncmp (st->F_type, "lp35", 4) == 0) {
+    st->fir_state = LP35_48kHz_init ();
   }
 /*
   * Filter type: 7kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP7", 3) == 0 || strncmp (F_type, "lp7", 3) == 0) {
-    fir_state = LP7_48kHz_init ();
+  else if (strncmp (st->F_type, "LP7", 3) == 0 || strncmp (st->F_type, "lp7", 3) == 0) {
+    st->fir_state = LP7_48kHz_init ();
   }
 /*
   * Filter type: 10kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP10", 5) == 0 || strncmp (F_type, "lp10", 5) == 0) {
-    fir_state = LP10_48kHz_init ();
+  else if (strncmp (st->F_type, "LP10", 5) == 0 || strncmp (st->F_type, "lp10", 5) == 0) {
+    st->fir_state = LP10_48kHz_init ();
   }
 // FILTER_12k48k_HW
   /*
    * Filter type: 12kHz lowpass filter (fs=48kHz): factor 1:1
    */
-  else if (strncmp (F_type, "LP12", 4) == 0 || strncmp (F_type, "lp12", 4) == 0) {
-    fir_state = LP12_48kHz_init ();
+  else if (strncmp (st->F_type, "LP12", 4) == 0 || strncmp (st->F_type, "lp12", 4) == 0) {
+    st->fir_state = LP12_48kHz_init ();
   }
 // FILTER_12k48k_HW
 /*
   * Filter type: 14kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP14", 4) == 0 || strncmp (F_type, "lp14", 4) == 0) {
-    fir_state = LP14_48kHz_init ();
+  else if (strncmp (st->F_type, "LP14", 4) == 0 || strncmp (st->F_type, "lp14", 4) == 0) {
+    st->fir_state = LP14_48kHz_init ();
   }
 
 /*
   * Filter type: 20kHz lowpass filter (fs=48kHz): factor 1:1
   */
-  else if (strncmp (F_type, "LP20", 4) == 0 || strncmp (F_type, "lp20", 4) == 0) {
-    fir_state = LP20_48kHz_init ();
+  else if (strncmp (st->F_type, "LP20", 4) == 0 || strncmp (st->F_type, "lp20", 4) == 0) {
+    st->fir_state = LP20_48kHz_init ();
   }
 
 /*
@@ -660,11 +594,11 @@ int main (int argc, char *argv[]) {
   *                    . fs ==  8000 -> unimplemented
   *                    . fs == 16000 -> OK, 1:1 at 16 kHz
   */
-  else if (strncmp (F_type, "pcm", 3) == 0 || strncmp (F_type, "PCM", 3) == 0) {
-    if (strncmp (F_type, "pcm1", 4) == 0 || strncmp (F_type, "PCM1", 4) == 0) {
-      parallel_iir_state = stdpcm_16khz_init ();
+  else if (strncmp (st->F_type, "pcm", 3) == 0 || strncmp (st->F_type, "PCM", 3) == 0) {
+    if (strncmp (st->F_type, "pcm1", 4) == 0 || strncmp (st->F_type, "PCM1", 4) == 0) {
+      st->parallel_iir_state = stdpcm_16khz_init ();
     } else
-      parallel_iir_state = upsample ? stdpcm_1_to_2_init ()     /* It is up-sampling! */
+      st->parallel_iir_state = st->upsample ? stdpcm_1_to_2_init () /* It is up-sampling! */
         : stdpcm_2_to_1_init ();        /* It is down-sampling! */
   }
 
@@ -673,16 +607,16 @@ int main (int argc, char *argv[]) {
   *                    . fs == 16000 -> upsample: 1:3
   *                    . fs == 48000 -> downsample: 3:1
   */
-  else if (strncmp (F_type, "iflat", 5) == 0 || strncmp (F_type, "IFLAT", 5) == 0) {
-    cascade_iir_state = upsample ? iir_casc_lp_1_to_3_init ()   /* It is up-sampling! */
+  else if (strncmp (st->F_type, "iflat", 5) == 0 || strncmp (st->F_type, "IFLAT", 5) == 0) {
+    st->cascade_iir_state = st->upsample ? iir_casc_lp_1_to_3_init () /* It is up-sampling! */
       : iir_casc_lp_3_to_1_init ();     /* It is down-sampling! */
   }
 
 /*
   * Filter type: DC - IIR DC removal filter (a la RPE-LTP)
   */
-  else if (strncmp (F_type, "dc", 2) == 0 || strncmp (F_type, "DC", 2) == 0) {
-    direct_iir_state = iir_dir_dc_removal_init ();
+  else if (strncmp (st->F_type, "dc", 2) == 0 || strncmp (st->F_type, "DC", 2) == 0) {
+    st->direct_iir_state = iir_dir_dc_removal_init ();
   }
 
 
@@ -690,64 +624,439 @@ int main (int argc, char *argv[]) {
   /* MEMORY ALLOCATION */
 
   /* Calculate Output buffer size and rate change factor */
-  switch (kernel_type) {
+  switch (st->kernel_type) {
   case FIR:
-    factor = fir_state->dwn_up;
-    out_size = (fir_state->hswitch == 'U')
-      ? inp_size * factor : ceil (inp_size / (double) factor);
+    st->fir_kernel = hq_select_kernel (st->fir_state, st->fir_kernel);
+    if (st->fft)
+      hq_fft_engine (st->fir_state);
+    st->factor = st->fir_state->dwn_up;
+    st->out_size = (st->fir_state->hswitch == 'U')
+      ? st->inp_size * st->factor : ceil (st->inp_size / (double) st->factor);
     break;
   case IIR_PARALLEL:
-    factor = parallel_iir_state->idown;
-    out_size = (parallel_iir_state->hswitch == 'U')
-      ? inp_size * factor : ceil (inp_size / (double) factor);
+    if (st->fir_kernel != FIR_KERNEL_SCALAR && nchan == 1)
+      st->iir_kernel = stdpcm_select_kernel (st->parallel_iir_state, IIR_KERNEL_SIMD);
+    st->factor = st->parallel_iir_state->idown;
+    st->out_size = (st->parallel_iir_state->hswitch == 'U')
+      ? st->inp_size * st->factor : ceil (st->inp_size / (double) st->factor);
     break;
   case IIR_CASCADE:
-    factor = cascade_iir_state->idown;
-    out_size = (cascade_iir_state->hswitch == 'U')
-      ? inp_size * factor : ceil (inp_size / (double) factor);
+    if (st->fir_kernel != FIR_KERNEL_SCALAR && nchan == 1)
+      st->iir_kernel = cascade_iir_select_kernel (st->cascade_iir_state, IIR_KERNEL_SIMD);
+    st->factor = st->cascade_iir_state->idown;
+    st->out_size = (st->cascade_iir_state->hswitch == 'U')
+      ? st->inp_size * st->factor : ceil (st->inp_size / (double) st->factor);
     break;
   case IIR_DIRECT:
-    factor = direct_iir_state->idown;
-    out_size = (direct_iir_state->hswitch == 'U')
-      ? inp_size * factor : ceil (inp_size / (double) factor);
+    st->factor = st->direct_iir_state->idown;
+    st->out_size = (st->direct_iir_state->hswitch == 'U')
+      ? st->inp_size * st->factor : ceil (st->inp_size / (double) st->factor);
   }
 
+  /* Multichannel filters share the coefficients of the mono filter */
+  if (nchan > 1) {
+    switch (st->kernel_type) {
+    case FIR:
+      st->fir_kernel = FIR_KERNEL_SCALAR;   /* the multichannel kernel is scalar */
+      if ((st->fir_mc_state = hq_mc_init (st->fir_state, nchan)) == NULL)
+        HARAKIRI ("Can't allocate memory for multichannel filter\n", 10);
+      break;
+    case IIR_PARALLEL:
+      if ((st->parallel_iir_mc_state = stdpcm_mc_init (st->parallel_iir_state, nchan)) == NULL)
+        HARAKIRI ("Can't allocate memory for multichannel filter\n", 10);
+      break;
+    case IIR_CASCADE:
+      if ((st->cascade_iir_mc_state = cascade_iir_mc_init (st->cascade_iir_state, nchan)) == NULL)
+        HARAKIRI ("Can't allocate memory for multichannel filter\n", 10);
+      break;
+    }
+  }
+
+  /* Allocate memory for the float output buffer of the stage */
+  if ((st->OutBuff = (float *) calloc (st->out_size * nchan, sizeof (float))) == NULL)
+    HARAKIRI ("Can't allocate memory for output data buffer\n", 10);
+}
+
+
+/*
+ * Filter smpno frames of InpBuff into the output buffer of the stage;
+ * returns the number of output frames
+ * By: 16.Oct.2026
+ */
+long run_stage (FILTER_STAGE * st, long smpno, float *InpBuff, long nchan) {
+  /* Reset output buffer */
+  memset (st->OutBuff, '\0', st->out_size * nchan * sizeof (float));
+
+  switch (st->kernel_type) {
+  case FIR:
+    smpno = (nchan > 1) ? hq_mc_kernel (smpno, InpBuff, st->fir_mc_state, st->OutBuff)
+      : hq_kernel (smpno, InpBuff, st->fir_state, st->OutBuff);
+    break;
+  case IIR_PARALLEL:
+    smpno = (nchan > 1) ? stdpcm_mc_kernel (smpno, InpBuff, st->parallel_iir_mc_state, st->OutBuff)
+      : stdpcm_kernel (smpno, InpBuff, st->parallel_iir_state, st->OutBuff);
+    break;
+  case IIR_CASCADE:
+    smpno = (nchan > 1) ? cascade_iir_mc_kernel (smpno, InpBuff, st->cascade_iir_mc_state, st->OutBuff)
+      : cascade_iir_kernel (smpno, InpBuff, st->cascade_iir_state, st->OutBuff);
+    break;
+  case IIR_DIRECT:
+    smpno = direct_iir_kernel (smpno, InpBuff, st->direct_iir_state, st->OutBuff);
+    break;
+  }
+  return smpno;
+}
+
+
+/*
+ * Release the filter state and output buffer of one stage
+ * By: 16.Oct.2026
+ */
+void free_stage (FILTER_STAGE * st, long nchan) {
+  switch (st->kernel_type) {
+  case FIR:
+    if (nchan > 1)
+      hq_mc_free (st->fir_mc_state);    /* also frees fir_state */
+    else
+      hq_free (st->fir_state);
+    break;
+  case IIR_PARALLEL:
+    if (nchan > 1)
+      stdpcm_mc_free (st->parallel_iir_mc_state);
+    else
+      stdpcm_free (st->parallel_iir_state);
+    break;
+  case IIR_CASCADE:
+    if (nchan > 1)
+      cascade_iir_mc_free (st->cascade_iir_mc_state);
+    else
+      cascade_iir_free (st->cascade_iir_state);
+    break;
+  case IIR_DIRECT:
+    direct_iir_free (st->direct_iir_state);
+    break;
+  }
+  free (st->OutBuff);
+}
+
+/*============================== */
+int main (int argc, char *argv[]) {
+  /* DECLARATIONS */
+
+  /* Algorithm variables */
+  FILTER_STAGE stage[MAX_STAGES];
+  long nstages, s;
+
+  float *InpBuff, *OutBuff;
+  short *TmpBuff;
+  char F_type[MAX_STRLEN], async = 0, upsample = 0, *name;
+  long cur_blk, satur = 0, total = 0, N, N1, N2;
+  char modified_IRS = 0, quiet = 0;
+  long inp_size, out_size, factor, smpno;
+  double fs = 8000;
+  int fir_kernel = FIR_KERNEL_SCALAR;
+  char fft = 0;
+  long nchan = 1;
+  static char funny[9] = "|/-\\|/-\\";
+
+  /* Sample formats of the files: 16-bit integers or 32-bit floats */
+  char float_in = 0, float_out = 0;
+  long isize, osize;
+  void *OutData;
+
+  /* For asynchronous tandem simulation */
+  long delay = 0, skip = 0;
+  char *zero = NULL;
+
+  /* File variables */
+  char FileIn[MAX_STRLEN], FileOut[MAX_STRLEN];
+  FILE *Fi, *Fo;
+  long start_byte;
+#ifdef VMS
+  char mrs[15];
+#endif
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  if (argc < 2)
+    display_usage ();
+  else {
+    while (argc > 1 && argv[1][0] == '-')
+      if (strcmp (argv[1], "-mod") == 0) {
+        /* Set modified IRS flag */
+        modified_IRS = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-fs") == 0) {
+        /* Change sampling frequency */
+        fs = atof (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-q") == 0) {
+        /* Change sampling frequency */
+        quiet = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-down") == 0) {
+        /* Filtering is for downsampling */
+        upsample = async = 0;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-up") == 0) {
+        /* Filtering is for upsampling */
+        upsample = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-async") == 0) {
+        /* Filtering is an asyncronization process */
+        async = upsample = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-delay") == 0) {
+        /* Filtering is an asyncronization process */
+        delay = atoi (argv[2]);
+        if (delay < 0)
+          skip = -delay;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-kernel") == 0) {
+        /* Dot-product implementation for FIR filters */
+        for (fir_kernel = FIR_KERNEL_AVX512; fir_kernel > FIR_KERNEL_AUTO; fir_kernel--)
+          if (strcmp (argv[2], fir_kernel_str[fir_kernel]) == 0)
+            break;
+        if (fir_kernel == FIR_KERNEL_AUTO && strcmp (argv[2], "auto") != 0) {
+          fprintf (stderr, "ERROR! Invalid kernel \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* FFT engine for long 1:1 FIR filters */
+        fft = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-channels") == 0) {
+        /* Number of interleaved channels */
+        nchan = atol (argv[2]);
+        if (nchan < 1) {
+          fprintf (stderr, "ERROR! Invalid number of channels \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-float") == 0 || strcmp (argv[1], "-float-in") == 0 || strcmp (argv[1], "-float-out") == 0) {
+        /* Input and/or output files of 32-bit float samples */
+        if (strcmp (argv[1], "-float-out") != 0)
+          float_in = 1;
+        if (strcmp (argv[1], "-float-in") != 0)
+          float_out = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-chain") == 0) {
+        /* The filter chain is read as the filter type */
+        if (argc < 3 || argv[2][0] == '-') {
+          fprintf (stderr, "ERROR! Missing filter list after -chain\n\n");
+          display_usage ();
+        }
+
+        /* Move arg{c,v} to the filter list */
+        argc--;
+        argv++;
+        break;
+      } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+        /* Display help message */
+        display_usage ();
+      } else {
+        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+        display_usage ();
+      }
+  }
+
+  /* Read parameters for processing */
+  GET_PAR_S (1, "_Filter type: ................. ", F_type);
+  GET_PAR_S (2, "_Input File: .................. ", FileIn);
+  GET_PAR_S (3, "_Output File: ................. ", FileOut);
+  FIND_PAR_L (4, "_Block Size: .................. ", N, 256);
+  FIND_PAR_L (5, "_Starting Block: .............. ", N1, 1);
+  FIND_PAR_L (6, "_No. of Blocks: ............... ", N2, 0);
+
+
+  /* ......... CHECK CONSISTENCY ......... */
+
+  /* Split the filter type into the stages of the chain, e.g. irs8,hq2:up,msin */
+  memset (stage, 0, sizeof (stage));
+  for (nstages = 0, name = strtok (F_type, ","); name != NULL; name = strtok (NULL, ",")) {
+    if (nstages == MAX_STAGES)
+      HARAKIRI ("\nToo many filters in the chain! Aborted.\n", 5);
+    strcpy (stage[nstages].F_type, name);
+    stage[nstages].upsample = upsample;
+    if ((name = strchr (stage[nstages].F_type, ':')) != NULL) {
+      if (strcmp (name, ":up") == 0)
+        stage[nstages].upsample = 1;
+      else if (strcmp (name, ":down") == 0)
+        stage[nstages].upsample = 0;
+      else
+        HARAKIRI ("\nInvalid direction in the filter chain (:up or :down)! Aborted.\n", 5);
+      *name = '\0';
+    }
+    stage[nstages].modified_IRS = modified_IRS;
+    stage[nstages].fir_kernel = fir_kernel;
+    stage[nstages].fft = fft;
+    stage[nstages].iir_kernel = IIR_KERNEL_SCALAR;
+
+    /* Verify that a valid filter was selected */
+    if (!valid_filter (stage[nstages].F_type, modified_IRS)) {
+      if (modified_IRS && (strcmp (stage[nstages].F_type, "irs8") == 0 || strcmp (stage[nstages].F_type, "IRS8") == 0))
+        fprintf (stderr, "\nModified IRS is NOT available at 8 kHz! Aborted.\n");
+      else
+        fprintf (stderr, "\nInvalid filter chosen! Aborted.\n");
+      exit (2);
+    }
+
+    /* There is no multichannel version of the direct-form IIR filter */
+    if (nchan > 1 && (strncmp (stage[nstages].F_type, "dc", 2) == 0 || strncmp (stage[nstages].F_type, "DC", 2) == 0))
+      HARAKIRI ("\nThe DC filter is only available for 1 channel! Aborted.\n", 5);
+    nstages++;
+  }
+  if (nstages == 0) {
+    fprintf (stderr, "\nInvalid filter chosen! Aborted.\n");
+    exit (2);
+  }
+
+  /* Asynchronization is only available for a single filter */
+  if (async && nstages > 1)
+    HARAKIRI ("\nASYNC filtering is not available for a filter chain! Aborted.\n", 5);
+
+  /* The delay option is only available with asynchronous filtering */
+  if (delay != 0 && !async)
+    HARAKIRI ("\nDelay option only available for ASYNC filtering! Aborted.\n", 5);
+
+  /* Delay and skip are given in frames; from now on they count samples */
+  delay *= nchan;
+  skip *= nchan;
+
+
+  /* ......... STARTING ......... */
+
+  /* Sample sizes in the files */
+  isize = float_in ? sizeof (float) : sizeof (short);
+  osize = float_out ? sizeof (float) : sizeof (short);
+
+  /* Find starting byte in file */
+  start_byte = isize * (long) (--N1) * (long) N * nchan;
+
+#ifdef SKIP_APPROACH_1
+  /* If samples are to be skipped in output file, does it here */
+  if (skip)
+    start_byte += skip * isize;
+#endif
+
+  /* Check if is to process the whole file */
+  if (N2 == 0) {
+    struct stat st;
+
+    /* ... find the input file size ... */
+    stat (FileIn, &st);
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * nchan * isize));
+  }
+  inp_size = N;                 /* frames of nchan samples */
+
+
+  /* Allocate memory for delay buffer & initialize it (null samples are zero bytes in both formats) */
+  if (delay > 0) {
+    if ((zero = (char *) calloc (delay, osize)) == NULL) {
+      HARAKIRI ("Error allocating memory for delay buffer\n", 5);
+    } else
+      memset (zero, 0, delay * osize);
+  }
+
+
+  /* ... INITIALIZE THE FILTERS; EACH STAGE GETS THE OUTPUT BLOCKS OF THE PREVIOUS ONE ... */
+  for (s = 0; s < nstages; s++) {
+    stage[s].inp_size = (s == 0) ? inp_size : stage[s - 1].out_size;
+    init_stage (&stage[s], nchan);
+    if (stage[s].modified_IRS)
+      modified_IRS = 1;
+  }
+  upsample = stage[nstages - 1].upsample;
+  factor = stage[nstages - 1].factor;
+  out_size = stage[nstages - 1].out_size;
+  OutBuff = stage[nstages - 1].OutBuff;
+
+
+  /* MEMORY ALLOCATION */
+
   /* Check consistency once more */
   if (async && factor == 1)
     HARAKIRI ("INCONSISTENCY: async operation requires non-unity upsampling factor; aborting\n", 10);
 
   /* Allocate memory for float input buffer */
-  if ((InpBuff = (float *) calloc (inp_size, sizeof (float))) == NULL)
+  if ((InpBuff = (float *) calloc (inp_size * nchan, sizeof (float))) == NULL)
     HARAKIRI ("Can't allocate memory for input data buffer\n", 10);
 
-  /* Allocate memory for float output buffer */
-  if ((OutBuff = (float *) calloc (out_size, sizeof (float))) == NULL)
-    HARAKIRI ("Can't allocate memory for output data buffer\n", 10);
-
   /* Allocate memory for short input/output buffer */
-  if ((TmpBuff = (short *) calloc (max (inp_size, out_size), sizeof (short))) == NULL)
+  if ((TmpBuff = (short *) calloc (max (inp_size, out_size) * nchan, sizeof (short))) == NULL)
     HARAKIRI ("Can't allocate memory for short data buffer\n", 10);
 
+  /* Output samples: converted to short in TmpBuff, or float ones as filtered */
+  OutData = float_out ? (void *) OutBuff : (void *) TmpBuff;
+
 
 /*
  * ......... PRINT INFO ..........
  */
-  if (factor == 1)
-    fprintf (stderr, "No-rate change operation\n");
-  else {
-    fprintf (stderr, "%s operation, ", async ? "Asynchronization" : (upsample ? "Upsampling" : "Downsampling"));
-    fprintf (stderr, "factor %ld\n", async ? 1l : factor);
+  for (s = 0; s < nstages; s++) {
+    if (nstages > 1)
+      fprintf (stderr, "Stage %ld: %s\n", s + 1, stage[s].F_type);
+    if (stage[s].factor == 1)
+      fprintf (stderr, "No-rate change operation\n");
+    else {
+      fprintf (stderr, "%s operation, ", async ? "Asynchronization" : (stage[s].upsample ? "Upsampling" : "Downsampling"));
+      fprintf (stderr, "factor %ld\n", async ? 1l : stage[s].factor);
+    }
+    fprintf (stderr, "Filter structure: %s\n", filter_type_str[(int) stage[s].kernel_type]);
+    if (stage[s].kernel_type == FIR)
+      fprintf (stderr, "FIR kernel: %s%s\n", fir_kernel_str[stage[s].fir_kernel],
+               (nchan == 1 && stage[s].fir_state->fft != NULL) ? " + FFT" : "");
+    else if (stage[s].kernel_type == IIR_PARALLEL || stage[s].kernel_type == IIR_CASCADE)
+      fprintf (stderr, "IIR kernel: %s\n", (stage[s].iir_kernel == IIR_KERNEL_SIMD) ? "simd" : "scalar");
   }
   if (modified_IRS)
     fprintf (stderr, "Using modified IRS\n");
+  if (nchan > 1)
+    fprintf (stderr, "Interleaved channels: %ld\n", nchan);
+  if (float_in || float_out)
+    fprintf (stderr, "Float samples in %s\n", float_in ? (float_out ? "input and output files" : "input file") : "output file");
 
   if (delay > 0)
     fprintf (stderr, "Delaying output file by %ld samples\n", delay);
   else if (skip)
     fprintf (stderr, "Skipping %ld samples in output file\n", skip);
 
-  fprintf (stderr, "Filter structure: %s\n", filter_type_str[(int) kernel_type]);
-
 
 /*
  * ......... FILE PREPARATION .........
@@ -775,7 +1084,7 @@ int main (int argc, char *argv[]) {
 
   /* One-time delay of output signal, if appropriate */
   if (async && delay > 0)
-    if ((smpno = fwrite (zero, sizeof (short), delay, Fo)) == 0 && ferror (Fo))
+    if ((smpno = fwrite (zero, osize, delay, Fo)) == 0 && ferror (Fo))
       KILL (FileOut, 6);
 
   /* Process regular frames */
@@ -784,58 +1093,53 @@ int main (int argc, char *argv[]) {
     if (!quiet)
       fprintf (stderr, "%c\r", funny[cur_blk % 8]);
 
-    /* Reset output buffer */
-    memset (OutBuff, '\0', out_size * sizeof (float));
-
-    /* Read a block of samples */
-    if ((smpno = fread (TmpBuff, sizeof (short), N, Fi)) == 0)
-      KILL (FileIn, 5);
-
-    /* ... and convert short to float, normalizing */
-    sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
-
-    /* Call the filtering routine */
-    switch (kernel_type) {
-    case FIR:
-      smpno = hq_kernel (smpno, InpBuff, fir_state, OutBuff);
-      break;
-    case IIR_PARALLEL:
-      smpno = stdpcm_kernel (smpno, InpBuff, parallel_iir_state, OutBuff);
-      break;
-    case IIR_CASCADE:
-      smpno = cascade_iir_kernel (smpno, InpBuff, cascade_iir_state, OutBuff);
-      break;
-    case IIR_DIRECT:
-      smpno = direct_iir_kernel (smpno, InpBuff, direct_iir_state, OutBuff);
-      break;
+    /* Read a block of samples, and convert short to float, normalizing */
+    if (float_in) {
+      if ((smpno = fread (InpBuff, sizeof (float), N * nchan, Fi)) == 0)
+        KILL (FileIn, 5);
+    } else {
+      if ((smpno = fread (TmpBuff, sizeof (short), N * nchan, Fi)) == 0)
+        KILL (FileIn, 5);
+      sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
     }
 
+    /* Call the filtering routines, the intermediate blocks staying in float;
+       counts are in frames of nchan samples, and a trailing incomplete frame is dropped */
+    smpno /= nchan;
+    for (s = 0; s < nstages; s++)
+      smpno = run_stage (&stage[s], smpno, (s == 0) ? InpBuff : stage[s - 1].OutBuff, nchan);
+
     /* Decimates to implement asynchronization process */
     if (async) {
-      long k;
+      long k, ch;
 
       /* Decrease output vector by `factor' */
       smpno /= factor;
 
-      /* Shift samples implementing decimation process */
+      /* Shift frames implementing decimation process */
       for (k = 0; k < smpno; k++)
-        OutBuff[k] = OutBuff[k * factor];
+        for (ch = 0; ch < nchan; ch++)
+          OutBuff[k * nchan + ch] = OutBuff[k * factor * nchan + ch];
     }
 
+    /* Back to number of samples */
+    smpno *= nchan;
+
     /* Convert the filtered data back to short */
-    satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
+    if (!float_out)
+      satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
 
     /* Save to file, skipping any samples if necessary */
     if (skip >= smpno) {
       skip -= smpno;
       continue;
     } else if (skip > 0) {
-      if ((smpno = fwrite (&TmpBuff[skip], sizeof (short), (smpno - skip), Fo)) == 0 && ferror (Fo))
+      if ((smpno = fwrite ((char *) OutData + skip * osize, osize, (smpno - skip), Fo)) == 0 && ferror (Fo))
         KILL (FileOut, 6);
       total += smpno;
       skip = 0;
     } else {
-      if ((smpno = fwrite (TmpBuff, sizeof (short), smpno, Fo)) == 0 && ferror (Fo))
+      if ((smpno = fwrite (OutData, osize, smpno, Fo)) == 0 && ferror (Fo))
         KILL (FileOut, 6);
       total += smpno;
     }
@@ -851,24 +1155,11 @@ int main (int argc, char *argv[]) {
 
   /* Release some memory */
   free (TmpBuff);
-  free (OutBuff);
   free (InpBuff);
 
-  /* Release filter structrues */
-  switch (kernel_type) {
-  case FIR:
-    hq_free (fir_state);
-    break;
-  case IIR_PARALLEL:
-    stdpcm_free (parallel_iir_state);
-    break;
-  case IIR_CASCADE:
-    cascade_iir_free (cascade_iir_state);
-    break;
-  case IIR_DIRECT:
-    direct_iir_free (direct_iir_state);
-    break;
-  }
+  /* Release filter structrues, and the output buffers */
+  for (s = 0; s < nstages; s++)
+    free_stage (&stage[s], nchan);
 
   /* Release memory for delay buffer */
   if (delay > 0)
@@ -0,0 +1,349 @@
+/*                                                          v1.0 - 16/Oct/2026
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: FFT (overlap-save) filtering of long filters
+
+DESCRIPTION:
+        This file contains an overlap-save block convolution engine for
+        filters without rate change (factor 1:1) and at least
+        FIR_FFT_MIN_TAPS coefficients. It is attached to the SCD_FIR
+        struct by hq_fft_engine() and called by hq_kernel(), so the
+        filtering calls of the user's program do not change.
+
+        The input is processed in passes of at most FIR_BLOCK samples, as
+        in fir_downsampling_kernel(). In each pass, the past lenh0-1 and
+        the new samples in the delay line are transformed with the
+        smallest power-of-two FFT that holds them, multiplied by the
+        spectrum of the impulse response and transformed back; the last
+        outputs of the circular convolution are the filtered samples.
+        There is no extra delay, whatever the segment length. When a pass
+        is too short for the FFT to pay off (e.g. sample-based filtering),
+        the dot-product selected by hq_select_kernel() is used instead.
+
+        The results differ from the time-domain kernels by float
+        rounding, so the engine is only used on request; by default,
+        hq_kernel() reproduces the reference results bit-exactly.
+
+        The spectra of the impulse response are computed on first use
+        for each FFT size, with the real FFT of the frequency response
+        tool (actrdft() in ../freqresp/fft.c).
+
+FUNCTIONS:
+  Local (Used by fir-lib.c; prototypes in fir-lib.c, not in firflt.h)
+         = fir_fft_init(...)     : allocate the engine for a filter
+         = fir_fft_free(...)     : release it
+         = fir_fft_kernel(...)   : filter a segment of samples
+  Local (should be used only here -- prototypes only in this file)
+         = fir_fft_spectrum(...) : spectrum of the impulse response for
+                                   a given FFT size
+
+HISTORY:
+    16.Oct.26 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memmove(), memset() */
+#include <math.h>               /* sqrt() */
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+#include "fft.h"                /* actrdft() */
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Cost of a FFT filtering pass of size n=2^lg (forward and inverse transforms, and the spectral product), relative to one vector multiply-add of the dot-product; measured for the SSE2 and AVX2 kernels */
+#define FIR_FFT_COST(n, lg) (5 * (n) * (lg) / 4)
+
+/* Floats per vector multiply-add for kernel k */
+#define FIR_FFT_LANES(k) (((k) >= FIR_KERNEL_SSE) ? 4L << ((k) - FIR_KERNEL_SSE) : 1L)
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+FIR_FFT *fir_fft_init ARGS ((long lenh, float *h));
+void fir_fft_free ARGS ((FIR_FFT * fft));
+long fir_fft_kernel ARGS ((long lenx, float *x, float *y, long lenh0, float *hp, float *T, FIR_FFT * fft, int kernel, float (*dot) (float *, float *, long)));
+
+static float *fir_fft_spectrum ARGS ((FIR_FFT * fft, int lg));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        FIR_FFT *fir_fft_init (long lenh, float *h);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate the overlap-save engine for a filter with lenh
+        coefficients. Only the work buffer for the largest FFT is
+        allocated here; spectra are computed on first use.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenh: .... (In) number of FIR-coefficients
+        h: ....... (In) FIR-coefficients (must stay valid while the
+                        engine is in use)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to a FIR_FFT struct, or NULL if the filter is too short or
+        too long, or if there is not enough memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_FFT *fir_fft_init (long lenh, float *h) {
+  FIR_FFT *fft;
+  long nfft;
+  int lg;
+
+  if (lenh < FIR_FFT_MIN_TAPS)
+    return (FIR_FFT *) NULL;
+
+  /* Largest FFT: past samples plus one block of input */
+  for (lg = 2, nfft = 4; nfft < lenh - 1 + FIR_BLOCK; lg++, nfft <<= 1);
+  if (lg > FIR_FFT_MAXLOG2)
+    return (FIR_FFT *) NULL;
+
+  if ((fft = (FIR_FFT *) calloc (1, sizeof (FIR_FFT))) == (FIR_FFT *) NULL)
+    return (FIR_FFT *) NULL;
+  if ((fft->X = (float *) malloc (nfft * sizeof (float))) == (float *) NULL) {
+    free (fft);
+    return (FIR_FFT *) NULL;
+  }
+  fft->lenh = lenh;
+  fft->h = h;
+
+  return fft;
+}
+
+/* ........................ End of fir_fft_init() ........................ */
+
+
+/*
+  ============================================================================
+
+        void fir_fft_free (FIR_FFT *fft);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Deallocate the overlap-save engine and all spectra computed.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fft: ..... (InOut) pointer to FIR_FFT struct
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void fir_fft_free (FIR_FFT * fft) {
+  int lg;
+
+  for (lg = 0; lg <= FIR_FFT_MAXLOG2; lg++) {
+    free (fft->H[lg]);
+    free (fft->ip[lg]);
+    free (fft->w[lg]);
+  }
+  free (fft->X);
+  free (fft);
+}
+
+/* ........................ End of fir_fft_free() ........................ */
+
+
+/*
+  ============================================================================
+
+        float *fir_fft_spectrum (FIR_FFT *fft, int lg);
+        ~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Return the spectrum of the zero-padded impulse response for the
+        FFT size 2^lg, in the packed format of actrdft(), computing it
+        (and the FFT tables for this size) on the first call.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fft: ..... (InOut) pointer to FIR_FFT struct
+        lg: ...... (In)    log2 of the FFT size
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the spectrum, or NULL if there is not enough memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static float *fir_fft_spectrum (FIR_FFT * fft, int lg) {
+  long nfft = 1L << lg;
+
+  if (fft->H[lg] != (float *) NULL)
+    return fft->H[lg];
+
+  fft->ip[lg] = (int *) calloc (3 + (long) sqrt (nfft / 2.0), sizeof (int));
+  fft->w[lg] = (float *) malloc (nfft / 2 * sizeof (float));
+  fft->H[lg] = (float *) malloc (nfft * sizeof (float));
+  if (fft->ip[lg] == (int *) NULL || fft->w[lg] == (float *) NULL || fft->H[lg] == (float *) NULL) {
+    free (fft->ip[lg]);
+    free (fft->w[lg]);
+    free (fft->H[lg]);
+    fft->ip[lg] = (int *) NULL;
+    fft->w[lg] = fft->H[lg] = (float *) NULL;
+    return (float *) NULL;
+  }
+
+  /* Transform the zero-padded impulse response */
+  memcpy (fft->H[lg], fft->h, fft->lenh * sizeof (float));
+  memset (&fft->H[lg][fft->lenh], 0, (nfft - fft->lenh) * sizeof (float));
+  actrdft ((int) nfft, 1, fft->H[lg], fft->ip[lg], fft->w[lg]);
+
+  return fft->H[lg];
+}
+
+/* ...................... End of fir_fft_spectrum() ...................... */
+
+
+/*
+  ============================================================================
+
+        long fir_fft_kernel (long lenx, float *x, float *y, long lenh0,
+        ~~~~~~~~~~~~~~~~~~~  float *hp, float *T, FIR_FFT *fft, int kernel,
+                             float (*dot) (float *, float *, long));
+
+        Description:
+        ~~~~~~~~~~~~
+
+        FIR-Filter (kernel) for filters without rate change, using the
+        overlap-save method for passes long enough, and the dot-product
+        otherwise.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenx: .... (In)    length of input signal
+        x: ....... (In)    array with input samples
+        y: ....... (Out)   array with output samples
+        lenh0: ... (In)    number of  FIR-coefficients
+        hp: ...... (In)    array with time-reversed FIR-coefficients
+        T: ....... (InOut) delay line, lenh0-1 past samples plus room for
+                           FIR_BLOCK input samples
+        fft: ..... (InOut) overlap-save engine
+        kernel: .. (In)    FIR_KERNEL_xxx of dot
+        dot: ..... (In)    dot-product function
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of filtered samples (= lenx).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long fir_fft_kernel (long lenx, float *x, float *y, long lenh0, float *hp, float *T, FIR_FFT * fft, int kernel, float (*dot) (float *, float *, long)) {
+  long lenT = lenh0 - 1;        /* number of past samples in T */
+  long lblk, nfft, kx, ky;      /* block length, FFT size and indices */
+  float *X = fft->X, *H, re;
+  int lg;
+
+  ky = 0;                       /* starting index in output array (y) */
+
+  while (lenx > 0) {
+    lblk = (lenx > FIR_BLOCK) ? FIR_BLOCK : lenx;
+
+    /* Append the input block to the past samples */
+    memcpy (&T[lenT], x, lblk * sizeof (float));
+
+    /* Smallest FFT for the past and new samples */
+    for (lg = 2, nfft = 4; nfft < lenT + lblk; lg++, nfft <<= 1);
+
+    if (FIR_FFT_COST (nfft, lg) < lblk * lenh0 / FIR_FFT_LANES (kernel) && (H = fir_fft_spectrum (fft, lg)) != (float *) NULL) {
+      /* Overlap-save: circular convolution of the zero-padded delay line */
+      memcpy (X, T, (lenT + lblk) * sizeof (float));
+      memset (&X[lenT + lblk], 0, (nfft - lenT - lblk) * sizeof (float));
+      actrdft ((int) nfft, 1, X, fft->ip[lg], fft->w[lg]);
+
+      X[0] *= H[0];             /* DC */
+      X[1] *= H[1];             /* Nyquist frequency */
+      for (kx = 2; kx < nfft; kx += 2) {
+        re = X[kx] * H[kx] - X[kx + 1] * H[kx + 1];
+        X[kx + 1] = X[kx] * H[kx + 1] + X[kx + 1] * H[kx];
+        X[kx] = re;
+      }
+
+      actrdft ((int) nfft, -1, X, fft->ip[lg], fft->w[lg]);
+
+      /* The first lenT outputs are wrapped around; the others are valid */
+      memcpy (&y[ky], &X[lenT], lblk * sizeof (float));
+      ky += lblk;
+    } else {
+      for (kx = 0; kx < lblk; kx++)
+        y[ky++] = dot (&T[kx], hp, lenh0);      /* T[kx..kx+lenh0-1] */
+    }
+
+    /* Update of delay line: keep the last lenh0-1 samples */
+    memmove (T, &T[lblk], lenT * sizeof (float));
+
+    x += lblk;
+    lenx -= lblk;
+  }
+
+  return ky;
+}
+
+/* ....................... End of fir_fft_kernel() ....................... */
+
+
+/* **************************** END OF FIR-FFT.C *************************** */
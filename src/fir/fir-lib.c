@@ -1,4 +1,4 @@
-/*                                                          v2.3 - 03/Dec/2004
+/*                                                          v2.8 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -46,6 +46,13 @@ FUNCTIONS:
                                     (needed only if another signal should
                                     be processed with the same filter)
          = hq_free(...)          :  deallocate FIR-filter memory
+         = hq_select_kernel(...) :  choose scalar or SIMD dot-product
+         = hq_fft_engine(...)    :  use the FFT engine for a long filter
+         = hq_mc_init(...)       :  multichannel (interleaved) filter
+                                    built from a mono one
+         = hq_mc_kernel(...)     :  multichannel FIR-filter function
+         = hq_mc_reset(...)      :  clear multichannel state variables
+         = hq_mc_free(...)       :  deallocate multichannel filter memory
 
   Local (Used by other sub-units of this module, should not be needed by
          the user's program. Prototypes here and in the sub-units that use
@@ -57,6 +64,11 @@ FUNCTIONS:
                                    up-sampling procedures;
          = fir_downsampling_kernel(...) : kernel function for all FIR
                                    down-sampling procedures;
+         = fir_dot_scalar(...) : portable dot-product used by both
+                                   kernels (the SIMD versions are in
+                                   fir-simd.c);
+         = fir_mc_upsampling_kernel(...), fir_mc_downsampling_kernel(...),
+           fir_mc_dot(...) : multichannel versions of the above;
 
 HISTORY:
     16.Dec.91 v0.1 First beta-version <hf@pkinbg.uucp>
@@ -71,6 +83,23 @@ HISTORY:
 				   OpenVMS/AXP <simao@ctd.comsat.com>
     03.Dec.04 v2.3 Added correction in fir_downsampling_kernel() for sample-based
 				   operation.	<Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+    16.Oct.26 v2.4 Up-sampling filters are split into polyphase coefficient
+                   sets at initialization time, so that only the non-zero
+                   taps are evaluated per output sample. Input samples are
+                   appended to a contiguous delay line, which removes the
+                   transition loops between x[] and T[]. Results are
+                   bit-exact with v2.3.
+    16.Oct.26 v2.5 Coefficients are stored time-reversed and the kernels
+                   call a dot-product function selected by hq_select_kernel()
+                   (scalar, SSE2, AVX2 or AVX-512, see fir-simd.c).
+    16.Oct.26 v2.6 Long filters without rate change use the overlap-save
+                   engine of fir-fft.c with the SIMD kernels.
+    16.Oct.26 v2.7 Added multichannel filtering of interleaved signals
+                   (hq_mc_xxx functions), with one delay line per channel
+                   and shared coefficients.
+    16.Oct.26 v2.8 The overlap-save engine is only attached on request
+                   (hq_fft_engine()), whatever the dot-product; the default
+                   remains the bit-exact time-domain filtering.
 
   =============================================================================
 */
@@ -81,6 +110,7 @@ HISTORY:
  */
 #include <stdio.h>
 #include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memmove() */
 
 #include "firflt.h"             /* Global definitions for FIR-FIR filter */
 
@@ -92,8 +122,23 @@ HISTORY:
 
 SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idwnup, int hswitch));
 
-static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long iupfac));
-static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long downfac, long *k0_ptr));
+/* From fir-simd.c */
+int fir_simd_supported ARGS ((int kernel));
+float fir_dot_sse ARGS ((float *x, float *h, long n));
+float fir_dot_avx2 ARGS ((float *x, float *h, long n));
+float fir_dot_avx512 ARGS ((float *x, float *h, long n));
+
+/* From fir-fft.c */
+FIR_FFT *fir_fft_init ARGS ((long lenh, float *h));
+void fir_fft_free ARGS ((FIR_FFT * fft));
+long fir_fft_kernel ARGS ((long lenx, float *x, float *y, long lenh0, float *hp, float *T, FIR_FFT * fft, int kernel, float (*dot) (float *, float *, long)));
+
+static float fir_dot_scalar ARGS ((float *x, float *h, long n));
+static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenhp, float *hp_ptr, float *T_ptr, long iupfac, float (*dot) (float *, float *, long)));
+static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long downfac, long *k0_ptr, float (*dot) (float *, float *, long)));
+static void fir_mc_dot ARGS ((float *T, float *h, long n, long nchan, float *y));
+static long fir_mc_upsampling_kernel ARGS ((long lenx, float *x, float *y, long lenhp, float *hp, float *T, long iupfac, long nchan));
+static long fir_mc_downsampling_kernel ARGS ((long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0, long nchan));
 
 
 /*
@@ -111,7 +156,10 @@ static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr
 
         Works as switch to FIR-kernel functions; the address of the
         according  function is generated by the initialization
-        procedures.
+        procedures. The dot-products are computed by the implementation
+        chosen with hq_select_kernel() (scalar by default). Long filters
+        without rate change are processed with the FFT engine in fir-fft.c
+        if hq_fft_engine() was called.
 
         WARNING! Prior to the first call one of the initialization must
         be called to allocate memory for state variables and the get the
@@ -144,15 +192,28 @@ static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr
  ============================================================================
 */
 long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
-  if (fir_ptr->hswitch == 'U')  /* call up-sampling procedure */
+  if (fir_ptr->fft != (FIR_FFT *) NULL)        /* call overlap-save procedure */
+    return fir_fft_kernel (     /* returns number of output samples */
+                            lseg,       /* In : length of input signal */
+                            x_ptr,      /* In : array with input samples */
+                            y_ptr,      /* Out : array with output samples */
+                            fir_ptr->lenh0,     /* In : number of FIR-coefficients */
+                            fir_ptr->hp,        /* In : time-reversed FIR-coefficients */
+                            fir_ptr->T, /* InOut: state variables */
+                            fir_ptr->fft,       /* InOut: overlap-save engine */
+                            fir_ptr->kernel,    /* In : dot-product kernel */
+                            fir_ptr->dot        /* In : dot-product function */
+      );
+  else if (fir_ptr->hswitch == 'U')     /* call up-sampling procedure */
     return fir_upsampling_kernel (      /* returns number of output samples */
                                    lseg,        /* In : length of input signal */
                                    x_ptr,       /* In : array with input samples */
                                    y_ptr,       /* Out : array with output samples */
-                                   fir_ptr->lenh0,      /* In : number of FIR-coefficients */
-                                   fir_ptr->h0, /* In : array with FIR-coefficients */
+                                   fir_ptr->lenhp,      /* In : number of coefficients per phase */
+                                   fir_ptr->hp, /* In : polyphase FIR-coefficients */
                                    fir_ptr->T,  /* InOut: state variables */
-                                   fir_ptr->dwn_up      /* In : upsampling factor */
+                                   fir_ptr->dwn_up,     /* In : upsampling factor */
+                                   fir_ptr->dot /* In : dot-product function */
       );
   else                          /* call down-sampling procedure */
     return fir_downsampling_kernel (    /* returns number of output samples */
@@ -160,10 +221,11 @@ long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
                                      x_ptr,     /* In : array with input samples */
                                      y_ptr,     /* Out : array with output samples */
                                      fir_ptr->lenh0,    /* In : number of FIR-coefficients */
-                                     fir_ptr->h0,       /* In : array with FIR-coefficients */
+                                     fir_ptr->hp,       /* In : time-reversed FIR-coefficients */
                                      fir_ptr->T,        /* InOut: state variables */
                                      fir_ptr->dwn_up,   /* In : downsampling factor */
-                                     &(fir_ptr->k0)     /* InOut: starting index in * x-array */
+                                     &(fir_ptr->k0),    /* InOut: starting index in * x-array */
+                                     fir_ptr->dot       /* In : dot-product function */
       );
 }
 
@@ -205,6 +267,9 @@ void hq_free (SCD_FIR * fir_ptr) {
 
   free (fir_ptr->T);            /* free state variables */
   free (fir_ptr->h0);           /* free state impulse response */
+  free (fir_ptr->hp);           /* free polyphase coefficient sets */
+  if (fir_ptr->fft != (FIR_FFT *) NULL)
+    fir_fft_free (fir_ptr->fft);        /* free overlap-save engine */
   free (fir_ptr);               /* free allocated struct */
 }
 
@@ -243,7 +308,7 @@ void hq_free (SCD_FIR * fir_ptr) {
 */
 void hq_reset (SCD_FIR * fir_ptr) {
   long k;
-  for (k = 0; k < fir_ptr->lenh0 - 1; k++)      /* clear delay line */
+  for (k = 0; k < fir_ptr->lenT; k++)  /* clear delay line */
     fir_ptr->T[k] = 0.0;        /* (= state variables) */
   fir_ptr->k0 = 0;              /* default starting index in x-array */
 }
@@ -251,6 +316,308 @@ void hq_reset (SCD_FIR * fir_ptr) {
 /* .......................... End of hq_reset() .......................... */
 
 
+/*
+  ============================================================================
+
+        int hq_select_kernel (SCD_FIR *fir_ptr, int kernel);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Choose the dot-product implementation used by hq_kernel() for
+        this filter. FIR_KERNEL_SCALAR (the default after initialization)
+        reproduces the reference results bit-exactly; the SIMD kernels
+        sum the products in a different order and therefore differ by
+        float rounding only. Filters with an FFT engine (see
+        hq_fft_engine()) use the dot-product only for short passes, and
+        differ by float rounding with any kernel. FIR_KERNEL_AUTO picks the widest SIMD
+        kernel supported by the CPU. If the requested kernel is not supported by
+        the CPU (or the compiler), the next narrower one is used.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: (InOut) pointer to struct SCD_FIR;
+        kernel: ...(In)  one of FIR_KERNEL_xxx (see firflt.h)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The FIR_KERNEL_xxx actually selected.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int hq_select_kernel (SCD_FIR * fir_ptr, int kernel) {
+  if (kernel == FIR_KERNEL_AUTO || kernel > FIR_KERNEL_AVX512)
+    kernel = FIR_KERNEL_AVX512;
+  while (kernel > FIR_KERNEL_SCALAR && !fir_simd_supported (kernel))
+    kernel--;
+
+  switch (kernel) {
+  case FIR_KERNEL_SSE:
+    fir_ptr->dot = fir_dot_sse;
+    break;
+  case FIR_KERNEL_AVX2:
+    fir_ptr->dot = fir_dot_avx2;
+    break;
+  case FIR_KERNEL_AVX512:
+    fir_ptr->dot = fir_dot_avx512;
+    break;
+  default:
+    kernel = FIR_KERNEL_SCALAR;
+    fir_ptr->dot = fir_dot_scalar;
+  }
+  fir_ptr->kernel = kernel;
+
+  return kernel;
+}
+
+/* ....................... End of hq_select_kernel() ....................... */
+
+
+/*
+  ============================================================================
+
+        int hq_fft_engine (SCD_FIR *fir_ptr);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Attach the overlap-save FFT engine of fir-fft.c to a filter
+        without rate change and with at least FIR_FFT_MIN_TAPS
+        coefficients, so that hq_kernel() processes long segments with it.
+        This is much faster for long filters, but the results differ from
+        the time-domain (reference) results by float rounding. No effect on
+        other filters. May be called between two calls of hq_kernel(),
+        since both methods share the delay line.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: (InOut) pointer to struct SCD_FIR;
+
+        Return value:
+        ~~~~~~~~~~~~~
+        1 if the filter has an FFT engine, 0 if it is not eligible or
+        there is not enough memory (the time-domain filtering is kept).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int hq_fft_engine (SCD_FIR * fir_ptr) {
+  if (fir_ptr->fft == (FIR_FFT *) NULL && fir_ptr->hswitch != 'U' && fir_ptr->dwn_up == 1)
+    fir_ptr->fft = fir_fft_init (fir_ptr->lenh0, fir_ptr->h0);
+
+  return fir_ptr->fft != (FIR_FFT *) NULL;
+}
+
+/* ....................... End of hq_fft_engine() ....................... */
+
+
+/*
+  ============================================================================
+
+        SCD_FIR_MC *hq_mc_init (SCD_FIR *fir_ptr, long nchan);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Build a filter for signals of nchan interleaved channels from
+        a (mono) filter returned by one of the initialization routines,
+        e.g. hq_mc_init(irs_8khz_init(), 2) for stereo. The coefficients,
+        the rate change and the down-sampling offset of fir_ptr are
+        shared by all channels, and each channel gets its own delay line.
+        The multichannel struct takes over fir_ptr, which is released by
+        hq_mc_free() and must not be used with hq_kernel() any more.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: (In)    pointer to struct SCD_FIR;
+        nchan: . (In)    number of channels (1 or more)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to a SCD_FIR_MC structure, or NULL if there is not enough
+        memory (fir_ptr is then left untouched).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+SCD_FIR_MC *hq_mc_init (SCD_FIR * fir_ptr, long nchan) {
+  SCD_FIR_MC *ptrMC;            /* pointer to the new struct */
+  long k;
+
+  /* Allocate memory for a new struct */
+  if ((ptrMC = (SCD_FIR_MC *) malloc (sizeof (SCD_FIR_MC))) == (SCD_FIR_MC *) NULL)
+    return 0;
+
+  /* Allocate memory for interleaved delay lines: past frames + one block */
+  if ((ptrMC->T = (float *) malloc ((fir_ptr->lenT + FIR_BLOCK) * nchan * sizeof (float))) == (float *) 0) {
+    free (ptrMC);
+    return 0;
+  }
+
+  ptrMC->nchan = nchan;
+  ptrMC->fir = fir_ptr;
+
+  /* Clear delay lines and down-sampling offset */
+  for (k = 0; k < fir_ptr->lenT * nchan; k++)
+    ptrMC->T[k] = 0.0;
+  fir_ptr->k0 = 0;
+
+  return (ptrMC);
+}
+
+/* .......................... End of hq_mc_init() .......................... */
+
+
+/*
+  ============================================================================
+
+        long hq_mc_kernel (long lseg, float *x_ptr, SCD_FIR_MC *mc_ptr,
+        ~~~~~~~~~~~~~~~~~  float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Filter lseg frames of interleaved samples (x[k*nchan+ch] is
+        sample k of channel ch) into interleaved output frames. Every
+        channel is filtered exactly as hq_kernel() with the scalar
+        dot-product would filter it alone (same summation order, hence
+        bit-exact), but the channels are processed side by side: the
+        innermost loops run over the channels of one frame, which are
+        adjacent in memory, so that the compiler can map them onto
+        vector lanes. The SIMD and FFT kernels of hq_select_kernel() are
+        not used here.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: .... (In)    number of input frames
+        x_ptr: ... (In)    array with lseg*nchan interleaved input samples
+        mc_ptr ... (InOut) pointer to multichannel FIR-struct
+        y_ptr .... (Out)   interleaved output frames
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of filtered frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_mc_kernel (long lseg, float *x_ptr, SCD_FIR_MC * mc_ptr, float *y_ptr) {
+  SCD_FIR *fir_ptr = mc_ptr->fir;
+
+  if (fir_ptr->hswitch == 'U')  /* call up-sampling procedure */
+    return fir_mc_upsampling_kernel (   /* returns number of output frames */
+                                      lseg,     /* In : number of input frames */
+                                      x_ptr,    /* In : interleaved input samples */
+                                      y_ptr,    /* Out : interleaved output samples */
+                                      fir_ptr->lenhp,   /* In : number of coefficients per phase */
+                                      fir_ptr->hp,      /* In : polyphase FIR-coefficients */
+                                      mc_ptr->T,        /* InOut: state variables */
+                                      fir_ptr->dwn_up,  /* In : upsampling factor */
+                                      mc_ptr->nchan     /* In : number of channels */
+      );
+  else                          /* call down-sampling procedure */
+    return fir_mc_downsampling_kernel ( /* returns number of output frames */
+                                        lseg,   /* In : number of input frames */
+                                        x_ptr,  /* In : interleaved input samples */
+                                        y_ptr,  /* Out : interleaved output samples */
+                                        fir_ptr->lenh0, /* In : number of FIR-coefficients */
+                                        fir_ptr->hp,    /* In : time-reversed FIR-coefficients */
+                                        mc_ptr->T,      /* InOut: state variables */
+                                        fir_ptr->dwn_up,        /* In : downsampling factor */
+                                        &(fir_ptr->k0), /* InOut: starting index in x-array */
+                                        mc_ptr->nchan   /* In : number of channels */
+      );
+}
+
+/* ......................... End of hq_mc_kernel() ......................... */
+
+
+/*
+  ============================================================================
+
+        void hq_mc_reset (SCD_FIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Clear the delay lines of all channels of a SCD_FIR_MC struct.
+
+        Parameters:
+        ~~~~~~~~~~~
+        mc_ptr: (InOut) pointer to struct SCD_FIR_MC;
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_mc_reset (SCD_FIR_MC * mc_ptr) {
+  long k;
+  for (k = 0; k < mc_ptr->fir->lenT * mc_ptr->nchan; k++)
+    mc_ptr->T[k] = 0.0;
+  mc_ptr->fir->k0 = 0;
+}
+
+/* ......................... End of hq_mc_reset() ......................... */
+
+
+/*
+  ============================================================================
+
+        void hq_mc_free (SCD_FIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Deallocate a SCD_FIR_MC struct, including the SCD_FIR struct
+        it was built from.
+
+        Parameters:
+        ~~~~~~~~~~~
+        mc_ptr: (InOut) pointer to struct SCD_FIR_MC;
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_mc_free (SCD_FIR_MC * mc_ptr) {
+  hq_free (mc_ptr->fir);        /* free coefficients */
+  free (mc_ptr->T);             /* free delay lines */
+  free (mc_ptr);                /* free allocated struct */
+}
+
+/* ......................... End of hq_mc_free() ......................... */
+
+
 
 /*
   ============================================================================
@@ -283,13 +650,20 @@ void hq_reset (SCD_FIR * fir_ptr) {
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Mar.92 v1.1 Corrected casting of malloc.
+        16.Oct.26 v1.2 Polyphase coefficient sets for up-sampling and
+                       delay line with room for FIR_BLOCK input samples.
+        16.Oct.26 v1.3 Coefficient sets stored time-reversed, for all
+                       filter types; scalar dot-product selected.
+        16.Oct.26 v1.4 FFT engine attached to filters without rate change
+                       and at least FIR_FFT_MIN_TAPS coefficients.
+        16.Oct.26 v1.5 FFT engine only attached by hq_fft_engine().
 
  ============================================================================
 */
 SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, int hswitch) {
   SCD_FIR *ptrFIR;              /* pointer to the new struct */
   float fak;
-  long k;
+  long k, iup, lenhp, lenT;
 
 
 /*
@@ -301,8 +675,12 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
     return 0;
   }
 
-  /* Allocate memory for delay line */
-  if ((ptrFIR->T = (float *) malloc ((lenh0 - 1) * sizeof (fak))) == (float *) 0) {
+  /* Length of each polyphase component and of the delay line; for down-sampling (and 1:1) there is a single "phase" with all coefficients */
+  lenhp = (hswitch == 'U') ? lenh0 / idwnup : lenh0;
+  lenT = lenhp - 1;
+
+  /* Allocate memory for delay line: past samples + one block of input */
+  if ((ptrFIR->T = (float *) malloc ((lenT + FIR_BLOCK) * sizeof (fak))) == (float *) 0) {
     free (ptrFIR);              /* deallocate struct FIR */
     return 0;
   }
@@ -314,6 +692,14 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
     return 0;
   }
 
+  /* Allocate memory for (time-reversed) polyphase coefficient sets */
+  if ((ptrFIR->hp = (float *) malloc ((hswitch == 'U' ? idwnup : 1) * lenhp * sizeof (fak))) == (float *) 0) {
+    free (ptrFIR->h0);          /* deallocate impulse response */
+    free (ptrFIR->T);           /* deallocate delay line */
+    free (ptrFIR);              /* deallocate struct FIR */
+    return 0;
+  }
+
 /*
  * ......... STORE VARIABLES INTO STATE VARIABLE .........
  */
@@ -325,6 +711,22 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   for (k = 0; k <= ptrFIR->lenh0 - 1; k++)
     ptrFIR->h0[k] = gain * h0[k];
 
+  /* Split coefficients into polyphase sets (phase iup gets h0[iup], h0[iup+idwnup], h0[iup+2*idwnup], ...), each one time-reversed so that dot-products run forward over the delay line; for down-sampling there is one set with all coefficients */
+  ptrFIR->lenhp = lenhp;
+  if (hswitch == 'U')
+    for (iup = 0; iup < idwnup; iup++)
+      for (k = 0; k < lenhp; k++)
+        ptrFIR->hp[iup * lenhp + lenhp - 1 - k] = ptrFIR->h0[iup + k * idwnup];
+  else
+    for (k = 0; k < lenhp; k++)
+      ptrFIR->hp[lenhp - 1 - k] = ptrFIR->h0[k];
+
+  /* Bit-exact reference dot-product unless changed by hq_select_kernel() */
+  hq_select_kernel (ptrFIR, FIR_KERNEL_SCALAR);
+
+  /* Time-domain filtering unless changed by hq_fft_engine() */
+  ptrFIR->fft = (FIR_FFT *) NULL;
+
   /* Store down-/up-sampling factor */
   ptrFIR->dwn_up = idwnup;
 
@@ -332,7 +734,8 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   ptrFIR->hswitch = hswitch;
 
   /* Clear Delay Line */
-  for (k = 0; k < ptrFIR->lenh0 - 1; k++)
+  ptrFIR->lenT = lenT;
+  for (k = 0; k < ptrFIR->lenT; k++)
     ptrFIR->T[k] = 0.0;
 
   /* Store default starting index for the x-array */
@@ -346,6 +749,49 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
 /* ..................... End of fir_initialization() ..................... */
 
 
+/*
+  ============================================================================
+
+        float fir_dot_scalar (float *x, float *h, long n);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Dot-product of x[0..n-1] with the time-reversed coefficients
+        h[0..n-1]. The products are summed from the newest sample x[n-1]
+        backwards, which is the summation order of the original kernels.
+
+        Parameters:
+        ~~~~~~~~~~~
+        x: ....... (In)    oldest of n consecutive samples
+        h: ....... (In)    time-reversed FIR-coefficients
+        n: ....... (In)    number of coefficients
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The dot-product.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static float fir_dot_scalar (float *x, float *h, long n) {
+  float y;
+  long k;
+
+  y = x[n - 1] * h[n - 1];
+  for (k = n - 2; k >= 0; k--)
+    y += x[k] * h[k];
+
+  return y;
+}
+
+/* ...................... End of fir_dot_scalar() ...................... */
+
+
 /*
   ============================================================================
 
@@ -357,7 +803,9 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
         ~~~~~~~~~~~~
 
         FIR-Filter (kernel) (for down-sampling, including downsampling
-        factor 1).
+        factor 1). The input is processed in passes of at most FIR_BLOCK
+        samples, each appended to the past samples in the delay line, so
+        that every dot-product reads from one contiguous array.
 
         Parameters:
         ~~~~~~~~~~~
@@ -365,10 +813,12 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
         x: ........ (In)    array with input samples
         y: ........ (Out)   array with output samples
         lenh0: .... (In)    number of  FIR-coefficients
-        h0: ....... (In)    array with FIR-coefficients
-        T: ........ (InOut) state variables
+        h0: ....... (In)    array with time-reversed FIR-coefficients
+        T: ........ (InOut) delay line, lenh0-1 past samples plus room for
+                            FIR_BLOCK input samples
         downfac: .. (In)    downsampling factor
         k0: ....... (InOut) offset in x-array
+        dot: ...... (In)    dot-product function
 
         Return value:
         ~~~~~~~~~~~~~
@@ -382,79 +832,35 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
         28.Feb.1992 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Jul.2000 -    Bug identified; correction solicited  <simao>
 		03.Dec.2004 v2.3 Sample-based bug solved. <Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+        16.Oct.2026 v2.4 Contiguous delay line; no more transition loop.
+        16.Oct.2026 v2.5 Dot-product through function pointer.
 
  ============================================================================
 */
-static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0) {
-  long ktrans, kx, kStart, ky, kappa;   /* loop indices */
+static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0, float (*dot) (float *, float *, long)) {
+  long lenT = lenh0 - 1;        /* number of past samples in T */
+  long lblk, kx, ky;            /* block length and loop indices */
 
-
-/*
-  * ......... First Step: Transition from k=0 ... k=lenh0-2 .........
-  */
-
-  kStart = *k0;
   ky = 0;                       /* starting index in output array (y) */
-  ktrans = lenh0 - 1;
-  if (ktrans > lenx - 1)
-    ktrans = lenx - 1;          /* x[*] less than h0[*]? */
-
-  for (kx = *k0; kx <= ktrans; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= kx; kappa++) {     /* first part from x-array */
-      y[ky] += x[kx - kappa] * h0[kappa];
-    }
-
-    for (kappa = kx + 1; kappa < lenh0; kappa++) {      /* second part from * T-array */
-      y[ky] += T[lenh0 - 2 + kx + 1 - kappa] * h0[kappa];
-    }
-    ky++;
-    kStart = kx;                /* Save index of last processed sample */
-  }
 
+  while (lenx > 0) {
+    lblk = (lenx > FIR_BLOCK) ? FIR_BLOCK : lenx;
 
-/*
-  * ......... Second Step: remaining part in x-array .........
-  */
-
-  *k0 = kStart;
-  for (kx = kStart + downfac; kx <= lenx - 1; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= lenh0 - 1; kappa++) {
-      y[ky] += x[kx - kappa] * h0[kappa];       /* remaining part of dot-product */
-    }
-    ky++;
-    *k0 = kx;
-  }
+    /* Append the input block to the past samples */
+    memcpy (&T[lenT], x, lblk * sizeof (float));
 
-  /* if the number of input samples is not a multiple of the down sampling factor, k0 points to the first sample in the next input segment to be processed */
-  if (*k0 <= lenx - 1) {
-    *k0 = *k0 + downfac;
-    *k0 = *k0 - lenx;
-  } else {                      /* if the offset was greater than the block length, nothing was done. * Just decrease the value of this offset with the size of this "skipped" block */
-    *k0 = *k0 - lenx;
-  }
+    /* Dot-products for every downfac-th sample, starting at offset k0 */
+    for (kx = *k0; kx < lblk; kx += downfac)
+      y[ky++] = dot (&T[kx], h0, lenh0);        /* T[kx..kx+lenh0-1] */
 
+    /* k0 points to the first sample in the next block to be processed (if the block length is not a multiple of the down sampling factor, or the offset was greater than the block length) */
+    *k0 = kx - lblk;
 
-/*
- * ......... Last Step: copy end of x-array into T-array .........
- *                      (update of delay line)
- */
+    /* Update of delay line: keep the last lenh0-1 samples */
+    memmove (T, &T[lblk], lenT * sizeof (float));
 
-  if (lenx >= lenh0 - 1) {      /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 + kappa];
-    }
-  } else {
-    /* Left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
-
-    /* Copy complete x-array -> T-array */
-    for (kappa = lenh0 - 1 - lenx; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 - 2)];
-    }
+    x += lblk;
+    lenx -= lblk;
   }
 
   /* Return number of output samples */
@@ -469,23 +875,30 @@ static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0,
   ============================================================================
 
         long fir_upsampling_kernel (long lenx, float *x_ptr, float *y_ptr,
-        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0_ptr, float *T_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenhp, float *hp_ptr, float *T_ptr,
                                     long iupfac);
 
         Description:
         ~~~~~~~~~~~~
 
-        FIR-Filter (kernel) for upsampling routine.
+        FIR-Filter (kernel) for upsampling routine. The coefficients are
+        stored as iupfac polyphase sets, so that each output sample is the
+        dot-product of one set with the input samples, skipping the zeros
+        that would be stuffed between them. The input is processed as in
+        fir_downsampling_kernel(), in passes of at most FIR_BLOCK samples.
 
         Parameters:
         ~~~~~~~~~~~
         lenx: .... (In)    length of input signal
         x: ....... (In)    array with input samples
         y: ....... (Out)   array with output samples
-        lenh0: ... (In)    number of  FIR-coefficients
-        h0: ...... (In)    array with FIR-coefficients
-        T: ....... (InOut) state variables
+        lenhp: ... (In)    number of  FIR-coefficients per phase
+        hp: ...... (In)    array with iupfac sets of lenhp time-reversed
+                           coefficients
+        T: ....... (InOut) delay line, lenhp-1 past samples plus room for
+                           FIR_BLOCK input samples
         iupfac: .. (In)    upsampling factor
+        dot: ..... (In)    dot-product function
 
         Return value:
         ~~~~~~~~~~~~~
@@ -497,95 +910,184 @@ static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0,
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v2.4 Polyphase coefficient sets and contiguous delay line.
+        16.Oct.26 v2.5 Dot-product through function pointer.
 
  ============================================================================
 */
-static long fir_upsampling_kernel (lenx, x, y, lenh0, h0, T, iupfac)
-     long lenx;
-     float *x, *y;
-     long lenh0;
-     float *h0, *T;
-     long iupfac;
-{
-  long ktrans, iup, kx, kStart, ky, kappa;      /* loop indices */
-
+static long fir_upsampling_kernel (long lenx, float *x, float *y, long lenhp, float *hp, float *T, long iupfac, float (*dot) (float *, float *, long)) {
+  long lenT = lenhp - 1;        /* number of past samples in T */
+  long lblk, iup, kx, ky;       /* block length and loop indices */
+  float *p;                     /* current polyphase component */
 
   ky = 0;                       /* starting index in output array (y) */
 
-/*
-  * ......... FIRST STEP: Transition from k=(0..lenh0/iupasm-2) .........
-  */
-
-  kStart = 0;
-  ktrans = (lenh0 / iupfac > lenx ?     /* length of transition */
-            lenx : lenh0 / iupfac);
-  for (kx = 0; kx <= ktrans - 1; kx++) {
-    /* Loop over #iupfac partial FIR coefficients */
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
-
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= kx; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
-      }
-
-      /* ... compute rest of dot-product with source data from T-array */
-      for (kappa = kx + 1; kappa < lenh0 / iupfac; kappa++) {
-        y[ky] += T[lenh0 / iupfac - 2 + kx + 1 - kappa]
-          * h0[iup + kappa * iupfac];
-      }
-      ky++;
-    }
-    kStart = kx;                /* Save index of last processed sample */
+  while (lenx > 0) {
+    lblk = (lenx > FIR_BLOCK) ? FIR_BLOCK : lenx;
+
+    /* Append the input block to the past samples */
+    memcpy (&T[lenT], x, lblk * sizeof (float));
+
+    /* Loop over #iupfac polyphase components for each input sample */
+    for (kx = 0; kx < lblk; kx++)
+      for (iup = 0, p = hp; iup < iupfac; iup++, p += lenhp)
+        y[ky++] = dot (&T[kx], p, lenhp);       /* T[kx..kx+lenhp-1] */
+
+    /* Update of delay line: keep the last lenhp-1 samples */
+    memmove (T, &T[lblk], lenT * sizeof (float));
+
+    x += lblk;
+    lenx -= lblk;
   }
 
+  return ky;
+}
+
+/* ................. End of fir_upsampling_kernel() .................. */
+
 
 /*
- * ......... SECOND STEP: compute remaining dot-products ..........
- *                        completely with data from x[*]
- */
+  ============================================================================
+
+        void fir_mc_dot (float *T, float *h, long n, long nchan, float *y);
+        ~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Dot-products of n consecutive interleaved frames T[] with the
+        time-reversed coefficients h[0..n-1], one per channel. For each
+        channel the products are summed in the order of fir_dot_scalar().
+
+        Parameters:
+        ~~~~~~~~~~~
+        T: ....... (In)    oldest of n consecutive frames
+        h: ....... (In)    time-reversed FIR-coefficients
+        n: ....... (In)    number of coefficients
+        nchan: ... (In)    number of channels
+        y: ....... (Out)   one output frame
 
-  for (kx = kStart + 1; kx <= lenx - 1; kx++) {
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
-
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= lenh0 / iupfac - 1; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
-      }
-      ky++;
-    }
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static void fir_mc_dot (float *T, float *h, long n, long nchan, float *y) {
+  float *t = &T[(n - 1) * nchan];       /* newest frame */
+  long k, ch;
+
+  for (ch = 0; ch < nchan; ch++)
+    y[ch] = t[ch] * h[n - 1];
+  for (k = n - 2; k >= 0; k--) {
+    t -= nchan;
+    for (ch = 0; ch < nchan; ch++)
+      y[ch] += t[ch] * h[k];
   }
+}
+
+/* ......................... End of fir_mc_dot() ......................... */
 
 
 /*
- * ......... Last Step: copy end of x-array into T-array .........
- *                        (update of delay line)
- */
+  ============================================================================
+
+        long fir_mc_downsampling_kernel (long lenx, float *x, float *y,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0, float *T,
+                                         long downfac, long *k0,
+                                         long nchan);
+
+        long fir_mc_upsampling_kernel (long lenx, float *x, float *y,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenhp, float *hp, float *T,
+                                       long iupfac, long nchan);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multichannel versions of fir_downsampling_kernel() and
+        fir_upsampling_kernel(): lengths and indices count frames of
+        nchan interleaved samples, and the delay line T holds interleaved
+        frames.
+
+        Parameters:
+        ~~~~~~~~~~~
+        As for fir_downsampling_kernel() and fir_upsampling_kernel(),
+        plus
+        nchan: .... (In)    number of channels
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of filtered frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long fir_mc_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0, long nchan) {
+  long lenT = lenh0 - 1;        /* number of past frames in T */
+  long lblk, kx, ky;            /* block length and loop indices */
+
+  ky = 0;                       /* starting index in output array (y) */
+
+  while (lenx > 0) {
+    lblk = (lenx > FIR_BLOCK) ? FIR_BLOCK : lenx;
+
+    /* Append the input block to the past frames */
+    memcpy (&T[lenT * nchan], x, lblk * nchan * sizeof (float));
 
-  if (lenx >= lenh0 / iupfac - 1) {
-    /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 / iupfac + kappa];
-    }
-  } else {
-    /* ... left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
-
-    /* ... copy complete x-array -> T-array */
-    for (kappa = lenh0 / iupfac - 1 - lenx; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 / iupfac - 2)];
-    }
+    /* Dot-products for every downfac-th frame, starting at offset k0 */
+    for (kx = *k0; kx < lblk; kx += downfac)
+      fir_mc_dot (&T[kx * nchan], h0, lenh0, nchan, &y[nchan * ky++]);
+
+    /* Offset of the first frame to be processed in the next block */
+    *k0 = kx - lblk;
+
+    /* Update of delay lines: keep the last lenh0-1 frames */
+    memmove (T, &T[lblk * nchan], lenT * nchan * sizeof (float));
+
+    x += lblk * nchan;
+    lenx -= lblk;
   }
 
   return ky;
 }
 
-/* ................. End of fir_upsampling_kernel() .................. */
+
+static long fir_mc_upsampling_kernel (long lenx, float *x, float *y, long lenhp, float *hp, float *T, long iupfac, long nchan) {
+  long lenT = lenhp - 1;        /* number of past frames in T */
+  long lblk, iup, kx, ky;       /* block length and loop indices */
+  float *p;                     /* current polyphase component */
+
+  ky = 0;                       /* starting index in output array (y) */
+
+  while (lenx > 0) {
+    lblk = (lenx > FIR_BLOCK) ? FIR_BLOCK : lenx;
+
+    /* Append the input block to the past frames */
+    memcpy (&T[lenT * nchan], x, lblk * nchan * sizeof (float));
+
+    /* Loop over #iupfac polyphase components for each input frame */
+    for (kx = 0; kx < lblk; kx++)
+      for (iup = 0, p = hp; iup < iupfac; iup++, p += lenhp)
+        fir_mc_dot (&T[kx * nchan], p, lenhp, nchan, &y[nchan * ky++]);
+
+    /* Update of delay lines: keep the last lenhp-1 frames */
+    memmove (T, &T[lblk * nchan], lenT * nchan * sizeof (float));
+
+    x += lblk * nchan;
+    lenx -= lblk;
+  }
+
+  return ky;
+}
+
+/* ........... End of fir_mc_downsampling/upsampling_kernel() ........... */
 
 
 /* **************************** END OF FIR-LIB.C ************************** */
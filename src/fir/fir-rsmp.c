@@ -0,0 +1,515 @@
+/*                                                          v1.0 - 16/Oct/2026
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Rational sampling rate conversion
+
+DESCRIPTION:
+        This file contains a sampling rate converter by a rational factor
+        up/down, built as a cascade of the high quality factor-2 and
+        factor-3 filters of fir-flat.c (hq_up_1_to_2_init(),
+        hq_down_3_to_1_init(), etc.). The cascade runs in one call, with
+        the intermediate signals kept in memory (in float, so that the
+        result differs by at most 1 LSB from running the stages one after
+        the other through 16-bit intermediate files with the filter
+        program; single-stage conversions are bit-exact with it).
+
+        Therefore, after reduction of the ratio fs_out/fs_in to up/down,
+        both up and down must be products of the factors 2 and 3 (e.g.
+        48k->16k, 32k->8k, 32k->48k, 8k->48k); other ratios, e.g.
+        44.1k<->48k, need prime factors for which there is no filter in
+        this module, and are rejected.
+
+        The order of the stages is chosen by hq_rsmp_plan(): among all
+        orderings of the needed stages, those where an intermediate rate
+        falls below both the input and the output rate are discarded,
+        since the bandwidth lost there would not be recovered; of the
+        others, the one with the least multiply-adds per input sample is
+        used. For example, 32k->48k is done as 1:3 followed by 2:1 (not
+        2:1 first, which would limit the band to 8 kHz), and 48k->8k as
+        3:1 followed by 2:1, since the 2:1 stage then runs at 16k.
+
+FUNCTIONS:
+  Global (have prototype in firflt.h)
+         = hq_rsmp_plan(...)     : stages for a rate conversion
+         = hq_rsmp_init(...)     : allocate and initialize a converter
+         = hq_rsmp_kernel(...)   : convert a segment of samples
+         = hq_rsmp_maxout(...)   : output buffer size needed
+         = hq_rsmp_reset(...)    : clear state variables
+         = hq_rsmp_free(...)     : deallocate converter memory
+  Local (should be used only here -- prototypes only in this file)
+         = fir_rsmp_stage_init(...) : initialize the filter of a stage
+         = fir_rsmp_search(...)  : recursive search of the stage order
+
+HISTORY:
+    16.Oct.26 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy() */
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+static SCD_FIR *fir_rsmp_stage_init ARGS ((long stage));
+static void fir_rsmp_search ARGS ((long *left, long depth, double rate, double cost, double min_rate, double *stage_cost, long *cur, long *best, double *best_cost));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        SCD_FIR *fir_rsmp_stage_init (long stage);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Initialize the high quality filter for a stage code: +2 and +3
+        for up-sampling by 2 and 3, -2 and -3 for down-sampling.
+
+        Parameters:
+        ~~~~~~~~~~~
+        stage: .... (In) stage code
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to a SCD_FIR structure, NULL if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static SCD_FIR *fir_rsmp_stage_init (long stage) {
+  switch (stage) {
+  case 2:
+    return hq_up_1_to_2_init ();
+  case 3:
+    return hq_up_1_to_3_init ();
+  case -2:
+    return hq_down_2_to_1_init ();
+  default:
+    return hq_down_3_to_1_init ();
+  }
+}
+
+/* ..................... End of fir_rsmp_stage_init() ..................... */
+
+
+/*
+  ============================================================================
+
+        void fir_rsmp_search (long *left, long depth, double rate,
+        ~~~~~~~~~~~~~~~~~~~~  double cost, double min_rate,
+                              double *stage_cost, long *cur, long *best,
+                              double *best_cost);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Depth-first search over the orderings of the remaining stages.
+        left[] holds the number of stages still to be placed, indexed
+        as stage_cost[]: up by 2, up by 3, down by 2, down by 3.
+
+        Parameters:
+        ~~~~~~~~~~~
+        left: ........ (InOut) stages still to be placed
+        depth: ....... (In)    number of stages placed in cur[]
+        rate: ........ (In)    current rate, relative to the input rate
+        cost: ........ (In)    multiply-adds per input sample so far
+        min_rate: .... (In)    lowest acceptable intermediate rate
+        stage_cost: .. (In)    multiply-adds per stage input sample
+        cur: ......... (InOut) stage codes being tried
+        best: ........ (Out)   best ordering found
+        best_cost: ... (InOut) its cost (negative if none found yet)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static void fir_rsmp_search (long *left, long depth, double rate, double cost, double min_rate, double *stage_cost, long *cur, long *best, double *best_cost) {
+  static long code[4] = { 2, 3, -2, -3 };
+  long i, k, more = 0;
+  double next;
+
+  for (i = 0; i < 4; i++) {
+    if (left[i] == 0)
+      continue;
+    more = 1;
+
+    /* Rate after this stage; skip orderings that lose bandwidth */
+    next = (code[i] > 0) ? rate * code[i] : rate / -code[i];
+    left[i]--;
+    if (next > min_rate * (1 - 1e-9) || left[0] + left[1] + left[2] + left[3] == 0) {
+      cur[depth] = code[i];
+      fir_rsmp_search (left, depth + 1, next, cost + rate * stage_cost[i], min_rate, stage_cost, cur, best, best_cost);
+    }
+    left[i]++;
+  }
+
+  /* All stages placed: keep the cheapest ordering */
+  if (!more && (*best_cost < 0 || cost < *best_cost)) {
+    *best_cost = cost;
+    for (k = 0; k < depth; k++)
+      best[k] = cur[k];
+  }
+}
+
+/* ....................... End of fir_rsmp_search() ....................... */
+
+
+/*
+  ============================================================================
+
+        long hq_rsmp_plan (long fs_in, long fs_out, long *stages);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Find the cascade of high quality factor-2/3 filters that converts
+        from fs_in to fs_out (see the description of this file for the
+        criteria). Stage codes are +2 and +3 for up-sampling by 2 and 3,
+        -2 and -3 for down-sampling.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fs_in: ...... (In)  input sampling rate
+        fs_out: ..... (In)  output sampling rate
+        stages: ..... (Out) array of FIR_RSMP_MAXSTAGES stage codes
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The number of stages (0 if fs_in equals fs_out), or -1 if the
+        conversion is not possible with factors 2 and 3, or needs more
+        than FIR_RSMP_MAXSTAGES stages.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_rsmp_plan (long fs_in, long fs_out, long *stages) {
+  static long code[4] = { 2, 3, -2, -3 }, factor[4] = { 2, 3, 2, 3 };
+  long up, down, a, b, i, n, left[4], cur[FIR_RSMP_MAXSTAGES];
+  double stage_cost[4], best_cost = -1;
+  SCD_FIR *fir;
+
+  if (fs_in <= 0 || fs_out <= 0)
+    return -1;
+
+  /* Reduce fs_out/fs_in to up/down */
+  for (a = fs_in, b = fs_out; b != 0;) {
+    n = a % b;
+    a = b;
+    b = n;
+  }
+  up = fs_out / a;
+  down = fs_in / a;
+
+  /* Count the factors 2 and 3 of up and down; nothing else may be left */
+  for (i = 0; i < 4; i++)
+    for (left[i] = 0; (i < 2 ? up : down) % factor[i] == 0; left[i]++)
+      if (i < 2)
+        up /= factor[i];
+      else
+        down /= factor[i];
+  n = left[0] + left[1] + left[2] + left[3];
+  if (up != 1 || down != 1 || n > FIR_RSMP_MAXSTAGES)
+    return -1;
+
+  /* Multiply-adds per input sample of each stage: all taps for up-sampling (one polyphase set per output), 1/factor of them for down-sampling */
+  for (i = 0; i < 4; i++) {
+    stage_cost[i] = 0;
+    if (left[i] > 0) {
+      if ((fir = fir_rsmp_stage_init (code[i])) == (SCD_FIR *) NULL)
+        return -1;
+      stage_cost[i] = (code[i] > 0) ? (double) fir->lenh0 : fir->lenh0 / (double) -code[i];
+      hq_free (fir);
+    }
+  }
+
+  /* Search for the cheapest ordering that keeps the bandwidth */
+  fir_rsmp_search (left, 0, 1.0, 0.0, (fs_out < fs_in) ? fs_out / (double) fs_in : 1.0, stage_cost, cur, stages, &best_cost);
+
+  return n;
+}
+
+/* ......................... End of hq_rsmp_plan() ......................... */
+
+
+/*
+  ============================================================================
+
+        FIR_RESAMPLER *hq_rsmp_init (long fs_in, long fs_out, long nchan);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate and initialize a converter from fs_in to fs_out for
+        signals of nchan interleaved channels. Mono converters use
+        hq_kernel(), so the stages may be switched to the SIMD kernels
+        with hq_select_kernel(stage[i], ...); for more channels the
+        stages are SCD_FIR_MC filters.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fs_in: ...... (In) input sampling rate
+        fs_out: ..... (In) output sampling rate
+        nchan: ...... (In) number of interleaved channels
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to a FIR_RESAMPLER structure, NULL if the conversion is
+        not possible (see hq_rsmp_plan()) or if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_RESAMPLER *hq_rsmp_init (long fs_in, long fs_out, long nchan) {
+  FIR_RESAMPLER *ptrRS;         /* pointer to the new struct */
+  long stages[FIR_RSMP_MAXSTAGES];
+  long i, n, len;
+
+  if ((n = hq_rsmp_plan (fs_in, fs_out, stages)) < 0 || nchan < 1)
+    return 0;
+
+  /* Allocate memory for a new struct, with all pointers NULL */
+  if ((ptrRS = (FIR_RESAMPLER *) calloc (1, sizeof (FIR_RESAMPLER))) == (FIR_RESAMPLER *) NULL)
+    return 0;
+  ptrRS->nchan = nchan;
+  ptrRS->nstages = n;
+
+  /* Stage filters, and buffers for the output of all but the last stage, sized for one pass of FIR_BLOCK input frames */
+  for (i = 0, len = FIR_BLOCK; i < n; i++) {
+    ptrRS->code[i] = stages[i];
+    len = (stages[i] > 0) ? len * stages[i] : (len - stages[i] - 1) / -stages[i];
+
+    if ((ptrRS->stage[i] = fir_rsmp_stage_init (stages[i])) == (SCD_FIR *) NULL) {
+      hq_rsmp_free (ptrRS);
+      return 0;
+    }
+    if (nchan > 1 && (ptrRS->mc[i] = hq_mc_init (ptrRS->stage[i], nchan)) == (SCD_FIR_MC *) NULL) {
+      hq_rsmp_free (ptrRS);
+      return 0;
+    }
+    if (i < n - 1 && (ptrRS->buf[i] = (float *) malloc (len * nchan * sizeof (float))) == (float *) NULL) {
+      hq_rsmp_free (ptrRS);
+      return 0;
+    }
+  }
+
+  return (ptrRS);
+}
+
+/* ......................... End of hq_rsmp_init() ......................... */
+
+
+/*
+  ============================================================================
+
+        long hq_rsmp_kernel (long lseg, float *x_ptr, FIR_RESAMPLER *rs_ptr,
+        ~~~~~~~~~~~~~~~~~~~  float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Convert lseg input frames (nchan interleaved samples each). The
+        input is processed in passes of at most FIR_BLOCK frames, each
+        going through all the stages. The output array must have room
+        for hq_rsmp_maxout(rs_ptr, lseg) frames.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: .... (In)    number of input frames
+        x_ptr: ... (In)    array with input samples
+        rs_ptr ... (InOut) pointer to FIR_RESAMPLER struct
+        y_ptr .... (Out)   output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_rsmp_kernel (long lseg, float *x_ptr, FIR_RESAMPLER * rs_ptr, float *y_ptr) {
+  long nchan = rs_ptr->nchan;
+  long lblk, i, n, total = 0;
+  float *in, *out;
+
+  /* Nothing to do for equal rates */
+  if (rs_ptr->nstages == 0) {
+    memcpy (y_ptr, x_ptr, lseg * nchan * sizeof (float));
+    return lseg;
+  }
+
+  while (lseg > 0) {
+    lblk = (lseg > FIR_BLOCK) ? FIR_BLOCK : lseg;
+
+    /* Run the block through the cascade; the last stage writes the output */
+    for (i = 0, in = x_ptr, n = lblk; i < rs_ptr->nstages; i++, in = out) {
+      out = (i == rs_ptr->nstages - 1) ? &y_ptr[total * nchan] : rs_ptr->buf[i];
+      n = (nchan > 1) ? hq_mc_kernel (n, in, rs_ptr->mc[i], out)
+        : hq_kernel (n, in, rs_ptr->stage[i], out);
+    }
+
+    total += n;
+    x_ptr += lblk * nchan;
+    lseg -= lblk;
+  }
+
+  return total;
+}
+
+/* ........................ End of hq_rsmp_kernel() ........................ */
+
+
+/*
+  ============================================================================
+
+        long hq_rsmp_maxout (FIR_RESAMPLER *rs_ptr, long lseg);
+        ~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Upper bound of the number of frames output by hq_rsmp_kernel()
+        for lseg input frames (about lseg*fs_out/fs_in; down-sampling
+        stages may output one frame more or less per pass, depending on
+        their offset).
+
+        Parameters:
+        ~~~~~~~~~~~
+        rs_ptr ... (In)    pointer to FIR_RESAMPLER struct
+        lseg: .... (In)    number of input frames
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Maximum number of output frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_rsmp_maxout (FIR_RESAMPLER * rs_ptr, long lseg) {
+  long lblk, i, n, total = 0;
+
+  for (; lseg > 0; lseg -= lblk) {
+    lblk = (lseg > FIR_BLOCK) ? FIR_BLOCK : lseg;
+    for (i = 0, n = lblk; i < rs_ptr->nstages; i++)
+      n = (rs_ptr->code[i] > 0) ? n * rs_ptr->code[i] : (n - rs_ptr->code[i] - 1) / -rs_ptr->code[i];
+    total += n;
+  }
+
+  return total;
+}
+
+/* ........................ End of hq_rsmp_maxout() ........................ */
+
+
+/*
+  ============================================================================
+
+        void hq_rsmp_reset (FIR_RESAMPLER *rs_ptr);
+        ~~~~~~~~~~~~~~~~~~
+        void hq_rsmp_free (FIR_RESAMPLER *rs_ptr);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Clear the state variables of all stages, or deallocate the
+        converter.
+
+        Parameters:
+        ~~~~~~~~~~~
+        rs_ptr ... (InOut) pointer to FIR_RESAMPLER struct
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_rsmp_reset (FIR_RESAMPLER * rs_ptr) {
+  long i;
+
+  for (i = 0; i < rs_ptr->nstages; i++)
+    if (rs_ptr->nchan > 1)
+      hq_mc_reset (rs_ptr->mc[i]);
+    else
+      hq_reset (rs_ptr->stage[i]);
+}
+
+
+void hq_rsmp_free (FIR_RESAMPLER * rs_ptr) {
+  long i;
+
+  for (i = 0; i < rs_ptr->nstages; i++) {
+    if (rs_ptr->mc[i] != (SCD_FIR_MC *) NULL)
+      hq_mc_free (rs_ptr->mc[i]);       /* also frees stage[i] */
+    else if (rs_ptr->stage[i] != (SCD_FIR *) NULL)
+      hq_free (rs_ptr->stage[i]);
+    free (rs_ptr->buf[i]);
+  }
+  free (rs_ptr);
+}
+
+/* ............... End of hq_rsmp_reset() / hq_rsmp_free() ............... */
+
+
+/* **************************** END OF FIR-RSMP.C ************************** */
@@ -0,0 +1,260 @@
+/*                                                          v1.0 - 16/Oct/2026
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: SIMD dot-products for the FIR kernels
+
+DESCRIPTION:
+        This file contains x86 SIMD versions of the dot-product used by
+        fir_upsampling_kernel() and fir_downsampling_kernel() in fir-lib.c,
+        and the run-time check of the instruction sets supported by the
+        CPU (with ugst_cpu_supports() of ugst-cpu.c). Each function is
+        compiled for its own instruction set (UGST_TARGET), so the module
+        builds without special compiler flags and the choice is made at
+        run time by hq_select_kernel(). On other architectures, or compilers without
+        support, fir_simd_supported() returns 0 for all SIMD kernels and
+        the dot-product functions fall back to plain C.
+
+        The coefficients are time-reversed, so that both arrays are read
+        forward. The products are accumulated in several vector partial
+        sums, so the results differ from the scalar kernel by float
+        rounding only.
+
+FUNCTIONS:
+  Local (Used by fir-lib.c; prototypes in fir-lib.c, not in firflt.h)
+         = fir_simd_supported(...) : check CPU support for a FIR_KERNEL_xxx
+         = fir_dot_sse(...)      : SSE2 dot-product
+         = fir_dot_avx2(...)     : AVX2/FMA dot-product
+         = fir_dot_avx512(...)   : AVX-512F dot-product
+
+HISTORY:
+    16.Oct.26 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+#include "ugst-cpu.h"           /* UGST_SIMD_X86, UGST_TARGET, ugst_cpu_supports() */
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+int fir_simd_supported ARGS ((int kernel));
+float fir_dot_sse ARGS ((float *x, float *h, long n));
+float fir_dot_avx2 ARGS ((float *x, float *h, long n));
+float fir_dot_avx512 ARGS ((float *x, float *h, long n));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        int fir_simd_supported (int kernel);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Check whether the CPU (and the operating system, for the AVX
+        register state) supports the given FIR_KERNEL_xxx.
+
+        Parameters:
+        ~~~~~~~~~~~
+        kernel: .. (In) one of FIR_KERNEL_SSE, FIR_KERNEL_AVX2 or
+                        FIR_KERNEL_AVX512
+
+        Return value:
+        ~~~~~~~~~~~~~
+        1 if supported, 0 otherwise.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int fir_simd_supported (int kernel) {
+  switch (kernel) {
+  case FIR_KERNEL_SSE:
+    return ugst_cpu_supports (UGST_CPU_SSE2);
+  case FIR_KERNEL_AVX2:
+    return ugst_cpu_supports (UGST_CPU_AVX2) && ugst_cpu_supports (UGST_CPU_FMA);
+  case FIR_KERNEL_AVX512:
+    return ugst_cpu_supports (UGST_CPU_AVX512F);
+  }
+  return 0;
+}
+
+/* ..................... End of fir_simd_supported() ..................... */
+
+
+/*
+  ============================================================================
+
+        float fir_dot_sse (float *x, float *h, long n);
+        ~~~~~~~~~~~~~~~~~
+        float fir_dot_avx2 (float *x, float *h, long n);
+        ~~~~~~~~~~~~~~~~~~
+        float fir_dot_avx512 (float *x, float *h, long n);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Dot-product of x[0..n-1] with the time-reversed coefficients
+        h[0..n-1], using two vector accumulators of 4 (SSE2), 8 (AVX2) or
+        16 (AVX-512) floats. The remaining n modulo the vector width
+        products are added in plain C. None of the arrays needs to be
+        aligned.
+
+        Parameters:
+        ~~~~~~~~~~~
+        x: ....... (In)    oldest of n consecutive samples
+        h: ....... (In)    time-reversed FIR-coefficients
+        n: ....... (In)    number of coefficients
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The dot-product.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+#ifdef UGST_SIMD_X86
+
+UGST_TARGET ("sse2")
+float fir_dot_sse (float *x, float *h, long n) {
+  __m128 acc0 = _mm_setzero_ps (), acc1 = _mm_setzero_ps ();
+  float part[4], y;
+  long k = 0;
+
+  for (; k + 8 <= n; k += 8) {
+    acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (&x[k]), _mm_loadu_ps (&h[k])));
+    acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (&x[k + 4]), _mm_loadu_ps (&h[k + 4])));
+  }
+  if (k + 4 <= n) {
+    acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (&x[k]), _mm_loadu_ps (&h[k])));
+    k += 4;
+  }
+  _mm_storeu_ps (part, _mm_add_ps (acc0, acc1));
+
+  y = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; k < n; k++)
+    y += x[k] * h[k];
+
+  return y;
+}
+
+
+UGST_TARGET ("avx2,fma")
+float fir_dot_avx2 (float *x, float *h, long n) {
+  __m256 acc0 = _mm256_setzero_ps (), acc1 = _mm256_setzero_ps ();
+  __m128 sum;
+  float part[4], y;
+  long k = 0;
+
+  for (; k + 16 <= n; k += 16) {
+    acc0 = _mm256_fmadd_ps (_mm256_loadu_ps (&x[k]), _mm256_loadu_ps (&h[k]), acc0);
+    acc1 = _mm256_fmadd_ps (_mm256_loadu_ps (&x[k + 8]), _mm256_loadu_ps (&h[k + 8]), acc1);
+  }
+  if (k + 8 <= n) {
+    acc0 = _mm256_fmadd_ps (_mm256_loadu_ps (&x[k]), _mm256_loadu_ps (&h[k]), acc0);
+    k += 8;
+  }
+  acc0 = _mm256_add_ps (acc0, acc1);
+  sum = _mm_add_ps (_mm256_castps256_ps128 (acc0), _mm256_extractf128_ps (acc0, 1));
+  _mm_storeu_ps (part, sum);
+
+  y = (part[0] + part[1]) + (part[2] + part[3]);
+  for (; k < n; k++)
+    y += x[k] * h[k];
+
+  return y;
+}
+
+
+UGST_TARGET ("avx512f")
+float fir_dot_avx512 (float *x, float *h, long n) {
+  __m512 acc0 = _mm512_setzero_ps (), acc1 = _mm512_setzero_ps ();
+  __mmask16 tail;
+  long k = 0;
+
+  for (; k + 32 <= n; k += 32) {
+    acc0 = _mm512_fmadd_ps (_mm512_loadu_ps (&x[k]), _mm512_loadu_ps (&h[k]), acc0);
+    acc1 = _mm512_fmadd_ps (_mm512_loadu_ps (&x[k + 16]), _mm512_loadu_ps (&h[k + 16]), acc1);
+  }
+  if (k + 16 <= n) {
+    acc0 = _mm512_fmadd_ps (_mm512_loadu_ps (&x[k]), _mm512_loadu_ps (&h[k]), acc0);
+    k += 16;
+  }
+
+  /* Remaining products with masked loads */
+  if (k < n) {
+    tail = (__mmask16) ((1u << (n - k)) - 1);
+    acc1 = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (tail, &x[k]), _mm512_maskz_loadu_ps (tail, &h[k]), acc1);
+  }
+
+  return _mm512_reduce_add_ps (_mm512_add_ps (acc0, acc1));
+}
+
+#else /* No x86 SIMD: never selected, as fir_simd_supported() returns 0 */
+
+static float fir_dot_c (float *x, float *h, long n) {
+  float y = 0;
+  long k;
+
+  for (k = 0; k < n; k++)
+    y += x[k] * h[k];
+  return y;
+}
+
+float fir_dot_sse (float *x, float *h, long n) {
+  return fir_dot_c (x, h, n);
+}
+
+float fir_dot_avx2 (float *x, float *h, long n) {
+  return fir_dot_c (x, h, n);
+}
+
+float fir_dot_avx512 (float *x, float *h, long n) {
+  return fir_dot_c (x, h, n);
+}
+
+#endif /* UGST_SIMD_X86 */
+
+/* ................... End of fir_dot_sse/avx2/avx512() ................... */
+
+
+/* **************************** END OF FIR-SIMD.C ************************** */
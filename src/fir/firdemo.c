@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010 v2.5
+/*                                                            16.Oct.2026 v2.6
   ============================================================================
 
         FIRDEMO.C
@@ -77,6 +77,8 @@
         -ht ..... uses the half-tilt IRS (if IRS was selected)
         -lseg ... changes the segment (block) length (default:LSEG0=256)
         -q ...... quiet processing (no progress flag)
+        -exact .. bit-exact time-domain filtering of the long IRS and
+                  Delta-SM filters, instead of the FFT engine
 
 
         Compilation:
@@ -193,6 +195,7 @@
         06.Jul.99 v2.3 Inserted conditional compilation for CYGWIN and
                        MS Visual C compiler.
         02.Feb.10 v2.5 Modified maximum filename length (y.hiwasaki)
+        16.Oct.26 v2.6 Added option -fft.
   ============================================================================
 */
 
@@ -279,6 +282,7 @@ void display_usage () {
   printf ("               \"regular\" one. For 16 and 48kHz.\n");
   printf ("  -ht ........ uses the half-tilt for 16 kHz IRS, if IRS filtering is selected\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
+  printf ("  -fft ....... FFT engine for the long filters (not bit-exact)\n");
   printf ("  -lseg ...... changes the segment (block) length (default:%d)\n", LSEG0);
 
   /* Quit program */
@@ -350,7 +354,7 @@ int main (int argc, char *argv[]) {
   static long noverflows0 = 0, noverflows1 = 0, noverflows2 = 0, noverflows3 = 0, noverflows4 = 0, noverflows5 = 0;
   long nsam = 0;
   long k;
-  int quiet = 0, modified_irs = 0, half_tilt = 0;
+  int quiet = 0, modified_irs = 0, half_tilt = 0, fft = 0;
 
 
 /*
@@ -388,6 +392,13 @@ int main (int argc, char *argv[]) {
         /* Don't print progress indicator */
         quiet = 1;
 
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* FFT filtering, not bit-exact */
+        fft = 1;
+
         /* Move argv over the option to the next argument */
         argv++;
         argc--;
@@ -525,6 +536,14 @@ int main (int argc, char *argv[]) {
   } else
     delta_sm_ptr = NULL;
 
+  /* Only the filters without rate change may have an FFT engine */
+  if (fft) {
+    if (irs_ptr != NULL)
+      hq_fft_engine (irs_ptr);
+    if (delta_sm_ptr != NULL)
+      hq_fft_engine (delta_sm_ptr);
+  }
+
   /* First Upsampling Procedure */
   if (up_1 == 2) {
     /* get pointer to a struct which contains filter coefficients and cleared state variables for a upsampling factor of 2 */
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: FIRFLT.H                                           v.2.5 -  31.Dec.2008
+   File: FIRFLT.H                                           v.2.10 - 16.Oct.2026
   ============================================================================
 
 	    ITU-T STL HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
@@ -18,6 +18,14 @@
    15.May.07	v2.4+	Added protoype for the [20Hz-20kHz] filter 
 						and the 1.5kHz, 14kHz. 20kHz LP filters	<Ericsson>
    31.Dec.2008  v2.5    Added LP filters (12kHz) for fs=48kHz < huawei >
+   16.Oct.2026  v2.6    Added polyphase coefficient sets and contiguous
+                        delay line to SCD_FIR.
+   16.Oct.2026  v2.7    Added SIMD dot-product kernels and hq_select_kernel().
+   16.Oct.2026  v2.8    Added FFT (overlap-save) engine for long filters.
+   16.Oct.2026  v2.9    Added SCD_FIR_MC and hq_mc_xxx() for interleaved
+                        multichannel signals.
+   16.Oct.2026  v2.10   Added FIR_RESAMPLER and hq_rsmp_xxx() (fir-rsmp.c).
+   16.Oct.2026  v2.11   Added hq_fft_engine().
 
   ============================================================================
 */
@@ -35,6 +43,37 @@
 #endif
 #endif
 
+/* 
+ * ..... Number of input samples processed per pass of the FIR kernels .....
+ *       (input segments longer than this are processed in several passes)
+ */
+#define FIR_BLOCK 1024
+
+/* 
+ * ..... Dot-product implementations selectable with hq_select_kernel() .....
+ */
+#define FIR_KERNEL_AUTO   0     /* best one supported by the CPU */
+#define FIR_KERNEL_SCALAR 1     /* portable C, bit-exact reference */
+#define FIR_KERNEL_SSE    2     /* x86 SSE2, 4 floats per instruction */
+#define FIR_KERNEL_AVX2   3     /* x86 AVX2+FMA, 8 floats per instruction */
+#define FIR_KERNEL_AVX512 4     /* x86 AVX-512F, 16 floats per instruction */
+
+/* 
+ * ..... FFT (overlap-save) filtering of long 1:1 filters, see fir-fft.c .....
+ */
+#define FIR_FFT_MIN_TAPS 256    /* shorter filters are never FFT-filtered */
+#define FIR_FFT_MAXLOG2  20     /* largest FFT is 2^FIR_FFT_MAXLOG2 */
+
+typedef struct {
+  long lenh;                    /* number of FIR coefficients */
+  float *h;                     /* FIR coefficients (not owned) */
+  float *H[FIR_FFT_MAXLOG2 + 1];        /* spectra of h for FFT size 2^i,
+                                           computed on first use */
+  int *ip[FIR_FFT_MAXLOG2 + 1]; /* bit reversal tables for actrdft() */
+  float *w[FIR_FFT_MAXLOG2 + 1];        /* cos/sin tables for actrdft() */
+  float *X;                     /* work buffer for the largest FFT */
+} FIR_FFT;
+
 /* 
  * ..... State variable structure for FIR filtering ..... 
  */
@@ -45,10 +84,53 @@ typedef struct {
   long k0;                      /* start index in next segment */
   /* (needed in segmentwise filtering) */
   float *h0;                    /* pointer to array with FIR coeff.  */
-  float *T;                     /* pointer to delay line */
+  float *T;                     /* pointer to delay line; holds lenT past
+                                   samples followed by room for FIR_BLOCK
+                                   new ones */
   char hswitch;                 /* switch to FIR-kernel */
+  long lenT;                    /* number of past samples in delay line */
+  long lenhp;                   /* number of coefficients per phase */
+  float *hp;                    /* time-reversed polyphase coefficient sets,
+                                   phase after phase (a single set for
+                                   down-sampling) */
+  int kernel;                   /* FIR_KERNEL_xxx in use */
+  float (*dot) ARGS ((float *x, float *h, long n));     /* dot-product of
+                                   x[0..n-1] and h[0..n-1] for kernel */
+  FIR_FFT *fft;                 /* overlap-save engine, or NULL */
 } SCD_FIR;
 
+/* 
+ * ..... State variables for FIR filtering of interleaved multichannel
+ *       signals: one delay line per channel, shared coefficients .....
+ */
+
+typedef struct {
+  long nchan;                   /* number of interleaved channels */
+  SCD_FIR *fir;                 /* coefficients, rate change and k0, shared
+                                   by all channels */
+  float *T;                     /* interleaved delay lines; fir->lenT past
+                                   frames followed by room for FIR_BLOCK
+                                   new ones */
+} SCD_FIR_MC;
+
+/* 
+ * ..... Rational sampling rate converter: cascade of the high quality
+ *       factor-2/3 filters, see fir-rsmp.c .....
+ */
+#define FIR_RSMP_MAXSTAGES 16   /* longest cascade */
+
+typedef struct {
+  long nchan;                   /* number of interleaved channels */
+  long nstages;                 /* number of stages in the cascade */
+  long code[FIR_RSMP_MAXSTAGES];        /* +2/+3: up-sampling, -2/-3:
+                                           down-sampling by 2 or 3 */
+  SCD_FIR *stage[FIR_RSMP_MAXSTAGES];   /* filters of the stages */
+  SCD_FIR_MC *mc[FIR_RSMP_MAXSTAGES];   /* their multichannel versions
+                                           (nchan > 1 only) */
+  float *buf[FIR_RSMP_MAXSTAGES];       /* output of each stage but the
+                                           last */
+} FIR_RESAMPLER;
+
 
 /* 
  * ..... Global function prototypes ..... 
@@ -89,6 +171,18 @@ SCD_FIR *LP12_48kHz_init ARGS ((void));
 // FILTER_12k48k_HW
 void hq_free ARGS ((SCD_FIR * fir_ptr));
 void hq_reset ARGS ((SCD_FIR * fir_ptr));
+int hq_select_kernel ARGS ((SCD_FIR * fir_ptr, int kernel));
+int hq_fft_engine ARGS ((SCD_FIR * fir_ptr));
+SCD_FIR_MC *hq_mc_init ARGS ((SCD_FIR * fir_ptr, long nchan));
+long hq_mc_kernel ARGS ((long lseg, float *x_ptr, SCD_FIR_MC * mc_ptr, float *y_ptr));
+void hq_mc_reset ARGS ((SCD_FIR_MC * mc_ptr));
+void hq_mc_free ARGS ((SCD_FIR_MC * mc_ptr));
+long hq_rsmp_plan ARGS ((long fs_in, long fs_out, long *stages));
+FIR_RESAMPLER *hq_rsmp_init ARGS ((long fs_in, long fs_out, long nchan));
+long hq_rsmp_kernel ARGS ((long lseg, float *x_ptr, FIR_RESAMPLER * rs_ptr, float *y_ptr));
+long hq_rsmp_maxout ARGS ((FIR_RESAMPLER * rs_ptr, long lseg));
+void hq_rsmp_reset ARGS ((FIR_RESAMPLER * rs_ptr));
+void hq_rsmp_free ARGS ((FIR_RESAMPLER * rs_ptr));
 
 #endif /* FIRFLT_FIRstruct_defined */
 
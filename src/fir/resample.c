@@ -0,0 +1,359 @@
+/*                                                           16.Oct.2026 v1.0
+  ===========================================================================
+
+  RESAMPLE.C
+  ~~~~~~~~~~
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Program to convert the sampling rate of a file by a rational factor,
+  using a cascade of the high quality factor-2 and factor-3 FIR filters
+  of the STL (the HQ2 and HQ3 filters of filter.c). The cascade is
+  planned by hq_rsmp_plan() in fir-rsmp.c, and run in a single pass
+  over the file. Since the intermediate signals are not rounded to 16
+  bits, the result may differ by 1 LSB from piping the stages through
+  several runs of filter.c.
+
+  Both the up-sampling and the down-sampling factor (after reducing
+  OutRate/InpRate) must be products of 2 and 3, e.g. 48000->16000,
+  32000->8000, 32000->48000 or 8000->48000. Other ratios are rejected:
+  44100<->48000, for instance, is 160/147 = 2^5*5 / 3*7^2, and the
+  module has no factor-5 or factor-7 filters.
+
+  Usage:
+  ~~~~~~
+  $ resample [-options] InpRate OutRate InpFile OutFile
+             [BlockSize [1stBlock [NoOfBlocks]]]
+
+  where:
+  InpRate       is the sampling rate of the input file, in Hz;
+  OutRate       is the sampling rate of the output file, in Hz;
+  InpFile       is the name of the file to be processed;
+  OutFile       is the name with the processed data;
+  BlockSize     is the block size, in number of samples (per channel)
+  1stBlock      is the number of the first block of the input file
+                to be processed;
+  NoOfBlocks    is the number of blocks to be processed, starting on
+                block "1stBlock"
+
+  Options:
+  -channels n ... number of interleaved channels in the files (default 1)
+  -kernel k ..... dot-product implementation for mono files: scalar
+                  (default, bit-exact reference), sse, avx2, avx512, or
+                  auto (best one supported by the CPU)
+  -plan ......... only print the cascade of stages and exit
+  -q ............ quiet processing (no progress flag)
+
+  Original author:
+  ~~~~~~~~~~~~~~~~
+  Based on filter.c by Simao Ferraz de Campos Neto
+
+  History:
+  ~~~~~~~~
+  16.Oct.2026 v1.0  Created.
+  ===========================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>             /* strcmp() */
+#include <math.h>
+
+#if defined(VMS)
+#include <stat.h>
+#else /* Unix, DOS, etc */
+#include <sys/stat.h>
+#endif
+
+/* UGST MODULES */
+#include "ugstdemo.h"
+#include "firflt.h"
+#include "ugst-utl.h"
+
+/* LOCAL DEFINITIONS */
+#ifndef max
+#define max(x,y) ((x)>(y)?(x):(y))
+#endif
+
+/* FIR dot-product kernel names, indexed by FIR_KERNEL_xxx */
+char *fir_kernel_str[] = { "auto", "scalar", "sse", "avx2", "avx512" };
+
+
+/*
+ * Function to display usage
+ */
+void display_usage () {
+  printf ("RESAMPLE.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Program to convert the sampling rate of a file by a rational\n");
+  printf (" factor, using a cascade of the high quality factor-2 and factor-3\n");
+  printf (" FIR filters of the STL, in a single pass. The up- and down-sampling\n");
+  printf (" factors must be products of 2 and 3 (e.g. 48000->16000, 32000->48000);\n");
+  printf (" other ratios, such as 44100<->48000 (147:160), are not supported.\n");
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ resample [-options] InpRate OutRate InpFile OutFile \n");
+  printf ("            [BlockSize [1stBlock [NoOfBlocks]]]\n");
+  printf (" where:\n");
+  printf ("  InpRate      is the sampling rate of the input file, in Hz;\n");
+  printf ("  OutRate      is the sampling rate of the output file, in Hz;\n");
+  printf ("  InpFile      is the name of the file to be processed;\n");
+  printf ("  OutFile      is the name with the processed data;\n");
+  printf ("  BlockSize    is the block size, in number of samples (per channel)\n");
+  printf ("  1stBlock     is the number of the first block of the input file\n");
+  printf ("               to be processed;\n");
+  printf ("  NoOfBlocks   is the number of blocks to be processed, starting on\n");
+  printf ("               block \"1stBlock\"\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -channels n  number of interleaved channels in the files [default: 1]\n");
+  printf ("  -kernel k .. dot-product for mono files: scalar [default], sse,\n");
+  printf ("               avx2, avx512, or auto (best supported by the CPU)\n");
+  printf ("  -plan ...... only print the cascade of stages and exit\n");
+  printf ("  -q ......... quiet processing (no progress flag)\n");
+  printf ("\n");
+
+  /* Quit program */
+  exit (-128);
+}
+
+
+/*
+ * Print the cascade of stages of a conversion
+ */
+void print_plan (long nstages, long *stages) {
+  long i;
+
+  if (nstages == 0)
+    fprintf (stderr, "No-rate change operation\n");
+  for (i = 0; i < nstages; i++)
+    if (stages[i] > 0)
+      fprintf (stderr, "Stage %ld: HQ%ld up-sampling, factor 1:%ld\n", i + 1, stages[i], stages[i]);
+    else
+      fprintf (stderr, "Stage %ld: HQ%ld down-sampling, factor %ld:1\n", i + 1, -stages[i], -stages[i]);
+}
+
+
+/*============================== */
+int main (int argc, char *argv[]) {
+  /* DECLARATIONS */
+
+  /* Algorithm variables */
+  FIR_RESAMPLER *rs_state;
+  long stages[FIR_RSMP_MAXSTAGES], nstages;
+
+  float *InpBuff, *OutBuff;
+  short *TmpBuff;
+  long cur_blk, satur = 0, N, N1, N2;
+  long fs_in, fs_out, inp_size, out_size, smpno, i;
+  long nchan = 1;
+  int fir_kernel = FIR_KERNEL_SCALAR;
+  char quiet = 0, plan_only = 0;
+  static char funny[9] = "|/-\\|/-\\";
+
+  /* File variables */
+  char FileIn[MAX_STRLEN], FileOut[MAX_STRLEN];
+  FILE *Fi, *Fo;
+  long start_byte;
+#ifdef VMS
+  char mrs[15];
+#endif
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  if (argc < 2)
+    display_usage ();
+  else {
+    while (argc > 1 && argv[1][0] == '-')
+      if (strcmp (argv[1], "-q") == 0) {
+        /* Quiet operation */
+        quiet = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-plan") == 0) {
+        /* Only print the stages */
+        plan_only = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-channels") == 0) {
+        /* Number of interleaved channels */
+        nchan = atol (argv[2]);
+        if (nchan < 1) {
+          fprintf (stderr, "ERROR! Invalid number of channels \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-kernel") == 0) {
+        /* Dot-product implementation for FIR filters */
+        for (fir_kernel = FIR_KERNEL_AVX512; fir_kernel > FIR_KERNEL_AUTO; fir_kernel--)
+          if (strcmp (argv[2], fir_kernel_str[fir_kernel]) == 0)
+            break;
+        if (fir_kernel == FIR_KERNEL_AUTO && strcmp (argv[2], "auto") != 0) {
+          fprintf (stderr, "ERROR! Invalid kernel \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+        /* Display help message */
+        display_usage ();
+      } else {
+        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+        display_usage ();
+      }
+  }
+
+  /* Read parameters for processing */
+  GET_PAR_L (1, "_Input sampling rate: ......... ", fs_in);
+  GET_PAR_L (2, "_Output sampling rate: ........ ", fs_out);
+
+  /* Plan the cascade */
+  if ((nstages = hq_rsmp_plan (fs_in, fs_out, stages)) < 0) {
+    fprintf (stderr, "\nNo cascade of factor-2/3 filters converts %ld Hz to %ld Hz! Aborted.\n", fs_in, fs_out);
+    fprintf (stderr, "(the reduced up- and down-sampling factors must be products of 2 and 3)\n");
+    exit (2);
+  }
+  if (plan_only) {
+    print_plan (nstages, stages);
+    exit (0);
+  }
+
+  GET_PAR_S (3, "_Input File: .................. ", FileIn);
+  GET_PAR_S (4, "_Output File: ................. ", FileOut);
+  FIND_PAR_L (5, "_Block Size: .................. ", N, 256);
+  FIND_PAR_L (6, "_Starting Block: .............. ", N1, 1);
+  FIND_PAR_L (7, "_No. of Blocks: ............... ", N2, 0);
+
+
+  /* ......... STARTING ......... */
+
+  /* Find starting byte in file */
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * nchan;
+
+  /* Check if is to process the whole file */
+  if (N2 == 0) {
+    struct stat st;
+
+    /* ... find the input file size ... */
+    stat (FileIn, &st);
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * nchan * sizeof (short)));
+  }
+  inp_size = N;                 /* frames of nchan samples */
+
+
+  /* ... INITIALIZE THE CONVERTER ... */
+  if ((rs_state = hq_rsmp_init (fs_in, fs_out, nchan)) == NULL)
+    HARAKIRI ("Can't allocate memory for the converter\n", 10);
+
+  /* Dot-product of mono stages */
+  if (nchan == 1)
+    for (i = 0; i < nstages; i++)
+      fir_kernel = hq_select_kernel (rs_state->stage[i], fir_kernel);
+  else
+    fir_kernel = FIR_KERNEL_SCALAR;     /* the multichannel kernel is scalar */
+
+
+  /* MEMORY ALLOCATION */
+  out_size = hq_rsmp_maxout (rs_state, inp_size);
+
+  /* Allocate memory for float input buffer */
+  if ((InpBuff = (float *) calloc (inp_size * nchan, sizeof (float))) == NULL)
+    HARAKIRI ("Can't allocate memory for input data buffer\n", 10);
+
+  /* Allocate memory for float output buffer */
+  if ((OutBuff = (float *) calloc (out_size * nchan, sizeof (float))) == NULL)
+    HARAKIRI ("Can't allocate memory for output data buffer\n", 10);
+
+  /* Allocate memory for short input/output buffer */
+  if ((TmpBuff = (short *) calloc (max (inp_size, out_size) * nchan, sizeof (short))) == NULL)
+    HARAKIRI ("Can't allocate memory for short data buffer\n", 10);
+
+
+/*
+ * ......... PRINT INFO ..........
+ */
+  fprintf (stderr, "Converting %ld Hz to %ld Hz\n", fs_in, fs_out);
+  print_plan (nstages, stages);
+  if (nchan > 1)
+    fprintf (stderr, "Interleaved channels: %ld\n", nchan);
+  fprintf (stderr, "FIR kernel: %s\n", fir_kernel_str[fir_kernel]);
+
+
+/*
+ * ......... FILE PREPARATION .........
+ */
+
+  /* Handle VMS ideosyncrasies... */
+#ifdef VMS
+  sprintf (mrs, "mrs=%d", 2 * N);
+#endif
+
+  /* Opening input file; abort if there's any problem */
+  if ((Fi = fopen (FileIn, RB)) == NULL)
+    KILL (FileIn, 2);
+
+  /* Creates output file */
+  if ((Fo = fopen (FileOut, WB)) == NULL)
+    KILL (FileOut, 3);
+
+  /* Move pointer to 1st block of interest */
+  if (fseek (Fi, start_byte, 0))
+    KILL (FileIn, 4);
+
+
+  /* CONVERSION! */
+  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+    /* Print progress info */
+    if (!quiet)
+      fprintf (stderr, "%c\r", funny[cur_blk % 8]);
+
+    /* Read a block of samples */
+    if ((smpno = fread (TmpBuff, sizeof (short), N * nchan, Fi)) == 0)
+      KILL (FileIn, 5);
+
+    /* ... and convert short to float, normalizing */
+    sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
+
+    /* Run the cascade; a trailing incomplete frame is dropped */
+    smpno = hq_rsmp_kernel (smpno / nchan, InpBuff, rs_state, OutBuff) * nchan;
+
+    /* Convert the filtered data back to short */
+    satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
+
+    /* Save to file */
+    if ((smpno = fwrite (TmpBuff, sizeof (short), smpno, Fo)) == 0 && ferror (Fo))
+      KILL (FileOut, 6);
+  }
+
+
+  /* FINALIZATIONS */
+  fprintf (stderr, "\n");
+  if (satur)
+    fprintf (stderr, "%ld samples saturated\n", satur);
+
+  /* Close open files */
+  fclose (Fi);
+  fclose (Fo);
+
+  /* Release memory */
+  free (TmpBuff);
+  free (OutBuff);
+  free (InpBuff);
+  hq_rsmp_free (rs_state);
+
+#ifndef VMS
+  return (0);
+#endif
+}
@@ -69,4 +69,9 @@ void powSpect (float *real,     /* input buffer containing the real part of the
 
 #else
 void powSpect (int m, float *x1, float *x2);
+
+/* Real FFT of a[0..n-1] in place (isgn=1), or its inverse (isgn=-1). ip[]
+   (2+sqrt(n/2) ints, ip[0]=0 on the first call) and w[] (n/2 floats) hold
+   the tables computed on the first call for a given n */
+void actrdft (int n, int isgn, float *a, int *ip, float *w);
 #endif
@@ -1,4 +1,4 @@
-/*                                                 Version 3.01 - 31.Jan.2000
+/*                                                 Version 3.02 - 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSS  TTTTT
@@ -54,6 +54,15 @@ ulaw_expand: ..... expands 1 vector of u-law samples to linear PCM
                    use 8 Least Sig. Bits (LSBs) from input and
                    14 Most Sig.Bits (MSBs) on output.
 
+alaw_to_ulaw: .... converts 1 vector of A-law samples to u-law, with
+                   the same result as alaw_expand() and ulaw_compress().
+
+ulaw_to_alaw: .... converts 1 vector of u-law samples to A-law, with
+                   the same result as ulaw_expand() and alaw_compress().
+
+g711_select_kernel: chooses the table-driven C or the x86 AVX2 version
+                   of the compression and expansion functions.
+
 PROTOTYPES: in g711.h
 
 HISTORY:
@@ -64,6 +73,9 @@ Apr/91       1.0   First version of the G711 module
 08/Feb/1992  3.0   Demo as separate file;
 31/Jan/2000  3.01  Updated documentation text; no change in functions
                    <simao.campos@labs.comsat.com>
+16/Oct/2026  3.02  Table-driven compression and expansion, AVX2 versions
+                   selected at run time, and direct A-law/u-law
+                   transcoding; results identical to v3.01 for all inputs
 =============================================================================
 */
 
@@ -74,10 +86,301 @@ Apr/91       1.0   First version of the G711 module
 /* Global prototype functions */
 #include "g711.h"
 
+/* UGST_SIMD_X86, UGST_TARGET() and ugst_cpu_supports() for the AVX2 versions */
+#include "ugst-cpu.h"
+
+/*
+ *	.......... T A B L E S ..........
+ */
+
+/* Index of a compressed sample in the tables below: the 7 LSBs and the
+   sign, as tested by the expansion rules (x > 127 or x < 0x80). Every
+   short value gives the same result as v3.01, also outside 0..255. */
+#define G711_INDEX(x) (((x) & 0x7F) | (((x) > 127) << 7))
+
+/* Linear value of each log sample, indexed by G711_INDEX() */
+static const short alaw_expand_tab[256] = {
+  -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736,
+  -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784,
+  -2752, -2624, -3008, -2880, -2240, -2112, -2496, -2368,
+  -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392,
+  -22016, -20992, -24064, -23040, -17920, -16896, -19968, -18944,
+  -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136,
+  -11008, -10496, -12032, -11520, -8960, -8448, -9984, -9472,
+  -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568,
+  -344, -328, -376, -360, -280, -264, -312, -296,
+  -472, -456, -504, -488, -408, -392, -440, -424,
+  -88, -72, -120, -104, -24, -8, -56, -40,
+  -216, -200, -248, -232, -152, -136, -184, -168,
+  -1376, -1312, -1504, -1440, -1120, -1056, -1248, -1184,
+  -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696,
+  -688, -656, -752, -720, -560, -528, -624, -592,
+  -944, -912, -1008, -976, -816, -784, -880, -848,
+  5504, 5248, 6016, 5760, 4480, 4224, 4992, 4736,
+  7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784,
+  2752, 2624, 3008, 2880, 2240, 2112, 2496, 2368,
+  3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392,
+  22016, 20992, 24064, 23040, 17920, 16896, 19968, 18944,
+  30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136,
+  11008, 10496, 12032, 11520, 8960, 8448, 9984, 9472,
+  15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568,
+  344, 328, 376, 360, 280, 264, 312, 296,
+  472, 456, 504, 488, 408, 392, 440, 424,
+  88, 72, 120, 104, 24, 8, 56, 40,
+  216, 200, 248, 232, 152, 136, 184, 168,
+  1376, 1312, 1504, 1440, 1120, 1056, 1248, 1184,
+  1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696,
+  688, 656, 752, 720, 560, 528, 624, 592,
+  944, 912, 1008, 976, 816, 784, 880, 848
+};
+
+static const short ulaw_expand_tab[256] = {
+  -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+  -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+  -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+  -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316,
+  -7932, -7676, -7420, -7164, -6908, -6652, -6396, -6140,
+  -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092,
+  -3900, -3772, -3644, -3516, -3388, -3260, -3132, -3004,
+  -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980,
+  -1884, -1820, -1756, -1692, -1628, -1564, -1500, -1436,
+  -1372, -1308, -1244, -1180, -1116, -1052, -988, -924,
+  -876, -844, -812, -780, -748, -716, -684, -652,
+  -620, -588, -556, -524, -492, -460, -428, -396,
+  -372, -356, -340, -324, -308, -292, -276, -260,
+  -244, -228, -212, -196, -180, -164, -148, -132,
+  -120, -112, -104, -96, -88, -80, -72, -64,
+  -56, -48, -40, -32, -24, -16, -8, 0,
+  32124, 31100, 30076, 29052, 28028, 27004, 25980, 24956,
+  23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764,
+  15996, 15484, 14972, 14460, 13948, 13436, 12924, 12412,
+  11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316,
+  7932, 7676, 7420, 7164, 6908, 6652, 6396, 6140,
+  5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092,
+  3900, 3772, 3644, 3516, 3388, 3260, 3132, 3004,
+  2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980,
+  1884, 1820, 1756, 1692, 1628, 1564, 1500, 1436,
+  1372, 1308, 1244, 1180, 1116, 1052, 988, 924,
+  876, 844, 812, 780, 748, 716, 684, 652,
+  620, 588, 556, 524, 492, 460, 428, 396,
+  372, 356, 340, 324, 308, 292, 276, 260,
+  244, 228, 212, 196, 180, 164, 148, 132,
+  120, 112, 104, 96, 88, 80, 72, 64,
+  56, 48, 40, 32, 24, 16, 8, 0
+};
+
+/* Other law's code of each log sample, indexed by G711_INDEX(); same as
+   expanding with one law and compressing with the other */
+static const unsigned char alaw_to_ulaw_tab[256] = {
+  0x29, 0x2A, 0x27, 0x28, 0x2D, 0x2E, 0x2B, 0x2C, 0x21, 0x22, 0x1F, 0x20, 0x25, 0x26, 0x23, 0x24,
+  0x39, 0x3A, 0x37, 0x38, 0x3D, 0x3E, 0x3B, 0x3C, 0x31, 0x32, 0x2F, 0x30, 0x35, 0x36, 0x33, 0x34,
+  0x0A, 0x0B, 0x08, 0x09, 0x0E, 0x0F, 0x0C, 0x0D, 0x02, 0x03, 0x00, 0x01, 0x06, 0x07, 0x04, 0x05,
+  0x1A, 0x1B, 0x18, 0x19, 0x1E, 0x1F, 0x1C, 0x1D, 0x12, 0x13, 0x10, 0x11, 0x16, 0x17, 0x14, 0x15,
+  0x62, 0x63, 0x60, 0x61, 0x66, 0x67, 0x64, 0x65, 0x5D, 0x5D, 0x5C, 0x5C, 0x5F, 0x5F, 0x5E, 0x5E,
+  0x74, 0x76, 0x70, 0x72, 0x7C, 0x7E, 0x78, 0x7A, 0x6A, 0x6B, 0x68, 0x69, 0x6E, 0x6F, 0x6C, 0x6D,
+  0x48, 0x49, 0x46, 0x47, 0x4C, 0x4D, 0x4A, 0x4B, 0x40, 0x41, 0x3F, 0x3F, 0x44, 0x45, 0x42, 0x43,
+  0x56, 0x57, 0x54, 0x55, 0x5A, 0x5B, 0x58, 0x59, 0x4F, 0x4F, 0x4E, 0x4E, 0x52, 0x53, 0x50, 0x51,
+  0xA9, 0xAA, 0xA7, 0xA8, 0xAD, 0xAE, 0xAB, 0xAC, 0xA1, 0xA2, 0x9F, 0xA0, 0xA5, 0xA6, 0xA3, 0xA4,
+  0xB9, 0xBA, 0xB7, 0xB8, 0xBD, 0xBE, 0xBB, 0xBC, 0xB1, 0xB2, 0xAF, 0xB0, 0xB5, 0xB6, 0xB3, 0xB4,
+  0x8A, 0x8B, 0x88, 0x89, 0x8E, 0x8F, 0x8C, 0x8D, 0x82, 0x83, 0x80, 0x81, 0x86, 0x87, 0x84, 0x85,
+  0x9A, 0x9B, 0x98, 0x99, 0x9E, 0x9F, 0x9C, 0x9D, 0x92, 0x93, 0x90, 0x91, 0x96, 0x97, 0x94, 0x95,
+  0xE2, 0xE3, 0xE0, 0xE1, 0xE6, 0xE7, 0xE4, 0xE5, 0xDD, 0xDD, 0xDC, 0xDC, 0xDF, 0xDF, 0xDE, 0xDE,
+  0xF4, 0xF6, 0xF0, 0xF2, 0xFC, 0xFE, 0xF8, 0xFA, 0xEA, 0xEB, 0xE8, 0xE9, 0xEE, 0xEF, 0xEC, 0xED,
+  0xC8, 0xC9, 0xC6, 0xC7, 0xCC, 0xCD, 0xCA, 0xCB, 0xC0, 0xC1, 0xBF, 0xBF, 0xC4, 0xC5, 0xC2, 0xC3,
+  0xD6, 0xD7, 0xD4, 0xD5, 0xDA, 0xDB, 0xD8, 0xD9, 0xCF, 0xCF, 0xCE, 0xCE, 0xD2, 0xD3, 0xD0, 0xD1
+};
+
+static const unsigned char ulaw_to_alaw_tab[256] = {
+  0x2A, 0x2B, 0x28, 0x29, 0x2E, 0x2F, 0x2C, 0x2D, 0x22, 0x23, 0x20, 0x21, 0x26, 0x27, 0x24, 0x25,
+  0x3A, 0x3B, 0x38, 0x39, 0x3E, 0x3F, 0x3C, 0x3D, 0x32, 0x33, 0x30, 0x31, 0x36, 0x37, 0x34, 0x35,
+  0x0B, 0x08, 0x09, 0x0E, 0x0F, 0x0C, 0x0D, 0x02, 0x03, 0x00, 0x01, 0x06, 0x07, 0x04, 0x05, 0x1A,
+  0x1B, 0x18, 0x19, 0x1E, 0x1F, 0x1C, 0x1D, 0x12, 0x13, 0x10, 0x11, 0x16, 0x17, 0x14, 0x15, 0x6B,
+  0x68, 0x69, 0x6E, 0x6F, 0x6C, 0x6D, 0x62, 0x63, 0x60, 0x61, 0x66, 0x67, 0x64, 0x65, 0x7B, 0x79,
+  0x7E, 0x7F, 0x7C, 0x7D, 0x72, 0x73, 0x70, 0x71, 0x76, 0x77, 0x74, 0x75, 0x4B, 0x49, 0x4F, 0x4D,
+  0x42, 0x43, 0x40, 0x41, 0x46, 0x47, 0x44, 0x45, 0x5A, 0x5B, 0x58, 0x59, 0x5E, 0x5F, 0x5C, 0x5D,
+  0x52, 0x53, 0x53, 0x50, 0x50, 0x51, 0x51, 0x56, 0x56, 0x57, 0x57, 0x54, 0x54, 0x55, 0x55, 0xD5,
+  0xAA, 0xAB, 0xA8, 0xA9, 0xAE, 0xAF, 0xAC, 0xAD, 0xA2, 0xA3, 0xA0, 0xA1, 0xA6, 0xA7, 0xA4, 0xA5,
+  0xBA, 0xBB, 0xB8, 0xB9, 0xBE, 0xBF, 0xBC, 0xBD, 0xB2, 0xB3, 0xB0, 0xB1, 0xB6, 0xB7, 0xB4, 0xB5,
+  0x8B, 0x88, 0x89, 0x8E, 0x8F, 0x8C, 0x8D, 0x82, 0x83, 0x80, 0x81, 0x86, 0x87, 0x84, 0x85, 0x9A,
+  0x9B, 0x98, 0x99, 0x9E, 0x9F, 0x9C, 0x9D, 0x92, 0x93, 0x90, 0x91, 0x96, 0x97, 0x94, 0x95, 0xEB,
+  0xE8, 0xE9, 0xEE, 0xEF, 0xEC, 0xED, 0xE2, 0xE3, 0xE0, 0xE1, 0xE6, 0xE7, 0xE4, 0xE5, 0xFB, 0xF9,
+  0xFE, 0xFF, 0xFC, 0xFD, 0xF2, 0xF3, 0xF0, 0xF1, 0xF6, 0xF7, 0xF4, 0xF5, 0xCB, 0xC9, 0xCF, 0xCD,
+  0xC2, 0xC3, 0xC0, 0xC1, 0xC6, 0xC7, 0xC4, 0xC5, 0xDA, 0xDB, 0xD8, 0xD9, 0xDE, 0xDF, 0xDC, 0xDD,
+  0xD2, 0xD2, 0xD3, 0xD3, 0xD0, 0xD0, 0xD1, 0xD1, 0xD6, 0xD6, 0xD7, 0xD7, 0xD4, 0xD4, 0xD5, 0xD5
+};
+
+/* Number of significant bits of 0..127: the segment of a compressed sample */
+static const unsigned char g711_seglen[128] = {
+  0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+};
+
+/* Kernel in use: G711_KERNEL_AUTO until the first call */
+static int g711_kernel = G711_KERNEL_AUTO;
+
+/* Samples per iteration of the AVX2 functions */
+#define G711_AVX2_BLOCK 16
+
+
 /*
  *	.......... F U N C T I O N S ..........
  */
 
+/* ................... Begin of g711_select_kernel() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: g711_select_kernel
+
+   DESCRIPTION: Chooses the implementation used by alaw_compress(),
+                alaw_expand(), ulaw_compress() and ulaw_expand(). All of
+                them give the same results; G711_KERNEL_AUTO, used when
+                this function is never called, picks the fastest one
+                supported by the CPU.
+                A kernel not supported falls back to the next lower one.
+
+   PROTOTYPE: int g711_select_kernel(int kernel)
+
+   PARAMETERS:
+     kernel:	(In)  one of G711_KERNEL_xxx (see g711.h)
+
+   RETURN VALUE: the G711_KERNEL_xxx actually selected.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ==========================================================================
+*/
+int g711_select_kernel (int kernel) {
+  if (kernel == G711_KERNEL_AUTO || kernel > G711_KERNEL_AVX2)
+    kernel = G711_KERNEL_AVX2;
+
+  if (kernel == G711_KERNEL_AVX2 && !ugst_cpu_supports (UGST_CPU_AVX2))
+    kernel = G711_KERNEL_SCALAR;
+  if (kernel != G711_KERNEL_AVX2)
+    kernel = G711_KERNEL_SCALAR;
+
+  return (g711_kernel = kernel);
+}
+
+/* ................... End of g711_select_kernel() ..................... */
+
+
+#ifdef UGST_SIMD_X86
+/*
+  ==========================================================================
+
+   AVX2 versions of the block functions, for 8 samples sign-extended to
+   32 bits, used by the public functions for the multiples of
+   G711_AVX2_BLOCK samples. The segment of a value v < 256 is taken from
+   the exponent of the float (2v+1), which is exact, and the mantissas
+   are aligned with variable shifts; the arithmetic is the one of the
+   v3.01 loops, so the results are identical.
+
+  ==========================================================================
+*/
+
+/* Number of significant bits of 0 <= v < 256 */
+UGST_TARGET ("avx2") static __m256i g711_bitlen_avx2 (__m256i v) {
+  __m256i f = _mm256_castps_si256 (_mm256_cvtepi32_ps (_mm256_add_epi32 (_mm256_add_epi32 (v, v), _mm256_set1_epi32 (1))));
+
+  return _mm256_sub_epi32 (_mm256_srli_epi32 (f, 23), _mm256_set1_epi32 (127));
+}
+
+UGST_TARGET ("avx2") static __m256i alaw_compress_avx2 (__m256i x) {
+  __m256i neg = _mm256_srai_epi32 (x, 31);
+  __m256i ix = _mm256_srai_epi32 (_mm256_xor_si256 (x, neg), 4);       /* 1's complement */
+  __m256i iexp = g711_bitlen_avx2 (_mm256_srli_epi32 (ix, 4));
+  __m256i shift = _mm256_max_epi32 (_mm256_sub_epi32 (iexp, _mm256_set1_epi32 (1)), _mm256_setzero_si256 ());
+  __m256i mant = _mm256_and_si256 (_mm256_srlv_epi32 (ix, shift), _mm256_set1_epi32 (0x0F));
+
+  ix = _mm256_or_si256 (_mm256_slli_epi32 (iexp, 4), mant);
+  ix = _mm256_or_si256 (ix, _mm256_andnot_si256 (neg, _mm256_set1_epi32 (0x0080)));
+  return _mm256_xor_si256 (ix, _mm256_set1_epi32 (0x0055));
+}
+
+UGST_TARGET ("avx2") static __m256i ulaw_compress_avx2 (__m256i x) {
+  __m256i neg = _mm256_srai_epi32 (x, 31);
+  __m256i absno = _mm256_add_epi32 (_mm256_srai_epi32 (_mm256_xor_si256 (x, neg), 2), _mm256_set1_epi32 (33));
+  __m256i segno, low_nibble;
+
+  absno = _mm256_min_epi32 (absno, _mm256_set1_epi32 (0x1FFF));
+  segno = _mm256_add_epi32 (g711_bitlen_avx2 (_mm256_srli_epi32 (absno, 6)), _mm256_set1_epi32 (1));
+  low_nibble = _mm256_andnot_si256 (_mm256_srlv_epi32 (absno, segno), _mm256_set1_epi32 (0x0F));
+  absno = _mm256_or_si256 (_mm256_slli_epi32 (_mm256_sub_epi32 (_mm256_set1_epi32 (8), segno), 4), low_nibble);
+  return _mm256_or_si256 (absno, _mm256_andnot_si256 (neg, _mm256_set1_epi32 (0x0080)));
+}
+
+UGST_TARGET ("avx2") static __m256i alaw_expand_avx2 (__m256i x) {
+  __m256i neg = _mm256_cmpgt_epi32 (_mm256_set1_epi32 (128), x);
+  __m256i ix = _mm256_and_si256 (_mm256_xor_si256 (x, _mm256_set1_epi32 (0x0055)), _mm256_set1_epi32 (0x007F));
+  __m256i iexp = _mm256_srli_epi32 (ix, 4);
+  __m256i mant = _mm256_and_si256 (ix, _mm256_set1_epi32 (0x000F));
+
+  /* add leading '1' and 1/2 quantization step, then shift by exponent */
+  mant = _mm256_add_epi32 (mant, _mm256_slli_epi32 (_mm256_min_epi32 (iexp, _mm256_set1_epi32 (1)), 4));
+  mant = _mm256_add_epi32 (_mm256_slli_epi32 (mant, 4), _mm256_set1_epi32 (0x0008));
+  mant = _mm256_sllv_epi32 (mant, _mm256_max_epi32 (_mm256_sub_epi32 (iexp, _mm256_set1_epi32 (1)), _mm256_setzero_si256 ()));
+  return _mm256_sub_epi32 (_mm256_xor_si256 (mant, neg), neg);
+}
+
+UGST_TARGET ("avx2") static __m256i ulaw_expand_avx2 (__m256i x) {
+  __m256i neg = _mm256_cmpgt_epi32 (_mm256_set1_epi32 (0x0080), x);
+  __m256i mantissa = _mm256_xor_si256 (x, _mm256_set1_epi32 (-1));
+  __m256i exponent = _mm256_and_si256 (_mm256_srli_epi32 (mantissa, 4), _mm256_set1_epi32 (0x0007));
+
+  /* ((0x80 << exp) + (8 << exp) * mant + (4 << exp)) - 4 * 33 */
+  mantissa = _mm256_slli_epi32 (_mm256_and_si256 (mantissa, _mm256_set1_epi32 (0x000F)), 3);
+  mantissa = _mm256_sllv_epi32 (_mm256_add_epi32 (mantissa, _mm256_set1_epi32 (0x0084)), exponent);
+  mantissa = _mm256_sub_epi32 (mantissa, _mm256_set1_epi32 (4 * 33));
+  return _mm256_sub_epi32 (_mm256_xor_si256 (mantissa, neg), neg);
+}
+
+/* Applies f to lseg (a multiple of G711_AVX2_BLOCK) samples */
+#define G711_AVX2_LOOP(lseg, inp, out, f) \
+  { long n; __m256i lo, hi, v; \
+    for (n = 0; n < (lseg); n += G711_AVX2_BLOCK) { \
+      v = _mm256_loadu_si256 ((const __m256i *) ((inp) + n)); \
+      lo = _mm256_cvtepi16_epi32 (_mm256_castsi256_si128 (v)); \
+      hi = _mm256_cvtepi16_epi32 (_mm256_extracti128_si256 (v, 1)); \
+      v = _mm256_permute4x64_epi64 (_mm256_packs_epi32 (f (lo), f (hi)), 0xD8); \
+      _mm256_storeu_si256 ((__m256i *) ((out) + n), v); \
+    } \
+  }
+
+UGST_TARGET ("avx2") static void alaw_compress_block_avx2 (long lseg, short *linbuf, short *logbuf) {
+  G711_AVX2_LOOP (lseg, linbuf, logbuf, alaw_compress_avx2);
+}
+
+UGST_TARGET ("avx2") static void alaw_expand_block_avx2 (long lseg, short *logbuf, short *linbuf) {
+  G711_AVX2_LOOP (lseg, logbuf, linbuf, alaw_expand_avx2);
+}
+
+UGST_TARGET ("avx2") static void ulaw_compress_block_avx2 (long lseg, short *linbuf, short *logbuf) {
+  G711_AVX2_LOOP (lseg, linbuf, logbuf, ulaw_compress_avx2);
+}
+
+UGST_TARGET ("avx2") static void ulaw_expand_block_avx2 (long lseg, short *logbuf, short *linbuf) {
+  G711_AVX2_LOOP (lseg, logbuf, linbuf, ulaw_expand_avx2);
+}
+
+/* Runs the AVX2 function over the whole blocks of lseg samples, and
+   leaves in n the index of the first sample left to the C loop */
+#define G711_AVX2_DISPATCH(n, lseg, f, inp, out) \
+  if (g711_kernel == G711_KERNEL_AUTO) \
+    g711_select_kernel (G711_KERNEL_AUTO); \
+  n = 0; \
+  if (g711_kernel == G711_KERNEL_AVX2) { \
+    n = (lseg) - (lseg) % G711_AVX2_BLOCK; \
+    f (n, inp, out); \
+  }
+#else
+#define G711_AVX2_DISPATCH(n, lseg, f, inp, out) n = 0
+#endif
+
+
 /* ................... Begin of alaw_compress() ..................... */
 /*
   ==========================================================================
@@ -99,6 +402,7 @@ Apr/91       1.0   First version of the G711 module
 
    HISTORY:
    10.Dec.91	1.0	Separated A-law compression function
+   16.Oct.26	1.1	Exponent from a table instead of a loop; AVX2 version
 
   ==========================================================================
 */
@@ -106,22 +410,18 @@ void alaw_compress (long lseg, short *linbuf, short *logbuf) {
   short ix, iexp;
   long n;
 
-  for (n = 0; n < lseg; n++) {
+  G711_AVX2_DISPATCH (n, lseg, alaw_compress_block_avx2, linbuf, logbuf);
+
+  for (; n < lseg; n++) {
     ix = linbuf[n] < 0          /* 0 <= ix < 2048 */
       ? (~linbuf[n]) >> 4       /* 1's complement for negative values */
       : (linbuf[n]) >> 4;
 
     /* Do more, if exponent > 0 */
-    if (ix > 15) {              /* exponent=0 for ix <= 15 */
-      iexp = 1;                 /* first step: */
-      while (ix > 16 + 15) {    /* find mantissa and exponent */
-        ix >>= 1;
-        iexp++;
-      }
-      ix -= 16;                 /* second step: remove leading '1' */
-
-      ix += iexp << 4;          /* now compute encoded value */
-    }
+    iexp = g711_seglen[ix >> 4];        /* exponent=0 for ix <= 15 */
+    if (iexp > 0)               /* mantissa without the leading '1' */
+      ix = (iexp << 4) + ((ix >> (iexp - 1)) & 0x000F);
+
     if (linbuf[n] >= 0)
       ix |= (0x0080);           /* add sign bit */
 
@@ -152,30 +452,17 @@ void alaw_compress (long lseg, short *linbuf, short *logbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated A-law expansion function
+   16.Oct.26	1.1	Table look-up; AVX2 version
 
   ============================================================================
 */
 void alaw_expand (long lseg, short *logbuf, short *linbuf) {
-  short ix, mant, iexp;
   long n;
 
-  for (n = 0; n < lseg; n++) {
-    ix = logbuf[n] ^ (0x0055);  /* re-toggle toggled bits */
-
-    ix &= (0x007F);             /* remove sign bit */
-    iexp = ix >> 4;             /* extract exponent */
-    mant = ix & (0x000F);       /* now get mantissa */
-    if (iexp > 0)
-      mant = mant + 16;         /* add leading '1', if exponent > 0 */
+  G711_AVX2_DISPATCH (n, lseg, alaw_expand_block_avx2, logbuf, linbuf);
 
-    mant = (mant << 4) + (0x0008);      /* now mantissa left justified and */
-    /* 1/2 quantization step added */
-    if (iexp > 1)               /* now left shift according exponent */
-      mant = mant << (iexp - 1);
-
-    linbuf[n] = logbuf[n] > 127 /* invert, if negative sample */
-      ? mant : -mant;
-  }
+  for (; n < lseg; n++)
+    linbuf[n] = alaw_expand_tab[G711_INDEX (logbuf[n])];
 }
 
 /* ................... End of alaw_expand() ..................... */
@@ -202,18 +489,20 @@ void alaw_expand (long lseg, short *logbuf, short *linbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated mu-law compression function
+   16.Oct.26	1.1	Segment from a table instead of a loop; AVX2 version
 
   ==========================================================================
 */
 void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
   long n;                       /* samples's count */
-  short i;                      /* aux.var. */
   short absno;                  /* absolute value of linear (input) sample */
   short segno;                  /* segment (Table 2/G711, column 1) */
   short low_nibble;             /* low nibble of log companded sample */
   short high_nibble;            /* high nibble of log companded sample */
 
-  for (n = 0; n < lseg; n++) {
+  G711_AVX2_DISPATCH (n, lseg, ulaw_compress_block_avx2, linbuf, logbuf);
+
+  for (; n < lseg; n++) {
     /* -------------------------------------------------------------------- */
     /* Change from 14 bit left justified to 14 bit right justified */
     /* Compute absolute value; adjust for easy processing */
@@ -227,12 +516,7 @@ void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
       absno = (0x1FFF);
 
     /* Determination of sample's segment */
-    i = absno >> 6;
-    segno = 1;
-    while (i != 0) {
-      segno++;
-      i >>= 1;
-    }
+    segno = 1 + g711_seglen[absno >> 6];
 
     /* Mounting the high-nibble of the log-PCM sample */
     high_nibble = (0x0008) - segno;
@@ -275,35 +559,92 @@ void ulaw_compress (long lseg, short *linbuf, short *logbuf) {
 
    HISTORY:
    10.Dec.91	1.0	Separated mu law expansion function
+   16.Oct.26	1.1	Table look-up; AVX2 version
 
   ============================================================================
 */
 
 void ulaw_expand (long lseg, short *logbuf, short *linbuf) {
   long n;                       /* aux.var. */
-  short segment;                /* segment (Table 2/G711, column 1) */
-  short mantissa;               /* low nibble of log companded sample */
-  short exponent;               /* high nibble of log companded sample */
-  short sign;                   /* sign of output sample */
-  short step;
-
-  for (n = 0; n < lseg; n++) {
-    sign = logbuf[n] < (0x0080) /* sign-bit = 1 for positiv values */
-      ? -1 : 1;
-    mantissa = ~logbuf[n];      /* 1's complement of input value */
-    exponent = (mantissa >> 4) & (0x0007);      /* extract exponent */
-    segment = exponent + 1;     /* compute segment number */
-    mantissa = mantissa & (0x000F);     /* extract mantissa */
-
-    /* Compute Quantized Sample (14 bit left justified!) */
-    step = (4) << segment;      /* position of the LSB */
-    /* = 1 quantization step) */
-    linbuf[n] = sign *          /* sign */
-      (((0x0080) << exponent)   /* '1', preceding the mantissa */
-       +step * mantissa         /* left shift of mantissa */
-       + step / 2               /* 1/2 quantization step */
-       - 4 * 33);
-  }
+
+  G711_AVX2_DISPATCH (n, lseg, ulaw_expand_block_avx2, logbuf, linbuf);
+
+  for (; n < lseg; n++)
+    linbuf[n] = ulaw_expand_tab[G711_INDEX (logbuf[n])];
 }
 
 /* ................... End of ulaw_expand() ..................... */
+
+
+/* ................... Begin of alaw_to_ulaw() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: alaw_to_ulaw
+
+   DESCRIPTION: A-law to u-law transcoding, without the linear samples in
+                between; same result as alaw_expand() followed by
+                ulaw_compress(). A single table look-up per sample, for
+                all kernels, as fast as the AVX2 arithmetic.
+
+   PROTOTYPE: void alaw_to_ulaw(long lseg, short *alawbuf, short *ulawbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     alawbuf:	(In)  buffer with A-law samples (8 bit right justified,
+                      without sign extension)
+     ulawbuf:	(Out) buffer with u-law samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ============================================================================
+*/
+void alaw_to_ulaw (long lseg, short *alawbuf, short *ulawbuf) {
+  long n;
+
+  for (n = 0; n < lseg; n++)
+    ulawbuf[n] = alaw_to_ulaw_tab[G711_INDEX (alawbuf[n])];
+}
+
+/* ................... End of alaw_to_ulaw() ..................... */
+
+
+/* ................... Begin of ulaw_to_alaw() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: ulaw_to_alaw
+
+   DESCRIPTION: u-law to A-law transcoding, without the linear samples in
+                between; same result as ulaw_expand() followed by
+                alaw_compress(). A single table look-up per sample, for
+                all kernels, as fast as the AVX2 arithmetic.
+
+   PROTOTYPE: void ulaw_to_alaw(long lseg, short *ulawbuf, short *alawbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     ulawbuf:	(In)  buffer with u-law samples (8 bit right justified,
+                      without sign extension)
+     alawbuf:	(Out) buffer with A-law samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ============================================================================
+*/
+void ulaw_to_alaw (long lseg, short *ulawbuf, short *alawbuf) {
+  long n;
+
+  for (n = 0; n < lseg; n++)
+    alawbuf[n] = ulaw_to_alaw_tab[G711_INDEX (ulawbuf[n])];
+}
+
+/* ................... End of ulaw_to_alaw() ..................... */
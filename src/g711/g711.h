@@ -16,10 +16,12 @@
 			and <Volker.Springer@eedn.ericsson.se>
    31.Jan.2000  v3.01   [version no.aligned with g711.c] Updated list of 
                         compilers for smart prototypes
+   16.Oct.2026  v3.02   Added alaw_to_ulaw(), ulaw_to_alaw() and
+                        g711_select_kernel()
   ============================================================================
 */
 #ifndef G711_defined
-#define G711_defined 301
+#define G711_defined 302
 
 /* Smart function prototypes: for [ag]cc, VaxC, and [tb]cc */
 #if !defined(ARGS)
@@ -36,6 +38,14 @@ void alaw_compress ARGS ((long lseg, short *linbuf, short *logbuf));
 void alaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
 void ulaw_compress ARGS ((long lseg, short *linbuf, short *logbuf));
 void ulaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
+void alaw_to_ulaw ARGS ((long lseg, short *alawbuf, short *ulawbuf));
+void ulaw_to_alaw ARGS ((long lseg, short *ulawbuf, short *alawbuf));
+int g711_select_kernel ARGS ((int kernel));
+
+/* Implementations selectable with g711_select_kernel(); all bit-exact */
+#define G711_KERNEL_AUTO   0    /* best one supported by the CPU (default) */
+#define G711_KERNEL_SCALAR 1    /* portable C, table-driven */
+#define G711_KERNEL_AVX2   2    /* x86 AVX2, 16 samples per iteration */
 
 /* Definitions for better user interface (?!) */
 #define IS_LIN 1
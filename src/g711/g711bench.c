@@ -0,0 +1,281 @@
+/*                                                         16/Oct/2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a benchmark of the G.711 functions of g711.c:
+	the loops of the previous versions, kept here as alaw_compress_old()
+	and so on, and the table-driven and AVX2 kernels of the current
+	version, selected with g711_select_kernel(). Each kernel is first
+	checked against the old functions for all the 65536 short input
+	values, including the transcoders alaw_to_ulaw() and ulaw_to_alaw()
+	against expansion followed by compression; then the speed of each
+	function is reported in samples per second.
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "g711.h"
+
+#define NFUNC 6
+
+static void display_usage () {
+  printf ("G711BENCH.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Program to check and time the G.711 kernels\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ g711bench [-options]\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -n N.......... number of samples per function [default: 100000000]\n");
+  printf ("  -frame L...... samples per call of the functions [default: 256]\n");
+  printf ("\n");
+  exit (2);
+}
+
+
+/* alaw_compress(), alaw_expand(), ulaw_compress() and ulaw_expand() as in
+   g711.c up to v3.01 */
+static void alaw_compress_old (long lseg, short *linbuf, short *logbuf) {
+  short ix, iexp;
+  long n;
+
+  for (n = 0; n < lseg; n++) {
+    ix = linbuf[n] < 0 ? (~linbuf[n]) >> 4 : (linbuf[n]) >> 4;
+    if (ix > 15) {
+      iexp = 1;
+      while (ix > 16 + 15) {
+        ix >>= 1;
+        iexp++;
+      }
+      ix -= 16;
+      ix += iexp << 4;
+    }
+    if (linbuf[n] >= 0)
+      ix |= (0x0080);
+    logbuf[n] = ix ^ (0x0055);
+  }
+}
+
+static void alaw_expand_old (long lseg, short *logbuf, short *linbuf) {
+  short ix, mant, iexp;
+  long n;
+
+  for (n = 0; n < lseg; n++) {
+    ix = logbuf[n] ^ (0x0055);
+    ix &= (0x007F);
+    iexp = ix >> 4;
+    mant = ix & (0x000F);
+    if (iexp > 0)
+      mant = mant + 16;
+    mant = (mant << 4) + (0x0008);
+    if (iexp > 1)
+      mant = mant << (iexp - 1);
+    linbuf[n] = logbuf[n] > 127 ? mant : -mant;
+  }
+}
+
+static void ulaw_compress_old (long lseg, short *linbuf, short *logbuf) {
+  long n;
+  short i, absno, segno, low_nibble, high_nibble;
+
+  for (n = 0; n < lseg; n++) {
+    absno = linbuf[n] < 0 ? ((~linbuf[n]) >> 2) + 33 : ((linbuf[n]) >> 2) + 33;
+    if (absno > (0x1FFF))
+      absno = (0x1FFF);
+    i = absno >> 6;
+    segno = 1;
+    while (i != 0) {
+      segno++;
+      i >>= 1;
+    }
+    high_nibble = (0x0008) - segno;
+    low_nibble = (absno >> segno) & (0x000F);
+    low_nibble = (0x000F) - low_nibble;
+    logbuf[n] = (high_nibble << 4) | low_nibble;
+    if (linbuf[n] >= 0)
+      logbuf[n] = logbuf[n] | (0x0080);
+  }
+}
+
+static void ulaw_expand_old (long lseg, short *logbuf, short *linbuf) {
+  long n;
+  short segment, mantissa, exponent, sign, step;
+
+  for (n = 0; n < lseg; n++) {
+    sign = logbuf[n] < (0x0080) ? -1 : 1;
+    mantissa = ~logbuf[n];
+    exponent = (mantissa >> 4) & (0x0007);
+    segment = exponent + 1;
+    mantissa = mantissa & (0x000F);
+    step = (4) << segment;
+    linbuf[n] = sign * (((0x0080) << exponent) + step * mantissa + step / 2 - 4 * 33);
+  }
+}
+
+/* Transcoding by the linear samples, with the old functions */
+static void alaw_to_ulaw_old (long lseg, short *alawbuf, short *ulawbuf) {
+  short lin[256];
+  long i, count;
+
+  for (i = 0; i < lseg; i += count) {
+    count = (lseg - i < 256) ? lseg - i : 256;
+    alaw_expand_old (count, alawbuf + i, lin);
+    ulaw_compress_old (count, lin, ulawbuf + i);
+  }
+}
+
+static void ulaw_to_alaw_old (long lseg, short *ulawbuf, short *alawbuf) {
+  short lin[256];
+  long i, count;
+
+  for (i = 0; i < lseg; i += count) {
+    count = (lseg - i < 256) ? lseg - i : 256;
+    ulaw_expand_old (count, ulawbuf + i, lin);
+    alaw_compress_old (count, lin, alawbuf + i);
+  }
+}
+
+
+typedef void (*G711_FUNC) ARGS ((long lseg, short *inp, short *out));
+
+static char *name[NFUNC] = { "alaw_compress", "alaw_expand", "ulaw_compress", "ulaw_expand", "alaw_to_ulaw", "ulaw_to_alaw" };
+static G711_FUNC func_old[NFUNC] = { alaw_compress_old, alaw_expand_old, ulaw_compress_old, ulaw_expand_old, alaw_to_ulaw_old, ulaw_to_alaw_old };
+static G711_FUNC func_new[NFUNC] = { alaw_compress, alaw_expand, ulaw_compress, ulaw_expand, alaw_to_ulaw, ulaw_to_alaw };
+
+/* Seconds taken by f over nsmp samples, in calls of lseg samples of inp */
+static double time_function (G711_FUNC f, long nsmp, long lseg, short *inp, long ninp, short *out) {
+  long i, count;
+  clock_t t0 = clock ();
+
+  for (i = 0; i < nsmp; i += count) {
+    count = (nsmp - i < lseg) ? nsmp - i : lseg;
+    f (count, inp + i % (ninp - lseg + 1), out);
+  }
+  return (double) (clock () - t0) / CLOCKS_PER_SEC;
+}
+
+
+int main (int argc, char *argv[]) {
+  short *all, *ref, *out, *speech, *code[2];
+  long nsmp = 100000000, lseg = 256, ninp = 65536, i, k, ndiff = 0;
+  double t[3];
+  int f, kernel, nkernels;
+  static char *kernel_name[3] = { "old", "scalar", "avx2" };
+  static int kernel_id[3] = { -1, G711_KERNEL_SCALAR, G711_KERNEL_AVX2 };
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-n") == 0) {
+      nsmp = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-frame") == 0) {
+      lseg = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
+  if (nsmp < 1 || lseg < 1 || lseg > ninp) {
+    fprintf (stderr, "ERROR! Invalid number of samples or frame length\n\n");
+    exit (-1);
+  }
+
+
+  /* ......... INITIALIZATIONS ......... */
+
+  all = (short *) malloc (ninp * sizeof (short));
+  ref = (short *) malloc (ninp * sizeof (short));
+  out = (short *) malloc (ninp * sizeof (short));
+  speech = (short *) malloc (ninp * sizeof (short));
+  code[0] = (short *) malloc (ninp * sizeof (short));
+  code[1] = (short *) malloc (ninp * sizeof (short));
+  if (all == NULL || ref == NULL || out == NULL || speech == NULL || code[0] == NULL || code[1] == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+
+  /* all the short values, and a decaying noise as input of the timings */
+  srand (1);
+  for (i = 0; i < ninp; i++) {
+    all[i] = (short) (i - 32768);
+    speech[i] = (short) ((rand () % 65536 - 32768) >> (i / 512 % 12));
+  }
+  alaw_compress_old (ninp, speech, code[0]);
+  ulaw_compress_old (ninp, speech, code[1]);
+
+  nkernels = (g711_select_kernel (G711_KERNEL_AVX2) == G711_KERNEL_AVX2) ? 3 : 2;
+
+
+  /* ......... CHECK AND TIMING ......... */
+
+  printf ("%ld samples in frames of %ld\n", nsmp, lseg);
+  for (f = 0; f < NFUNC; f++) {
+    func_old[f] (ninp, all, ref);
+    for (kernel = 0; kernel < nkernels; kernel++) {
+      if (kernel > 0) {
+        g711_select_kernel (kernel_id[kernel]);
+
+        /* all input values, in one call and in calls of lseg samples */
+        for (i = 0; i < ninp; i += lseg)
+          func_new[f] ((ninp - i < lseg) ? ninp - i : lseg, all + i, out + i);
+        for (k = 0, i = 0; i < ninp; i++)
+          k += (out[i] != ref[i]);
+        func_new[f] (ninp, all, out);
+        for (i = 0; i < ninp; i++)
+          k += (out[i] != ref[i]);
+        if (k) {
+          printf ("%s (%s): %ld samples differ from the old function\n", name[f], kernel_name[kernel], k);
+          ndiff += k;
+        }
+      }
+      t[kernel] = time_function (kernel ? func_new[f] : func_old[f], nsmp, lseg, (f == 0 || f == 2) ? speech : code[(f == 3 || f == 5) ? 1 : 0], ninp, out);
+    }
+    for (kernel = 0; kernel < nkernels; kernel++)
+      printf ("%-13s %-6s %8.3f s  %12.0f samples/s  speed-up %5.1f\n", name[f], kernel_name[kernel], t[kernel], (t[kernel] > 0) ? nsmp / t[kernel] : 0, (t[kernel] > 0) ? t[0] / t[kernel] : 0);
+  }
+  printf ("%ld samples differ from the old functions\n", ndiff);
+
+  free (all);
+  free (ref);
+  free (out);
+  free (speech);
+  free (code[0]);
+  free (code[1]);
+  return (ndiff != 0);
+}
@@ -1,4 +1,4 @@
-/*                                                        02.Feb.2010 v3.3
+/*                                                        16.Oct.2026 v3.4
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   G711DEMO.C
@@ -39,6 +39,9 @@
                 read from a file.
   -skip         is the number of samples to skip before the beginning
                 of the 1st block.
+  -kernel k     implementation of the G711 functions: scalar, avx2, or
+                auto (default, best one supported by the CPU). All give
+                the same results.
 
   Example:
   $ G711 u lili voice.ref voice.rel 256 3 45
@@ -146,6 +149,7 @@
                    size is not a multiple of the file
                    size. <simao.campos@labs.comsat.com>
   02.Feb.2010 v3.3 Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v3.4 Added option -kernel
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ugstdemo.h"           /* UGST defines for demo programs */
 
@@ -179,7 +183,7 @@
   --------------------------------------------------------------------------
 */
 void display_usage () {
-  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.3 of 02.Feb.2010 \n");
+  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.4 of 16.Oct.2026 \n");
   fprintf (stderr, "\n");
   fprintf (stderr, "  Description:\n");
   fprintf (stderr, "  ~~~~~~~~~~~~\n");
@@ -208,6 +212,7 @@ void display_usage () {
   fprintf (stderr, "  -?         displays this message.\n");
   fprintf (stderr, "  -r         disables even-bit swap by A-law encoding and decoding.\n");
   fprintf (stderr, "  -skip      is the number of samples to skip.\n");
+  fprintf (stderr, "  -kernel k  scalar, avx2 or auto [auto]; all give the same results.\n");
   fprintf (stderr, "\n");
 
   /* Quit program */
@@ -272,6 +277,22 @@ int main (int argc, char *argv[]) {
         /* Move argv over the option to the next argument */
         argv += 2;
 
+        /* Update argc */
+        argc -= 2;
+      } else if (strcmp (argv[1], "-kernel") == 0) {
+        /* Implementation of the G711 functions */
+        if (strcmp (argv[2], "scalar") == 0)
+          g711_select_kernel (G711_KERNEL_SCALAR);
+        else if (strcmp (argv[2], "avx2") == 0)
+          g711_select_kernel (G711_KERNEL_AVX2);
+        else if (strcmp (argv[2], "auto") != 0) {
+          fprintf (stderr, "ERROR! Invalid kernel \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Move argv over the option to the next argument */
+        argv += 2;
+
         /* Update argc */
         argc -= 2;
       } else if (argv[1][1] == '?') {
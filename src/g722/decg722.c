@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v3.0
+/*                                                          16.Oct.2026 v3.2
 ============================================================================
 
 DECG722.C
@@ -67,6 +67,7 @@ History:
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
 02.Feb.10  v3.1       Implicit casting of toupper() argument removed.
                       (y.hiwasaki)
+16.Oct.26  v3.2       Reference QMF selected for the complexity count
 ============================================================================
 */
 
@@ -375,6 +376,7 @@ int main (int argc, char *argv[]) {
   g722_reset_decoder (&decoder);
 
 #ifdef WMOPS
+  g722_select_qmf (G722_QMF_REFERENCE);     /* count the QMF operators too */
   setFrameRate (16000, N);
   spe1Id = getCounterId ("lost frame processing");
   setCounter (spe1Id);
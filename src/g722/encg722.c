@@ -1,4 +1,4 @@
-/*                     v3.0 - 10/Jan/2007
+/*                     v3.1 - 16/Oct/2026
 ============================================================================
 
 ENCG722.C
@@ -64,6 +64,7 @@ History:
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators and G.729.1 methodology
                       Added some castings to avoid warnings
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Reference QMF selected for the complexity count
 ============================================================================
 */
 
@@ -255,6 +256,7 @@ int main (int argc, char *argv[]) {
   g722_reset_encoder (&encoder);
 
 #ifdef WMOPS
+  g722_select_qmf (G722_QMF_REFERENCE);     /* count the QMF operators too */
   setFrameRate (16000, N);
   spe1Id = getCounterId ("encoding");
   setCounter (spe1Id);
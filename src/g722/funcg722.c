@@ -42,6 +42,7 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added qmf_tx_block() and qmf_rx_block()
   ============================================================================
 */
 
@@ -1538,4 +1539,155 @@ void qmf_rx (Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state *
 #undef delayx
 /* ..................... End of qmf_rx() ..................... */
 
+/*___________________________________________________________________________
+
+    Function Name : qmf_tx_block
+
+    Purpose :
+
+     Same as n calls of qmf_tx(), for a block of n pairs of input samples,
+     without basic operators nor complexity counting. The past samples
+     are copied once per block ahead of the input, in time order, and the
+     filter slides over them, instead of shifting the delay line for each
+     pair; the delay line of the state is left as qmf_tx() leaves it.
+     The accumulators need no saturation: the 12 coefficients of each
+     have a sum of magnitudes of 12964, so |accuma|, |accumb| < 2^29 and
+     2*(accuma +/- accumb) < 2^31.
+
+    Inputs :
+     x    - 2*n input samples, in time order (read-only)
+     xl   - n lower band samples (write-only)
+     xh   - n higher band samples (write-only)
+     n    - number of sample pairs
+     s    - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+#define delayx s->qmf_tx_delayx
+void qmf_tx_block (Word16 * x, Word16 * xl, Word16 * xh, Word32 n, g722_state * s) {
+  Word16 buf[22 + 2 * G722_QMF_BLOCK];  /* past 22 samples + current block */
+  Word16 *px;
+  Word32 accuma, accumb, comp_low, comp_high;
+  Word32 i, j, k, len;
+
+  if (n <= 0)
+    return;
+
+  /* delayx[2..23] hold the past samples, newest first */
+  for (k = 0; k < 22; k++)
+    buf[21 - k] = delayx[k + 2];
+
+  for (i = 0; i < n; i += len) {
+    len = (n - i < G722_QMF_BLOCK) ? n - i : G722_QMF_BLOCK;
+    for (k = 0; k < 2 * len; k++)
+      buf[22 + k] = x[2 * i + k];
+
+    for (j = 0; j < len; j++) {
+      /* px[-k] is delayx[k] of qmf_tx() */
+      px = buf + 22 + 2 * j + 1;
+      accuma = accumb = 0;
+      for (k = 0; k < 24; k += 2) {
+        accuma += (Word32) coef_qmf[k] * px[-k];
+        accumb += (Word32) coef_qmf[k + 1] * px[-k - 1];
+      }
+      comp_low = (accuma + accumb) * 2 >> 16;
+      comp_high = (accuma - accumb) * 2 >> 16;
+      xl[i + j] = (Word16) (comp_low > 16383 ? 16383 : comp_low < -16384 ? -16384 : comp_low);
+      xh[i + j] = (Word16) (comp_high > 16383 ? 16383 : comp_high < -16384 ? -16384 : comp_high);
+    }
+
+    /* keep the last 22 samples for the next block */
+    for (k = 0; k < 22; k++)
+      buf[k] = buf[2 * len + k];
+  }
+
+  /* Delay line as shifted by qmf_tx() after the last pair */
+  for (k = 0; k < 22; k++)
+    delayx[k + 2] = buf[21 - k];
+  delayx[0] = buf[21];
+  delayx[1] = buf[20];
+}
+
+#undef delayx
+/* ..................... End of qmf_tx_block() ..................... */
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_rx_block
+
+    Purpose :
+
+     Same as n calls of qmf_rx(), for a block of n pairs of lower and
+     higher band samples, without basic operators nor complexity
+     counting, and with the delay line handled as in qmf_tx_block().
+     The accumulators are below 2^29 as in qmf_tx_block(); the
+     saturation of L_shl(accum, 4) and of the sum and difference of rl
+     and rh is done explicitly.
+
+    Inputs :
+     rl   - n lower band samples (read-only)
+     rh   - n higher band samples (read-only)
+     xout - 2*n output samples, in time order (write-only)
+     n    - number of sample pairs
+     s    - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+#define delayx s->qmf_rx_delayx
+void qmf_rx_block (Word16 * rl, Word16 * rh, Word16 * xout, Word32 n, g722_state * s) {
+  Word16 buf[22 + 2 * G722_QMF_BLOCK];  /* past 22 samples + current block */
+  Word16 *px;
+  Word32 accuma, accumb, sum, diff;
+  Word32 i, j, k, len;
+
+  if (n <= 0)
+    return;
+
+  /* delayx[2..23] hold the past samples, newest first */
+  for (k = 0; k < 22; k++)
+    buf[21 - k] = delayx[k + 2];
+
+  for (i = 0; i < n; i += len) {
+    len = (n - i < G722_QMF_BLOCK) ? n - i : G722_QMF_BLOCK;
+    for (j = 0; j < len; j++) {
+      /* delayx[1] and delayx[0] of qmf_rx() */
+      sum = (Word32) rl[i + j] + rh[i + j];
+      diff = (Word32) rl[i + j] - rh[i + j];
+      buf[22 + 2 * j] = (Word16) (sum > MAX_16 ? MAX_16 : sum < MIN_16 ? MIN_16 : sum);
+      buf[23 + 2 * j] = (Word16) (diff > MAX_16 ? MAX_16 : diff < MIN_16 ? MIN_16 : diff);
+
+      px = buf + 23 + 2 * j;
+      accuma = accumb = 0;
+      for (k = 0; k < 24; k += 2) {
+        accuma += (Word32) coef_qmf[k] * px[-k];
+        accumb += (Word32) coef_qmf[k + 1] * px[-k - 1];
+      }
+
+      /* extract_h (L_shl (accum, 4)) */
+      accuma >>= 12;
+      accumb >>= 12;
+      xout[2 * (i + j)] = (Word16) (accuma > MAX_16 ? MAX_16 : accuma < MIN_16 ? MIN_16 : accuma);
+      xout[2 * (i + j) + 1] = (Word16) (accumb > MAX_16 ? MAX_16 : accumb < MIN_16 ? MIN_16 : accumb);
+    }
+
+    /* keep the last 22 samples for the next block */
+    for (k = 0; k < 22; k++)
+      buf[k] = buf[2 * len + k];
+  }
+
+  /* Delay line as shifted by qmf_rx() after the last pair */
+  for (k = 0; k < 22; k++)
+    delayx[k + 2] = buf[21 - k];
+  delayx[0] = buf[21];
+  delayx[1] = buf[20];
+}
+
+#undef delayx
+/* ..................... End of qmf_rx_block() ..................... */
+
 /* ******************** End of funcg722.c ***************************** */
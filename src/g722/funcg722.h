@@ -25,6 +25,7 @@
                         based on the CNET's 07/01/90 version 2.00
    01.Jul.95    v2.0    Smart prototypes that work with many compilers; 
                         reformated; state variable structure added. 
+   16.Oct.26    v3.1    Added qmf_tx_block() and qmf_rx_block()
   ============================================================================
 */
 #ifndef FUNCG722_H
@@ -105,6 +106,11 @@ void uppol2 ARGS ((Word16 al[], Word16 plt[]));
 void upzero ARGS ((Word16 dlt[], Word16 bl[]));
 void qmf_tx ARGS ((Word16 xin0, Word16 xin1, Word16 * xl, Word16 * xh, g722_state * s));
 void qmf_rx ARGS ((Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state * s));
+void qmf_tx_block ARGS ((Word16 * x, Word16 * xl, Word16 * xh, Word32 n, g722_state * s));
+void qmf_rx_block ARGS ((Word16 * rl, Word16 * rh, Word16 * xout, Word32 n, g722_state * s));
+
+/* Sample pairs per pass of qmf_tx_block() and qmf_rx_block() */
+#define G722_QMF_BLOCK 256
 
 #endif /* FUNCG722_H */
 /* ........................ End of file funcg722.h ......................... */
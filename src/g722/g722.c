@@ -1,4 +1,4 @@
-/*                     v3.0 - 10/Jan/2007
+/*                     v3.1 - 16/Oct/2026
   ============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -39,11 +39,30 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       g722_encode() and g722_decode() use the block QMF
+                      filters unless g722_select_qmf() asks for the
+                      reference ones (for complexity counting)
   ============================================================================
 */
 #include "g722.h"
 #include "stl.h"
 
+/* QMF filters in use, G722_QMF_xxx */
+static int g722_qmf = G722_QMF_FAST;
+
+
+/* Chooses the QMF filters of g722_encode() and g722_decode(): the block
+   filters without basic operators (G722_QMF_FAST, default), or qmf_tx()
+   and qmf_rx(), whose operators are counted (G722_QMF_REFERENCE). The
+   results are the same. Returns the choice. */
+int g722_select_qmf (int qmf) {
+  g722_qmf = (qmf == G722_QMF_REFERENCE) ? G722_QMF_REFERENCE : G722_QMF_FAST;
+  return g722_qmf;
+}
+
+/* .................... end of g722_select_qmf() ....................... */
+
+
 void g722_reset_encoder (g722_state * encoder) {
   Word16 xl, il;
   Word16 xh, ih, j;
@@ -73,12 +92,27 @@ Word32 g722_encode (short *incode, short *code, Word32 read1, g722_state * encod
   Word16 xin0, xin1;
 
   /* Auxiliary variables */
-  Word32 i;
+  Word32 i, j, n;
   Word16 *p_incode;
+  Word16 xl_buf[G722_QMF_BLOCK], xh_buf[G722_QMF_BLOCK];
 
   /* Divide sample counter by 2 to account for QMF operation */
   read1 = L_shr (read1, 1);
 
+  /* Block QMF, then the band encoders over the block */
+  if (g722_qmf == G722_QMF_FAST) {
+    for (i = 0; i < read1; i += n) {
+      n = (read1 - i < G722_QMF_BLOCK) ? read1 - i : G722_QMF_BLOCK;
+      qmf_tx_block (incode + 2 * i, xl_buf, xh_buf, n, encoder);
+      for (j = 0; j < n; j++) {
+        il = lsbcod (xl_buf[j], 0, encoder);
+        ih = hsbcod (xh_buf[j], 0, encoder);
+        code[i + j] = ((ih << 6) + il) & 0xFF;
+      }
+    }
+    return (read1);
+  }
+
   /* Main loop - never reset */
   p_incode = incode;
 #ifdef WMOPS
@@ -143,7 +177,21 @@ short g722_decode (short *code, short *outcode, short mode, short read1, g722_st
   Word16 xout1, xout2;
 
   /* Auxiliary variables */
-  short i;
+  short i, j, n;
+  Word16 rl_buf[G722_QMF_BLOCK], rh_buf[G722_QMF_BLOCK];
+
+  /* Band decoders over a block, then block QMF */
+  if (g722_qmf == G722_QMF_FAST) {
+    for (i = 0; i < read1; i += n) {
+      n = (read1 - i < G722_QMF_BLOCK) ? read1 - i : G722_QMF_BLOCK;
+      for (j = 0; j < n; j++) {
+        rl_buf[j] = lsbdec ((Word16) (code[i + j] & 0x3F), mode, 0, decoder);
+        rh_buf[j] = hsbdec ((Word16) ((code[i + j] >> 6) & 0x03), 0, decoder);
+      }
+      qmf_rx_block (rl_buf, rh_buf, outcode + 2 * i, n, decoder);
+    }
+    return (shl (read1, 1));
+  }
 
   /* Decode - reset is never applied here */
   for (i = 0; i < read1; i++) {
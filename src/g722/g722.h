@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: G722.H                                  v3.0 - 10/Jan/2007
+   File: G722.H                                  v3.2 - 16/Oct/2026
   ============================================================================
 
                             UGST/ITU-T G722 MODULE
@@ -14,6 +14,8 @@
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.1 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added g722_select_qmf()
+16.Oct.26  v3.2       Added the multi-channel functions of g722multi.c
   ============================================================================
 */
 #ifndef G722_H
@@ -66,6 +68,38 @@ void g722_reset_encoder ARGS ((g722_state * encoder));
 Word32 g722_encode ARGS ((short *incode, short *code, Word32 nsmp, g722_state * encoder));
 void g722_reset_decoder ARGS ((g722_state * decoder));
 short g722_decode ARGS ((short *code, short *outcode, short mode, short nsmp, g722_state * decoder));
+int g722_select_qmf ARGS ((int qmf));
+
+/* QMF filters used by g722_encode() and g722_decode(); both bit-exact */
+#define G722_QMF_FAST      0    /* qmf_tx_block()/qmf_rx_block(), not counted (default) */
+#define G722_QMF_REFERENCE 1    /* qmf_tx()/qmf_rx(), with complexity counting */
+
+/* State of N channels for g722multi.c: each variable of one sub-band of
+   g722_state is a row of N words, one per channel (a[0] and b[0] unused) */
+typedef struct {
+  Word16 *a[3], *b[7], *d[7], *p[3], *r[3];
+  Word16 *det, *nb, *s, *sp, *sz;
+} G722_MULTI_BAND;
+
+#define G722_MULTI_ROWS (2 * 26 + 48 + 3)       /* rows of data below */
+
+typedef struct {
+  long nchan;                   /* number of channels */
+  G722_MULTI_BAND band[2];      /* lower and higher sub-band */
+  Word16 *qmf;                  /* QMF delay lines, 24 rows written twice */
+  int pos;                      /* row of delayx[0] in qmf */
+  Word16 *x[2], *w;             /* scratch rows */
+  Word32 *acc;                  /* QMF accumulators, 2 rows */
+  Word16 *data;                 /* storage of all the rows */
+} g722_multi_state;
+
+/* Multi-channel functions (g722multi.c); buffers interleaved by channel */
+g722_multi_state *g722_multi_create ARGS ((long nchan));
+void g722_multi_free ARGS ((g722_multi_state * s));
+void g722_reset_encoder_multi ARGS ((g722_multi_state * s));
+Word32 g722_encode_multi ARGS ((short *incode, short *code, Word32 nsmp, g722_multi_state * s));
+void g722_reset_decoder_multi ARGS ((g722_multi_state * s));
+Word32 g722_decode_multi ARGS ((short *code, short *outcode, short mode, Word32 nsmp, g722_multi_state * s));
 
 #endif /* G722_H */
 /* ................. End of file g722.h .................................. */
@@ -0,0 +1,226 @@
+/*                                                         16/Oct/2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a benchmark of the multi-channel G.722 functions
+	of g722multi.c. N channels are made from one 16 kHz input file,
+	channel c starting at sample c*L/N of the file of L samples (and
+	wrapping around). Each channel is encoded with g722_encode() on its
+	own g722_state, and all of them with g722_encode_multi(); the same
+	for the decoders, in the three modes. The outputs must be identical;
+	the time taken by each version is reported.
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "g722.h"
+
+static void display_usage () {
+  printf ("G722BENCH.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Program to check and time the multi-channel G.722 functions\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ g722bench [-options] InpFile\n");
+  printf (" where:\n");
+  printf ("  InpFile...... 16 kHz speech file, 16 bit samples\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -ch N......... number of channels [default: 16]\n");
+  printf ("  -frame L...... samples per channel and call [default: 160]\n");
+  printf ("  -n R.......... passes over the input file [default: 1]\n");
+  printf ("\n");
+  exit (2);
+}
+
+
+int main (int argc, char *argv[]) {
+  FILE *Fi;
+  short *inp, *multi_inp, *chan_inp, *ref_code, *code, *ref_out, *out;
+  long nchan = 16, lseg = 160, npass = 1, ninp, nframes, c, i, k, f, pass, ndiff = 0;
+  g722_state *state;
+  g722_multi_state *mstate;
+  clock_t t0;
+  double t_ref[4], t_multi[4];
+  static char *name[4] = { "encoder", "decoder mode 1", "decoder mode 2", "decoder mode 3" };
+  short mode;
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-ch") == 0) {
+      nchan = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-frame") == 0) {
+      lseg = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-n") == 0) {
+      npass = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
+  if (argc < 2)
+    display_usage ();
+  lseg &= ~1L;
+  if (nchan < 1 || lseg < 2 || lseg > 32766 || npass < 1) {
+    fprintf (stderr, "ERROR! Invalid number of channels, frame length or passes\n\n");
+    exit (-1);
+  }
+
+
+  /* ......... INITIALIZATIONS ......... */
+
+  if ((Fi = fopen (argv[1], RB)) == NULL)
+    KILL (argv[1], 2);
+  fseek (Fi, 0L, SEEK_END);
+  ninp = ftell (Fi) / sizeof (short);
+  fseek (Fi, 0L, SEEK_SET);
+  nframes = ninp / lseg;
+  if (nframes < 1) {
+    fprintf (stderr, "ERROR! Input file shorter than one frame\n\n");
+    exit (-1);
+  }
+  ninp = nframes * lseg;
+
+  inp = (short *) malloc (ninp * sizeof (short));
+  chan_inp = (short *) malloc (nchan * ninp * sizeof (short));
+  multi_inp = (short *) malloc (nchan * ninp * sizeof (short));
+  ref_code = (short *) malloc (nchan * ninp / 2 * sizeof (short));
+  code = (short *) malloc (nchan * ninp / 2 * sizeof (short));
+  ref_out = (short *) malloc (nchan * ninp * sizeof (short));
+  out = (short *) malloc (nchan * ninp * sizeof (short));
+  state = (g722_state *) malloc (nchan * sizeof (g722_state));
+  mstate = g722_multi_create (nchan);
+  if (inp == NULL || chan_inp == NULL || multi_inp == NULL || ref_code == NULL || code == NULL || ref_out == NULL || out == NULL || state == NULL || mstate == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+  if (fread (inp, sizeof (short), ninp, Fi) != (size_t) ninp)
+    KILL (argv[1], 3);
+  fclose (Fi);
+
+  /* channel c in chan_inp[c*ninp ...], and interleaved in multi_inp */
+  for (c = 0; c < nchan; c++)
+    for (i = 0; i < ninp; i++) {
+      chan_inp[c * ninp + i] = inp[(i + c * ninp / nchan) % ninp];
+      multi_inp[i * nchan + c] = chan_inp[c * ninp + i];
+    }
+
+
+  /* ......... ENCODERS ......... */
+
+  printf ("%ld channels of %ld samples in frames of %ld, %ld passes\n", nchan, ninp, lseg, npass);
+
+  t0 = clock ();
+  for (pass = 0; pass < npass; pass++)
+    for (c = 0; c < nchan; c++) {
+      g722_reset_encoder (&state[c]);
+      for (f = 0; f < nframes; f++)
+        g722_encode (chan_inp + c * ninp + f * lseg, ref_code + c * ninp / 2 + f * lseg / 2, lseg, &state[c]);
+    }
+  t_ref[0] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+  t0 = clock ();
+  for (pass = 0; pass < npass; pass++) {
+    g722_reset_encoder_multi (mstate);
+    for (f = 0; f < nframes; f++)
+      g722_encode_multi (multi_inp + f * lseg * nchan, code + f * lseg / 2 * nchan, lseg, mstate);
+  }
+  t_multi[0] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+  for (k = 0, c = 0; c < nchan; c++)
+    for (i = 0; i < ninp / 2; i++)
+      k += (code[i * nchan + c] != ref_code[c * ninp / 2 + i]);
+  if (k)
+    printf ("g722_encode_multi: %ld codewords differ from g722_encode\n", k);
+  ndiff += k;
+
+  /* the decoders use the interleaved codewords of the reference */
+  for (c = 0; c < nchan; c++)
+    for (i = 0; i < ninp / 2; i++)
+      code[i * nchan + c] = ref_code[c * ninp / 2 + i];
+
+
+  /* ......... DECODERS ......... */
+
+  for (mode = 1; mode <= 3; mode++) {
+    t0 = clock ();
+    for (pass = 0; pass < npass; pass++)
+      for (c = 0; c < nchan; c++) {
+        g722_reset_decoder (&state[c]);
+        for (f = 0; f < nframes; f++)
+          g722_decode (ref_code + c * ninp / 2 + f * lseg / 2, ref_out + c * ninp + f * lseg, mode, (short) (lseg / 2), &state[c]);
+      }
+    t_ref[mode] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock ();
+    for (pass = 0; pass < npass; pass++) {
+      g722_reset_decoder_multi (mstate);
+      for (f = 0; f < nframes; f++)
+        g722_decode_multi (code + f * lseg / 2 * nchan, out + f * lseg * nchan, mode, lseg / 2, mstate);
+    }
+    t_multi[mode] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+    for (k = 0, c = 0; c < nchan; c++)
+      for (i = 0; i < ninp; i++)
+        k += (out[i * nchan + c] != ref_out[c * ninp + i]);
+    if (k)
+      printf ("g722_decode_multi (mode %d): %ld samples differ from g722_decode\n", mode, k);
+    ndiff += k;
+  }
+
+
+  /* ......... RESULTS ......... */
+
+  for (k = 0; k < 4; k++)
+    printf ("%-14s  single %8.3f s  multi %8.3f s  %10.0f samples/s  speed-up %5.1f\n", name[k], t_ref[k], t_multi[k], (t_multi[k] > 0) ? nchan * ninp * npass / t_multi[k] : 0, (t_multi[k] > 0) ? t_ref[k] / t_multi[k] : 0);
+  printf ("%ld samples differ from the single-channel functions\n", ndiff);
+
+  free (inp);
+  free (chan_inp);
+  free (multi_inp);
+  free (ref_code);
+  free (code);
+  free (ref_out);
+  free (out);
+  free (state);
+  g722_multi_free (mstate);
+  return (ndiff != 0);
+}
@@ -0,0 +1,612 @@
+/*                     v1.0 - 16/Oct/2026
+  ============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+
+MODULE:         G722MULTI.C, G.722 ENCODER AND DECODER FOR MANY CHANNELS
+
+DESCRIPTION:
+        This file contains g722_encode_multi() and g722_decode_multi(),
+        which run N independent G.722 channels in lock step, one sample
+        (pair) of every channel at a time. The state of the channels is
+        kept in structure-of-arrays form: each variable of g722_state is
+        an array with one element per channel, so the QMF filters, the
+        quantizers and the predictors (filtep, filtez, upzero, uppol1,
+        uppol2 in funcg722.c) become loops over the channels that the
+        compiler can vectorize.
+
+        The basic operators are replaced by plain C arithmetic with the
+        same saturations (macros below), and the tables are indexed by
+        the codes directly, so every channel is bit-exact with
+        g722_encode() and g722_decode() on its own g722_state. Where
+        a basic operator cannot overflow for the values it gets, the
+        saturation is left out; the bounds are given at that point.
+
+        Input and output buffers are interleaved by channel: sample k of
+        channel c is at buf[k * nchan + c].
+
+FUNCTIONS:
+  Global (have prototype in g722.h)
+         = g722_multi_create(...)        : allocate the state of N channels
+         = g722_multi_free(...)          : release it
+         = g722_reset_encoder_multi(...) : reset all channels of an encoder
+         = g722_encode_multi(...)        : encode all channels
+         = g722_reset_decoder_multi(...) : reset all channels of a decoder
+         = g722_decode_multi(...)        : decode all channels
+
+HISTORY:
+    16.Oct.26 v1.0 Created.
+
+  ============================================================================
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "g722.h"
+
+
+/*
+ * ......... Basic operators without complexity counting .........
+ * The arguments are evaluated more than once
+ */
+#define SAT16(x)      ((x) > MAX_16 ? MAX_16 : (x) < MIN_16 ? MIN_16 : (x))
+#define ADD16(x, y)   SAT16 ((Word32) (x) + (y))
+#define SUB16(x, y)   SAT16 ((Word32) (x) - (y))
+#define MULT16(x, y)  ((Word32) (x) * (y) == 0x40000000L ? MAX_16 : ((Word32) (x) * (y)) >> 15)
+#define LIMIT(x)      ((x) > 16383 ? 16383 : (x) < -16384 ? -16384 : (x))
+
+
+/*
+ * ......... Tables .........
+ */
+
+/* Coefficients for both QMF filters, as coef_qmf[] in funcg722.c */
+static const Word16 qmf_coef[24] = {
+  3 * 2, -11 * 2, -11 * 2, 53 * 2, 12 * 2, -156 * 2,
+  32 * 2, 362 * 2, -210 * 2, -805 * 2, 951 * 2, 3876 * 2,
+  3876 * 2, 951 * 2, -805 * 2, -210 * 2, 362 * 2, 32 * 2,
+  -156 * 2, 12 * 2, 53 * 2, -11 * 2, -11 * 2, 3 * 2
+};
+
+/* 6-level quantizer decision levels of quantl(), times 8 */
+static const Word32 q6_8[30] = {
+  0, 35 * 8, 72 * 8, 110 * 8, 150 * 8, 190 * 8, 233 * 8, 276 * 8,
+  323 * 8, 370 * 8, 422 * 8, 473 * 8, 530 * 8, 587 * 8, 650 * 8, 714 * 8,
+  786 * 8, 858 * 8, 940 * 8, 1023 * 8, 1121 * 8, 1219 * 8, 1339 * 8, 1458 * 8,
+  1612 * 8, 1765 * 8, 1980 * 8, 2195 * 8, 2557 * 8, 2919 * 8
+};
+
+/* invqal(): signed oq4[ril4[il >> 2]] * 8, indexed by il >> 2 */
+static const Word16 invqal_tab[16] = {
+  0, -20456, -12896, -8968, -6288, -4240, -2584, -1200,
+  20456, 12896, 8968, 6288, 4240, 2584, 1200, 0
+};
+
+/* logscl(): wl[ril4[il >> 2]], indexed by il >> 2 */
+static const Word16 logscl_tab[16] = {
+  -60, 3042, 1198, 538, 334, 172, 58, -30,
+  3042, 1198, 538, 334, 172, 58, -30, -60
+};
+
+/* invqbl(): signed inverse quantizer output times 8, indexed by the
+   6-bit code, for modes 1 (6 bits), 2 (5 bits) and 3 (4 bits) */
+static const Word16 invqbl_tab[3][64] = {
+  {-136, -136, -136, -136, -24808, -21904, -19008, -16704,
+   -14984, -13512, -12280, -11192, -10232, -9360, -8576, -7856,
+   -7192, -6576, -6000, -5456, -4944, -4464, -4008, -3576,
+   -3168, -2776, -2400, -2032, -1688, -1360, -1040, -728,
+   24808, 21904, 19008, 16704, 14984, 13512, 12280, 11192,
+   10232, 9360, 8576, 7856, 7192, 6576, 6000, 5456,
+   4944, 4464, 4008, 3576, 3168, 2776, 2400, 2032,
+   1688, 1360, 1040, 728, 432, 136, -432, -136},
+  {-280, -280, -280, -280, -23352, -23352, -17560, -17560,
+   -14120, -14120, -11664, -11664, -9752, -9752, -8184, -8184,
+   -6864, -6864, -5712, -5712, -4696, -4696, -3784, -3784,
+   -2960, -2960, -2208, -2208, -1520, -1520, -880, -880,
+   23352, 23352, 17560, 17560, 14120, 14120, 11664, 11664,
+   9752, 9752, 8184, 8184, 6864, 6864, 5712, 5712,
+   4696, 4696, 3784, 3784, 2960, 2960, 2208, 2208,
+   1520, 1520, 880, 880, 280, 280, -280, -280},
+  {0, 0, 0, 0, -20456, -20456, -20456, -20456,
+   -12896, -12896, -12896, -12896, -8968, -8968, -8968, -8968,
+   -6288, -6288, -6288, -6288, -4240, -4240, -4240, -4240,
+   -2584, -2584, -2584, -2584, -1200, -1200, -1200, -1200,
+   20456, 20456, 20456, 20456, 12896, 12896, 12896, 12896,
+   8968, 8968, 8968, 8968, 6288, 6288, 6288, 6288,
+   4240, 4240, 4240, 4240, 2584, 2584, 2584, 2584,
+   1200, 1200, 1200, 1200, 0, 0, 0, 0}
+};
+
+/* invqah() and logsch(): signed oq2[ih2[ih]] * 8 and wh[ih2[ih]] */
+static const Word16 invqah_tab[4] = { -7408, -1616, 7408, 1616 };
+static const Word16 logsch_tab[4] = { 798, -214, 798, -214 };
+
+/* ILA table of funcg722.c, used by scalel() and scaleh() */
+static const Word16 ila[353] = {
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4,
+  4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6,
+  7, 7, 7, 7, 7, 7, 8, 8, 8, 8, 8, 9, 9, 9, 9, 10,
+  10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 13, 13, 13, 13, 14, 14,
+  15, 15, 15, 16, 16, 16, 17, 17, 18, 18, 18, 19, 19, 20, 20, 21,
+  21, 22, 22, 23, 23, 24, 24, 25, 25, 26, 27, 27, 28, 28, 29, 30,
+  31, 31, 32, 33, 33, 34, 35, 36, 37, 37, 38, 39, 40, 41, 42, 43,
+  44, 45, 46, 47, 48, 49, 50, 51, 52, 54, 55, 56, 57, 58, 60, 61,
+  63, 64, 65, 67, 68, 70, 71, 73, 75, 76, 78, 80, 82, 83, 85, 87,
+  89, 91, 93, 95, 97, 99, 102, 104, 106, 109, 111, 113, 116, 118, 121, 124,
+  127, 129, 132, 135, 138, 141, 144, 147, 151, 154, 157, 161, 165, 168, 172, 176,
+  180, 184, 188, 192, 196, 200, 205, 209, 214, 219, 223, 228, 233, 238, 244, 249,
+  255, 260, 266, 272, 278, 284, 290, 296, 303, 310, 316, 323, 331, 338, 345, 353,
+  361, 369, 377, 385, 393, 402, 411, 420, 429, 439, 448, 458, 468, 478, 489, 500,
+  511, 522, 533, 545, 557, 569, 582, 594, 607, 621, 634, 648, 663, 677, 692, 707,
+  723, 739, 755, 771, 788, 806, 823, 841, 860, 879, 898, 918, 938, 958, 979, 1001,
+  1023, 1045, 1068, 1092, 1115, 1140, 1165, 1190, 1216, 1243, 1270, 1298, 1327, 1356, 1386, 1416,
+  1447, 1479, 1511, 1544, 1578, 1613, 1648, 1684, 1721, 1759, 1797, 1837, 1877, 1918, 1960, 2003,
+  2047, 2092, 2138, 2185, 2232, 2281, 2331, 2382, 2434, 2488, 2542, 2598, 2655, 2713, 2773, 2833,
+  2895, 2959, 3024, 3090, 3157, 3227, 3297, 3370, 3443, 3519, 3596, 3675, 3755, 3837, 3921, 4007,
+  4095
+};
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*___________________________________________________________________________
+
+    Function Name : g722_multi_create
+
+    Purpose :
+
+     Allocate the state of nchan G.722 channels. It must be reset with
+     g722_reset_encoder_multi() or g722_reset_decoder_multi() before use.
+
+    Inputs :
+     nchan - number of channels
+
+    Return Value :
+     Pointer to the state, or NULL if nchan < 1 or out of memory.
+ ___________________________________________________________________________
+*/
+g722_multi_state *g722_multi_create (long nchan) {
+  g722_multi_state *s;
+  Word16 *p;
+  int band, i;
+
+  if (nchan < 1)
+    return NULL;
+  if ((s = (g722_multi_state *) calloc (1, sizeof (g722_multi_state))) == NULL)
+    return NULL;
+  s->acc = (Word32 *) calloc (2 * nchan, sizeof (Word32));
+  s->data = (Word16 *) calloc (G722_MULTI_ROWS * nchan, sizeof (Word16));
+  if (s->acc == NULL || s->data == NULL) {
+    g722_multi_free (s);
+    return NULL;
+  }
+  s->nchan = nchan;
+
+  /* one row of nchan words per variable */
+  p = s->data;
+  for (band = 0; band < 2; band++) {
+    for (i = 1; i < 3; i++, p += nchan)
+      s->band[band].a[i] = p;
+    for (i = 1; i < 7; i++, p += nchan)
+      s->band[band].b[i] = p;
+    for (i = 0; i < 7; i++, p += nchan)
+      s->band[band].d[i] = p;
+    for (i = 0; i < 3; i++, p += nchan)
+      s->band[band].p[i] = p;
+    for (i = 0; i < 3; i++, p += nchan)
+      s->band[band].r[i] = p;
+    s->band[band].det = p, p += nchan;
+    s->band[band].nb = p, p += nchan;
+    s->band[band].s = p, p += nchan;
+    s->band[band].sp = p, p += nchan;
+    s->band[band].sz = p, p += nchan;
+  }
+  s->qmf = p, p += 48 * nchan;
+  s->x[0] = p, p += nchan;
+  s->x[1] = p, p += nchan;
+  s->w = p;
+
+  return s;
+}
+
+/* ..................... End of g722_multi_create() ..................... */
+
+
+/*___________________________________________________________________________
+
+    Function Name : g722_multi_free
+
+    Purpose :
+
+     Release a state allocated by g722_multi_create().
+
+    Inputs :
+     s - pointer to the state (may be NULL)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+void g722_multi_free (g722_multi_state * s) {
+  if (s == NULL)
+    return;
+  free (s->acc);
+  free (s->data);
+  free (s);
+}
+
+/* ..................... End of g722_multi_free() ..................... */
+
+
+/* Reset of all channels: as the reset (rs == 1) branch of lsbcod() and
+   hsbcod(), and the QMF delay lines cleared */
+static void g722_reset_multi (g722_multi_state * s) {
+  long c;
+
+  memset (s->data, 0, G722_MULTI_ROWS * s->nchan * sizeof (Word16));
+  memset (s->acc, 0, 2 * s->nchan * sizeof (Word32));
+  s->pos = 0;
+  for (c = 0; c < s->nchan; c++) {
+    s->band[0].det[c] = 32;
+    s->band[1].det[c] = 8;
+  }
+}
+
+
+/*___________________________________________________________________________
+
+    Function Name : g722_reset_encoder_multi
+                    g722_reset_decoder_multi
+
+    Purpose :
+
+     Reset all channels, as g722_reset_encoder() or g722_reset_decoder()
+     on each of them.
+
+    Inputs :
+     s - pointer to the state (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+void g722_reset_encoder_multi (g722_multi_state * s) {
+  g722_reset_multi (s);
+}
+
+void g722_reset_decoder_multi (g722_multi_state * s) {
+  g722_reset_multi (s);
+}
+
+/* ................. End of g722_reset_{en,de}coder_multi() ................. */
+
+
+/*
+  ============================================================================
+
+   Predictor update of one sub-band, for all channels, once d[0] (the
+   quantized difference signal), nb and det have been computed: parrec,
+   recons, upzero(), uppol2(), uppol1(), filtez(), filtep() and predic of
+   lsbcod()/hsbcod(), in the same order and with the same saturations.
+   The r[0] of the high band is the decoder output before limit().
+
+  ============================================================================
+*/
+static void g722_band_update (G722_MULTI_BAND * b, long nchan) {
+  Word32 wd1, wd2, wd3, sg0, sg1, sg2, apl;
+  long c;
+  int i;
+
+  /* parrec and recons */
+  for (c = 0; c < nchan; c++) {
+    b->p[0][c] = ADD16 (b->d[0][c], b->sz[c]);
+    b->r[0][c] = ADD16 (b->s[c], b->d[0][c]);
+  }
+
+  /* upzero: update of b[] and shift of d[] */
+  for (i = 6; i > 0; i--)
+    for (c = 0; c < nchan; c++) {
+      wd1 = (b->d[0][c] == 0) ? 0 : 128;
+      wd2 = ((b->d[0][c] < 0) == (b->d[i][c] < 0)) ? wd1 : -wd1;
+      wd3 = MULT16 (b->b[i][c], 32640);
+      b->b[i][c] = ADD16 (wd2, wd3);
+      b->d[i][c] = b->d[i - 1][c];
+    }
+
+  for (c = 0; c < nchan; c++) {
+    sg0 = b->p[0][c] < 0;
+    sg1 = b->p[1][c] < 0;
+    sg2 = b->p[2][c] < 0;
+
+    /* uppol2 */
+    wd1 = SAT16 ((Word32) b->a[1][c] * 4);
+    wd2 = (sg0 == sg1) ? SAT16 (-wd1) : wd1;
+    wd2 = (wd2 >> 7) + ((sg0 == sg2) ? 128 : -128);       /* |wd2| < 400 */
+    apl = ADD16 (wd2, MULT16 (b->a[2][c], 32512));
+    apl = (apl > 12288) ? 12288 : (apl < -12288) ? -12288 : apl;
+    b->a[2][c] = apl;
+
+    /* uppol1 */
+    wd3 = 15360 - apl;
+    apl = ADD16 ((sg0 == sg1) ? 192 : -192, MULT16 (b->a[1][c], 32640));
+    apl = (apl > wd3) ? wd3 : (apl < -wd3) ? -wd3 : apl;
+    b->p[2][c] = b->p[1][c];
+    b->p[1][c] = b->p[0][c];
+    b->a[1][c] = apl;
+  }
+
+  /* filtez, summed from d[6] down to d[1] as in funcg722.c */
+  for (c = 0; c < nchan; c++)
+    b->sz[c] = 0;
+  for (i = 6; i > 0; i--)
+    for (c = 0; c < nchan; c++) {
+      wd1 = ADD16 (b->d[i][c], b->d[i][c]);
+      wd1 = MULT16 (wd1, b->b[i][c]);
+      b->sz[c] = ADD16 (b->sz[c], wd1);
+    }
+
+  /* filtep and predic */
+  for (c = 0; c < nchan; c++) {
+    b->r[2][c] = b->r[1][c];
+    b->r[1][c] = b->r[0][c];
+    wd1 = ADD16 (b->r[1][c], b->r[1][c]);
+    wd1 = MULT16 (b->a[1][c], wd1);
+    wd2 = ADD16 (b->r[2][c], b->r[2][c]);
+    wd2 = MULT16 (b->a[2][c], wd2);
+    b->sp[c] = ADD16 (wd1, wd2);
+    b->s[c] = ADD16 (b->sp[c], b->sz[c]);
+  }
+}
+
+
+/*
+  ============================================================================
+
+   Inverse quantizers and scale factor adaptation of the two sub-bands,
+   for all channels, from the codes in code[]: invqal(), logscl() and
+   scalel() for the lower band, invqah(), logsch() and scaleh() for the
+   higher one. nb is at most 18432 (22528), so the products with 32512
+   and the sums with the tables do not saturate; det is at most 16384,
+   so its products with the tables do not either.
+
+  ============================================================================
+*/
+static void g722_lower_adapt (G722_MULTI_BAND * b, Word16 * code, long nchan) {
+  Word32 ril, nbp;
+  long c;
+
+  for (c = 0; c < nchan; c++) {
+    ril = code[c] >> 2;
+    b->d[0][c] = ((Word32) b->det[c] * invqal_tab[ril]) >> 15;
+    nbp = (((Word32) b->nb[c] * 32512) >> 15) + logscl_tab[ril];
+    nbp = (nbp < 0) ? 0 : (nbp > 18432) ? 18432 : nbp;
+    b->nb[c] = nbp;
+    b->det[c] = (ila[((nbp >> 6) & 511) + 64] + 1) << 2;
+  }
+}
+
+static void g722_higher_adapt (G722_MULTI_BAND * b, Word16 * code, long nchan) {
+  Word32 nbp;
+  long c;
+
+  for (c = 0; c < nchan; c++) {
+    b->d[0][c] = ((Word32) invqah_tab[code[c]] * b->det[c]) >> 15;
+    nbp = (((Word32) b->nb[c] * 32512) >> 15) + logsch_tab[code[c]];
+    nbp = (nbp < 0) ? 0 : (nbp > 22528) ? 22528 : nbp;
+    b->nb[c] = nbp;
+    b->det[c] = (ila[(nbp >> 6) & 511] + 1) << 2;
+  }
+}
+
+
+/*
+  ============================================================================
+
+   QMF filters for all channels, as qmf_tx() and qmf_rx(). The delay
+   lines of all channels advance together, so they share one circular
+   buffer of 24 rows, written twice (rows k and k+24) so that the 24
+   rows from the current position are always contiguous: row pos is
+   delayx[0] of qmf_tx()/qmf_rx(), row pos+1 is delayx[1], and so on.
+   The accumulators do not saturate (see qmf_tx_block() in funcg722.c).
+
+  ============================================================================
+*/
+static void g722_qmf_multi (g722_multi_state * s) {
+  long c, nchan = s->nchan;
+  Word32 *acca = s->acc, *accb = s->acc + nchan;
+  Word16 *row;
+  int k;
+
+  row = s->qmf + s->pos * nchan;
+  for (c = 0; c < nchan; c++) {
+    acca[c] = (Word32) qmf_coef[0] * row[c];
+    accb[c] = (Word32) qmf_coef[1] * row[nchan + c];
+  }
+  for (k = 2; k < 24; k += 2) {
+    row += 2 * nchan;
+    for (c = 0; c < nchan; c++) {
+      acca[c] += (Word32) qmf_coef[k] * row[c];
+      accb[c] += (Word32) qmf_coef[k + 1] * row[nchan + c];
+    }
+  }
+}
+
+/* Stores the newest pair (delayx[0], delayx[1]) of the delay lines */
+static void g722_qmf_push (g722_multi_state * s, Word16 * x0, Word16 * x1) {
+  long nchan = s->nchan;
+
+  s->pos = (s->pos == 0) ? 22 : s->pos - 2;
+  memcpy (s->qmf + s->pos * nchan, x0, nchan * sizeof (Word16));
+  memcpy (s->qmf + (s->pos + 1) * nchan, x1, nchan * sizeof (Word16));
+  memcpy (s->qmf + (s->pos + 24) * nchan, x0, nchan * sizeof (Word16));
+  memcpy (s->qmf + (s->pos + 25) * nchan, x1, nchan * sizeof (Word16));
+}
+
+
+/*___________________________________________________________________________
+
+    Function Name : g722_encode_multi
+
+    Purpose :
+
+     Encode nsmp samples of each channel, as g722_encode() on each of
+     them.
+
+    Inputs :
+     incode - nsmp frames of nchan 16 kHz samples, interleaved (read-only)
+     code   - nsmp/2 frames of nchan G.722 codewords (write-only)
+     nsmp   - number of samples per channel (an odd last one is ignored)
+     s      - pointer to the state (read/write)
+
+    Return Value :
+     Number of codewords per channel, nsmp/2.
+ ___________________________________________________________________________
+*/
+Word32 g722_encode_multi (short *incode, short *code, Word32 nsmp, g722_multi_state * s) {
+  long c, nchan = s->nchan;
+  G722_MULTI_BAND *lb = &s->band[0], *hb = &s->band[1];
+  Word16 *il = s->x[0], *ih = s->x[1], *wd = s->w;
+  Word32 *acca = s->acc, *accb = s->acc + nchan;
+  Word32 i, el, eh, comp, mil;
+  int m;
+
+  nsmp >>= 1;
+  for (i = 0; i < nsmp; i++) {
+    /* QMF analysis: delayx[1] is the first sample of the pair */
+    g722_qmf_push (s, incode + (2 * i + 1) * nchan, incode + 2 * i * nchan);
+    g722_qmf_multi (s);
+
+    /* Lower band: subtra and quantl(); the decision level index mil is
+       the number of levels not above |el|, as the search in quantl() */
+    for (c = 0; c < nchan; c++) {
+      comp = LIMIT (((acca[c] + accb[c]) * 2) >> 16);
+      el = SUB16 (comp, lb->s[c]);
+      wd[c] = (el < 0) ? MAX_16 - (el & MAX_16) : el;
+      il[c] = (el < 0);         /* sign, for the code below */
+    }
+    for (c = 0; c < nchan; c++)
+      ih[c] = 1;
+    for (m = 1; m < 30; m++)
+      for (c = 0; c < nchan; c++)
+        ih[c] += ((q6_8[m] * lb->det[c]) >> 15) <= wd[c];
+    for (c = 0; c < nchan; c++) {
+      mil = ih[c];
+      il[c] = il[c] ? ((mil < 3) ? 64 - mil : 34 - mil) : 62 - mil;
+    }
+    g722_lower_adapt (lb, il, nchan);
+    g722_band_update (lb, nchan);
+
+    /* Higher band: subtra and quanth() */
+    for (c = 0; c < nchan; c++) {
+      comp = LIMIT (((acca[c] - accb[c]) * 2) >> 16);
+      eh = SUB16 (comp, hb->s[c]);
+      wd[c] = (eh < 0) ? MAX_16 - (eh & MAX_16) : eh;
+      ih[c] = (wd[c] >= ((564 * 8 * (Word32) hb->det[c]) >> 15)) ? 0 : 1;
+      ih[c] += (eh < 0) ? 0 : 2;
+    }
+    g722_higher_adapt (hb, ih, nchan);
+    g722_band_update (hb, nchan);
+
+    for (c = 0; c < nchan; c++)
+      code[i * nchan + c] = ((ih[c] << 6) + il[c]) & 0xFF;
+  }
+
+  return (nsmp);
+}
+
+/* ..................... End of g722_encode_multi() ..................... */
+
+
+/*___________________________________________________________________________
+
+    Function Name : g722_decode_multi
+
+    Purpose :
+
+     Decode nsmp codewords of each channel, as g722_decode() on each of
+     them.
+
+    Inputs :
+     code    - nsmp frames of nchan G.722 codewords (read-only)
+     outcode - 2*nsmp frames of nchan 16 kHz samples (write-only)
+     mode    - G.722 mode (1, 2 or 3), the same for all channels
+     nsmp    - number of codewords per channel
+     s       - pointer to the state (read/write)
+
+    Return Value :
+     Number of samples per channel, 2*nsmp.
+ ___________________________________________________________________________
+*/
+Word32 g722_decode_multi (short *code, short *outcode, short mode, Word32 nsmp, g722_multi_state * s) {
+  long c, nchan = s->nchan;
+  G722_MULTI_BAND *lb = &s->band[0], *hb = &s->band[1];
+  Word16 *il = s->x[0], *ih = s->x[1], *yl = s->w;
+  Word32 *acca = s->acc, *accb = s->acc + nchan;
+  const Word16 *invqbl = invqbl_tab[(mode == 0 || mode == 1) ? 0 : (mode == 2) ? 1 : 2];
+  Word16 *row0, *row1;
+  Word32 i, yh;
+
+  for (i = 0; i < nsmp; i++) {
+    for (c = 0; c < nchan; c++) {
+      il[c] = code[i * nchan + c] & 0x3F;
+      ih[c] = (code[i * nchan + c] >> 6) & 0x03;
+
+      /* Lower band output: invqbl(), recons and limit() */
+      yl[c] = ADD16 (lb->s[c], ((Word32) lb->det[c] * invqbl[il[c]]) >> 15);
+      yl[c] = LIMIT (yl[c]);
+    }
+    g722_lower_adapt (lb, il, nchan);
+    g722_band_update (lb, nchan);
+
+    g722_higher_adapt (hb, ih, nchan);
+    g722_band_update (hb, nchan);
+
+    /* QMF synthesis from the sum and difference of the two bands */
+    s->pos = (s->pos == 0) ? 22 : s->pos - 2;
+    row0 = s->qmf + s->pos * nchan;
+    row1 = row0 + nchan;
+    for (c = 0; c < nchan; c++) {
+      yh = LIMIT (hb->r[1][c]);
+      row1[c] = ADD16 (yl[c], yh);
+      row0[c] = SUB16 (yl[c], yh);
+      row0[24 * nchan + c] = row0[c];
+      row1[24 * nchan + c] = row1[c];
+    }
+    g722_qmf_multi (s);
+    for (c = 0; c < nchan; c++) {
+      yh = acca[c] >> 12;       /* extract_h (L_shl (acca, 4)) */
+      outcode[2 * i * nchan + c] = SAT16 (yh);
+      yh = accb[c] >> 12;
+      outcode[(2 * i + 1) * nchan + c] = SAT16 (yh);
+    }
+  }
+
+  return (2 * nsmp);
+}
+
+/* ..................... End of g722_decode_multi() ..................... */
+
+/* ********************** End of g722multi.c ***************************** */
@@ -1,4 +1,4 @@
-/*                                                           v2.0 24.Jan.2000
+/*                                                           v2.1 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -39,6 +39,10 @@ HISTORY:
                   processing of test vector ri40fa. Corrected code
                   provided by Jayesh Patel <jayesh@dspse.com>.
 		  Verified by <simao.campos@labs.comsat.com>
+16.Oct.2026 v2.1  G726_encode() and G726_decode() use a fused per-sample
+                  step unless G726_select_impl() asks for the blocks
+                  below; G726_encode() no longer changes its input buffer
+                  for A law.
 
 FUNCTIONS:
 Public:
@@ -46,6 +50,12 @@ Public:
 
   G726_decode ..... G726 decoder function;
 
+  G726_select_impl  choice between the fused implementation of the two
+                    functions above and the blocks below (reference);
+
+  G726_rate_tables  tables of the fused implementation for one rate,
+                    also used by the AVX2 kernel of g726multi.c;
+
 Private:
   G726_accum ...... addition of predictor outputs to form the partial
                     signal estimate (from the sixth order predictor) and
@@ -158,11 +168,53 @@ Private:
  */
 #include "g726.h"
 
+/* Implementation in use, G726_IMPL_xxx */
+static int G726_impl = G726_IMPL_FAST;
+
+/* Fused implementation, at the end of this file */
+static void G726_encode_fast ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+static void G726_decode_fast ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+
 
 /*
  *  .................. FUNCTIONS ..................
  */
 
+/*
+  ----------------------------------------------------------------------------
+
+        int G726_select_impl (int impl);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Chooses the implementation of G726_encode() and G726_decode():
+        the fused per-sample step (G726_IMPL_FAST, default) or the
+        blocks G726_xxx() of this file (G726_IMPL_REFERENCE), as in the
+        Recommendation. The results are the same.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The implementation chosen.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+int G726_select_impl (int impl) {
+  G726_impl = (impl == G726_IMPL_REFERENCE) ? G726_IMPL_REFERENCE : G726_IMPL_FAST;
+  return G726_impl;
+}
+
+/* ...................... end of G726_select_impl() ...................... */
+
+
 /*
   ----------------------------------------------------------------------------
 
@@ -196,6 +248,9 @@ Private:
                         <tdsindi@venus.cpqd.ansp.br>
         05.Feb.92 v1.0c Version 1.0 in C, by translating Fortran to C (f2c)
                         <tdsimao@venus.cpqd.ansp.br>
+        16.Oct.26 v1.1  Runs G726_encode_fast() unless the reference is
+                        selected; the input buffer is no longer changed
+                        for A law
 
  ----------------------------------------------------------------------------
 */
@@ -219,15 +274,15 @@ void G726_encode (short *inp_buf, short *out_buf, long smpno, char *law, short r
 
   long j;
 
-  /* Invert even bits if A law */
-  if (*law == '1') {
-    for (j = 0; j < smpno; j++)
-      inp_buf[j] ^= 85;
+  if (G726_impl == G726_IMPL_FAST) {
+    G726_encode_fast (inp_buf, out_buf, smpno, law, rate, r, state);
+    return;
   }
 
   /* Process all desired samples in inp_buf to out_buf; The comments about general blocks are given as in G.726, and refer to: 4.1.1 Input PCM format conversion and difference signal computation 4.1.2 Adaptive quantizer 4.1.3 Inverse adaptive quantizer 4.1.4 Quantizer scale factor adaptation 4.1.5 Adaptation speed control 4.1.6 Adaptive predictor and reconstructed signal calculator 4.1.7 Tone and transition detector 4.1.8 (Only in the decoder) */
   for (j = 0; j < smpno; j++, r = 0) {
-    s = inp_buf[j];
+    /* Invert even bits if A law */
+    s = (*law == '1') ? inp_buf[j] ^ 85 : inp_buf[j];
 
     /* Process `known-state' part of 4.2.6 */
     G726_delayd (&r, &state->sr1, &sr2);
@@ -398,6 +453,8 @@ void G726_encode (short *inp_buf, short *out_buf, long smpno, char *law, short r
                         <tdsindi@venus.cpqd.ansp.br>
         05.Feb.92 v1.0c Version 1.0 in C, by translating Fortran to C (f2c)
                         <tdsimao@venus.cpqd.ansp.br>
+        16.Oct.26 v1.1  Runs G726_decode_fast() unless the reference is
+                        selected
 
  ----------------------------------------------------------------------------
 */
@@ -420,6 +477,11 @@ void G726_decode (short *inp_buf, short *out_buf, long smpno, char *law, short r
   short yut;
   long j;
 
+  if (G726_impl == G726_IMPL_FAST) {
+    G726_decode_fast (inp_buf, out_buf, smpno, law, rate, r, state);
+    return;
+  }
+
   /* Process all desired samples in inp_buf to out_buf; The comments about general blocks are given as in G.726, and refer to: 4.1.1 Input PCM format conversion and difference signal computation 4.1.2 Adaptive quantizer 4.1.3 Inverse adaptive quantizer 4.1.4 Quantizer scale factor adaptation 4.1.5 Adaptation speed control 4.1.6 Adaptive predictor and reconstructed signal calculator 4.1.7 Tone and transition detector 4.1.8 Output PCM format conversion and synchronous coding adjustment */
   for (j = 0; j < smpno; j++, r = 0) {
     /* Process `known-state' part of 4.2.6 */
@@ -3224,4 +3286,575 @@ void G726_sync (short rate, short *i, short *sp, short *dlnx, short *dsx, char *
 
 /* ........................ end of G726_sync() ........................  */
 
+/*
+  ============================================================================
+
+        Fast implementation of G726_encode() and G726_decode()
+
+        The blocks above are computed again below, in the same order and
+        with the same arithmetic, as functions of values rather than of
+        pointers, so that the compiler can inline all of them into one
+        per-sample step and keep the state in registers. The step works
+        on a local copy of the G726_state; the reset is applied to that
+        copy before the loop, which is what the delay blocks do for the
+        first sample when r is 1. The branches on the rate are replaced
+        by the tables of G726_RATE, chosen once per call.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+  ============================================================================
+*/
+
+static const G726_RATE G726_rate_tab[4] = {
+  /* 16 kbit/s */
+  {3, 2, {261, 2048}, {0, 1, 0}, 0,
+   {116, 365, 365, 116},
+   {4074, 439},
+   {0, 7}},
+  /* 24 kbit/s */
+  {7, 4, {8, 218, 331, 2048}, {7, 1, 2, 3, 7}, 1,
+   {2048, 135, 273, 373, 373, 273, 135, 2048},
+   {4092, 30, 137, 582},
+   {0, 1, 2, 7}},
+  /* 32 kbit/s */
+  {15, 8, {80, 178, 246, 300, 349, 400, 2048, 3972}, {1, 2, 3, 4, 5, 6, 7, 15, 1}, 1,
+   {2048, 4, 135, 213, 273, 323, 373, 425, 425, 373, 323, 273, 213, 135, 4, 2048},
+   {4084, 18, 41, 64, 112, 198, 355, 1122},
+   {0, 0, 0, 1, 1, 1, 3, 7}},
+  /* 40 kbit/s; the level 0 of G726_quan is always passed */
+  {31, 16, {68, 139, 198, 250, 298, 339, 378, 413, 445, 475, 502, 528, 553, 2048, 3974, 4080},
+   {2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 31, 1, 2}, 1,
+   {2048, 4030, 28, 104, 169, 224, 274, 318, 358, 395, 429, 459, 488, 514, 539, 566,
+    566, 539, 514, 488, 459, 429, 395, 358, 318, 274, 224, 169, 104, 28, 4030, 2048},
+   {14, 14, 24, 39, 40, 41, 58, 100, 141, 179, 219, 280, 358, 440, 529, 696},
+   {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 3, 4, 5, 6, 6}}
+};
+
+/* Tables for the rate argument of G726_encode() and G726_decode(); as in
+   the blocks, any rate other than 2, 3 or 4 is taken as 5. Also used by
+   the AVX2 kernel of g726multi.c */
+const G726_RATE *G726_rate_tables (short rate) {
+  return &G726_rate_tab[(rate == 2) ? 0 : (rate == 3) ? 1 : (rate == 4) ? 2 : 3];
+}
+
+/* Number of significant bits of 0 <= x < 65536, as the chains of
+   comparisons of G726_floata(), G726_floatb() and G726_fmult() */
+static long G726_nbits (long x) {
+#if defined(__GNUC__)
+  return (x == 0) ? 0 : 32 - __builtin_clz ((unsigned int) x);
+#else
+  long n;
+
+  for (n = 0; x != 0; n++)
+    x >>= 1;
+  return n;
+#endif
+}
+
+/* G726_expand() */
+static short G726_expand_v (short s, int alaw) {
+  long mant, iexp;
+  short s1, ss, sig, ssq, sss;
+
+  s1 = s ^ 128;
+  if (alaw) {
+    if (s1 >= 128) {
+      s1 += -128;
+      sig = 4096;
+    } else
+      sig = 0;
+    iexp = s1 / 16;
+    mant = s1 - (iexp << 4);
+    ss = (iexp == 0) ? ((mant << 1) + 1 + sig) : ((1 << (iexp - 1)) * ((mant << 1) + 33) + sig);
+    sss = ss / 4096;
+    ssq = (ss & 4095) << 1;
+  } else {
+    if (s1 >= 128) {
+      s1 = (s1 - 128) ^ 127;
+      sig = 8192;
+    } else {
+      s1 ^= 127;
+      sig = 0;
+    }
+    iexp = s1 / 16;
+    mant = s1 - (iexp << 4);
+    ss = (iexp == 0) ? ((mant << 1) + sig) : ((1 << iexp) * ((mant << 1) + 33) - 33 + sig);
+    sss = ss / 8192;
+    ssq = ss & 8191;
+  }
+  return (sss == 0) ? ssq : ((16384 - ssq) & 16383);
+}
+
+/* G726_subta() */
+static short G726_subta_v (short sl, short se) {
+  long sli, sei;
+
+  sli = ((sl >> 13) == 0) ? sl : (sl + 49152L);
+  sei = ((se >> 14) == 0) ? se : (se + 32768L);
+  return (short) ((sli + 65536 - sei) & 65535);
+}
+
+/* G726_log() followed by G726_subtb(); the sign ds is returned in *ds */
+static short G726_log_v (short d, short y, short *ds) {
+  long dqm, exp_, dl;
+
+  *ds = (d >> 15);
+  dqm = (*ds) ? ((65536 - (long) d) & 32767) : d;
+  exp_ = (dqm >= 2) ? G726_nbits (dqm) - 1 : 0;
+  dl = (exp_ << 7) + (((dqm << 7) >> exp_) & 127);
+  return (short) ((dl + 4096 - (y >> 2)) & 4095);
+}
+
+/* Number of decision levels of rt not above dln */
+static short G726_level (const G726_RATE * rt, short dln) {
+  short k;
+
+  for (k = 0; k < rt->nthr && dln >= rt->thr[k]; k++);
+  return k;
+}
+
+/* G726_quan() */
+static short G726_quan_v (const G726_RATE * rt, short dln, short ds) {
+  short i;
+
+  i = rt->qtab[G726_level (rt, dln)];
+  if (ds)
+    i = rt->max - i;
+  if (rt->zfix && i == 0)
+    i = rt->max;
+  return i;
+}
+
+/* G726_reconst(), G726_adda() and G726_antilog() */
+static short G726_dq_v (const G726_RATE * rt, short i, short y) {
+  long dql, dex, dqmag;
+
+  dql = (rt->dqln[i] + (y >> 2)) & 4095;
+  dex = (dql >> 7) & 15;
+  dqmag = (dql >> 11) ? 0 : ((((dql & 127) + 128) << 7) >> (14 - dex));
+  return (i > (rt->max >> 1)) ? (short) (dqmag - 32768) : (short) dqmag;
+}
+
+/* G726_mix() */
+static short G726_mix_v (short al, short yu, long yl) {
+  long dif, difm, prodm, prod;
+
+  dif = (yu + 16384 - (yl >> 6)) & 16383;
+  difm = ((dif >> 13) == 0) ? dif : ((16384 - dif) & 8191);
+  prodm = (difm * al) >> 6;
+  prod = ((dif >> 13) == 0) ? prodm : ((16384 - prodm) & 16383);
+  return (short) (((yl >> 6) + prod) & 8191);
+}
+
+/* G726_filtd() and G726_limb() */
+static short G726_yup_v (short wi, short y) {
+  long dif, difsx, yut;
+
+  dif = (((long) wi << 5) + 131072 - y) & 131071;
+  difsx = ((dif >> 16) == 0) ? (dif >> 5) : ((dif >> 5) + 4096);
+  yut = (y + difsx) & 8191;
+  if ((((yut + 15840) & 16383) >> 13) == 1)
+    return 544;
+  if ((((yut + 11264) & 16383) >> 13) == 0)
+    return 5120;
+  return (short) yut;
+}
+
+/* G726_filte() */
+static long G726_filte_v (short yup, long yl) {
+  long dif, difsx;
+
+  dif = (yup + ((1048576 - yl) >> 6)) & 16383;
+  difsx = ((dif >> 13) == 0) ? dif : (dif + 507904);
+  return (yl + difsx) & 524287;
+}
+
+/* G726_filta() */
+static short G726_filta_v (short fi, short dms) {
+  short dif, difsx;
+
+  dif = ((fi << 9) + 8192 - dms) & 8191;
+  difsx = ((dif >> 12) == 0) ? (dif >> 5) : ((dif >> 5) + 3840);
+  return (difsx + dms) & 4095;
+}
+
+/* G726_filtb() */
+static short G726_filtb_v (short fi, short dml) {
+  long dif, difsx;
+
+  dif = (((long) fi << 11) + 32768 - dml) & 32767;
+  difsx = ((dif >> 14) == 0) ? (dif >> 7) : ((dif >> 7) + 16128);
+  return (short) ((difsx + dml) & 16383);
+}
+
+/* G726_subtc() and G726_filtc() */
+static short G726_ap_v (short dmsp, short dmlp, short tdp, short y, short ap) {
+  long dif, difm;
+  short ax, difc, difsx;
+
+  dif = (((long) dmsp << 2) + 32768 - dmlp) & 32767;
+  difm = ((dif >> 14) == 0) ? dif : ((32768 - dif) & 16383);
+  ax = (y >= 1536 && difm < (dmlp >> 3) && tdp == 0) ? 0 : 1;
+  difc = ((ax << 9) + 2048 - ap) & 2047;
+  difsx = ((difc >> 10) == 0) ? (difc >> 4) : ((difc >> 4) + 896);
+  return (difsx + ap) & 1023;
+}
+
+/* G726_fmult() */
+static unsigned long G726_fmult_v (short An, short SRn) {
+  long an, srn, ans, anmag, anexp, anmant, wanexp, wanmant, wanmag;
+
+  an = An & 65535;
+  srn = SRn & 65535;
+  ans = an >> 15;
+  anmag = (ans == 0) ? (an >> 2) : ((16384 - (an >> 2)) & 8191);
+  anexp = G726_nbits (anmag);
+  anmant = (anmag == 0) ? 32 : ((anmag << 6) >> anexp);
+  wanexp = ((srn >> 6) & 15) + anexp;
+  wanmant = (((srn & 63) * anmant) + 48) >> 4;
+  wanmag = (wanexp <= 26) ? (wanmant << 7) >> (26 - wanexp) : ((wanmant << 7) << (wanexp - 26)) & 32767;
+  return ((srn >> 10) ^ ans) ? (65536 - wanmag) & 65535 : wanmag;
+}
+
+/* G726_floata() and G726_floatb(), from the sign and the magnitude */
+static short G726_float_v (long s, long mag) {
+  long exp_;
+
+  exp_ = G726_nbits (mag);
+  return (short) ((s << 10) + (exp_ << 6) + ((mag == 0) ? 32 : ((mag << 6) >> exp_)));
+}
+
+/* Magnitude of dq in the two's complement of G726_addb() and G726_addc() */
+static unsigned long G726_dqi_v (short dq) {
+  unsigned long dq1 = dq & 65535;
+
+  return ((dq >> 15) & 1) ? ((65536 - (dq1 & 32767)) & 65535) : dq1;
+}
+
+/* G726_upa2() followed by G726_limc() */
+static short G726_a2p_v (short pk0, short pk1, short pk2, short a2, short a1, short sigpk) {
+  long a11, a21, fa1, fa, uga2b, uga2, ula2, a2t;
+
+  a11 = a1 & 65535;
+  a21 = a2 & 65535;
+  if ((a1 >> 15) == 0)
+    fa1 = (a11 <= 8191) ? (a11 << 2) : (8191 << 2);
+  else
+    fa1 = (a11 >= 57345) ? ((a11 << 2) & 131071) : (24577 << 2);
+  fa = (pk0 ^ pk1) ? fa1 : ((131072 - fa1) & 131071);
+  uga2b = (((pk0 ^ pk2) == 0 ? 16384 : 114688) + fa) & 131071;
+  uga2 = (sigpk == 1) ? 0 : ((uga2b >> 16) ? ((uga2b >> 7) + 64512) : (uga2b >> 7));
+  ula2 = ((a2 >> 15) == 0) ? (65536 - (a21 >> 7)) & 65535 : (65536 - ((a21 >> 7) + 65024)) & 65535;
+  a2t = (a21 + ((uga2 + ula2) & 65535)) & 65535;
+  if (a2t >= 32768 && a2t <= 53248)
+    a2t = 53248;
+  else if (a2t >= 12288 && a2t <= 32767)
+    a2t = 12288;
+  return (short) a2t;
+}
+
+/* G726_upa1() followed by G726_limd() */
+static short G726_a1p_v (short pk0, short pk1, short a1, short sigpk, short a2p) {
+  long a11, ash, uga1, ula1, a1t, a2p1, a1ul, a1ll;
+
+  a11 = a1 & 65535;
+  uga1 = (sigpk == 1) ? 0 : (((pk0 ^ pk1) == 0) ? 192 : 65344);
+  ash = a11 >> 8;
+  ula1 = (((a11 >> 15) == 0) ? (65536 - ash) : (65536 - (ash + 65280))) & 65535;
+  a1t = (a11 + ((uga1 + ula1) & 65535)) & 65535;
+  a2p1 = a2p & 65535;
+  a1ul = (15360 + 65536 - a2p1) & 65535;
+  a1ll = (a2p1 + 65536 - 15360) & 65535;
+  if (a1t >= 32768 && a1t <= a1ll)
+    a1t = a1ll;
+  else if (a1t >= a1ul && a1t <= 32767)
+    a1t = a1ul;
+  return (short) a1t;
+}
+
+/* G726_xor() and G726_upb() */
+static short G726_bp_v (short dqn, short dq, short b, short leak, long param) {
+  long bb, ugb, ulb;
+
+  bb = b & 65535;
+  ugb = ((dq & 32767) == 0) ? 0 : ((((dq >> 15) & 1) ^ (dqn >> 10)) == 0 ? 128 : 65408);
+  ulb = ((bb >> 15) == 0) ? ((65536 - (bb >> leak)) & 65535) : ((65536 - ((bb >> leak) + param)) & 65535);
+  return (short) ((bb + ((ugb + ulb) & 65535)) & 65535);
+}
+
+/* G726_compress() */
+static short G726_compress_v (short sr, int alaw) {
+  short imag, iesp, ofst, ofst1, is, sp;
+  long i, im;
+
+  is = (sr >> 15);
+  im = (is == 0) ? (sr & 65535) : ((65536 - (sr & 65535)) & 32767);
+  if (alaw) {
+    im = (sr == -32768) ? 2 : im;
+    imag = (is == 0) ? (im >> 1) : ((im + 1) >> 1);
+    if (is)
+      --imag;
+    if (imag > 4095)
+      imag = 4095;
+    iesp = 7;
+    for (i = 1; i <= 7; ++i) {
+      imag += imag;
+      if (imag >= 4096)
+        break;
+      iesp = 7 - i;
+    }
+    imag = (imag & 4095) >> 8;
+    sp = (is == 0) ? imag + (iesp << 4) : imag + (iesp << 4) + 128;
+    return sp ^ 128;
+  }
+  imag = (im > 8158) ? 8159 : im + 1;
+  iesp = 0;
+  ofst = 31;
+  if (imag > ofst) {
+    for (iesp = 1; iesp <= 8; ++iesp) {
+      ofst1 = ofst;
+      ofst += (1 << (iesp + 5));
+      if (imag <= ofst)
+        break;
+    }
+    imag -= ofst1 + 1;
+  }
+  imag /= (1 << (iesp + 1));
+  sp = (is == 0) ? (imag + (iesp << 4)) : (imag + (iesp << 4) + 128);
+  return sp ^ 255;
+}
+
+/* G726_sync(), with the decision levels of the quantizer: the codes are
+   compared in offset binary, i.e. with the sign bit inverted */
+static short G726_sync_v (const G726_RATE * rt, short i, short sp, short dlnx, short dsx, int alaw) {
+  short half, id, im, ss, mask;
+
+  half = (rt->max + 1) >> 1;
+  im = i ^ half;
+  id = rt->qtab[G726_level (rt, dlnx)] ^ half;
+  if (dsx)
+    id = rt->max - id;
+  if (rt->zfix && id == half)
+    id = half - 1;
+
+  ss = (sp & 128) >> 7;
+  mask = (sp & 127);
+  if (alaw) {
+    if (id > im && ss == 1 && mask == 0)
+      ss = 0;
+    else if (id > im && ss == 1 && mask != 0)
+      mask--;
+    else if (id > im && ss == 0 && mask != 127)
+      mask++;
+    else if (id < im && ss == 1 && mask != 127)
+      mask++;
+    else if (id < im && ss == 0 && mask == 0)
+      ss = 1;
+    else if (id < im && ss == 0 && mask != 0)
+      mask--;
+  } else {
+    if (id > im && ss == 1 && mask == 127) {
+      ss = 0;
+      mask--;
+    } else if (id > im && ss == 1 && mask != 127)
+      mask++;
+    else if (id > im && ss == 0 && mask != 0)
+      mask--;
+    else if (id < im && ss == 1 && mask != 0)
+      mask--;
+    else if (id < im && ss == 0 && mask == 127)
+      ss = 1;
+    else if (id < im && ss == 0 && mask != 127)
+      mask++;
+  }
+  return mask + (ss << 7);
+}
+
+/* State after the reset (r = 1) of the delay blocks */
+static void G726_reset_state (G726_state * st) {
+  st->sr0 = st->sr1 = 32;
+  st->a1r = st->a2r = 0;
+  st->b1r = st->b2r = st->b3r = st->b4r = st->b5r = st->b6r = 0;
+  st->dq0 = st->dq1 = st->dq2 = st->dq3 = st->dq4 = st->dq5 = 32;
+  st->dmsp = st->dmlp = st->apr = 0;
+  st->yup = 544;
+  st->ylp = 34816;
+  st->tdr = 0;
+  st->pk0 = st->pk1 = 0;
+}
+
+/* One sample of the encoder (decode == 0: x is the log PCM sample,
+   without the inversion of the even bits of A law, and the ADPCM code is
+   returned) or of the decoder (decode == 1: x is the ADPCM code and the
+   log PCM sample is returned) */
+static short G726_step (G726_state * st, const G726_RATE * rt, int alaw, int decode, short leak, long param, short x) {
+  short a1, a2, b1, b2, b3, b4, b5, b6, sr2, dq6, pk2;
+  short se, sez, y, al, ap, dms, dml, i, im, ds, dq, sr, tr, a1p, a2p, tdp, sigpk, out;
+  unsigned long sezi, sei, dqsez;
+  long yl, dqmag, thr;
+
+  /* `known-state' parts of 4.2.6: delays and predictor */
+  sr2 = st->sr1;
+  st->sr1 = st->sr0;
+  a2 = st->a2r;
+  a1 = st->a1r;
+  dq6 = st->dq5;
+  st->dq5 = st->dq4;
+  st->dq4 = st->dq3;
+  st->dq3 = st->dq2;
+  st->dq2 = st->dq1;
+  st->dq1 = st->dq0;
+  b1 = st->b1r;
+  b2 = st->b2r;
+  b3 = st->b3r;
+  b4 = st->b4r;
+  b5 = st->b5r;
+  b6 = st->b6r;
+  sezi = (G726_fmult_v (b1, st->dq1) + G726_fmult_v (b2, st->dq2)) & 65535;
+  sezi = (sezi + G726_fmult_v (b3, st->dq3)) & 65535;
+  sezi = (sezi + G726_fmult_v (b4, st->dq4)) & 65535;
+  sezi = (sezi + G726_fmult_v (b5, st->dq5)) & 65535;
+  sezi = (sezi + G726_fmult_v (b6, dq6)) & 65535;
+  sei = (((sezi + G726_fmult_v (a2, sr2)) & 65535) + G726_fmult_v (a1, st->sr1)) & 65535;
+  sez = (short) (sezi >> 1);
+  se = (short) (sei >> 1);
+
+  /* `known-state' parts of 4.2.5 and 4.2.4 */
+  dms = st->dmsp;
+  dml = st->dmlp;
+  ap = st->apr;
+  al = (ap >= 256) ? 64 : (ap >> 2);
+  yl = st->ylp;
+  y = G726_mix_v (al, st->yup, yl);
+
+  /* 4.2.1 and 4.2.2, or the ADPCM code */
+  if (decode)
+    i = x;
+  else {
+    short dln = G726_log_v (G726_subta_v (G726_expand_v (x, alaw), se), y, &ds);
+
+    i = G726_quan_v (rt, dln, ds);
+  }
+  out = i;
+
+  /* 4.2.3 */
+  dq = G726_dq_v (rt, i, y);
+
+  /* 4.2.5 and 4.2.4 */
+  im = (i > (rt->max >> 1)) ? rt->max - i : i;
+  st->dmsp = G726_filta_v (rt->fi[im], dms);
+  st->dmlp = G726_filtb_v (rt->fi[im], dml);
+  st->yup = G726_yup_v (rt->wi[im], y);
+  st->ylp = G726_filte_v (st->yup, yl);
+
+  /* `known-state' part of 4.2.7: transition detector */
+  dqmag = dq & 32767;
+  thr = (((yl >> 10) & 31) + 32) << (yl >> 15);
+  if ((yl >> 15) > 9)
+    thr = 31744;
+  tr = (dqmag > ((thr + (thr >> 1)) >> 1) && st->tdr == 1) ? 1 : 0;
+
+  /* 4.2.6: pk's, sr0 and dq0 */
+  pk2 = st->pk1;
+  st->pk1 = st->pk0;
+  dqsez = (G726_dqi_v (dq) + (((sez >> 14) == 0) ? (unsigned long) sez : (unsigned long) sez + 32768)) & 65535;
+  st->pk0 = (short) (dqsez >> 15);
+  sigpk = (dqsez == 0) ? 1 : 0;
+  sr = (short) ((G726_dqi_v (dq) + (((se >> 14) == 0) ? (unsigned long) se : (unsigned long) se + 32768)) & 65535);
+  st->sr0 = G726_float_v ((sr & 65535) >> 15, ((sr & 65535) >> 15) ? (65536 - (sr & 65535)) & 32767 : sr & 65535);
+  st->dq0 = G726_float_v ((dq >> 15) & 1, dq & 32767);
+
+  /* 4.2.8: output PCM and synchronous coding adjustment */
+  if (decode) {
+    short sp, dlnx, dsx;
+
+    sp = G726_compress_v (sr, alaw);
+    dlnx = G726_log_v (G726_subta_v (G726_expand_v (sp, alaw), se), y, &dsx);
+    out = G726_sync_v (rt, i, sp, dlnx, dsx, alaw);
+  }
+
+  /* 4.2.6: a2, a1; 4.2.7: tone detector; 4.2.5: speed control */
+  a2p = G726_a2p_v (st->pk0, st->pk1, pk2, a2, a1, sigpk);
+  a1p = G726_a1p_v (st->pk0, st->pk1, a1, sigpk, a2p);
+  tdp = ((a2p & 65535) >= 32768 && (a2p & 65535) < 53760) ? 1 : 0;
+  st->a2r = tr ? 0 : a2p;
+  st->a1r = tr ? 0 : a1p;
+  st->tdr = tr ? 0 : tdp;
+  st->apr = tr ? 256 : G726_ap_v (st->dmsp, st->dmlp, tdp, y, ap);
+
+  /* 4.2.6: b's */
+  st->b1r = tr ? 0 : G726_bp_v (st->dq1, dq, b1, leak, param);
+  st->b2r = tr ? 0 : G726_bp_v (st->dq2, dq, b2, leak, param);
+  st->b3r = tr ? 0 : G726_bp_v (st->dq3, dq, b3, leak, param);
+  st->b4r = tr ? 0 : G726_bp_v (st->dq4, dq, b4, leak, param);
+  st->b5r = tr ? 0 : G726_bp_v (st->dq5, dq, b5, leak, param);
+  st->b6r = tr ? 0 : G726_bp_v (dq6, dq, b6, leak, param);
+
+  return out;
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        static void G726_encode_fast (short *inp_buf, short *out_buf,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long smpno, char *law, short rate,
+                                      short r, G726_state *state);
+        static void G726_decode_fast (...);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        G726_encode() and G726_decode() by G726_step(). Same arguments
+        and results; inp_buf is not changed.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+static void G726_encode_fast (short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state) {
+  const G726_RATE *rt = G726_rate_tables (rate);
+  short leak = (rate == 5) ? 9 : 8;
+  long param = (rate == 5) ? 65408 : 65280;
+  short inv = (*law == '1') ? 85 : 0;
+  G726_state st = *state;
+  long j;
+
+  if (r)
+    G726_reset_state (&st);
+  if (inv)
+    for (j = 0; j < smpno; j++)
+      out_buf[j] = G726_step (&st, rt, 1, 0, leak, param, (short) (inp_buf[j] ^ inv));
+  else
+    for (j = 0; j < smpno; j++)
+      out_buf[j] = G726_step (&st, rt, 0, 0, leak, param, inp_buf[j]);
+  *state = st;
+}
+
+static void G726_decode_fast (short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state) {
+  const G726_RATE *rt = G726_rate_tables (rate);
+  short leak = (rate == 5) ? 9 : 8;
+  long param = (rate == 5) ? 65408 : 65280;
+  G726_state st = *state;
+  long j;
+
+  if (r)
+    G726_reset_state (&st);
+  if (*law == '1')
+    for (j = 0; j < smpno; j++)
+      out_buf[j] = G726_step (&st, rt, 1, 1, leak, param, inp_buf[j]) ^ 85;
+  else
+    for (j = 0; j < smpno; j++)
+      out_buf[j] = G726_step (&st, rt, 0, 1, leak, param, inp_buf[j]);
+  *state = st;
+}
+
+/* ................. end of G726_{en,de}code_fast() ................. */
+
+
 /* ************************* END OF G726.C ************************* */
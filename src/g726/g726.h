@@ -10,6 +10,10 @@
    History:
    28.Feb.92	v1.0	First version <simao@cpqd.br>
    06.May.94    v2.0    Smart prototypes that work with many compilers <simao>
+   16.Oct.26    v2.1    Added G726_select_impl()
+   16.Oct.26    v2.2    Added the multi-channel functions of g726multi.c
+   16.Oct.26    v2.3    G726_RATE and G726_rate_tables(), shared by the
+                        fused step and the AVX2 kernel
   ============================================================================
 */
 #ifndef G726_defined
@@ -53,6 +57,7 @@ typedef struct {
 /* Function prototypes */
 void G726_encode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
 void G726_decode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+int G726_select_impl ARGS ((int impl));
 void G726_expand ARGS ((short *s, char *law, short *sl));
 void G726_subta ARGS ((short *sl, short *se, short *d));
 void G726_log ARGS ((short *d, short *dl, short *ds));
@@ -95,6 +100,37 @@ void G726_trans ARGS ((short *td, long *yl, short *dq, short *tr));
 void G726_compress ARGS ((short *sr, char *law, short *sp));
 void G726_sync ARGS ((short rate, short *i, short *sp, short *dlnx, short *dsx, char *law, short *sd));
 
+/* Tables of one rate: the quantizer (G726_quan) gives qtab[k] for the
+   number k of levels thr[] not above dln; G726_sync uses the same levels */
+typedef struct {
+  short max;                    /* largest code, 2^rate-1 */
+  short nthr;                   /* number of decision levels */
+  short thr[17];                /* decision levels, ascending */
+  short qtab[18];               /* magnitude code for 0..nthr levels */
+  short zfix;                   /* whether code 0 is replaced by max */
+  short dqln[32];               /* G726_reconst, by code */
+  short wi[16];                 /* G726_functw, by magnitude code */
+  short fi[16];                 /* G726_functf, by magnitude code */
+} G726_RATE;
+
+/* Tables of a rate argument (2 to 5) of G726_encode()/G726_decode() */
+const G726_RATE *G726_rate_tables ARGS ((short rate));
+
+/* Implementations of G726_encode() and G726_decode(); both bit-exact */
+#define G726_IMPL_FAST      0   /* fused per-sample step (default) */
+#define G726_IMPL_REFERENCE 1   /* blocks G726_xxx() of g726.c */
+
+/* Multi-channel functions (g726multi.c); buffers interleaved by channel,
+   one rate and one state per channel */
+void G726_encode_multi ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state));
+void G726_decode_multi ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state));
+int G726_select_multi_kernel ARGS ((int kernel));
+
+/* Kernels selectable with G726_select_multi_kernel(); all bit-exact */
+#define G726_KERNEL_AUTO   0    /* best one supported by the CPU (default) */
+#define G726_KERNEL_SCALAR 1    /* portable C, G726_encode()/G726_decode() per channel */
+#define G726_KERNEL_AVX2   2    /* x86 AVX2, 8 lanes per vector */
+
 /* Definitions for better user interface (?!) */
 #ifndef IS_LOG
 #define IS_LOG   0
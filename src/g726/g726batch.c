@@ -0,0 +1,431 @@
+/*                                                         16/Oct/2026 v1.1 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a demonstration program for the multi-channel
+	G.726 functions of g726multi.c. Every regular file of a directory
+	is one channel: G.711 log samples (encoder) or ADPCM codes
+	(decoder), one per 16 bit word, right aligned. The files are taken
+	in alphabetical order and get the rates of the list given in the
+	command line one after the other. All channels are processed
+	together by G726_encode_multi() or G726_decode_multi(), in frames;
+	the output of each channel is saved with the same name in an
+	output directory, if given.
+
+	With -check, each channel is also processed on its own by the
+	reference implementation of G726_encode() or G726_decode() (the
+	blocks of g726.c, see G726_select_impl()); the program then
+	reports the number of samples that differ, the channels whose
+	final states differ, and the time taken by each.
+
+  USAGE:
+	g726batch [-options] InpDir [OutDir]
+
+  OPTIONS:
+	-law #      A or a for G.711 A-law, u for u-law [default: A]
+	-rate #     dash-separated list of rates (16, 24, 32, 40), given
+	            to the files in turn [default: 32]
+	-enc        run the encoders [default]
+	-dec        run the decoders
+	-frame #    samples per channel and call [default: 160]
+	-check      compare with the reference single-channel functions
+	-scalar     use the C kernel (the fused G726_encode()/G726_decode()
+	            on each channel), not the AVX2 one
+	-q          quiet operation
+
+  EXIT VALUE:
+	0  success
+	1  samples or states differ from the reference functions
+	   (-check)
+	2  usage
+	3  error reading or writing a file
+	-1 other errors
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+	16.Oct.26 v1.1 -check compares with the reference implementation,
+	               since the C kernel runs the fused G726_encode()/
+	               G726_decode() itself
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_MSC_VER)
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "g726.h"
+
+#define MAX_PATH_LEN 1024
+
+
+static void display_usage () {
+  printf ("G726BATCH.C - Version 1.1 of 16.Oct.2026 \n\n");
+
+  printf (" Program to encode or decode all the files of a directory\n");
+  printf (" with the multi-channel G.726 functions, one channel per file\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ g726batch [-options] InpDir [OutDir]\n");
+  printf (" where:\n");
+  printf ("  InpDir....... directory of G.711 (encoder) or ADPCM (decoder)\n");
+  printf ("                files, 16 bit words\n");
+  printf ("  OutDir....... directory for the output files [default: none]\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -law #....... A or a for A-law, u for u-law [default: A]\n");
+  printf ("  -rate #...... dash-separated list of rates (16, 24, 32, 40),\n");
+  printf ("                given to the files in turn [default: 32]\n");
+  printf ("  -enc......... run the encoders [default]\n");
+  printf ("  -dec......... run the decoders\n");
+  printf ("  -frame L..... samples per channel and call [default: 160]\n");
+  printf ("  -check....... compare with the reference G726_encode()/\n");
+  printf ("                G726_decode() (blocks of g726.c)\n");
+  printf ("  -scalar...... use the C kernel (fused G726_encode()/G726_decode()\n");
+  printf ("                on each channel), not the AVX2 one\n");
+  printf ("  -q........... quiet operation\n");
+  printf ("\n");
+  exit (2);
+}
+
+
+/* Reads the dash-separated list of rates of str (in kbit/s) into rate[],
+   as the rate parameter of G726_encode(); returns the number of rates,
+   or 0 if the list is empty or has an invalid rate */
+static int parse_rates (char *str, short *rate, int max_rates) {
+  int count = 0;
+  long kbps;
+  char *s = str;
+
+  while (*s) {
+    kbps = strtol (s, &s, 10);
+    if (kbps != 16 && kbps != 24 && kbps != 32 && kbps != 40)
+      return 0;
+    if (count == max_rates)
+      return 0;
+    rate[count++] = (short) (kbps / 8);
+    if (*s == '-')
+      s++;
+    else if (*s)
+      return 0;
+  }
+  return count;
+}
+
+
+static int compare_names (const void *a, const void *b) {
+  return strcmp (*(char *const *) a, *(char *const *) b);
+}
+
+/* Appends a copy of name to the list of *count names of *list, if dir/name
+   is a regular file; returns 0 if there is no memory */
+static int add_name (char *dir, char *name, char ***list, long *count, long *size) {
+  char path[MAX_PATH_LEN];
+  struct stat st;
+
+  sprintf (path, "%.500s/%.500s", dir, name);
+  if (stat (path, &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG)
+    return 1;
+  if (*count == *size) {
+    *size = 2 * *size + 16;
+    if ((*list = (char **) realloc (*list, *size * sizeof (char *))) == NULL)
+      return 0;
+  }
+  if (((*list)[*count] = (char *) malloc (strlen (name) + 1)) == NULL)
+    return 0;
+  strcpy ((*list)[(*count)++], name);
+  return 1;
+}
+
+/* Names of the regular files of directory dir, in alphabetical order, in
+   *list; returns their number, or -1 on error */
+static long list_files (char *dir, char ***list) {
+  long count = 0, size = 0;
+  int ok = 1;
+#if defined(_MSC_VER)
+  struct _finddata_t fd;
+  intptr_t h;
+  char pattern[MAX_PATH_LEN];
+
+  *list = NULL;
+  sprintf (pattern, "%.1000s/*", dir);
+  if ((h = _findfirst (pattern, &fd)) == -1)
+    return -1;
+  do
+    ok = add_name (dir, fd.name, list, &count, &size);
+  while (ok && _findnext (h, &fd) == 0);
+  _findclose (h);
+#else
+  DIR *d;
+  struct dirent *e;
+
+  *list = NULL;
+  if ((d = opendir (dir)) == NULL)
+    return -1;
+  while (ok && (e = readdir (d)) != NULL)
+    ok = add_name (dir, e->d_name, list, &count, &size);
+  closedir (d);
+#endif
+  if (!ok)
+    return -1;
+  if (count > 1)
+    qsort (*list, count, sizeof (char *), compare_names);
+  return count;
+}
+
+
+int main (int argc, char *argv[]) {
+  FILE *F;
+  char **name, *inp_dir, *out_dir = NULL, law[2] = "1", path[MAX_PATH_LEN];
+  short rate_list[64], *rate, *inp, *out, *ref, *buf;
+  long *len, nchan, nsmp = 0, lseg = 160, count, c, i, k, ndiff = 0, nstate = 0;
+  int nrates = 1, decode = 0, check = 0, quiet = 0, kernel = G726_KERNEL_AUTO;
+  G726_state *state, *multi_state;
+  clock_t t0;
+  double t_multi, t_single = 0;
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  rate_list[0] = 4;
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-law") == 0) {
+      if (argv[2][0] == 'a' || argv[2][0] == 'A')
+        law[0] = '1';
+      else if (argv[2][0] == 'u' || argv[2][0] == 'U')
+        law[0] = '0';
+      else
+        HARAKIRI (" Invalid law (A or u)! Aborted...\n", -1);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-rate") == 0) {
+      if ((nrates = parse_rates (argv[2], rate_list, 64)) == 0) {
+        fprintf (stderr, "ERROR! Invalid bitrate list: %s\n\n", argv[2]);
+        exit (-1);
+      }
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-frame") == 0) {
+      lseg = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-enc") == 0) {
+      decode = 0;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-dec") == 0) {
+      decode = 1;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-check") == 0) {
+      check = 1;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-scalar") == 0) {
+      kernel = G726_KERNEL_SCALAR;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-q") == 0) {
+      quiet = 1;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
+  if (argc < 2)
+    display_usage ();
+  inp_dir = argv[1];
+  if (argc > 2)
+    out_dir = argv[2];
+  if (lseg < 1) {
+    fprintf (stderr, "ERROR! Invalid frame length\n\n");
+    exit (-1);
+  }
+
+
+  /* ......... INITIALIZATIONS ......... */
+
+  if ((nchan = list_files (inp_dir, &name)) < 0)
+    KILL (inp_dir, 3);
+  if (nchan == 0) {
+    fprintf (stderr, "ERROR! No files in %s\n\n", inp_dir);
+    exit (-1);
+  }
+
+  len = (long *) malloc (nchan * sizeof (long));
+  rate = (short *) malloc (nchan * sizeof (short));
+  /* cleared, so that the states can be compared with memcmp() */
+  state = (G726_state *) calloc (nchan, sizeof (G726_state));
+  multi_state = (G726_state *) calloc (nchan, sizeof (G726_state));
+  if (len == NULL || rate == NULL || state == NULL || multi_state == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+  for (c = 0; c < nchan; c++) {
+    sprintf (path, "%.500s/%.500s", inp_dir, name[c]);
+    if ((F = fopen (path, RB)) == NULL)
+      KILL (path, 3);
+    fseek (F, 0L, SEEK_END);
+    len[c] = ftell (F) / sizeof (short);
+    fclose (F);
+    if (len[c] > nsmp)
+      nsmp = len[c];
+    rate[c] = rate_list[c % nrates];
+  }
+  nsmp = (nsmp + lseg - 1) / lseg * lseg;
+  if (nsmp == 0) {
+    fprintf (stderr, "ERROR! All the files of %s are empty\n\n", inp_dir);
+    exit (-1);
+  }
+
+  inp = (short *) calloc (nchan * nsmp, sizeof (short));
+  out = (short *) malloc (nchan * nsmp * sizeof (short));
+  ref = (short *) malloc (nchan * nsmp * sizeof (short));
+  buf = (short *) malloc (nsmp * sizeof (short));
+  if (inp == NULL || out == NULL || ref == NULL || buf == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+
+  /* the channels, interleaved; encoder inputs are 8 bit log samples and
+     decoder inputs codes of rate[c] bits, and shorter channels are
+     completed with zeros; a file that shrank since it was measured
+     gives a shorter channel */
+  for (c = 0; c < nchan; c++) {
+    sprintf (path, "%.500s/%.500s", inp_dir, name[c]);
+    if ((F = fopen (path, RB)) == NULL)
+      KILL (path, 3);
+    len[c] = (long) fread (buf, sizeof (short), len[c], F);
+    if (ferror (F))
+      KILL (path, 3);
+    fclose (F);
+    for (i = 0; i < len[c]; i++)
+      inp[i * nchan + c] = (short) (buf[i] & (decode ? (1 << rate[c]) - 1 : 255));
+  }
+  kernel = G726_select_multi_kernel (kernel);
+  if (!quiet)
+    printf ("%ld channels of up to %ld samples, %s-law, %s, frames of %ld, %s\n", nchan, nsmp, (law[0] == '1') ? "A" : "u", decode ? "decoder" : "encoder", lseg, (kernel == G726_KERNEL_AVX2) ? "AVX2 lanes" : "C per channel");
+
+
+  /* ......... MULTI-CHANNEL PROCESSING ......... */
+
+  t0 = clock ();
+  for (i = 0; i < nsmp; i += lseg)
+    if (decode)
+      G726_decode_multi (inp + i * nchan, out + i * nchan, lseg, law, rate, (short) (i == 0), nchan, state);
+    else
+      G726_encode_multi (inp + i * nchan, out + i * nchan, lseg, law, rate, (short) (i == 0), nchan, state);
+  t_multi = (double) (clock () - t0) / CLOCKS_PER_SEC;
+
+
+  /* ......... CHECK WITH THE REFERENCE SINGLE-CHANNEL FUNCTIONS ......... */
+
+  if (check) {
+    /* the C kernel itself runs the fused implementation, so compare
+       with the blocks of the Recommendation */
+    G726_select_impl (G726_IMPL_REFERENCE);
+    /* state[] holds the final states of the multi-channel run here; keep
+       them, and let the reset (r=1) of the first frame of each channel
+       restart the single-channel functions from the initial state, which
+       is what makes the two runs comparable */
+    memcpy (multi_state, state, nchan * sizeof (G726_state));
+    t0 = clock ();
+    for (c = 0; c < nchan; c++)
+      for (i = 0; i < nsmp; i += lseg) {
+        for (k = 0; k < lseg; k++)
+          buf[k] = inp[(i + k) * nchan + c];
+        if (decode)
+          G726_decode (buf, ref + c * nsmp + i, lseg, law, rate[c], (short) (i == 0), &state[c]);
+        else
+          G726_encode (buf, ref + c * nsmp + i, lseg, law, rate[c], (short) (i == 0), &state[c]);
+      }
+    t_single = (double) (clock () - t0) / CLOCKS_PER_SEC;
+    G726_select_impl (G726_IMPL_FAST);
+
+    for (c = 0; c < nchan; c++) {
+      for (k = 0, i = 0; i < nsmp; i++)
+        k += (out[i * nchan + c] != ref[c * nsmp + i]);
+      if (k)
+        printf ("%s: %ld samples differ from the reference G726_%scode\n", name[c], k, decode ? "de" : "en");
+      ndiff += k;
+      if (memcmp (&multi_state[c], &state[c], sizeof (G726_state)) != 0) {
+        printf ("%s: final state differs from the reference G726_%scode\n", name[c], decode ? "de" : "en");
+        nstate++;
+      }
+    }
+  }
+
+
+  /* ......... OUTPUT FILES ......... */
+
+  if (out_dir != NULL)
+    for (c = 0; c < nchan; c++) {
+      for (i = 0; i < len[c]; i++)
+        buf[i] = out[i * nchan + c];
+      sprintf (path, "%.500s/%.500s", out_dir, name[c]);
+      if ((F = fopen (path, WB)) == NULL)
+        KILL (path, 3);
+      count = (long) fwrite (buf, sizeof (short), len[c], F);
+      fclose (F);
+      if (count != len[c])
+        KILL (path, 3);
+    }
+
+
+  /* ......... RESULTS ......... */
+
+  if (!quiet) {
+    printf ("multi  %8.3f s  %12.0f samples/s\n", t_multi, (t_multi > 0) ? nchan * nsmp / t_multi : 0);
+    if (check) {
+      printf ("ref    %8.3f s  %12.0f samples/s  speed-up %5.1f\n", t_single, (t_single > 0) ? nchan * nsmp / t_single : 0, (t_multi > 0) ? t_single / t_multi : 0);
+      printf ("%ld samples differ from the reference functions\n", ndiff);
+      printf ("%ld final states differ from the reference functions\n", nstate);
+    }
+  }
+
+  for (c = 0; c < nchan; c++)
+    free (name[c]);
+  free (name);
+  free (len);
+  free (rate);
+  free (state);
+  free (multi_state);
+  free (inp);
+  free (out);
+  free (ref);
+  free (buf);
+  return (ndiff != 0 || nstate != 0);
+}
@@ -0,0 +1,213 @@
+/*                                                         16/Oct/2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a benchmark of G726_encode() and G726_decode()
+	at the four rates and for both laws: the blocks of g726.c
+	(G726_IMPL_REFERENCE) against the fused step (G726_IMPL_FAST). The
+	two must give the same codes and samples, for a linear speech file
+	compressed with G.711, and for random log samples and ADPCM codes;
+	the input buffers must not be changed. The time taken by each is
+	reported, in samples per second.
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "g711.h"
+#include "g726.h"
+
+#define NRAND 65536
+
+static void display_usage () {
+  printf ("G726BENCH.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Program to check and time the G.726 implementations\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ g726bench [-options] InpFile\n");
+  printf (" where:\n");
+  printf ("  InpFile...... 8 kHz linear speech file, 16 bit samples\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -frame L...... samples per call of the functions [default: 160]\n");
+  printf ("  -n R.......... passes over the input file [default: 1]\n");
+  printf ("\n");
+  exit (2);
+}
+
+
+/* Runs the encoder or the decoder of implementation impl over inp, in
+   calls of lseg samples, with a reset in the first */
+static void run_g726 (int impl, int decode, short *inp, short *out, long nsmp, long lseg, char *law, short rate) {
+  G726_state state;
+  long i, count;
+
+  G726_select_impl (impl);
+  for (i = 0; i < nsmp; i += count) {
+    count = (nsmp - i < lseg) ? nsmp - i : lseg;
+    if (decode)
+      G726_decode (inp + i, out + i, count, law, rate, (short) (i == 0), &state);
+    else
+      G726_encode (inp + i, out + i, count, law, rate, (short) (i == 0), &state);
+  }
+}
+
+/* Number of output samples that differ between the two implementations,
+   plus the number of input samples that they have changed */
+static long check_g726 (int decode, short *inp, short *tmp, short *ref, short *out, long nsmp, long lseg, char *law, short rate) {
+  long i, k;
+
+  memcpy (tmp, inp, nsmp * sizeof (short));
+  run_g726 (G726_IMPL_REFERENCE, decode, tmp, ref, nsmp, lseg, law, rate);
+  run_g726 (G726_IMPL_FAST, decode, tmp, out, nsmp, lseg, law, rate);
+  for (k = 0, i = 0; i < nsmp; i++)
+    k += (out[i] != ref[i]) + (tmp[i] != inp[i]);
+  return k;
+}
+
+
+int main (int argc, char *argv[]) {
+  FILE *Fi;
+  short *lin, *logbuf, *code, *out, *ref, *tmp, *rnd;
+  long lseg = 160, npass = 1, nsmp, nbuf, i, k, pass, ndiff = 0;
+  int lw, dec, impl;
+  short rate;
+  char law[2][2] = { "1", "0" };
+  static char *law_name[2] = { "A", "u" };
+  static char *impl_name[2] = { "fast", "reference" };
+  clock_t t0;
+  double t[2];
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-frame") == 0) {
+      lseg = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-n") == 0) {
+      npass = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+    }
+  if (argc < 2)
+    display_usage ();
+  if (lseg < 1 || npass < 1) {
+    fprintf (stderr, "ERROR! Invalid frame length or number of passes\n\n");
+    exit (-1);
+  }
+
+
+  /* ......... INITIALIZATIONS ......... */
+
+  if ((Fi = fopen (argv[1], RB)) == NULL)
+    KILL (argv[1], 2);
+  fseek (Fi, 0L, SEEK_END);
+  nsmp = ftell (Fi) / sizeof (short);
+  fseek (Fi, 0L, SEEK_SET);
+  if (nsmp < 1) {
+    fprintf (stderr, "ERROR! Empty input file\n\n");
+    exit (-1);
+  }
+
+  nbuf = (nsmp > NRAND) ? nsmp : NRAND;
+  lin = (short *) malloc (nbuf * sizeof (short));
+  logbuf = (short *) malloc (nbuf * sizeof (short));
+  code = (short *) malloc (nbuf * sizeof (short));
+  out = (short *) malloc (nbuf * sizeof (short));
+  ref = (short *) malloc (nbuf * sizeof (short));
+  tmp = (short *) malloc (nbuf * sizeof (short));
+  rnd = (short *) malloc (NRAND * sizeof (short));
+  if (lin == NULL || logbuf == NULL || code == NULL || out == NULL || ref == NULL || tmp == NULL || rnd == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+  if (fread (lin, sizeof (short), nsmp, Fi) != (size_t) nsmp)
+    KILL (argv[1], 3);
+  fclose (Fi);
+  srand (1);
+
+
+  /* ......... CHECK AND TIMING ......... */
+
+  printf ("%ld samples in frames of %ld, %ld passes\n", nsmp, lseg, npass);
+  for (lw = 0; lw < 2; lw++) {
+    if (lw == 0)
+      alaw_compress (nsmp, lin, logbuf);
+    else
+      ulaw_compress (nsmp, lin, logbuf);
+
+    for (rate = 2; rate <= 5; rate++) {
+      /* the speech file, and random log samples and codes */
+      run_g726 (G726_IMPL_REFERENCE, 0, logbuf, code, nsmp, lseg, law[lw], rate);
+      k = check_g726 (0, logbuf, tmp, ref, out, nsmp, lseg, law[lw], rate);
+      k += check_g726 (1, code, tmp, ref, out, nsmp, lseg, law[lw], rate);
+      for (i = 0; i < NRAND; i++)
+        rnd[i] = rand () & 255;
+      k += check_g726 (0, rnd, tmp, ref, out, NRAND, lseg, law[lw], rate);
+      for (i = 0; i < NRAND; i++)
+        rnd[i] = rand () & ((1 << rate) - 1);
+      k += check_g726 (1, rnd, tmp, ref, out, NRAND, lseg, law[lw], rate);
+      if (k)
+        printf ("%s-law, %d kbit/s: %ld samples differ between the implementations\n", law_name[lw], 8 * rate, k);
+      ndiff += k;
+
+      for (dec = 0; dec < 2; dec++) {
+        for (impl = 0; impl < 2; impl++) {
+          t0 = clock ();
+          for (pass = 0; pass < npass; pass++)
+            run_g726 (impl, dec, dec ? code : logbuf, out, nsmp, lseg, law[lw], rate);
+          t[impl] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+        }
+        for (impl = 0; impl < 2; impl++)
+          printf ("%s-law %2d kbit/s %s %-9s %8.3f s  %12.0f samples/s  speed-up %5.1f\n", law_name[lw], 8 * rate, dec ? "decoder" : "encoder", impl_name[impl], t[impl], (t[impl] > 0) ? nsmp * npass / t[impl] : 0, (t[impl] > 0) ? t[1] / t[impl] : 0);
+      }
+    }
+  }
+  printf ("%ld samples differ between the implementations\n", ndiff);
+
+  G726_select_impl (G726_IMPL_FAST);
+  free (lin);
+  free (logbuf);
+  free (code);
+  free (out);
+  free (ref);
+  free (tmp);
+  free (rnd);
+  return (ndiff != 0);
+}
@@ -0,0 +1,805 @@
+/*                                                           v1.2 16.Oct.2026
+=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+
+MODULE:         G726MULTI.C, G.726 ENCODER AND DECODER FOR MANY CHANNELS
+
+DESCRIPTION:
+        This file contains G726_encode_multi() and G726_decode_multi(),
+        which run N independent G.726 channels in lock step, one sample
+        of every channel at a time, each channel at its own rate. The
+        channels keep their state in an array of N G726_state, so that
+        they can be moved between these functions and G726_encode() or
+        G726_decode() at any time.
+
+        The portable kernel runs G726_encode() or G726_decode(), i.e. the
+        fused step of g726.c, on each channel in turn, G726_CHUNK samples
+        at a time. On x86 CPUs with AVX2 (see G726_select_multi_kernel()),
+        the channels are taken G726_LANES at a time instead. The state of
+        such a group is copied to structure-of-arrays form (one array
+        element, or lane, per channel) for the duration of the call, and
+        every block of the Recommendation is computed for 8 lanes per
+        vector, with the branches replaced by selections. The tables that
+        depend on the rate are read per lane, indexed by the rate of the
+        lane (a gather); the decision levels of the quantizer are copied
+        to the lanes once per call.
+
+        Every channel is bit-exact with G726_encode() and G726_decode()
+        on its own G726_state at the same rate. Input and output buffers
+        are interleaved by channel: sample k of channel c is at
+        buf[k * nchan + c].
+
+FUNCTIONS:
+  Global (have prototype in g726.h)
+         = G726_encode_multi(...) : encode N channels
+         = G726_decode_multi(...) : decode N channels
+         = G726_select_multi_kernel(...) : C or AVX2 kernel
+
+HISTORY:
+16.Oct.2026 v1.0  Created.
+16.Oct.2026 v1.1  The C kernel runs the fused step of g726.c on each
+                  channel, instead of its own copy of the blocks.
+16.Oct.2026 v1.2  The lane tables are built from G726_rate_tables(), and
+                  the CPU is checked with ugst_cpu_supports().
+
+=============================================================================
+*/
+
+#include "g726.h"
+
+/* UGST_SIMD_X86, UGST_TARGET() and ugst_cpu_supports() for the AVX2 kernel */
+#include "ugst-cpu.h"
+
+/* Samples of a channel per call of G726_encode()/G726_decode() in the
+   C kernel */
+#define G726_CHUNK 256
+
+/* Channels computed together by the AVX2 kernel, a multiple of 8 */
+#define G726_LANES 64
+
+/* Kernel in use, G726_KERNEL_AUTO until the first call */
+static int G726_kernel = G726_KERNEL_AUTO;
+
+#ifdef UGST_SIMD_X86
+/*
+ * ......... Tables by rate: 16, 24, 32 and 40 kbit/s .........
+ * The G726_RATE tables of g726.c (G726_rate_tables()), in int and with
+ * one row per rate, so that the lanes gather them by ri*size+index.
+ * Filled by G726_m_tables() when the AVX2 kernel is selected.
+ */
+
+static int G726_m_max[4];       /* largest code, 2^rate-1 */
+static int G726_m_zfix[4];      /* whether code 0 is replaced by max */
+static int G726_m_thr[4][16];   /* decision levels, completed with 4096
+                                   (above any dln) */
+static int G726_m_qtab[4 * 17]; /* magnitude code, by number of levels */
+static int G726_m_dqln[4 * 32]; /* G726_reconst, by code */
+static int G726_m_wi[4 * 16];   /* G726_functw, by magnitude code */
+static int G726_m_fi[4 * 16];   /* G726_functf, by magnitude code */
+
+static void G726_m_tables () {
+  const G726_RATE *rt;
+  int ri, k;
+
+  for (ri = 0; ri < 4; ri++) {
+    rt = G726_rate_tables ((short) (ri + 2));
+    G726_m_max[ri] = rt->max;
+    G726_m_zfix[ri] = rt->zfix;
+    for (k = 0; k < 16; k++)
+      G726_m_thr[ri][k] = (k < rt->nthr) ? rt->thr[k] : 4096;
+    for (k = 0; k < 17; k++)
+      G726_m_qtab[ri * 17 + k] = rt->qtab[k];
+    for (k = 0; k < 32; k++)
+      G726_m_dqln[ri * 32 + k] = rt->dqln[k];
+    for (k = 0; k < 16; k++) {
+      G726_m_wi[ri * 16 + k] = rt->wi[k];
+      G726_m_fi[ri * 16 + k] = rt->fi[k];
+    }
+  }
+}
+
+
+/*
+ * ......... State of a group of lanes .........
+ * The variables of G726_state, one element per lane, with the delays
+ * of sr, dq and pk in rows of increasing delay; dq[6] and pk[2] are
+ * only used within a sample. The predictor coefficients are only used
+ * modulo 65536 and are kept so.
+ */
+typedef struct {
+  long n;                       /* lanes in use */
+  int ri[G726_LANES];           /* rate index, 0 to 3 */
+  int max[G726_LANES];          /* largest code of the lane */
+  int zfix[G726_LANES];         /* G726_m_zfix of the lane */
+  int leak[G726_LANES];         /* shift of the leak of G726_upb */
+  int param[G726_LANES];        /* and its sign extension */
+  int thr[16][G726_LANES];      /* decision levels of the lane */
+
+  int sr[3][G726_LANES];
+  int a1r[G726_LANES], a2r[G726_LANES];
+  int b[6][G726_LANES];         /* b1r to b6r */
+  int dq[7][G726_LANES];
+  int dmsp[G726_LANES], dmlp[G726_LANES], apr[G726_LANES], yup[G726_LANES];
+  int tdr[G726_LANES];
+  int pk[3][G726_LANES];
+  int ylp[G726_LANES];
+} G726_LANE_STATE;
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        static void G726_lanes_load (G726_LANE_STATE *ls,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  G726_state *state, short *rate,
+                                     long n, short r);
+        static void G726_lanes_save (G726_LANE_STATE *ls,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  G726_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Copy of the n states state[0..n-1] to the lanes, with the tables
+        of their rates (any rate other than 2, 3 or 4 is taken as 5, as
+        in G726_encode()) and the reset of the delay blocks when r is 1;
+        and back to the states. The lanes up to the next multiple of 8
+        get a copy of lane 0, so that whole vectors can be computed.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+static void G726_lanes_load (G726_LANE_STATE * ls, G726_state * state, short *rate, long n, short r) {
+  G726_state *st;
+  long c, cs;
+  int k;
+
+  ls->n = n;
+  for (c = 0; c < ((n + 7) & ~7L); c++) {
+    cs = (c < n) ? c : 0;
+    st = &state[cs];
+    ls->ri[c] = (rate[cs] == 2) ? 0 : (rate[cs] == 3) ? 1 : (rate[cs] == 4) ? 2 : 3;
+    ls->max[c] = G726_m_max[ls->ri[c]];
+    ls->zfix[c] = G726_m_zfix[ls->ri[c]];
+    ls->leak[c] = (ls->ri[c] == 3) ? 9 : 8;
+    ls->param[c] = (ls->ri[c] == 3) ? 65408 : 65280;
+    for (k = 0; k < 16; k++)
+      ls->thr[k][c] = G726_m_thr[ls->ri[c]][k];
+
+    if (r) {
+      ls->sr[0][c] = ls->sr[1][c] = 32;
+      ls->a1r[c] = ls->a2r[c] = 0;
+      for (k = 0; k < 6; k++) {
+        ls->b[k][c] = 0;
+        ls->dq[k][c] = 32;
+      }
+      ls->dmsp[c] = ls->dmlp[c] = ls->apr[c] = 0;
+      ls->yup[c] = 544;
+      ls->tdr[c] = 0;
+      ls->pk[0][c] = ls->pk[1][c] = 0;
+      ls->ylp[c] = 34816;
+      continue;
+    }
+    ls->sr[0][c] = st->sr0;
+    ls->sr[1][c] = st->sr1;
+    ls->a1r[c] = st->a1r;
+    ls->a2r[c] = st->a2r;
+    ls->b[0][c] = st->b1r;
+    ls->b[1][c] = st->b2r;
+    ls->b[2][c] = st->b3r;
+    ls->b[3][c] = st->b4r;
+    ls->b[4][c] = st->b5r;
+    ls->b[5][c] = st->b6r;
+    ls->dq[0][c] = st->dq0;
+    ls->dq[1][c] = st->dq1;
+    ls->dq[2][c] = st->dq2;
+    ls->dq[3][c] = st->dq3;
+    ls->dq[4][c] = st->dq4;
+    ls->dq[5][c] = st->dq5;
+    ls->dmsp[c] = st->dmsp;
+    ls->dmlp[c] = st->dmlp;
+    ls->apr[c] = st->apr;
+    ls->yup[c] = st->yup;
+    ls->tdr[c] = st->tdr;
+    ls->pk[0][c] = st->pk0;
+    ls->pk[1][c] = st->pk1;
+    ls->ylp[c] = (int) st->ylp;
+  }
+}
+
+static void G726_lanes_save (G726_LANE_STATE * ls, G726_state * state) {
+  G726_state *st;
+  long c;
+
+  for (c = 0; c < ls->n; c++) {
+    st = &state[c];
+    st->sr0 = (short) ls->sr[0][c];
+    st->sr1 = (short) ls->sr[1][c];
+    st->a1r = (short) ls->a1r[c];
+    st->a2r = (short) ls->a2r[c];
+    st->b1r = (short) ls->b[0][c];
+    st->b2r = (short) ls->b[1][c];
+    st->b3r = (short) ls->b[2][c];
+    st->b4r = (short) ls->b[3][c];
+    st->b5r = (short) ls->b[4][c];
+    st->b6r = (short) ls->b[5][c];
+    st->dq0 = (short) ls->dq[0][c];
+    st->dq1 = (short) ls->dq[1][c];
+    st->dq2 = (short) ls->dq[2][c];
+    st->dq3 = (short) ls->dq[3][c];
+    st->dq4 = (short) ls->dq[4][c];
+    st->dq5 = (short) ls->dq[5][c];
+    st->dmsp = (short) ls->dmsp[c];
+    st->dmlp = (short) ls->dmlp[c];
+    st->apr = (short) ls->apr[c];
+    st->yup = (short) ls->yup[c];
+    st->tdr = (short) ls->tdr[c];
+    st->pk0 = (short) ls->pk[0][c];
+    st->pk1 = (short) ls->pk[1][c];
+    st->ylp = ls->ylp[c];
+  }
+}
+
+/* .................. end of G726_lanes_{load,save}() .................. */
+
+
+/*
+ * ......... AVX2 kernel .........
+ * The fused step of g726.c (G726_step()) on vectors of 8 lanes, with the
+ * same arithmetic: a condition becomes a mask of all ones, ?: a blend,
+ * and the tables by rate are gathered with the rate index of each lane. The number of
+ * significant bits is taken from the exponent of a float, which is exact
+ * for these values.
+ */
+
+#define G726_V(k) _mm256_set1_epi32 (k)
+
+/* m ? a : b, for a mask m */
+UGST_TARGET ("avx2") static __m256i G726_v_sel (__m256i m, __m256i a, __m256i b) {
+  return _mm256_blendv_epi8 (b, a, m);
+}
+
+/* Mask of a > k */
+UGST_TARGET ("avx2") static __m256i G726_v_gt (__m256i a, int k) {
+  return _mm256_cmpgt_epi32 (a, G726_V (k));
+}
+
+/* Mask of a == k */
+UGST_TARGET ("avx2") static __m256i G726_v_eq (__m256i a, int k) {
+  return _mm256_cmpeq_epi32 (a, G726_V (k));
+}
+
+/* Number of significant bits of 0 <= x < 65536 */
+UGST_TARGET ("avx2") static __m256i G726_v_nbits (__m256i x) {
+  __m256i f = _mm256_castps_si256 (_mm256_cvtepi32_ps (_mm256_add_epi32 (_mm256_add_epi32 (x, x), G726_V (1))));
+
+  return _mm256_sub_epi32 (_mm256_srli_epi32 (f, 23), G726_V (127));
+}
+
+/* G726_floata() and G726_floatb(), from the sign and the magnitude */
+UGST_TARGET ("avx2") static __m256i G726_v_float (__m256i s, __m256i mag) {
+  __m256i exp_ = G726_v_nbits (mag);
+  __m256i mant = G726_v_sel (G726_v_eq (mag, 0), G726_V (32), _mm256_srlv_epi32 (_mm256_slli_epi32 (mag, 6), exp_));
+
+  return _mm256_add_epi32 (_mm256_add_epi32 (_mm256_slli_epi32 (s, 10), _mm256_slli_epi32 (exp_, 6)), mant);
+}
+
+/* G726_mix() */
+UGST_TARGET ("avx2") static __m256i G726_v_mix (__m256i al, __m256i yu, __m256i yl) {
+  __m256i yl6 = _mm256_srli_epi32 (yl, 6);
+  __m256i dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (yu, G726_V (16384)), yl6), G726_V (16383));
+  __m256i neg = G726_v_gt (dif, 8191);
+  __m256i difm = G726_v_sel (neg, _mm256_and_si256 (_mm256_sub_epi32 (G726_V (16384), dif), G726_V (8191)), dif);
+  __m256i prodm = _mm256_srli_epi32 (_mm256_mullo_epi32 (difm, al), 6);
+  __m256i prod = G726_v_sel (neg, _mm256_and_si256 (_mm256_sub_epi32 (G726_V (16384), prodm), G726_V (16383)), prodm);
+
+  return _mm256_and_si256 (_mm256_add_epi32 (yl6, prod), G726_V (8191));
+}
+
+/* G726_fmult(): An * SRn */
+UGST_TARGET ("avx2") static __m256i G726_v_fmult (__m256i an, __m256i srn) {
+  __m256i ans, anmag, anexp, anmant, wanexp, wanmant, wanmag;
+
+  an = _mm256_and_si256 (an, G726_V (65535));
+  srn = _mm256_and_si256 (srn, G726_V (65535));
+  ans = _mm256_srli_epi32 (an, 15);
+  anmag = G726_v_sel (G726_v_eq (ans, 0), _mm256_srli_epi32 (an, 2), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (16384), _mm256_srli_epi32 (an, 2)), G726_V (8191)));
+  anexp = G726_v_nbits (anmag);
+  anmant = G726_v_sel (G726_v_eq (anmag, 0), G726_V (32), _mm256_srlv_epi32 (_mm256_slli_epi32 (anmag, 6), anexp));
+  wanexp = _mm256_add_epi32 (_mm256_and_si256 (_mm256_srli_epi32 (srn, 6), G726_V (15)), anexp);
+  wanmant = _mm256_srli_epi32 (_mm256_add_epi32 (_mm256_mullo_epi32 (_mm256_and_si256 (srn, G726_V (63)), anmant), G726_V (48)), 4);
+  wanmag = _mm256_sllv_epi32 (_mm256_slli_epi32 (wanmant, 7), _mm256_max_epi32 (_mm256_sub_epi32 (wanexp, G726_V (26)), _mm256_setzero_si256 ()));
+  wanmag = _mm256_and_si256 (_mm256_srlv_epi32 (wanmag, _mm256_max_epi32 (_mm256_sub_epi32 (G726_V (26), wanexp), _mm256_setzero_si256 ())), G726_V (32767));
+  return G726_v_sel (G726_v_eq (_mm256_xor_si256 (_mm256_srli_epi32 (srn, 10), ans), 0), wanmag, _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), wanmag), G726_V (65535)));
+}
+
+/* G726_expand(), for A law from the samples before the inversion of
+   the even bits */
+UGST_TARGET ("avx2") static __m256i G726_v_expand (int alaw, __m256i s) {
+  __m256i s1, sig, iexp, mant, ss, ssq;
+
+  if (alaw) {
+    s1 = _mm256_xor_si256 (s, G726_V (85 ^ 128));
+    sig = _mm256_and_si256 (G726_v_gt (s1, 127), G726_V (4096));
+    s1 = _mm256_and_si256 (s1, G726_V (127));
+    iexp = _mm256_srli_epi32 (s1, 4);
+    mant = _mm256_slli_epi32 (_mm256_and_si256 (s1, G726_V (15)), 1);
+    ss = G726_v_sel (G726_v_eq (iexp, 0), _mm256_add_epi32 (mant, G726_V (1)), _mm256_srli_epi32 (_mm256_sllv_epi32 (_mm256_add_epi32 (mant, G726_V (33)), iexp), 1));
+    ss = _mm256_add_epi32 (ss, sig);
+    ssq = _mm256_slli_epi32 (_mm256_and_si256 (ss, G726_V (4095)), 1);
+    return G726_v_sel (G726_v_gt (ss, 4095), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (16384), ssq), G726_V (16383)), ssq);
+  }
+  s1 = _mm256_xor_si256 (s, G726_V (128));
+  sig = _mm256_and_si256 (G726_v_gt (s1, 127), G726_V (8192));
+  s1 = _mm256_xor_si256 (_mm256_and_si256 (s1, G726_V (127)), G726_V (127));
+  iexp = _mm256_srli_epi32 (s1, 4);
+  mant = _mm256_slli_epi32 (_mm256_and_si256 (s1, G726_V (15)), 1);
+  ss = _mm256_add_epi32 (_mm256_sub_epi32 (_mm256_sllv_epi32 (_mm256_add_epi32 (mant, G726_V (33)), iexp), G726_V (33)), sig);
+  ssq = _mm256_and_si256 (ss, G726_V (8191));
+  return G726_v_sel (G726_v_gt (ss, 8191), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (16384), ssq), G726_V (16383)), ssq);
+}
+
+/* G726_subta(), G726_log() and G726_subtb(): dln, with the sign of the
+   difference in bit 12 */
+UGST_TARGET ("avx2") static __m256i G726_v_dln (__m256i sl, __m256i se, __m256i y) {
+  __m256i sli, sei, d, neg, dqm, exp_, dl;
+
+  sli = G726_v_sel (G726_v_gt (sl, 8191), _mm256_add_epi32 (sl, G726_V (49152)), sl);
+  sei = G726_v_sel (G726_v_gt (se, 16383), _mm256_add_epi32 (se, G726_V (32768)), se);
+  d = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (sli, G726_V (65536)), sei), G726_V (65535));
+  neg = G726_v_gt (d, 32767);
+  dqm = G726_v_sel (neg, _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), d), G726_V (32767)), d);
+  exp_ = _mm256_max_epi32 (_mm256_sub_epi32 (G726_v_nbits (dqm), G726_V (1)), _mm256_setzero_si256 ());
+  dl = _mm256_add_epi32 (_mm256_slli_epi32 (exp_, 7), _mm256_and_si256 (_mm256_srlv_epi32 (_mm256_slli_epi32 (dqm, 7), exp_), G726_V (127)));
+  dl = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (dl, G726_V (4096)), _mm256_srli_epi32 (y, 2)), G726_V (4095));
+  return _mm256_add_epi32 (dl, _mm256_and_si256 (neg, G726_V (4096)));
+}
+
+/* G726_quan(), for the lanes c to c+7: code from dln with its sign; in
+   offset binary (with the sign bit inverted, as compared by G726_sync())
+   if offs is 1 */
+UGST_TARGET ("avx2") static __m256i G726_v_quan (G726_LANE_STATE * ls, long c, int offs, __m256i dln) {
+  __m256i mag1 = _mm256_add_epi32 (_mm256_and_si256 (dln, G726_V (4095)), G726_V (1));
+  __m256i ri = _mm256_loadu_si256 ((__m256i *) & ls->ri[c]);
+  __m256i rmax = _mm256_loadu_si256 ((__m256i *) & ls->max[c]);
+  __m256i zfix = _mm256_loadu_si256 ((__m256i *) & ls->zfix[c]);
+  __m256i lev = _mm256_setzero_si256 (), half, id, fix;
+  int k;
+
+  for (k = 0; k < 16; k++)
+    lev = _mm256_sub_epi32 (lev, _mm256_cmpgt_epi32 (mag1, _mm256_loadu_si256 ((__m256i *) & ls->thr[k][c])));
+  half = offs ? _mm256_srli_epi32 (_mm256_add_epi32 (rmax, G726_V (1)), 1) : _mm256_setzero_si256 ();
+  id = _mm256_i32gather_epi32 (G726_m_qtab, _mm256_add_epi32 (_mm256_mullo_epi32 (ri, G726_V (17)), lev), 4);
+  id = _mm256_xor_si256 (id, half);
+  id = G726_v_sel (G726_v_gt (dln, 4095), _mm256_sub_epi32 (rmax, id), id);
+  fix = _mm256_and_si256 (G726_v_eq (zfix, 1), _mm256_cmpeq_epi32 (id, half));
+  return G726_v_sel (fix, offs ? _mm256_sub_epi32 (half, G726_V (1)) : rmax, id);
+}
+
+/* G726_compress(): sp from sr, for A law after the inversion of the even
+   bits. The doubling loop of A law ends after min(13-nbits,7) steps; the
+   segment of u law is the one whose offset 2^(iesp+6)-33 is reached */
+UGST_TARGET ("avx2") static __m256i G726_v_compress (int alaw, __m256i sr) {
+  __m256i is = _mm256_srli_epi32 (_mm256_and_si256 (sr, G726_V (65535)), 15);
+  __m256i neg = G726_v_eq (is, 1);
+  __m256i im = G726_v_sel (neg, _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), sr), G726_V (32767)), sr);
+  __m256i imag, nb, big, sh, iesp;
+
+  if (alaw) {
+    im = G726_v_sel (G726_v_eq (sr, 32768), G726_V (2), im);
+    imag = G726_v_sel (neg, _mm256_sub_epi32 (_mm256_srli_epi32 (_mm256_add_epi32 (im, G726_V (1)), 1), G726_V (1)), _mm256_srli_epi32 (im, 1));
+    imag = _mm256_min_epi32 (imag, G726_V (4095));
+    nb = G726_v_nbits (imag);
+    big = G726_v_gt (nb, 5);
+    sh = G726_v_sel (big, _mm256_sub_epi32 (G726_V (13), nb), G726_V (7));
+    iesp = _mm256_and_si256 (big, _mm256_sub_epi32 (nb, G726_V (5)));
+    imag = _mm256_srli_epi32 (_mm256_and_si256 (_mm256_sllv_epi32 (imag, sh), G726_V (4095)), 8);
+    imag = _mm256_add_epi32 (_mm256_add_epi32 (imag, _mm256_slli_epi32 (iesp, 4)), _mm256_slli_epi32 (is, 7));
+    return _mm256_xor_si256 (imag, G726_V (128 ^ 85));
+  }
+  imag = _mm256_min_epi32 (_mm256_add_epi32 (im, G726_V (1)), G726_V (8159));
+  iesp = _mm256_sub_epi32 (G726_v_nbits (_mm256_add_epi32 (imag, G726_V (32))), G726_V (6));
+  imag = _mm256_sub_epi32 (imag, _mm256_sub_epi32 (_mm256_sllv_epi32 (G726_V (1), _mm256_add_epi32 (iesp, G726_V (5))), G726_V (32)));
+  imag = _mm256_srav_epi32 (imag, _mm256_add_epi32 (iesp, G726_V (1)));
+  imag = _mm256_add_epi32 (_mm256_add_epi32 (imag, _mm256_slli_epi32 (iesp, 4)), _mm256_slli_epi32 (is, 7));
+  return _mm256_xor_si256 (imag, G726_V (255));
+}
+
+/* G726_sync(), for the lanes c to c+7: the output from the code i, the
+   log PCM sample sp (for A law after the inversion of the even bits) and
+   the code id of sp in offset binary. The chains of comparisons of
+   G726_sync() are reduced to one step of sp up or down */
+UGST_TARGET ("avx2") static __m256i G726_v_sync (G726_LANE_STATE * ls, long c, int alaw, __m256i i, __m256i sp, __m256i id) {
+  __m256i rmax = _mm256_loadu_si256 ((__m256i *) & ls->max[c]);
+  __m256i im = _mm256_xor_si256 (i, _mm256_srli_epi32 (_mm256_add_epi32 (rmax, G726_V (1)), 1));
+  __m256i t = alaw ? _mm256_xor_si256 (sp, G726_V (85)) : sp;
+  __m256i ss = _mm256_and_si256 (_mm256_srli_epi32 (t, 7), G726_V (1));
+  __m256i ssm = G726_v_eq (ss, 1);
+  __m256i mask = _mm256_and_si256 (t, G726_V (127));
+  __m256i gt = _mm256_cmpgt_epi32 (id, im), lt = _mm256_cmpgt_epi32 (im, id);
+  __m256i down = _mm256_or_si256 (_mm256_and_si256 (gt, ssm), _mm256_andnot_si256 (ssm, lt));
+  __m256i up = _mm256_or_si256 (_mm256_andnot_si256 (ssm, gt), _mm256_and_si256 (lt, ssm));
+  __m256i m0 = G726_v_eq (mask, 0), m127 = G726_v_eq (mask, 127), v;
+
+  /* the masks are -1: adding one subtracts 1 */
+  if (alaw) {
+    v = _mm256_slli_epi32 (_mm256_xor_si256 (ss, _mm256_and_si256 (_mm256_and_si256 (down, m0), G726_V (1))), 7);
+    v = _mm256_add_epi32 (_mm256_add_epi32 (v, mask), _mm256_andnot_si256 (m0, down));
+    v = _mm256_sub_epi32 (v, _mm256_andnot_si256 (m127, up));
+    return _mm256_xor_si256 (v, G726_V (85));
+  }
+  v = _mm256_slli_epi32 (_mm256_xor_si256 (ss, _mm256_and_si256 (_mm256_and_si256 (down, m127), G726_V (1))), 7);
+  v = _mm256_add_epi32 (_mm256_add_epi32 (v, mask), _mm256_and_si256 (_mm256_and_si256 (gt, ssm), m127));
+  v = _mm256_sub_epi32 (v, _mm256_andnot_si256 (m127, down));
+  return _mm256_add_epi32 (v, _mm256_andnot_si256 (m0, up));
+}
+
+#define G726_LD(a) _mm256_loadu_si256 ((__m256i *) & (a)[c])
+#define G726_ST(a, v) _mm256_storeu_si256 ((__m256i *) & (a)[c], v)
+
+/*
+  ----------------------------------------------------------------------------
+
+        static void G726_lanes_step_avx2 (G726_LANE_STATE *ls, int alaw,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  int decode, int *x, short *out);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        One sample of all lanes, as G726_step() in g726.c: x[c] is the
+        log PCM sample of lane c (encoder) or its ADPCM code (decoder),
+        and out[c] receives the code (encoder) or the log PCM sample
+        (decoder). Codes are taken modulo 2^rate. The whole sample is
+        computed for 8 lanes at a time; the lanes up to the next
+        multiple of 8 are computed too.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+UGST_TARGET ("avx2") static void G726_lanes_step_avx2 (G726_LANE_STATE * ls, int alaw, int decode, int *x, short *out) {
+  __m256i dqo[7], wa[8], sez, se, y, sl, code, rmax, ri, signm, im, fi, wi, dq, dms, dml, yl, dif, difsx, yu, thr, tr;
+  __m256i dqi, dqsez, pk0, pk1, pk2, sigpk, sr, sr0, dq0, a11, a21, fa1, fa, uga2, ula2, a2p, uga1, ula1, a1p, a1ul, a1ll;
+  __m256i tdp, difm, ax, apr, bb, ugb, ulb, dqs, sp, id;
+  long c;
+  int k;
+
+  for (c = 0; c < ls->n; c += 8) {
+    /* `known-state' parts of 4.2.6: delays and predictor; 4.2.5, 4.2.4;
+       dqo[k] is dq with delay k after the shift */
+    for (k = 0; k < 6; k++)
+      dqo[k + 1] = G726_LD (ls->dq[k]);
+    G726_ST (ls->sr[2], G726_LD (ls->sr[1]));
+    G726_ST (ls->sr[1], G726_LD (ls->sr[0]));
+    pk2 = G726_LD (ls->pk[1]);
+    pk1 = G726_LD (ls->pk[0]);
+    for (k = 0; k < 6; k++)
+      wa[k] = G726_v_fmult (G726_LD (ls->b[k]), dqo[k + 1]);
+    wa[6] = G726_v_fmult (G726_LD (ls->a2r), G726_LD (ls->sr[2]));
+    wa[7] = G726_v_fmult (G726_LD (ls->a1r), G726_LD (ls->sr[1]));
+    sez = wa[0];
+    for (k = 1; k < 6; k++)
+      sez = _mm256_and_si256 (_mm256_add_epi32 (sez, wa[k]), G726_V (65535));
+    se = _mm256_and_si256 (_mm256_add_epi32 (sez, wa[6]), G726_V (65535));
+    se = _mm256_srli_epi32 (_mm256_and_si256 (_mm256_add_epi32 (se, wa[7]), G726_V (65535)), 1);
+    sez = _mm256_srli_epi32 (sez, 1);
+    apr = G726_LD (ls->apr);
+    yl = G726_LD (ls->ylp);
+    y = G726_v_mix (_mm256_min_epi32 (_mm256_srli_epi32 (apr, 2), G726_V (64)), G726_LD (ls->yup), yl);
+
+    /* 4.2.1 and 4.2.2, or the ADPCM code */
+    rmax = G726_LD (ls->max);
+    if (decode)
+      code = _mm256_and_si256 (G726_LD (x), rmax);
+    else {
+      sl = G726_v_expand (alaw, G726_LD (x));
+      code = G726_v_quan (ls, c, 0, G726_v_dln (sl, se, y));
+      _mm_storeu_si128 ((__m128i *) & out[c], _mm256_castsi256_si128 (_mm256_permute4x64_epi64 (_mm256_packs_epi32 (code, code), 0x08)));
+    }
+
+    /* 4.2.3: G726_reconst(), G726_adda() and G726_antilog() */
+    ri = G726_LD (ls->ri);
+    dq = _mm256_i32gather_epi32 (G726_m_dqln, _mm256_add_epi32 (_mm256_slli_epi32 (ri, 5), code), 4);
+    dq = _mm256_and_si256 (_mm256_add_epi32 (dq, _mm256_srli_epi32 (y, 2)), G726_V (4095));
+    dq = _mm256_andnot_si256 (G726_v_gt (dq, 2047), _mm256_srlv_epi32 (_mm256_slli_epi32 (_mm256_add_epi32 (_mm256_and_si256 (dq, G726_V (127)), G726_V (128)), 7), _mm256_sub_epi32 (G726_V (14), _mm256_and_si256 (_mm256_srli_epi32 (dq, 7), G726_V (15)))));
+    signm = _mm256_cmpgt_epi32 (code, _mm256_srli_epi32 (rmax, 1));
+    dq = _mm256_sub_epi32 (dq, _mm256_and_si256 (signm, G726_V (32768)));
+
+    /* 4.2.5 and 4.2.4: G726_filta(), G726_filtb(), G726_filtd(),
+       G726_limb() and G726_filte() */
+    im = G726_v_sel (signm, _mm256_sub_epi32 (rmax, code), code);
+    fi = _mm256_i32gather_epi32 (G726_m_fi, _mm256_add_epi32 (_mm256_slli_epi32 (ri, 4), im), 4);
+    wi = _mm256_i32gather_epi32 (G726_m_wi, _mm256_add_epi32 (_mm256_slli_epi32 (ri, 4), im), 4);
+    dms = G726_LD (ls->dmsp);
+    dml = G726_LD (ls->dmlp);
+    dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (_mm256_slli_epi32 (fi, 9), G726_V (8192)), dms), G726_V (8191));
+    difsx = _mm256_add_epi32 (_mm256_srli_epi32 (dif, 5), _mm256_and_si256 (G726_v_gt (dif, 4095), G726_V (3840)));
+    dms = _mm256_and_si256 (_mm256_add_epi32 (difsx, dms), G726_V (4095));
+    dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (_mm256_slli_epi32 (fi, 11), G726_V (32768)), dml), G726_V (32767));
+    difsx = _mm256_add_epi32 (_mm256_srli_epi32 (dif, 7), _mm256_and_si256 (G726_v_gt (dif, 16383), G726_V (16128)));
+    dml = _mm256_and_si256 (_mm256_add_epi32 (difsx, dml), G726_V (16383));
+    G726_ST (ls->dmsp, dms);
+    G726_ST (ls->dmlp, dml);
+    dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (_mm256_slli_epi32 (wi, 5), G726_V (131072)), y), G726_V (131071));
+    difsx = _mm256_add_epi32 (_mm256_srli_epi32 (dif, 5), _mm256_and_si256 (G726_v_gt (dif, 65535), G726_V (4096)));
+    yu = _mm256_and_si256 (_mm256_add_epi32 (y, difsx), G726_V (8191));
+    dif = G726_v_gt (_mm256_and_si256 (_mm256_add_epi32 (yu, G726_V (15840)), G726_V (16383)), 8191);
+    yu = G726_v_sel (G726_v_gt (_mm256_and_si256 (_mm256_add_epi32 (yu, G726_V (11264)), G726_V (16383)), 8191), yu, G726_V (5120));
+    yu = G726_v_sel (dif, G726_V (544), yu);
+    G726_ST (ls->yup, yu);
+    dif = _mm256_and_si256 (_mm256_add_epi32 (yu, _mm256_srli_epi32 (_mm256_sub_epi32 (G726_V (1048576), yl), 6)), G726_V (16383));
+    difsx = _mm256_add_epi32 (dif, _mm256_and_si256 (G726_v_gt (dif, 8191), G726_V (507904)));
+    G726_ST (ls->ylp, _mm256_and_si256 (_mm256_add_epi32 (yl, difsx), G726_V (524287)));
+
+    /* `known-state' part of 4.2.7: transition detector */
+    thr = _mm256_sllv_epi32 (_mm256_add_epi32 (_mm256_and_si256 (_mm256_srli_epi32 (yl, 10), G726_V (31)), G726_V (32)), _mm256_srli_epi32 (yl, 15));
+    thr = G726_v_sel (G726_v_gt (_mm256_srli_epi32 (yl, 15), 9), G726_V (31744), thr);
+    thr = _mm256_srli_epi32 (_mm256_add_epi32 (thr, _mm256_srli_epi32 (thr, 1)), 1);
+    tr = _mm256_and_si256 (_mm256_cmpgt_epi32 (_mm256_and_si256 (dq, G726_V (32767)), thr), G726_v_eq (G726_LD (ls->tdr), 1));
+
+    /* 4.2.6: pk0, sr0 and dq0 */
+    dqs = _mm256_and_si256 (_mm256_srai_epi32 (dq, 15), G726_V (1));
+    dqi = G726_v_sel (G726_v_eq (dqs, 1), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), _mm256_and_si256 (dq, G726_V (32767))), G726_V (65535)), _mm256_and_si256 (dq, G726_V (65535)));
+    dqsez = _mm256_add_epi32 (sez, _mm256_and_si256 (G726_v_gt (sez, 16383), G726_V (32768)));
+    dqsez = _mm256_and_si256 (_mm256_add_epi32 (dqi, dqsez), G726_V (65535));
+    pk0 = _mm256_srli_epi32 (dqsez, 15);
+    sigpk = G726_v_eq (dqsez, 0);
+    sr = _mm256_add_epi32 (se, _mm256_and_si256 (G726_v_gt (se, 16383), G726_V (32768)));
+    sr = _mm256_and_si256 (_mm256_add_epi32 (dqi, sr), G726_V (65535));
+    sr0 = _mm256_srli_epi32 (sr, 15);
+    sr0 = G726_v_float (sr0, G726_v_sel (G726_v_eq (sr0, 1), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), sr), G726_V (32767)), sr));
+    dq0 = G726_v_float (dqs, _mm256_and_si256 (dq, G726_V (32767)));
+    G726_ST (ls->pk[2], pk2);
+    G726_ST (ls->pk[1], pk1);
+    G726_ST (ls->pk[0], pk0);
+    G726_ST (ls->sr[0], sr0);
+    G726_ST (ls->dq[0], dq0);
+    for (k = 1; k < 7; k++)
+      G726_ST (ls->dq[k], dqo[k]);
+
+    /* 4.2.6: G726_upa2() and G726_limc() */
+    a11 = _mm256_and_si256 (G726_LD (ls->a1r), G726_V (65535));
+    a21 = _mm256_and_si256 (G726_LD (ls->a2r), G726_V (65535));
+    fa1 = G726_v_sel (G726_v_gt (a11, 32767), _mm256_max_epi32 (a11, G726_V (57345)), _mm256_min_epi32 (a11, G726_V (8191)));
+    fa1 = _mm256_and_si256 (_mm256_slli_epi32 (fa1, 2), G726_V (131071));
+    fa = G726_v_sel (_mm256_cmpeq_epi32 (pk0, pk1), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (131072), fa1), G726_V (131071)), fa1);
+    fa = _mm256_add_epi32 (fa, G726_v_sel (_mm256_cmpeq_epi32 (pk0, pk2), G726_V (16384), G726_V (114688)));
+    fa = _mm256_and_si256 (fa, G726_V (131071));
+    uga2 = _mm256_add_epi32 (_mm256_srli_epi32 (fa, 7), _mm256_and_si256 (G726_v_gt (fa, 65535), G726_V (64512)));
+    uga2 = _mm256_andnot_si256 (sigpk, uga2);
+    ula2 = _mm256_add_epi32 (_mm256_srli_epi32 (a21, 7), _mm256_and_si256 (G726_v_gt (a21, 32767), G726_V (65024)));
+    ula2 = _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), ula2), G726_V (65535));
+    a2p = _mm256_and_si256 (_mm256_add_epi32 (a21, _mm256_and_si256 (_mm256_add_epi32 (uga2, ula2), G726_V (65535))), G726_V (65535));
+    a2p = G726_v_sel (_mm256_andnot_si256 (G726_v_gt (a2p, 53248), G726_v_gt (a2p, 32767)), G726_V (53248), a2p);
+    a2p = G726_v_sel (_mm256_andnot_si256 (G726_v_gt (a2p, 32767), G726_v_gt (a2p, 12287)), G726_V (12288), a2p);
+
+    /* 4.2.6: G726_upa1() and G726_limd() */
+    uga1 = _mm256_andnot_si256 (sigpk, G726_v_sel (_mm256_cmpeq_epi32 (pk0, pk1), G726_V (192), G726_V (65344)));
+    ula1 = _mm256_add_epi32 (_mm256_srli_epi32 (a11, 8), _mm256_and_si256 (G726_v_gt (a11, 32767), G726_V (65280)));
+    ula1 = _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), ula1), G726_V (65535));
+    a1p = _mm256_and_si256 (_mm256_add_epi32 (a11, _mm256_and_si256 (_mm256_add_epi32 (uga1, ula1), G726_V (65535))), G726_V (65535));
+    a1ul = _mm256_and_si256 (_mm256_sub_epi32 (G726_V (15360 + 65536), a2p), G726_V (65535));
+    a1ll = _mm256_and_si256 (_mm256_add_epi32 (a2p, G726_V (65536 - 15360)), G726_V (65535));
+    a1p = G726_v_sel (_mm256_andnot_si256 (_mm256_cmpgt_epi32 (a1p, a1ll), G726_v_gt (a1p, 32767)), a1ll, a1p);
+    a1p = G726_v_sel (_mm256_andnot_si256 (G726_v_gt (a1p, 32767), _mm256_cmpgt_epi32 (_mm256_add_epi32 (a1p, G726_V (1)), a1ul)), a1ul, a1p);
+
+    /* 4.2.7: tone detector; 4.2.5: G726_subtc() and G726_filtc() */
+    tdp = _mm256_andnot_si256 (G726_v_gt (a2p, 53759), G726_v_gt (a2p, 32767));
+    dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (_mm256_slli_epi32 (dms, 2), G726_V (32768)), dml), G726_V (32767));
+    difm = G726_v_sel (G726_v_gt (dif, 16383), _mm256_and_si256 (_mm256_sub_epi32 (G726_V (32768), dif), G726_V (16383)), dif);
+    ax = _mm256_and_si256 (_mm256_and_si256 (G726_v_gt (y, 1535), _mm256_cmpgt_epi32 (_mm256_srli_epi32 (dml, 3), difm)), _mm256_xor_si256 (tdp, G726_V (-1)));
+    ax = _mm256_andnot_si256 (ax, G726_V (512));
+    dif = _mm256_and_si256 (_mm256_sub_epi32 (_mm256_add_epi32 (ax, G726_V (2048)), apr), G726_V (2047));
+    difsx = _mm256_add_epi32 (_mm256_srli_epi32 (dif, 4), _mm256_and_si256 (G726_v_gt (dif, 1023), G726_V (896)));
+    G726_ST (ls->a2r, _mm256_andnot_si256 (tr, a2p));
+    G726_ST (ls->a1r, _mm256_andnot_si256 (tr, a1p));
+    G726_ST (ls->tdr, _mm256_andnot_si256 (tr, _mm256_and_si256 (tdp, G726_V (1))));
+    G726_ST (ls->apr, G726_v_sel (tr, G726_V (256), _mm256_and_si256 (_mm256_add_epi32 (apr, difsx), G726_V (1023))));
+
+    /* 4.2.6: G726_xor() and G726_upb() */
+    for (k = 0; k < 6; k++) {
+      bb = _mm256_and_si256 (G726_LD (ls->b[k]), G726_V (65535));
+      ugb = G726_v_sel (_mm256_cmpeq_epi32 (dqs, _mm256_srli_epi32 (dqo[k + 1], 10)), G726_V (128), G726_V (65408));
+      ugb = _mm256_andnot_si256 (G726_v_eq (_mm256_and_si256 (dq, G726_V (32767)), 0), ugb);
+      ulb = _mm256_srlv_epi32 (bb, G726_LD (ls->leak));
+      ulb = _mm256_add_epi32 (ulb, _mm256_and_si256 (G726_v_gt (bb, 32767), G726_LD (ls->param)));
+      ulb = _mm256_and_si256 (_mm256_sub_epi32 (G726_V (65536), ulb), G726_V (65535));
+      bb = _mm256_and_si256 (_mm256_add_epi32 (bb, _mm256_and_si256 (_mm256_add_epi32 (ugb, ulb), G726_V (65535))), G726_V (65535));
+      G726_ST (ls->b[k], _mm256_andnot_si256 (tr, bb));
+    }
+
+    /* 4.2.8: output PCM and synchronous coding adjustment */
+    if (decode) {
+      sp = G726_v_compress (alaw, sr);
+      id = G726_v_quan (ls, c, 1, G726_v_dln (G726_v_expand (alaw, sp), se, y));
+      sp = G726_v_sync (ls, c, alaw, code, sp, id);
+      _mm_storeu_si128 ((__m128i *) & out[c], _mm256_castsi256_si128 (_mm256_permute4x64_epi64 (_mm256_packs_epi32 (sp, sp), 0x08)));
+    }
+  }
+}
+
+/* ................... end of G726_lanes_step_avx2() ................... */
+#endif
+
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        int G726_select_multi_kernel (int kernel);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Selects the kernel of G726_encode_multi() and
+        G726_decode_multi(): G726_KERNEL_SCALAR, G726_KERNEL_AVX2, or
+        G726_KERNEL_AUTO (the default) for AVX2 when the compiler and
+        the CPU support it. A kernel the CPU does not support falls
+        back to G726_KERNEL_SCALAR. All kernels are bit-exact.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The G726_KERNEL_xxx actually selected.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+int G726_select_multi_kernel (int kernel) {
+  if (kernel == G726_KERNEL_AUTO || kernel > G726_KERNEL_AVX2)
+    kernel = G726_KERNEL_AVX2;
+
+  if (kernel == G726_KERNEL_AVX2 && !ugst_cpu_supports (UGST_CPU_AVX2))
+    kernel = G726_KERNEL_SCALAR;
+  if (kernel != G726_KERNEL_AVX2)
+    kernel = G726_KERNEL_SCALAR;
+#ifdef UGST_SIMD_X86
+  else
+    G726_m_tables ();
+#endif
+
+  return (G726_kernel = kernel);
+}
+
+/* ................ end of G726_select_multi_kernel() ................ */
+
+
+/* C kernel: each channel in turn, through a block of G726_CHUNK samples;
+   codes given to the decoder are taken modulo 2^rate */
+static void G726_multi_scalar (int decode, short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state) {
+  short inp[G726_CHUNK], out[G726_CHUNK];
+  short mask;
+  long c, j0, n, j;
+
+  for (c = 0; c < nchan; c++) {
+    mask = decode ? (short) ((1 << ((rate[c] >= 2 && rate[c] <= 4) ? rate[c] : 5)) - 1) : (short) -1;
+    for (j0 = 0; j0 < smpno; j0 += n) {
+      n = (smpno - j0 < G726_CHUNK) ? smpno - j0 : G726_CHUNK;
+      for (j = 0; j < n; j++)
+        inp[j] = inp_buf[(j0 + j) * nchan + c] & mask;
+      if (decode)
+        G726_decode (inp, out, n, law, rate[c], (short) (r && j0 == 0), &state[c]);
+      else
+        G726_encode (inp, out, n, law, rate[c], (short) (r && j0 == 0), &state[c]);
+      for (j = 0; j < n; j++)
+        out_buf[(j0 + j) * nchan + c] = out[j];
+    }
+  }
+}
+
+#ifdef UGST_SIMD_X86
+/* AVX2 kernel: one group of lanes after the other */
+static void G726_multi_avx2 (int decode, short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state) {
+  G726_LANE_STATE ls;
+  int x[G726_LANES];
+  short out[G726_LANES];
+  int alaw = (*law == '1');
+  long c0, n, c, j;
+
+  for (c = 0; c < G726_LANES; c++)
+    x[c] = 0;
+
+  for (c0 = 0; c0 < nchan; c0 += n) {
+    n = (nchan - c0 < G726_LANES) ? nchan - c0 : G726_LANES;
+    G726_lanes_load (&ls, state + c0, rate + c0, n, r);
+    for (j = 0; j < smpno; j++) {
+      for (c = 0; c < n; c++)
+        x[c] = inp_buf[j * nchan + c0 + c];
+      G726_lanes_step_avx2 (&ls, alaw, decode, x, out);
+      for (c = 0; c < n; c++)
+        out_buf[j * nchan + c0 + c] = out[c];
+    }
+    G726_lanes_save (&ls, state + c0);
+  }
+}
+#endif
+
+/* Encoder (decode == 0) or decoder of G726_encode_multi() and
+   G726_decode_multi(), with the kernel in use */
+static void G726_multi (int decode, short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state) {
+  if (G726_kernel == G726_KERNEL_AUTO)
+    G726_select_multi_kernel (G726_KERNEL_AUTO);
+#ifdef UGST_SIMD_X86
+  if (G726_kernel == G726_KERNEL_AVX2) {
+    G726_multi_avx2 (decode, inp_buf, out_buf, smpno, law, rate, r, nchan, state);
+    return;
+  }
+#endif
+  G726_multi_scalar (decode, inp_buf, out_buf, smpno, law, rate, r, nchan, state);
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+
+        void G726_encode_multi (short *inp_buf, short *out_buf,
+        ~~~~~~~~~~~~~~~~~~~~~~  long smpno, char *law, short *rate,
+                                short r, long nchan, G726_state *state);
+        void G726_decode_multi (...);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        G726_encode() and G726_decode() for nchan channels: smpno
+        samples of each channel, interleaved by channel in inp_buf and
+        out_buf, channel c at rate rate[c] with its state in state[c].
+        The law (`law'=='1' for A law, '0' for mu law) and the reset r
+        apply to all channels. Every channel gives the same output and
+        state as G726_encode() or G726_decode() on its own; inp_buf is
+        not changed. Codes given to the decoder are taken modulo
+        2^rate[c].
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 First version
+
+ ----------------------------------------------------------------------------
+*/
+void G726_encode_multi (short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state) {
+  G726_multi (0, inp_buf, out_buf, smpno, law, rate, r, nchan, state);
+}
+
+void G726_decode_multi (short *inp_buf, short *out_buf, long smpno, char *law, short *rate, short r, long nchan, G726_state * state) {
+  G726_multi (1, inp_buf, out_buf, smpno, law, rate, r, nchan, state);
+}
+
+/* ................ end of G726_{en,de}code_multi() ................ */
+
+
+/* ********************** END OF G726MULTI.C ********************** */
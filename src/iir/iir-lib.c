@@ -1,4 +1,4 @@
-/*                                                           v3.1 - 22/Feb/1996
+/*                                                           v3.3 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -51,6 +51,19 @@ FUNCTIONS    : - stdpcm_kernel(...)   =  parallel-form IIR filter (kernel)
 	       - direct_iir_kernel(...) = direct-form IIR filter (kernel)
 	       - direct_iir_free(...) = deallocate direct filter memory
 	       - direct_iir_reset(...) = clear direct state variables
+               - stdpcm_mc_init(...), cascade_iir_mc_init(...) =
+                                         multichannel (interleaved) filter
+                                         built from a mono one
+               - stdpcm_mc_kernel(...), cascade_iir_mc_kernel(...) =
+                                         multichannel filter (kernel)
+               - stdpcm_mc_reset(...), cascade_iir_mc_reset(...) =
+                                         clear multichannel state variables
+               - stdpcm_mc_free(...), cascade_iir_mc_free(...) =
+                                         deallocate multichannel filter
+               - stdpcm_select_kernel(...), cascade_iir_select_kernel(...) =
+                                         choose the scalar or the SIMD
+                                         kernel of a parallel or cascade
+                                         filter
 HISTORY:
 
     16.Dec.91 v0.1 First beta-version <hf@pkinbg.uucp>
@@ -61,6 +74,11 @@ HISTORY:
     22.Feb.96 v3.1 Changed inclusion of stdlib.h to inconditional, as
                    suggested by Kirchherr (FI/DBP Telekom) to run under
 		   OpenVMS/AXP <simao@ctd.comsat.com>
+    16.Oct.26 v3.2 Added multichannel filtering of interleaved signals
+                   for the parallel and cascade forms, with one set of
+                   state variables per channel and shared coefficients.
+    16.Oct.26 v3.3 Added a SIMD kernel for the parallel and cascade forms,
+                   with 4 second-order sections in the lanes of a vector.
 
   =============================================================================
 */
@@ -76,6 +94,12 @@ HISTORY:
 /* Definitions for IIR filters */
 #include "iirflt.h"
 
+/* SSE2 is part of the x86-64 base instruction set; otherwise plain C */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IIR_SSE2
+#include <emmintrin.h>
+#endif
+
 
 
 /*
@@ -107,6 +131,19 @@ static long direct_form_iir_up_kernel ARGS ((long lenx, float *x, float *y, long
 DIRECT_IIR *direct_iir_init ARGS ((long zno, long pno, float *a, float *b, double gain, long idown, char hswitch));
 
 
+/* Multichannel parallel- and cascade-form basic function prototypes */
+static long scd_parallel_form_iir_mc_down_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float *T, long nchan));
+static long scd_parallel_form_iir_mc_up_kernel ARGS ((long lenx, float *x, float *y, long iup, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float *T, long nchan));
+static long cascade_form_iir_mc_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double gain, float (*a)[2], float (*b)[2], float *T, double *xj, long nchan));
+
+
+/* SIMD parallel- and cascade-form basic function prototypes */
+static long scd_parallel_form_iir_simd_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double direct_cof, double gain, float (*T)[2], float *lanes));
+static long cascade_form_iir_simd_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double gain, float *lanes));
+static void iir_parallel_lanes ARGS ((float *x, long n, long first, long step, float *g, long nsect, float *acc));
+static void iir_cascade_lanes ARGS ((float *w, long n, float *g));
+
+
 /*
  * ...................... BEGIN OF FUNCTIONS .........................
  */
@@ -144,6 +181,7 @@ DIRECT_IIR *direct_iir_init ARGS ((long zno, long pno, float *a, float *b, doubl
  ============================================================================
 */
 void stdpcm_free (SCD_IIR * iir_ptr) {
+  free (iir_ptr->lanes);        /* free SIMD kernel data */
   free (iir_ptr->T);            /* free state variables */
   free (iir_ptr);               /* free allocated struct */
 }
@@ -272,8 +310,10 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
   ptrIIR->direct_cof = direct_cof;
 
 
-  /* Store switch to IIR-kernel procedure */
+  /* Store switch to IIR-kernel procedure; scalar kernel by default */
   ptrIIR->hswitch = hswitch;
+  ptrIIR->kernel = IIR_KERNEL_SCALAR;
+  ptrIIR->lanes = (float *) 0;
 
   /* Clear state variables */
   T_ptr = ptrIIR->T;
@@ -320,11 +360,14 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Runs the SIMD kernel when selected.
 
  ============================================================================
 */
 long stdpcm_kernel (long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr) {
-  if (iir_ptr->hswitch == 'U')
+  if (iir_ptr->kernel == IIR_KERNEL_SIMD)
+    return scd_parallel_form_iir_simd_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->hswitch == 'U', iir_ptr->nblocks, iir_ptr->direct_cof, iir_ptr->gain, iir_ptr->T, iir_ptr->lanes);
+  else if (iir_ptr->hswitch == 'U')
     return scd_parallel_form_iir_up_kernel (    /* returns number of output samples */
                                              lseg,      /* In : length of input signal */
                                              x_ptr,     /* In : array with input samples */
@@ -543,6 +586,7 @@ static long scd_parallel_form_iir_up_kernel (long lenx, float *x, float *y, long
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Also clears the state of the SIMD kernel.
 
  ============================================================================
 */
@@ -559,6 +603,10 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
     T_ptr[n][3] = 0.0;
   }
 
+  /* The SIMD kernel keeps its own state */
+  if (iir_ptr->lanes)
+    cascade_iir_select_kernel (iir_ptr, iir_ptr->kernel);
+
   iir_ptr->k0 = iir_ptr->idown; /* modulo counter for down-sampling */
 }
 
@@ -594,11 +642,14 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Runs the SIMD kernel when selected.
 
  ============================================================================
 */
 long cascade_iir_kernel (long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr) {
-  if (iir_ptr->hswitch == 'U')
+  if (iir_ptr->kernel == IIR_KERNEL_SIMD)
+    return cascade_form_iir_simd_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->hswitch == 'U', iir_ptr->nblocks, iir_ptr->gain, iir_ptr->lanes);
+  else if (iir_ptr->hswitch == 'U')
     return cascade_form_iir_up_kernel ( /* returns number of output samples */
                                         lseg,   /* In : input signal leng. */
                                         x_ptr,  /* In : input sample array */
@@ -849,8 +900,10 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
   ptrIIR->gain = gain;
 
 
-  /* Store switch to IIR-kernel procedure */
+  /* Store switch to IIR-kernel procedure; scalar kernel by default */
   ptrIIR->hswitch = hswitch;
+  ptrIIR->kernel = IIR_KERNEL_SCALAR;
+  ptrIIR->lanes = (float *) 0;
 
   /* Clear state variables */
   T_ptr = ptrIIR->T;
@@ -903,6 +956,7 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
  ============================================================================
 */
 void cascade_iir_free (CASCADE_IIR * iir_ptr) {
+  free (iir_ptr->lanes);        /* free SIMD kernel data */
   free (iir_ptr->T);            /* free state variables */
   free (iir_ptr);               /* free allocated struct */
 }
@@ -910,6 +964,855 @@ void cascade_iir_free (CASCADE_IIR * iir_ptr) {
 /* ....................... End of cascade_iir_free() ....................... */
 
 
+/* *************************************************************************
+   ********* MULTICHANNEL (INTERLEAVED) PARALLEL- AND CASCADE-FORM *********
+ * ************************************************************************* */
+
+/*
+  ============================================================================
+
+        SCD_IIR_MC *stdpcm_mc_init (SCD_IIR *iir_ptr, long nchan);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        CASCADE_IIR_MC *cascade_iir_mc_init (CASCADE_IIR *iir_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long nchan);
+
+        Description:
+        ~~~~~~~~~~~~
+        Build a filter for signals of nchan interleaved channels from a
+        (mono) filter returned by one of the initialization routines,
+        e.g. stdpcm_mc_init(stdpcm_16khz_init(), 2). The coefficients,
+        gain, rate change and modulo counter of iir_ptr are shared by all
+        channels, and each channel gets its own state variables. The
+        multichannel struct takes over iir_ptr, which is released by the
+        corresponding _mc_free() function.
+
+        Parameters:
+        ~~~~~~~~~~~
+        iir_ptr: ... pointer to the mono filter struct
+        nchan: ..... number of channels (1 or more)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns a pointer to the new struct, or NULL if there is not
+        enough memory (iir_ptr is then left untouched).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+SCD_IIR_MC *stdpcm_mc_init (SCD_IIR * iir_ptr, long nchan) {
+  SCD_IIR_MC *ptrMC;            /* pointer to the new struct */
+
+  if ((ptrMC = (SCD_IIR_MC *) malloc (sizeof (SCD_IIR_MC))) == (SCD_IIR_MC *) 0)
+    return 0;
+
+  /* State variables T[n][0..1], each one for all channels */
+  if ((ptrMC->T = (float *) malloc (iir_ptr->nblocks * 2 * nchan * sizeof (float))) == (float *) 0) {
+    free (ptrMC);
+    return 0;
+  }
+
+  ptrMC->nchan = nchan;
+  ptrMC->iir = iir_ptr;
+  stdpcm_mc_reset (ptrMC);
+
+  return (ptrMC);
+}
+
+
+CASCADE_IIR_MC *cascade_iir_mc_init (CASCADE_IIR * iir_ptr, long nchan) {
+  CASCADE_IIR_MC *ptrMC;        /* pointer to the new struct */
+
+  if ((ptrMC = (CASCADE_IIR_MC *) malloc (sizeof (CASCADE_IIR_MC))) == (CASCADE_IIR_MC *) 0)
+    return 0;
+
+  /* State variables T[n][0..3], each one for all channels */
+  if ((ptrMC->T = (float *) malloc (iir_ptr->nblocks * 4 * nchan * sizeof (float))) == (float *) 0) {
+    free (ptrMC);
+    return 0;
+  }
+
+  /* Signal between the stages, one per channel */
+  if ((ptrMC->xj = (double *) malloc (nchan * sizeof (double))) == (double *) 0) {
+    free (ptrMC->T);
+    free (ptrMC);
+    return 0;
+  }
+
+  ptrMC->nchan = nchan;
+  ptrMC->iir = iir_ptr;
+  cascade_iir_mc_reset (ptrMC);
+
+  return (ptrMC);
+}
+
+/* ............ End of stdpcm_mc_init() / cascade_iir_mc_init() ............ */
+
+
+/*
+  ============================================================================
+
+        void stdpcm_mc_reset (SCD_IIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~~~~~~
+        void cascade_iir_mc_reset (CASCADE_IIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        void stdpcm_mc_free (SCD_IIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~~~~~
+        void cascade_iir_mc_free (CASCADE_IIR_MC *mc_ptr);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+        Clear the state variables of all channels, or deallocate a
+        multichannel struct together with the mono filter it was built
+        from.
+
+        Parameters:
+        ~~~~~~~~~~~
+        mc_ptr: ... pointer to the multichannel struct
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Nothing.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void stdpcm_mc_reset (SCD_IIR_MC * mc_ptr) {
+  long k;
+
+  for (k = 0; k < mc_ptr->iir->nblocks * 2 * mc_ptr->nchan; k++)
+    mc_ptr->T[k] = 0.0;
+  mc_ptr->iir->k0 = mc_ptr->iir->idown; /* modulo counter for down-sampling */
+}
+
+
+void cascade_iir_mc_reset (CASCADE_IIR_MC * mc_ptr) {
+  long k;
+
+  for (k = 0; k < mc_ptr->iir->nblocks * 4 * mc_ptr->nchan; k++)
+    mc_ptr->T[k] = 0.0;
+  mc_ptr->iir->k0 = mc_ptr->iir->idown; /* modulo counter for down-sampling */
+}
+
+
+void stdpcm_mc_free (SCD_IIR_MC * mc_ptr) {
+  stdpcm_free (mc_ptr->iir);    /* free mono filter */
+  free (mc_ptr->T);             /* free state variables */
+  free (mc_ptr);                /* free allocated struct */
+}
+
+
+void cascade_iir_mc_free (CASCADE_IIR_MC * mc_ptr) {
+  cascade_iir_free (mc_ptr->iir);       /* free mono filter */
+  free (mc_ptr->xj);            /* free inter-stage signal */
+  free (mc_ptr->T);             /* free state variables */
+  free (mc_ptr);                /* free allocated struct */
+}
+
+/* ...... End of stdpcm/cascade_iir_mc_reset() and _mc_free() ...... */
+
+
+/*
+  ============================================================================
+
+        long stdpcm_mc_kernel (long lseg, float *x_ptr, SCD_IIR_MC *mc_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~  float *y_ptr);
+
+        long cascade_iir_mc_kernel (long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  CASCADE_IIR_MC *mc_ptr, float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Filter lseg frames of interleaved samples (x[k*nchan+ch] is
+        sample k of channel ch) into interleaved output frames, for both
+        up- and down-sampling. Each channel gets the same results as with
+        stdpcm_kernel() or cascade_iir_kernel() on the channel alone
+        (same operations in the same order). The recursion runs along
+        the frames, while the innermost loops run over the channels of a
+        frame, whose state variables are adjacent in memory, so that the
+        compiler can map the channels onto vector lanes.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: ...... number of input frames
+        x_ptr: ..... array with lseg*nchan interleaved input samples
+        mc_ptr: .... pointer to the multichannel struct
+        y_ptr: ..... interleaved output frames
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long stdpcm_mc_kernel (long lseg, float *x_ptr, SCD_IIR_MC * mc_ptr, float *y_ptr) {
+  SCD_IIR *iir_ptr = mc_ptr->iir;
+
+  if (iir_ptr->hswitch == 'U')
+    return scd_parallel_form_iir_mc_up_kernel (lseg, x_ptr, y_ptr, iir_ptr->idown, iir_ptr->nblocks, iir_ptr->direct_cof, iir_ptr->gain, iir_ptr->b, iir_ptr->c, mc_ptr->T, mc_ptr->nchan);
+  else
+    return scd_parallel_form_iir_mc_down_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->nblocks, iir_ptr->direct_cof, iir_ptr->gain, iir_ptr->b, iir_ptr->c, mc_ptr->T, mc_ptr->nchan);
+}
+
+
+long cascade_iir_mc_kernel (long lseg, float *x_ptr, CASCADE_IIR_MC * mc_ptr, float *y_ptr) {
+  CASCADE_IIR *iir_ptr = mc_ptr->iir;
+
+  return cascade_form_iir_mc_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->hswitch == 'U', iir_ptr->nblocks, iir_ptr->gain, iir_ptr->a, iir_ptr->b, mc_ptr->T, mc_ptr->xj, mc_ptr->nchan);
+}
+
+/* ......... End of stdpcm_mc_kernel() / cascade_iir_mc_kernel() ......... */
+
+
+/*
+  ============================================================================
+
+        long scd_parallel_form_iir_mc_down_kernel (long lenx, float *x,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  float *y, long *k0,
+                                      long idown, long nblocks,
+                                      double direct_cof, double gain,
+                                      float (*b)[3], float (*c)[2],
+                                      float *T, long nchan);
+
+        long scd_parallel_form_iir_mc_up_kernel (long lenx, float *x,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  float *y, long iup,
+                                      long nblocks, double direct_cof,
+                                      double gain, float (*b)[3],
+                                      float (*c)[2], float *T,
+                                      long nchan);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multichannel versions of scd_parallel_form_iir_down_kernel() and
+        scd_parallel_form_iir_up_kernel(). Lengths count frames; the
+        state variable T[n][i] of channel ch is T[(2*n+i)*nchan+ch].
+
+        Parameters:
+        ~~~~~~~~~~~
+        As for the mono kernels, plus
+        nchan: ....... (In) number of channels
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of frames filtered.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long scd_parallel_form_iir_mc_down_kernel (long lenx, float *x, float *y, long *k0, long idown, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float *T, long nchan) {
+  long kx, ky, n, ch;
+  float Ttmp, *T0, *T1, *yk;
+
+
+  ky = 0;                       /* starting index in output array (y) */
+  for (kx = 0; kx < lenx; kx++, x += nchan) {   /* loop over all input frames */
+    if (*k0 % idown == 0) {     /* compute output only every "idown" frames */
+      yk = &y[ky * nchan];
+      for (ch = 0; ch < nchan; ch++)
+        yk[ch] = direct_cof * x[ch];    /* direct path */
+      for (n = 0, T0 = T; n < nblocks; n++, T0 += 2 * nchan) {  /* loop over all second order filter */
+        T1 = T0 + nchan;
+        for (ch = 0; ch < nchan; ch++) {
+          Ttmp = 2. * (x[ch] - c[n][0] * T0[ch] - c[n][1] * T1[ch]);
+          yk[ch] += b[n][2] * Ttmp + b[n][1] * T1[ch] + b[n][0] * T0[ch];
+          T0[ch] = T1[ch];
+          T1[ch] = Ttmp;
+        }
+      }
+      for (ch = 0; ch < nchan; ch++)
+        yk[ch] *= gain;
+      ky++;
+    } else {
+      for (n = 0, T0 = T; n < nblocks; n++, T0 += 2 * nchan) {
+        T1 = T0 + nchan;
+        for (ch = 0; ch < nchan; ch++) {
+          Ttmp = 2. * (x[ch] - c[n][0] * T0[ch] - c[n][1] * T1[ch]);
+          T0[ch] = T1[ch];
+          T1[ch] = Ttmp;
+        }
+      }
+    }
+    (*k0)++;
+  }
+  *k0 %= idown;                 /* avoid overflow by (*k0)++ */
+  return ky;
+}
+
+
+static long scd_parallel_form_iir_mc_up_kernel (long lenx, float *x, float *y, long iup, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float *T, long nchan) {
+  long ky, n, ch;
+  float Ttmp, *T0, *T1, *yk;
+
+
+  for (ky = 0; ky < iup * lenx; ky++) { /* loop over all output frames */
+    yk = &y[ky * nchan];
+    if (ky % iup == 0) {        /* take one input frame every "iup" frames */
+      for (ch = 0; ch < nchan; ch++)
+        yk[ch] = direct_cof * x[ch];    /* direct path */
+      for (n = 0, T0 = T; n < nblocks; n++, T0 += 2 * nchan) {  /* loop over all second order filter */
+        T1 = T0 + nchan;
+        for (ch = 0; ch < nchan; ch++) {
+          Ttmp = 2. * (x[ch] - c[n][0] * T0[ch] - c[n][1] * T1[ch]);
+          yk[ch] += b[n][2] * Ttmp + b[n][1] * T1[ch] + b[n][0] * T0[ch];
+          T0[ch] = T1[ch];
+          T1[ch] = Ttmp;
+        }
+      }
+      x += nchan;
+    } else {
+      for (ch = 0; ch < nchan; ch++)
+        yk[ch] = 0.0;           /* at other instants feed zero-valued samples */
+      for (n = 0, T0 = T; n < nblocks; n++, T0 += 2 * nchan) {
+        T1 = T0 + nchan;
+        for (ch = 0; ch < nchan; ch++) {
+          Ttmp = 2. * (0.0 - c[n][0] * T0[ch] - c[n][1] * T1[ch]);
+          yk[ch] += b[n][2] * Ttmp + b[n][1] * T1[ch] + b[n][0] * T0[ch];
+          T0[ch] = T1[ch];
+          T1[ch] = Ttmp;
+        }
+      }
+    }
+    for (ch = 0; ch < nchan; ch++)
+      yk[ch] *= gain;
+  }
+  return ky;
+}
+
+/* ......... End of scd_parallel_form_iir_mc_down/up_kernel() ......... */
+
+
+/*
+  ============================================================================
+
+        long cascade_form_iir_mc_kernel (long lenx, float *x, float *y,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long *k0, long idwnup, int up,
+                                         long nblocks, double gain,
+                                         float (*a)[2], float (*b)[2],
+                                         float *T, double *xj,
+                                         long nchan);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multichannel version of cascade_form_iir_down_kernel() and
+        cascade_form_iir_up_kernel(). Lengths count frames; the state
+        variable T[n][i] of channel ch is T[(4*n+i)*nchan+ch].
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenx: ........ (In) number of input frames
+        x: ........... (In) interleaved input samples
+        y: ........... (Out) interleaved output samples
+        k0: .......... (In/Out) pointer to modulo counter (down-sampling)
+        idwnup: ...... (In) down- or up-sampling factor
+        up: .......... (In) 1 for up-sampling, 0 for down-sampling
+        nblocks: ..... (In) number of coeff. sets
+        gain: ........ (In) gain factor
+        a: ........... (In) numerator coefficients
+        b: ........... (In) denominator coefficients
+        T: ........... (In/Out) state variables
+        xj: .......... (Work) signal between stages, one per channel
+        nchan: ....... (In) number of channels
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output frames.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long cascade_form_iir_mc_kernel (long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double gain, float (*a)[2], float (*b)[2], float *T, double *xj, long nchan) {
+  long kx, ky, k, n, ch;
+  double yj;
+  float *Tn;
+
+
+  ky = 0;                       /* starting index in output array (y) */
+  kx = 0;                       /* starting index in input array (x) */
+  for (k = 0; k < (up ? idwnup * lenx : lenx); k++) {
+    /* Up-sampling feeds one input frame every "idwnup" frames and zeros otherwise */
+    if (!up || k % idwnup == 0) {
+      for (ch = 0; ch < nchan; ch++)
+        xj[ch] = x[kx * nchan + ch];
+      kx++;
+    } else
+      for (ch = 0; ch < nchan; ch++)
+        xj[ch] = 0.;
+
+    /* Filter frame through all cascade stages */
+    for (n = 0, Tn = T; n < nblocks; n++, Tn += 4 * nchan)
+      for (ch = 0; ch < nchan; ch++) {
+        yj = xj[ch] + a[n][0] * Tn[ch] + a[n][1] * Tn[nchan + ch];
+        yj -= (b[n][0] * Tn[2 * nchan + ch] + b[n][1] * Tn[3 * nchan + ch]);
+
+        /* Save samples in memory */
+        Tn[nchan + ch] = Tn[ch];
+        Tn[ch] = xj[ch];
+        Tn[3 * nchan + ch] = Tn[2 * nchan + ch];
+        Tn[2 * nchan + ch] = yj;
+
+        /* The yj of this stage is the xj of the next */
+        xj[ch] = yj;
+      }
+
+    /* Down-sampling computes output only every "idwnup" frames */
+    if (up || *k0 % idwnup == 0) {
+      for (ch = 0; ch < nchan; ch++)
+        y[ky * nchan + ch] = xj[ch] * gain;
+      ky++;
+    }
+    if (!up)
+      (*k0)++;
+  }
+  if (!up)
+    *k0 %= idwnup;              /* avoid overflow by (*k0)++ */
+  return ky;
+}
+
+/* .............. End of cascade_form_iir_mc_kernel() .............. */
+
+
+/* *************************************************************************
+   ************** SIMD KERNEL FOR PARALLEL- AND CASCADE-FORM ***************
+ * ************************************************************************* */
+
+/*
+  ============================================================================
+
+        int stdpcm_select_kernel (SCD_IIR *iir_ptr, int kernel);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+
+        int cascade_iir_select_kernel (CASCADE_IIR *iir_ptr, int kernel);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+        Choose the kernel used by stdpcm_kernel() or cascade_iir_kernel().
+        IIR_KERNEL_SCALAR is the original code. IIR_KERNEL_SIMD filters
+        blocks of up to IIR_BLOCK samples with IIR_LANES second-order
+        sections in the lanes of one SSE2 vector (plain C elsewhere):
+
+        - parallel form: the sections are independent, so they are
+          simply computed side by side; the state variables stay in
+          iir_ptr->T and the kernels may be switched at any time. The
+          section outputs are added in the original order, so the result
+          is bit-exact, except for rare rounding differences in the
+          zero-valued samples of the 1:2 up-sampling filter (where the
+          original code computes in double precision);
+
+        - cascade form: each section is run in transposed direct form II
+          (y= x+s1; s1= a0*x-b0*y+s2; s2= a1*x-b1*y) in single precision,
+          and the sections of a vector are pipelined: at step t lane k
+          processes sample t-k, taking as input the output of lane k-1 of
+          the previous step. Groups of IIR_LANES sections are applied one
+          after the other to the block. The original kernel runs direct
+          form I with double-precision signal between the sections, so
+          the results differ by float rounding: for the filters of this
+          module and 16-bit speech signals, at most 1 LSB (up to 2 LSB
+          for full-scale white noise through the 12-section 3:1 low-pass
+          filters).
+          The SIMD kernel has its own state, which is derived from
+          iir_ptr->T when it is selected, but is not copied back: choose
+          the kernel before filtering or right after cascade_iir_reset().
+
+        Parameters:
+        ~~~~~~~~~~~
+        iir_ptr: ... pointer to the filter struct
+        kernel: .... IIR_KERNEL_SCALAR or IIR_KERNEL_SIMD
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the kernel in use, which is IIR_KERNEL_SCALAR if the
+        memory for the SIMD kernel could not be allocated.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int stdpcm_select_kernel (SCD_IIR * iir_ptr, int kernel) {
+  long ngroups = (iir_ptr->nblocks + IIR_LANES - 1) / IIR_LANES;
+  long n;
+  float *g;
+
+  iir_ptr->kernel = IIR_KERNEL_SCALAR;
+  if (kernel != IIR_KERNEL_SIMD)
+    return iir_ptr->kernel;
+
+  /* Per group: c0, c1, b0, b1, b2, T0, T1; then input and output block */
+  if (iir_ptr->lanes == (float *) 0)
+    if ((iir_ptr->lanes = (float *) calloc (ngroups * 7 * IIR_LANES + 2 * IIR_BLOCK, sizeof (float))) == (float *) 0)
+      return iir_ptr->kernel;
+
+  /* Section n goes to lane n % IIR_LANES of group n / IIR_LANES; the
+   * unused lanes keep zero coefficients */
+  for (n = 0; n < iir_ptr->nblocks; n++) {
+    g = iir_ptr->lanes + (n / IIR_LANES) * 7 * IIR_LANES + n % IIR_LANES;
+    g[0 * IIR_LANES] = iir_ptr->c[n][0];
+    g[1 * IIR_LANES] = iir_ptr->c[n][1];
+    g[2 * IIR_LANES] = iir_ptr->b[n][0];
+    g[3 * IIR_LANES] = iir_ptr->b[n][1];
+    g[4 * IIR_LANES] = iir_ptr->b[n][2];
+  }
+
+  return (iir_ptr->kernel = IIR_KERNEL_SIMD);
+}
+
+
+int cascade_iir_select_kernel (CASCADE_IIR * iir_ptr, int kernel) {
+  long ngroups = (iir_ptr->nblocks + IIR_LANES - 1) / IIR_LANES;
+  long n;
+  float *g, (*T)[4] = iir_ptr->T;
+
+  iir_ptr->kernel = IIR_KERNEL_SCALAR;
+  if (kernel != IIR_KERNEL_SIMD)
+    return iir_ptr->kernel;
+
+  /* Per group: a0, a1, b0, b1, s1, s2; then the work block */
+  if (iir_ptr->lanes == (float *) 0)
+    if ((iir_ptr->lanes = (float *) calloc (ngroups * 6 * IIR_LANES + IIR_BLOCK, sizeof (float))) == (float *) 0)
+      return iir_ptr->kernel;
+
+  /* Section n goes to lane n % IIR_LANES of group n / IIR_LANES; the
+   * unused lanes keep zero coefficients and state, passing the signal
+   * through. The transposed direct form II state is obtained from the
+   * direct form I one (last inputs T[n][0..1], last outputs T[n][2..3]) */
+  for (n = 0; n < iir_ptr->nblocks; n++) {
+    g = iir_ptr->lanes + (n / IIR_LANES) * 6 * IIR_LANES + n % IIR_LANES;
+    g[0 * IIR_LANES] = iir_ptr->a[n][0];
+    g[1 * IIR_LANES] = iir_ptr->a[n][1];
+    g[2 * IIR_LANES] = iir_ptr->b[n][0];
+    g[3 * IIR_LANES] = iir_ptr->b[n][1];
+    g[4 * IIR_LANES] = iir_ptr->a[n][0] * T[n][0] + iir_ptr->a[n][1] * T[n][1] - iir_ptr->b[n][0] * T[n][2] - iir_ptr->b[n][1] * T[n][3];
+    g[5 * IIR_LANES] = iir_ptr->a[n][1] * T[n][0] - iir_ptr->b[n][1] * T[n][2];
+  }
+
+  return (iir_ptr->kernel = IIR_KERNEL_SIMD);
+}
+
+/* ........ End of stdpcm_select_kernel() / cascade_iir_select_kernel() ........ */
+
+
+/*
+  ============================================================================
+
+        long scd_parallel_form_iir_simd_kernel (long lenx, float *x,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  float *y, long *k0,
+                                                long idwnup, int up,
+                                                long nblocks,
+                                                double direct_cof,
+                                                double gain,
+                                                float (*T)[2],
+                                                float *lanes);
+
+        long cascade_form_iir_simd_kernel (long lenx, float *x, float *y,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long *k0, long idwnup, int up,
+                                           long nblocks, double gain,
+                                           float *lanes);
+
+        Description:
+        ~~~~~~~~~~~~
+        SIMD parallel- and cascade-form kernels, for both up- and
+        down-sampling (see stdpcm_select_kernel()). The input is
+        processed in blocks of IIR_BLOCK samples at the higher rate (with
+        zeros inserted for up-sampling), and each group of IIR_LANES
+        sections is applied to a whole block.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenx: ........ (In) number of input samples
+        x: ........... (In) input samples
+        y: ........... (Out) output samples
+        k0: .......... (In/Out) pointer to modulo counter (down-sampling)
+        idwnup: ...... (In) down- or up-sampling factor
+        up: .......... (In) 1 for up-sampling, 0 for down-sampling
+        nblocks: ..... (In) number of second-order sections
+        direct_cof: .. (In) direct path coefficient
+        gain: ........ (In) gain factor
+        T: ........... (In/Out) state variables
+        lanes: ....... (In/Out) coefficients, state and work buffers laid
+                                out by the select_kernel() functions
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long scd_parallel_form_iir_simd_kernel (long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double direct_cof, double gain, float (*T)[2], float *lanes) {
+  long ngroups = (nblocks + IIR_LANES - 1) / IIR_LANES;
+  float *xb = lanes + ngroups * 7 * IIR_LANES, *acc = xb + IIR_BLOCK;
+  float *g;
+  long k, j, n, len, first, step, kx, ky;
+
+
+  /* State variables to the lanes */
+  for (n = 0; n < nblocks; n++) {
+    g = lanes + (n / IIR_LANES) * 7 * IIR_LANES + n % IIR_LANES;
+    g[5 * IIR_LANES] = T[n][0];
+    g[6 * IIR_LANES] = T[n][1];
+  }
+
+  /* Up-sampling computes every output sample, down-sampling every idwnup-th */
+  step = up ? 1 : idwnup;
+
+  kx = ky = 0;
+  for (k = 0; k < (up ? idwnup * lenx : lenx); k += len) {
+    len = (up ? idwnup * lenx : lenx) - k;
+    if (len > IIR_BLOCK)
+      len = IIR_BLOCK;
+
+    /* Input block (zero-stuffed for up-sampling) and direct path */
+    for (j = 0; j < len; j++) {
+      xb[j] = (!up || (k + j) % idwnup == 0) ? x[kx++] : 0;
+      acc[j] = direct_cof * xb[j];
+    }
+
+    /* Add the sections of each group to the output samples */
+    first = up ? 0 : (idwnup - *k0 % idwnup) % idwnup;
+    for (n = 0; n < ngroups; n++)
+      iir_parallel_lanes (xb, len, first, step, lanes + n * 7 * IIR_LANES, (nblocks - n * IIR_LANES < IIR_LANES) ? nblocks - n * IIR_LANES : IIR_LANES, acc);
+
+    for (j = first; j < len; j += step)
+      y[ky++] = acc[j] * gain;
+    if (!up)
+      *k0 = (*k0 + len) % idwnup;
+  }
+
+  /* State variables back from the lanes */
+  for (n = 0; n < nblocks; n++) {
+    g = lanes + (n / IIR_LANES) * 7 * IIR_LANES + n % IIR_LANES;
+    T[n][0] = g[5 * IIR_LANES];
+    T[n][1] = g[6 * IIR_LANES];
+  }
+
+  return ky;
+}
+
+
+static long cascade_form_iir_simd_kernel (long lenx, float *x, float *y, long *k0, long idwnup, int up, long nblocks, double gain, float *lanes) {
+  long ngroups = (nblocks + IIR_LANES - 1) / IIR_LANES;
+  float *w = lanes + ngroups * 6 * IIR_LANES;
+  long k, j, n, len, first, step, kx, ky;
+
+
+  step = up ? 1 : idwnup;
+
+  kx = ky = 0;
+  for (k = 0; k < (up ? idwnup * lenx : lenx); k += len) {
+    len = (up ? idwnup * lenx : lenx) - k;
+    if (len > IIR_BLOCK)
+      len = IIR_BLOCK;
+
+    /* Input block, zero-stuffed for up-sampling */
+    for (j = 0; j < len; j++)
+      w[j] = (!up || (k + j) % idwnup == 0) ? x[kx++] : 0;
+
+    /* The block goes through the groups of sections in place */
+    for (n = 0; n < ngroups; n++)
+      iir_cascade_lanes (w, len, lanes + n * 6 * IIR_LANES);
+
+    first = up ? 0 : (idwnup - *k0 % idwnup) % idwnup;
+    for (j = first; j < len; j += step)
+      y[ky++] = w[j] * gain;
+    if (!up)
+      *k0 = (*k0 + len) % idwnup;
+  }
+
+  return ky;
+}
+
+/* ....... End of scd_parallel_form/cascade_form_iir_simd_kernel() ....... */
+
+
+/*
+  ============================================================================
+
+        void iir_parallel_lanes (float *x, long n, long first, long step,
+        ~~~~~~~~~~~~~~~~~~~~~~~  float *g, long nsect, float *acc);
+
+        void iir_cascade_lanes (float *w, long n, float *g);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+        Run one group of IIR_LANES second-order sections over a block.
+
+        iir_parallel_lanes() updates the state of the parallel sections
+        with every input sample, and adds the outputs of the first nsect
+        sections, one after the other, to acc[first], acc[first+step],
+        and so on.
+
+        iir_cascade_lanes() runs the cascade of sections in transposed
+        direct form II over w[] in place. The lanes are filled and
+        emptied in a wavefront, so that each block is complete on
+        return; a lane only updates its state while it holds a sample.
+
+        Parameters:
+        ~~~~~~~~~~~
+        x, w: ...... (In, In/Out) block of samples
+        n: ......... (In) number of samples
+        first: ..... (In) first sample whose output is needed
+        step: ...... (In) distance between samples whose output is needed
+        g: ......... (In/Out) coefficients and state of the group
+        nsect: ..... (In) number of sections used in the group
+        acc: ....... (In/Out) output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+#ifdef IIR_SSE2
+
+static void iir_parallel_lanes (float *x, long n, long first, long step, float *g, long nsect, float *acc) {
+  __m128 c0 = _mm_loadu_ps (g), c1 = _mm_loadu_ps (g + 4);
+  __m128 b0 = _mm_loadu_ps (g + 8), b1 = _mm_loadu_ps (g + 12), b2 = _mm_loadu_ps (g + 16);
+  __m128 T0 = _mm_loadu_ps (g + 20), T1 = _mm_loadu_ps (g + 24), Ttmp, xv;
+  float part[IIR_LANES];
+  long j, l;
+
+  for (j = 0; j < n; j++) {
+    /* Ttmp = 2 * (x - c0*T0 - c1*T1) */
+    xv = _mm_set1_ps (x[j]);
+    Ttmp = _mm_sub_ps (_mm_sub_ps (xv, _mm_mul_ps (c0, T0)), _mm_mul_ps (c1, T1));
+    Ttmp = _mm_add_ps (Ttmp, Ttmp);
+
+    if (j == first) {
+      /* y += b2*Ttmp + b1*T1 + b0*T0, section by section */
+      _mm_storeu_ps (part, _mm_add_ps (_mm_add_ps (_mm_mul_ps (b2, Ttmp), _mm_mul_ps (b1, T1)), _mm_mul_ps (b0, T0)));
+      for (l = 0; l < nsect; l++)
+        acc[j] += part[l];
+      first += step;
+    }
+
+    T0 = T1;
+    T1 = Ttmp;
+  }
+
+  _mm_storeu_ps (g + 20, T0);
+  _mm_storeu_ps (g + 24, T1);
+}
+
+
+static void iir_cascade_lanes (float *w, long n, float *g) {
+  __m128 a0 = _mm_loadu_ps (g), a1 = _mm_loadu_ps (g + 4);
+  __m128 b0 = _mm_loadu_ps (g + 8), b1 = _mm_loadu_ps (g + 12);
+  __m128 s1 = _mm_loadu_ps (g + 16), s2 = _mm_loadu_ps (g + 20);
+  __m128 lane = _mm_set_ps (3, 2, 1, 0), v, yv, s1n, s2n, on;
+  long t;
+
+  yv = _mm_setzero_ps ();
+  for (t = 0; t < n + IIR_LANES - 1; t++) {
+    /* Lane k gets the output of lane k-1; lane 0 the new sample */
+    v = _mm_castsi128_ps (_mm_slli_si128 (_mm_castps_si128 (yv), 4));
+    v = _mm_move_ss (v, _mm_set_ss (t < n ? w[t] : 0.0f));
+
+    yv = _mm_add_ps (v, s1);
+    s1n = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (a0, v), _mm_mul_ps (b0, yv)), s2);
+    s2n = _mm_sub_ps (_mm_mul_ps (a1, v), _mm_mul_ps (b1, yv));
+
+    if (t >= IIR_LANES - 1 && t < n) {
+      s1 = s1n;
+      s2 = s2n;
+    } else {
+      /* Filling or emptying: only lanes with 0 <= t-k < n are active */
+      on = _mm_and_ps (_mm_cmple_ps (lane, _mm_set1_ps ((float) t)), _mm_cmpgt_ps (lane, _mm_set1_ps ((float) (t - n))));
+      s1 = _mm_or_ps (_mm_and_ps (on, s1n), _mm_andnot_ps (on, s1));
+      s2 = _mm_or_ps (_mm_and_ps (on, s2n), _mm_andnot_ps (on, s2));
+    }
+
+    if (t >= IIR_LANES - 1)
+      w[t - (IIR_LANES - 1)] = _mm_cvtss_f32 (_mm_shuffle_ps (yv, yv, 3));
+  }
+
+  _mm_storeu_ps (g + 16, s1);
+  _mm_storeu_ps (g + 20, s2);
+}
+
+#else /* Same operations, one lane at a time */
+
+static void iir_parallel_lanes (float *x, long n, long first, long step, float *g, long nsect, float *acc) {
+  float *c0 = g, *c1 = g + 4, *b0 = g + 8, *b1 = g + 12, *b2 = g + 16;
+  float *T0 = g + 20, *T1 = g + 24, Ttmp, part;
+  long j, l;
+
+  for (j = 0; j < n; j++)
+    for (l = 0; l < IIR_LANES; l++) {
+      Ttmp = x[j] - c0[l] * T0[l] - c1[l] * T1[l];
+      Ttmp += Ttmp;
+      if (j == first && l < nsect) {
+        part = b2[l] * Ttmp + b1[l] * T1[l] + b0[l] * T0[l];
+        acc[j] += part;
+      }
+      T0[l] = T1[l];
+      T1[l] = Ttmp;
+      if (j == first && l == IIR_LANES - 1)
+        first += step;
+    }
+}
+
+
+static void iir_cascade_lanes (float *w, long n, float *g) {
+  float *a0 = g, *a1 = g + 4, *b0 = g + 8, *b1 = g + 12, *s1 = g + 16, *s2 = g + 20;
+  float v[IIR_LANES], yv[IIR_LANES];
+  long t, l;
+
+  for (l = 0; l < IIR_LANES; l++)
+    yv[l] = 0;
+  for (t = 0; t < n + IIR_LANES - 1; t++) {
+    for (l = IIR_LANES - 1; l > 0; l--)
+      v[l] = yv[l - 1];
+    v[0] = t < n ? w[t] : 0.0f;
+
+    for (l = 0; l < IIR_LANES; l++) {
+      yv[l] = v[l] + s1[l];
+      if (t - l >= 0 && t - l < n) {
+        s1[l] = a0[l] * v[l] - b0[l] * yv[l] + s2[l];
+        s2[l] = a1[l] * v[l] - b1[l] * yv[l];
+      }
+    }
+
+    if (t >= IIR_LANES - 1)
+      w[t - (IIR_LANES - 1)] = yv[IIR_LANES - 1];
+  }
+}
+
+#endif /* IIR_SSE2 */
+
+/* ........ End of iir_parallel_lanes() / iir_cascade_lanes() ........ */
+
+
 /* *********************************************************************** */
 
 /*
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: IIRFLT.H                                     Version: 3.0 - 31.JUL.95
+   File: IIRFLT.H                                     Version: 3.2 - 16.OCT.26
   ============================================================================
 
                             UGST/ITU-T IIR FILTERS
@@ -12,6 +12,10 @@
    30.Oct.94	v2.0	Name changed to iirflt.h/included cascade-form 
                         IIR filters <simao@ctd.comsat.com>
    31.Jul.95	v3.0	Added direct-form IIR filters <simao@ctd.comsat.com>
+   16.Oct.26	v3.1	Added multichannel parallel- and cascade-form
+                        filters (SCD_IIR_MC, CASCADE_IIR_MC)
+   16.Oct.26	v3.2	Added the SIMD kernel for the parallel- and
+                        cascade-form filters (IIR_KERNEL_xxx)
 
   ============================================================================
 */
@@ -29,6 +33,16 @@
 #endif
 #endif
 
+/*
+ * ..... Kernels for the parallel- and cascade-form filters .....
+ */
+#define IIR_KERNEL_SCALAR 1     /* portable C, bit-exact reference */
+#define IIR_KERNEL_SIMD   2     /* 4 second-order sections per SIMD vector */
+
+#define IIR_LANES 4             /* sections per vector in the SIMD kernel */
+#define IIR_BLOCK 256           /* samples per pass of the SIMD kernel */
+
+
 /*
  * ..... State variable structure for IIR filtering, parallel form  .....
  */
@@ -43,6 +57,9 @@ typedef struct {
   float (*c)[2];                /* In : denominator coefficients */
   float (*T)[2];                /* In/Out : state variables */
   char hswitch;                 /* "U": upsampling; else downsampling */
+  int kernel;                   /* IIR_KERNEL_xxx in use */
+  float *lanes;                 /* Work : SIMD coefficients, state and
+                                   buffers, or NULL */
 } SCD_IIR;
 
 
@@ -58,6 +75,9 @@ typedef struct {
   float (*b)[2];                /* In : denominator coefficients */
   float (*T)[4];                /* In/Out : state variables, 1 for each stage */
   char hswitch;                 /* "U": upsampling; else downsampling */
+  int kernel;                   /* IIR_KERNEL_xxx in use */
+  float *lanes;                 /* Work : SIMD coefficients, transposed
+                                   direct form II state and buffer, or NULL */
 } CASCADE_IIR;
 
 
@@ -78,6 +98,27 @@ typedef struct {
 } DIRECT_IIR;
 
 
+/*
+ * ..... State variables for filtering interleaved multichannel signals:
+ *       one set of state variables per channel, shared coefficients .....
+ */
+
+typedef struct {
+  long nchan;                   /* number of interleaved channels */
+  SCD_IIR *iir;                 /* coefficients, gain, rate change, k0 */
+  float *T;                     /* In/Out : state variables T[n][i] of
+                                   channel ch at T[(2*n+i)*nchan+ch] */
+} SCD_IIR_MC;
+
+typedef struct {
+  long nchan;                   /* number of interleaved channels */
+  CASCADE_IIR *iir;             /* coefficients, gain, rate change, k0 */
+  float *T;                     /* In/Out : state variables T[n][i] of
+                                   channel ch at T[(4*n+i)*nchan+ch] */
+  double *xj;                   /* Work : signal between stages */
+} CASCADE_IIR_MC;
+
+
 /*
  * ..... Global function prototypes .....
  */
@@ -86,6 +127,7 @@ typedef struct {
 long stdpcm_kernel ARGS ((long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr));
 void stdpcm_free ARGS ((SCD_IIR * iir_ptr));
 void stdpcm_reset ARGS ((SCD_IIR * iir_ptr));
+int stdpcm_select_kernel ARGS ((SCD_IIR * iir_ptr, int kernel));
 
 /* Originals of the STL92: parallel IIR filter initialization */
 SCD_IIR *stdpcm_16khz_init ARGS ((void));
@@ -97,6 +139,7 @@ SCD_IIR *stdpcm_1_to_2_init ARGS ((void));
 long cascade_iir_kernel ARGS ((long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr));
 void cascade_iir_reset ARGS ((CASCADE_IIR * iir_ptr));
 void cascade_iir_free ARGS ((CASCADE_IIR * iir_ptr));
+int cascade_iir_select_kernel ARGS ((CASCADE_IIR * iir_ptr, int kernel));
 
 /* Additions to the STL92: cascade IIR filter initialization */
 CASCADE_IIR *iir_G712_8khz_init ARGS ((void));
@@ -105,6 +148,17 @@ CASCADE_IIR *iir_casc_lp_3_to_1_init ARGS ((void));
 CASCADE_IIR *iir_casc_lp_1_to_3_init ARGS ((void));
 
 
+/* Multichannel (interleaved) parallel and cascade IIR basic functions */
+SCD_IIR_MC *stdpcm_mc_init ARGS ((SCD_IIR * iir_ptr, long nchan));
+long stdpcm_mc_kernel ARGS ((long lseg, float *x_ptr, SCD_IIR_MC * mc_ptr, float *y_ptr));
+void stdpcm_mc_reset ARGS ((SCD_IIR_MC * mc_ptr));
+void stdpcm_mc_free ARGS ((SCD_IIR_MC * mc_ptr));
+CASCADE_IIR_MC *cascade_iir_mc_init ARGS ((CASCADE_IIR * iir_ptr, long nchan));
+long cascade_iir_mc_kernel ARGS ((long lseg, float *x_ptr, CASCADE_IIR_MC * mc_ptr, float *y_ptr));
+void cascade_iir_mc_reset ARGS ((CASCADE_IIR_MC * mc_ptr));
+void cascade_iir_mc_free ARGS ((CASCADE_IIR_MC * mc_ptr));
+
+
 /* Additions to the STL92: direct IIR basic functions */
 long direct_iir_kernel ARGS ((long lseg, float *x_ptr, DIRECT_IIR * iir_ptr, float *y_ptr));
 void direct_reset ARGS ((DIRECT_IIR * iir_ptr));
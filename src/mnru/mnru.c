@@ -1,4 +1,4 @@
-/*                                                        31.JULY.1995 v.2.00
+/*                                                        16.Oct.2026 v.2.10
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -51,6 +51,13 @@ random_MNRU: .......... Generates gaussian-like noise samples for use by the
                         not be changed by the user. Its prototype is found
                         in mnru.h.
 
+random_MNRU_block: .... Same as random_MNRU, for a block of `n' samples at
+                        once. Its prototype is found in mnru.h.
+
+MNRU_valid_q_format: .. Checks that a file name is a printf() format for
+                        the output file of each Q of a multi-Q run. Its
+                        prototype is found in mnru.h.
+
 HISTORY:
 
   25.Set.91  v1.0F      Fortran version released to UGST by CSELT/Italy.
@@ -67,6 +74,13 @@ HISTORY:
                         To increase speed, a new random number generator
                         has been included. Works for both narrow-band and
                         wideband speech.
+  16.Oct.26  v2.1       Block processing: the noise of a whole block is
+                        generated at once by random_MNRU_block(), and the
+                        DC and output filters run over the block, with no
+                        per-call memset(). Each state has its own random
+                        generators, started from the seed; compile with
+                        MNRU_COMPAT_RNG to continue the process-wide
+                        generators of v2.0 instead. Same output.
 =============================================================================
 */
 
@@ -80,7 +94,7 @@ HISTORY:
 /* General includes */
 #include <math.h>
 #include <stdlib.h>             /* for calloc(), free() */
-#include <string.h>             /* for memset() */
+#include <string.h>             /* for memset(), strspn(), strchr() */
 
 #ifndef STL92_RNG               /* Uses the new Random Number Generator */
 #define random_MNRU new_random_MNRU
@@ -90,6 +104,19 @@ float new_random_MNRU ARGS ((char *mode, new_RANDOM_state * r, long seed));
 float ran_vax ARGS ((void));
 unsigned long ran16_32c ARGS ((void));
 
+/* Process-wide generators, as used by all states up to v2.0 */
+#define INIT          314159265L
+static unsigned long vax_seed = INIT;   /* for ran_vax() */
+static unsigned long ran16_seed = 12345;        /* for ran16_32c() */
+
+#ifdef MNRU_COMPAT_RNG
+#define VAX_SEED(r) (&vax_seed)
+#define RUN_SEED(r) (&ran16_seed)
+#else
+#define VAX_SEED(r) (&(r)->vax)
+#define RUN_SEED(r) (&(r)->run)
+#endif
+
 /*
   =============================================================================
 
@@ -108,14 +135,16 @@ unsigned long ran16_32c ARGS ((void));
 	using indeces generated by another LCG.
 
 	To (re)initialize the sequence, use mode=RANDOM_RESET (the routine
-	will change mode to RANDOM_RUN).
+	will change mode to RANDOM_RUN). The table LCG then starts from
+	`seed', and the index LCG from its original value, so that the seed
+	used by the demo programs, 314159265, gives the original sequence.
+	When compiled with MNRU_COMPAT_RNG, both LCGs are instead shared by
+	all the states of the process and never restarted, as up to v2.0.
 
 	Functions used:
 	~~~~~~~~~~~~~~~
-        ran_vax():    generate uniformly distributed samples in the range
-                      0..1. Return a float number.
-	ran16_32C():  generate uniformly distributed samples in the range
-	              0..65535 (2^16-1)
+        vax_step():   generate uniformly distributed samples in the range
+                      0..1, as ran_vax(). Return a float number.
 
         Prototype: MNRU.H
         ~~~~~~~~~~
@@ -126,6 +155,8 @@ unsigned long ran16_32c ARGS ((void));
                         implemented by Aachen University and used by
                         the ITU-T 8kbit/s speech codec host laboratory
                         (in hardware). <simao@ctd.comsat.com>
+        16.Oct.26  1.1	Generators kept in the state variable, and
+                        random_MNRU_block() added.
 
 =============================================================================
 */
@@ -137,44 +168,61 @@ unsigned long ran16_32c ARGS ((void));
 #define TABLE_SIZE 8192         /* 2^13 */
 #define ITER_NO 8
 #define FACTOR 8                /* = 65536(max.no returned by ran16_32c) div.by TABLE_SIZE */
-float new_random_MNRU (char *mode, RANDOM_state * r, long seed) {
-  long i;
-  double z1;                    /* white random number -8...8 */
-  /* weighted with a gaussian distribution */
-  double z2;                    /* white random number 0...1 */
-  double phi;                   /* gauss curve */
+#define LANES 8                 /* samples generated side by side */
+#define CONST         69069
+#define BIT32         4294967296.0
+#define RUN_STEP(x) (((x) * 253 + 1) & 0xFFFFFFL)
 
-  extern float ran_vax ();
-  extern unsigned long ran16_32c ();
+/* ran_vax() on the given seed */
+static float vax_step (unsigned long *seed) {
+  *seed = *seed * CONST + 1;    /* includes the mod 2**32 operation */
+  return ((float) (*seed & 0xFFFFFF00) / BIT32);        /* mask the first 24 bit, divide by 2**32 */
+}
 
-  long index;
+/* Initialize the generators and the gaussian table */
+static void new_random_init (char *mode, new_RANDOM_state * r, long seed) {
+  double z1, z2, phi;
+  long i;
 
-  /* *** RUN INITIALIZATION SEQUENCE *** */
-  if (*mode == RANDOM_RESET) {  /* then reset sequence */
-    /* Toogle mode from reset to run */
-    *mode = RANDOM_RUN;
+  /* Toogle mode from reset to run */
+  *mode = RANDOM_RUN;
 
-    /* Allocate memory for gaussian table */
-    r->gauss = (float *) calloc (TABLE_SIZE, sizeof (float));
+  /* Restart the generators of the state */
+  r->vax = (unsigned long) seed;
+  r->run = 12345;
 
-    /* Generate gaussian random number table */
-    for (i = 0L; i < TABLE_SIZE; i++) {
-      /* Interact until find gaussian sample */
-      do {
-        z1 = S1 + DIF * (double) ran_vax ();
-        phi = exp (-(z1) * (z1) / MO);
-        z2 = (double) ran_vax ();
-      } while (z2 > phi);
+  /* Allocate memory for gaussian table */
+  r->gauss = (float *) calloc (TABLE_SIZE, sizeof (float));
 
-      /* Save gaussian-distributed sample in table */
-      r->gauss[i] = (float) z1;
-    }
+  /* Generate gaussian random number table */
+  for (i = 0L; i < TABLE_SIZE; i++) {
+    /* Interact until find gaussian sample */
+    do {
+      z1 = S1 + DIF * (double) vax_step (VAX_SEED (r));
+      phi = exp (-(z1) * (z1) / MO);
+      z2 = (double) vax_step (VAX_SEED (r));
+    } while (z2 > phi);
+
+    /* Save gaussian-distributed sample in table */
+    r->gauss[i] = (float) z1;
   }
+}
+
+float new_random_MNRU (char *mode, RANDOM_state * r, long seed) {
+  long i;
+  double z1;                    /* white random number -8...8 */
+  /* weighted with a gaussian distribution */
+  unsigned long *run;
+
+  /* *** RUN INITIALIZATION SEQUENCE *** */
+  if (*mode == RANDOM_RESET)    /* then reset sequence */
+    new_random_init (mode, r, seed);
 
   /* *** REAL GENERATOR (after initialization) ** */
+  run = RUN_SEED (r);
   for (z1 = 0, i = 0; i < ITER_NO; i++) {
-    index = ran16_32c () / FACTOR;
-    z1 += r->gauss[index];
+    *run = RUN_STEP (*run);
+    z1 += r->gauss[(*run >> 8) / FACTOR];
   }
   z1 /= 2;                      /* provisional */
 
@@ -182,13 +230,87 @@ float new_random_MNRU (char *mode, RANDOM_state * r, long seed) {
   return ((float) z1);
 }
 
+/*  .................... End of new_random_MNRU() ....................... */
+
+
+/*
+  =============================================================================
+
+	void random_MNRU_block (char *mode, RANDOM_state *r, long seed,
+        ~~~~~~~~~~~~~~~~~~~~~~  double *noise, long n)
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fill noise[] with the next `n' samples of random_MNRU(), in the
+        same sequence. Since the index generator is an LCG, the state
+        before the draws of the sample k+l is found directly from the
+        state before the sample k (the LCG applied ITER_NO*l times is
+        also an LCG), so that LANES samples are drawn side by side,
+        in loops without dependencies that the compiler can vectorize.
+        The sums of the table values are exact in double precision
+        (they are multiples of 2^-20 below 2^6), so that their order
+        does not change the result.
+
+        Prototype: MNRU.H
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26  1.0	Created.
+
+=============================================================================
+*/
+void random_MNRU_block (char *mode, RANDOM_state * r, long seed, double *noise, long n) {
+  unsigned long v[LANES], a = 1, c = 0, *run;
+  double z[LANES];
+  float *gauss;
+  long i, k, l;
+
+  /* *** RUN INITIALIZATION SEQUENCE *** */
+  if (*mode == RANDOM_RESET)    /* then reset sequence */
+    new_random_init (mode, r, seed);
+  gauss = r->gauss;
+  run = RUN_SEED (r);
+
+  /* LCG of the draws of one whole sample: x -> a.x + c */
+  for (i = 0; i < ITER_NO; i++) {
+    a = (a * 253) & 0xFFFFFFL;
+    c = RUN_STEP (c);
+  }
+
+  /* LANES samples at a time */
+  for (k = 0; k + LANES <= n; k += LANES) {
+    for (v[0] = *run, l = 1; l < LANES; l++)
+      v[l] = (a * v[l - 1] + c) & 0xFFFFFFL;
+    for (l = 0; l < LANES; l++)
+      z[l] = 0;
+    for (i = 0; i < ITER_NO; i++)
+      for (l = 0; l < LANES; l++) {
+        v[l] = RUN_STEP (v[l]);
+        z[l] += gauss[(v[l] >> 8) / FACTOR];
+      }
+    for (l = 0; l < LANES; l++)
+      noise[k + l] = (float) (z[l] / 2);
+    *run = v[LANES - 1];
+  }
+
+  /* Remaining samples */
+  for (; k < n; k++)
+    noise[k] = new_random_MNRU (mode, r, seed);
+}
+
+#undef RUN_STEP
+#undef BIT32
+#undef CONST
+#undef LANES
 #undef TABLE_SIZE
 #undef BIT15
 #undef MO
 #undef DIF
 #undef S2
 #undef S1
-/*  .................... End of new_random_MNRU() ....................... */
+/*  .................... End of random_MNRU_block() ....................... */
 
 
 /*
@@ -221,27 +343,12 @@ float new_random_MNRU (char *mode, RANDOM_state * r, long seed) {
   History:
   ~~~~~~~~
   01.Jul.95  v1.00  Created, adapted from montrand.c
+  16.Oct.26  v1.01  Seed shared with random_MNRU() for MNRU_COMPAT_RNG
 
   ===========================================================================
 */
-#define CONST         69069
-#define INIT          314159265L
-#define BIT32         4294967296.0
 float ran_vax () {
-  static unsigned long seed, buffer;
-  static float ran;
-  static short firsttime = 0;
-
-  if (firsttime == 0) {
-    firsttime = 1;
-    seed = INIT;
-  }
-
-  seed = seed * CONST + 1;      /* includes the mod 2**32 operation */
-  buffer = seed & 0xFFFFFF00;   /* mask the first 24 bit */
-  ran = (float) buffer / BIT32; /* and divide by 2**32 to get random */
-
-  return (ran);
+  return (vax_step (&vax_seed));
 }
 
 /*  ......................... End of ran_vax() ............................ */
@@ -259,6 +366,9 @@ float ran_vax () {
   a number between 0 and 2^16-1. This is based on Aachen University's
   randm() of the narrow-band MNRU program mnrusim.c by PB (08.04.1991).
 
+  The 24-bit seed, originally kept in a float and updated in double
+  precision (which was exact), is now kept in an integer.
+
   Parameters: none.
   ~~~~~~~~~~~
 
@@ -276,28 +386,19 @@ float ran_vax () {
   History:
   ~~~~~~~~
   01.Jul.95  v1.00  Created, adapted from mnrusim.c
+  16.Oct.26  v1.01  Integer seed, shared with random_MNRU() for
+                    MNRU_COMPAT_RNG
 
   ===========================================================================
 */
-#define BIT24	16777216.0
-#define BIT8    256.0
 unsigned long ran16_32c () {
-  static float seed = 12345.0;
-  double buffer1, buffer2;
-  long seedl;
-  unsigned long result;
-
-  buffer1 = ((253.0 * seed) + 1.0);
-  buffer2 = (buffer1 / BIT24);
-  seedl = ((long) buffer2) & 0x00FFFFFFL;
-  seed = buffer1 = buffer1 - (float) seedl *BIT24;
-  result = buffer1 / BIT8;
-
-  return result;
+  ran16_seed = (253 * ran16_seed + 1) & 0xFFFFFFL;
+  return (ran16_seed >> 8);
 }
 
-#undef BIT8
-#undef BIT24
+#undef ITER_NO
+#undef FACTOR
+#undef INIT
 /*  .................... End of ran16_32c() ....................... */
 
 #else /* Use the original MNRU noise generator */
@@ -440,6 +541,15 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 #undef FAC
 /*  .................... End of ori_random_MNRU() ....................... */
 
+
+/* Block version of ori_random_MNRU(); see random_MNRU_block() above */
+void random_MNRU_block (char *mode, RANDOM_state * r, long seed, double *noise, long n) {
+  long k;
+
+  for (k = 0; k < n; k++)
+    noise[k] = ori_random_MNRU (mode, r, seed);
+}
+
 #endif /* *********************** STL92_RNG ****************************** */
 
 
@@ -514,6 +624,12 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 			     - input signal DC removal filter
 			     - output low-pass filter (instead of band-pass)
 			     <simao@ctd.comsat.com>
+        16.Oct.2026     2.10 Block processing: noise from
+                             random_MNRU_block(), and each filter run
+                             over the whole block, in buffers allocated
+                             at MNRU_START (blocks longer than the one
+                             given then are processed in pieces).
+        16.Oct.2026     2.11 Same as MNRU_process_multi() for one Q.
 
   ==========================================================================
 */
@@ -534,149 +650,235 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 // Noise gain definition for P.50 FB MNRU
 #define P50_NOISE_GAIN 3.0287
 
+/* Reset the state variables of one MNRU output for a given `Q' */
+static void mnru_reset (MNRU_state * s, long seed, char mode, double Q) {
+  /* Reset clip counter */
+  s->clip = 0;
+
+  /* Seed for random number generation */
+  s->seed = seed;
+
+  /* Gain for signal path */
+  if (mode == MOD_NOISE)
+    s->signal_gain = 1.000;
+  else if (mode == SIGNAL_ONLY)
+    s->signal_gain = 1.000;
+  else                          /* (mode == NOISE_ONLY) */
+    s->signal_gain = 0.000;
+
+  /* Gain for noise path */
+  if (mode == MOD_NOISE || mode == NOISE_ONLY)
+    s->noise_gain = NOISE_GAIN * pow (10.0, (-0.05 * Q));
+  else                          /* (mode == SIGNAL_ONLY) */
+    s->noise_gain = 0;
+
+  /* Flag for random sequence initialization */
+  s->rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+  s->rnd_state.gauss = NULL;    /* not allocated if no noise is drawn */
+#endif
+
+  /* Initialization of the output low-pass filter */
+  /* Cleanup memory */
+  memset (s->DLY, '\0', sizeof (s->DLY));
+
+#ifdef NBMNRU_MASK_ONLY
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.758717518025;
+  s->A[0][1] = 1.50771485802;
+  s->A[0][2] = 0.758717518025;
+  s->A[1][0] = 0.758717518025;
+  s->A[1][1] = 1.46756552150;
+  s->A[1][2] = 0.758717518025;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.16833932919;
+  s->B[0][1] = 0.400250061172;
+  s->B[1][0] = 1.66492368687;
+  s->B[1][1] = 0.850653444434;
+#else
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.775841885724;
+  s->A[0][1] = 1.54552788762;
+  s->A[0][2] = 0.775841885724;
+  s->A[1][0] = 0.775841885724;
+  s->A[1][1] = 1.51915539326;
+  s->A[1][2] = 0.775841885724;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.23307153957;
+  s->B[0][1] = 0.430807372835;
+  s->B[1][0] = 1.71128410940;
+  s->B[1][1] = 0.859087959597;
+#endif
+
+  /* Initialization of the input DC-removal filter */
+  s->last_xk = s->last_yk = 0;
+
+  /* No buffers yet */
+  s->vet = s->blk = DNULL;
+  s->len = 0;
+}
+
+
 double *MNRU_process (char operation, MNRU_state * s, float *input, float *output, long n, long seed, char mode, double Q) {
-  long count, i;
-  double noise, tmp;
-  register double inp_smp, out_tmp, out_flt;
+  return (MNRU_process_multi (operation, s, 1L, input, &output, n, seed, mode, &Q));
+}
 
+/*  .................... End of MNRU_process() ....................... */
 
-  /*
-   *    ..... RESET PORTION .....
-   */
 
-  /* Check if is START of operation: reset state and allocate memory buffer */
-  if (operation == MNRU_START) {
+/*
+  ==========================================================================
 
-    /* Reset clip counter */
-    s->clip = 0;
+        double *MNRU_process_multi (char operation, MNRU_state *s,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long nq, float *input, float **output,
+                                    long n, long seed, char mode, double *Q)
 
-    /* Allocate memory for sample's buffer */
-    if ((s->vet = (double *) calloc (n, sizeof (double))) == DNULL)
-      return ((double *) DNULL);
+        Description:
+        ~~~~~~~~~~~~
 
-    /* Seed for random number generation */
-    s->seed = seed;
+        Same as MNRU_process(), for the `nq' values of the vector `Q' at
+        once: output[q] receives what MNRU_process() gives for Q[q]. The
+        random noise and the input DC-removal filter, which do not depend
+        on Q, are computed once for all outputs; each output then has its
+        own modulation, output filter and clip counter. Since the noise
+        sequence only depends on the seed, the outputs are the same as
+        those of separate runs.
 
-    /* Gain for signal path */
-    if (mode == MOD_NOISE)
-      s->signal_gain = 1.000;
-    else if (mode == SIGNAL_ONLY)
-      s->signal_gain = 1.000;
-    else                        /* (mode == NOISE_ONLY) */
-      s->signal_gain = 0.000;
+        `s' is a vector of `nq' state variables: s[q] holds the output
+        filter and clip counter of Q[q], and s[0] also the random number
+        generator, the DC-removal filter and the returned buffer.
 
-    /* Gain for noise path */
-    if (mode == MOD_NOISE || mode == NOISE_ONLY)
-      s->noise_gain = NOISE_GAIN * pow (10.0, (-0.05 * Q));
-    else                        /* (mode == SIGNAL_ONLY) */
-      s->noise_gain = 0;
+        Return Value:
+        ~~~~~~~~~~~~~
+        As MNRU_process(); also (double *)NULL if n <= 0 at MNRU_START,
+        since the buffers are allocated with that length.
 
-    /* Flag for random sequence initialization */
-    s->rnd_mode = RANDOM_RESET;
+        History:
+        ~~~~~~~~
+        16.Oct.2026     1.0  Created, from MNRU_process().
+        16.Oct.2026     1.1  Rejects n <= 0 at MNRU_START, which gave
+                             empty buffers and an endless loop later.
 
-    /* Initialization of the output low-pass filter */
-    /* Cleanup memory */
-    memset (s->DLY, '\0', sizeof (s->DLY));
+  ==========================================================================
+*/
+double *MNRU_process_multi (char operation, MNRU_state * s, long nq, float *input, float **output, long n, long seed, char mode, double *Q) {
+  long count, i, q, m, done;
+  double noise, tmp, *x, *y;
+  register double inp_smp, out_flt;
+  double a0, a1, a2, b0, b1, d0, d1;
 
-#ifdef NBMNRU_MASK_ONLY
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.758717518025;
-    s->A[0][1] = 1.50771485802;
-    s->A[0][2] = 0.758717518025;
-    s->A[1][0] = 0.758717518025;
-    s->A[1][1] = 1.46756552150;
-    s->A[1][2] = 0.758717518025;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.16833932919;
-    s->B[0][1] = 0.400250061172;
-    s->B[1][0] = 1.66492368687;
-    s->B[1][1] = 0.850653444434;
-#else
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.775841885724;
-    s->A[0][1] = 1.54552788762;
-    s->A[0][2] = 0.775841885724;
-    s->A[1][0] = 0.775841885724;
-    s->A[1][1] = 1.51915539326;
-    s->A[1][2] = 0.775841885724;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.23307153957;
-    s->B[0][1] = 0.430807372835;
-    s->B[1][0] = 1.71128410940;
-    s->B[1][1] = 0.859087959597;
-#endif
 
-    /* Initialization of the input DC-removal filter */
-    s->last_xk = s->last_yk = 0;
+  /*
+   *    ..... RESET PORTION .....
+   */
+
+  /* Check if is START of operation: reset state and allocate memory buffers */
+  if (operation == MNRU_START) {
+    for (q = 0; q < nq; q++)
+      mnru_reset (&s[q], seed, mode, Q[q]);
+    if (n <= 0)
+      return ((double *) DNULL);
+
+    /* Noise buffer, shared by all outputs, and work buffer of each output */
+    if ((s[0].vet = (double *) calloc (n, sizeof (double))) == DNULL)
+      return ((double *) DNULL);
+    for (q = 0; q < nq; q++) {
+      if ((s[q].blk = (double *) calloc (n, sizeof (double))) == DNULL) {
+        while (--q >= 0)
+          free (s[q].blk);
+        free (s[0].vet);
+        return (s[0].vet = (double *) DNULL);
+      }
+      s[q].len = n;
+    }
   }
 
   /*
    *    ..... REAL MNRU WORK .....
    */
 
-  /* Initialize memory */
-  memset (s->vet, '\0', n * sizeof (double));
+  /* Blocks of up to s->len samples */
+  for (x = s[0].blk, done = 0; done < n; done += m) {
+    m = (n - done < s[0].len) ? n - done : s[0].len;
+
+    /* Random number generation for the whole block */
+    if (mode != SIGNAL_ONLY)
+      random_MNRU_block (&s[0].rnd_mode, &s[0].rnd_state, s[0].seed, s[0].vet, m);
 
-  for (count = 0; count < n; count++) {
-    /* Copy sample to local variable */
-    inp_smp = *input++;
+    /* Input samples, DC-removed */
+    for (count = 0; count < m; count++) {
+      inp_smp = input[done + count];
 
 #ifndef NO_DC_REMOVAL
-    /* Remove DC from input sample: H(z)= (1-Z-1)/(1-a.Z-1) */
-    tmp = inp_smp - s->last_xk;
-    tmp += ALPHA * s->last_yk;
+      /* Remove DC from input sample: H(z)= (1-Z-1)/(1-a.Z-1) */
+      tmp = inp_smp - s[0].last_xk;
+      tmp += ALPHA * s[0].last_yk;
 
-    /* Update for next time */
-    s->last_xk = inp_smp;
-    s->last_yk = tmp;
+      /* Update for next time */
+      s[0].last_xk = inp_smp;
+      s[0].last_yk = tmp;
 
-    /* Overwrite DC-removed version of the input signal */
-    inp_smp = tmp;
+      /* Overwrite DC-removed version of the input signal */
+      inp_smp = tmp;
 #endif
-
-    /* Random number generation */
-    if (mode == SIGNAL_ONLY)
-      noise = 0;
-    else {
-      noise = (double) random_MNRU (&s->rnd_mode, &s->rnd_state, s->seed);
-      noise *= s->noise_gain * inp_smp; /* noise modulated by input sample */
-      if (noise > 1.00 || noise < -1.00)
-        s->clip++;              /* clip counter */
+      x[count] = inp_smp;
     }
 
-    /* Addition of signal and modulated noise */
-    out_tmp = noise + inp_smp * s->signal_gain;
-
-#ifdef NO_OUT_FILTER
-    out_flt = out_tmp;
-#else
-    /* Filter output sample by each stage of the low-pass IIR filter */
-    for (i = 0; i < MNRU_STAGE_OUT_FLT; i++) {
-      out_flt = out_tmp * s->A[i][0] + s->DLY[i][1];
-      s->DLY[i][1] = out_tmp * s->A[i][1] - out_flt * s->B[i][0] + s->DLY[i][0];
-      s->DLY[i][0] = out_tmp * s->A[i][2] - out_flt * s->B[i][1];
+    /* Each output; the first one last, since it overwrites x[] */
+    for (q = nq - 1; q >= 0; q--) {
+      y = s[q].blk;
+      for (count = 0; count < m; count++) {
+        /* Modulated noise */
+        if (mode == SIGNAL_ONLY)
+          noise = 0;
+        else {
+          noise = s[0].vet[count];
+          noise *= s[q].noise_gain * x[count];  /* noise modulated by input sample */
+          if (noise > 1.00 || noise < -1.00)
+            s[q].clip++;        /* clip counter */
+        }
+
+        /* Addition of signal and modulated noise */
+        y[count] = noise + x[count] * s[q].signal_gain;
+      }
 
-      out_tmp = out_flt;        /* output becomes input for next stage */
-    }
+#ifndef NO_OUT_FILTER
+      /* Filter the block by each stage of the low-pass IIR filter */
+      for (i = 0; i < MNRU_STAGE_OUT_FLT; i++) {
+        a0 = s[q].A[i][0], a1 = s[q].A[i][1], a2 = s[q].A[i][2];
+        b0 = s[q].B[i][0], b1 = s[q].B[i][1];
+        d0 = s[q].DLY[i][0], d1 = s[q].DLY[i][1];
+        for (count = 0; count < m; count++) {
+          out_flt = y[count] * a0 + d1;
+          d1 = y[count] * a1 - out_flt * b0 + d0;
+          d0 = y[count] * a2 - out_flt * b1;
+          y[count] = out_flt;   /* output becomes input for next stage */
+        }
+        s[q].DLY[i][0] = d0, s[q].DLY[i][1] = d1;
+      }
 #endif
 
-    /* Copy noise-modulated speech sample to output vector */
-    *output++ = out_flt;
+      /* Copy noise-modulated speech samples to output vector */
+      for (count = 0; count < m; count++)
+        output[q][done + count] = y[count];
+    }
   }
 
-  /* Check if is end of operation THEN release memory buffer */
+  /* Check if is end of operation THEN release memory buffers */
   if (operation == MNRU_STOP) {
-    free (s->rnd_state.gauss);
-    free (s->vet);
-    s->vet = (double *) DNULL;
+    free (s[0].rnd_state.gauss);
+    free (s[0].vet);
+    for (q = 0; q < nq; q++)
+      free (s[q].blk);
+    s[0].vet = (double *) DNULL;
   }
 
   /* Return address of vet: if NULL, nothing is allocated */
-  return ((double *) s->vet);
+  return ((double *) s[0].vet);
 }
-/*  .................... End of MNRU_process() ....................... */
+/*  .................... End of MNRU_process_multi() ....................... */
 
 
 /**
@@ -796,21 +998,8 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 		  return s->vet;
 	  }
 
-	  /* Initialize memory and upsample by a factor of 5 */
-	  memset(s->vet, '\0', n * sizeof(double));
-	  memset(filteredNoiseTemp, 0, n * sizeof(double));
-
 	  //Fill noise array
-	  for (count = 0; count < n; count++)
-	  {
-		 /* Random number generation */
-		 if (mode == SIGNAL_ONLY)
-			s->vet[count] = 0;
-		 else
-		 {
-			s->vet[count] = (double) random_MNRU(&s->rnd_mode, &s->rnd_state, s->seed);
-		 }
-	  }
+	  random_MNRU_block(&s->rnd_mode, &s->rnd_state, s->seed, s->vet, n);
 
 	  for (count = 0; count < n; count++)
 		  s->vet[count] *= s->noise_gain;
@@ -866,6 +1055,178 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 
 /*  .................... End of P50_MNRU_process() ....................... */
 
+
+/**
+*   double *P50_MNRU_process_multi (char operation, MNRU_state *s, long nq, double *input, double **output,
+*        long n, long seed, char mode, double *Q, char dcRemoval)
+*
+*   Same as P50_MNRU_process(), for the `nq' values of the vector `Q' at once: output[q] receives the output for
+*   Q[q]. The random noise, its P.50 shaping (filterFunc_IIR() and filterFunc_FIR()) and the input DC-removal
+*   filter do not depend on Q and are computed once for all outputs. Since the noise is shaped before, rather
+*   than after, being scaled by the noise gain of each Q, the outputs may differ from those of P50_MNRU_process()
+*   by rounding errors of the order of 1e-16 relative.
+*
+*   Unlike P50_MNRU_process(), the filter memories are kept in the state variables, so that several instances
+*   may run in the same program.
+*
+*   @param  s           vector of `nq' state variables; s[0] holds the noise generator and filters, and each s[q]
+*                       the gains of Q[q]
+*   @param  output      vector of `nq' pointers to output double-data vectors
+*   @param  Q           vector of `nq' values of Q, in dB
+*
+*   The other parameters and the return value are as for P50_MNRU_process(); NULL is also returned if n <= 0
+*   at MNRU_START, or if a later call gives more than the `n' of MNRU_START.
+**/
+double *P50_MNRU_process_multi(char operation, MNRU_state *s, long nq, double* input, double** output,
+                               long n, long seed, char mode, double *Q, char dcRemoval)
+{
+  long            count, q;
+  double          tmp;
+
+  /*
+  *    ..... RESET PORTION .....
+  */
+
+  /* Check if is START of operation: reset state and allocate memory buffers */
+  if (operation == MNRU_START)
+  {
+    for (q = 0; q < nq; q++)
+    {
+      s[q].clip = 0;
+      s[q].seed = seed;
+      s[q].signal_gain = (mode == NOISE_ONLY) ? 0.000 : 1.000;
+      if (mode == MOD_NOISE || mode == NOISE_ONLY)
+        s[q].noise_gain = P50_NOISE_GAIN * pow(10.0, (-0.05 * Q[q]));
+      else
+        s[q].noise_gain = 0;
+    }
+
+    /* Noise generator, filters and DC-removal filter, shared by all outputs */
+    s[0].rnd_mode = RANDOM_RESET;
+    s[0].rnd_state.gauss = NULL;
+    s[0].last_xk = s[0].last_yk = 0;
+    s[0].vet = s[0].blk = s[0].dly_fir = s[0].dly_iir = NULL;
+    if (n <= 0)
+      return NULL;
+    s[0].len = n;
+    s[0].vet = (double *) calloc(n, sizeof(double));
+    s[0].blk = (double *) calloc(n, sizeof(double));
+    s[0].dly_fir = (double *) calloc(iP50FIRcoeffsLen, sizeof(double));
+    s[0].dly_iir = (double *) calloc(iP50IIRorder, sizeof(double));
+    if (s[0].vet == NULL || s[0].blk == NULL || s[0].dly_fir == NULL || s[0].dly_iir == NULL)
+    {
+      free(s[0].vet); free(s[0].blk); free(s[0].dly_fir); free(s[0].dly_iir);
+      return (s[0].vet = NULL);
+    }
+  }
+
+  /*
+   *    ..... REAL MNRU WORK .....
+   */
+
+  if (operation != MNRU_STOP)
+  {
+    //the buffers only hold the block length given at MNRU_START
+    if (n > s[0].len)
+      return NULL;
+
+    //skip everything if mode == SIGNAL_ONLY
+    if (mode == SIGNAL_ONLY)
+    {
+      for (q = 0; q < nq; q++)
+        memcpy(output[q], input, n * sizeof(double));
+      return s[0].vet;
+    }
+
+    //Unit-gain noise, shaped by the P.50 filters as in P50_MNRU_process()
+    random_MNRU_block(&s[0].rnd_mode, &s[0].rnd_state, s[0].seed, s[0].vet, n);
+    filterFunc_IIR(s[0].vet, s[0].blk, n, dP50IIRcoeffs, iP50IIRorder, s[0].dly_iir);
+    filterFunc_FIR(s[0].blk, s[0].vet, n, dP50FIRcoeffs, iP50FIRcoeffsLen, s[0].dly_fir);
+
+    if (dcRemoval == 1) {
+      for (count = 0; count < n; count++)
+      {
+        /* Remove DC from input sample: H(z)= (1-Z-1)/(1-a.Z-1) */
+        tmp = input[count] - s[0].last_xk;
+        tmp += ALPHA * s[0].last_yk;
+
+        /* Update for next time */
+        s[0].last_xk = input[count];
+        s[0].last_yk = tmp;
+
+        /* Overwrite DC-removed version of the input signal */
+        input[count] = tmp;
+      }
+    }
+
+    //Add the modulated noise of each Q to the signal
+    for (q = 0; q < nq; q++)
+      for (count = 0; count < n; count++)
+        output[q][count] = input[count] * (s[q].signal_gain + s[q].noise_gain * s[0].vet[count]);
+  }
+  else //operation == MNRU_STOP
+  {
+    free(s[0].rnd_state.gauss);
+    free(s[0].vet);
+    free(s[0].blk);
+    free(s[0].dly_fir);
+    free(s[0].dly_iir);
+    s[0].rnd_state.gauss = NULL;
+    s[0].vet = s[0].blk = s[0].dly_fir = s[0].dly_iir = NULL;
+  }
+
+  /* Return address of vet: if NULL, nothing is allocated */
+  return ((double *) s[0].vet);
+}
+
+/*  .................... End of P50_MNRU_process_multi() ....................... */
+
+
+/*
+  ==========================================================================
+
+        int MNRU_valid_q_format (char *fmt);
+        ~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Check that `fmt', the output file name of the Q values processed
+        with MNRU_process_multi() or P50_MNRU_process_multi(), is a printf()
+        format with exactly one conversion for the Q value,
+        %[flags][width][.prec] followed by f, g or e, and no other
+        conversion than %%.
+
+        Return Value:
+        ~~~~~~~~~~~~~
+        1 if the format is valid, 0 otherwise.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026     1.0  Created, from the copies in mnrudemo.c and
+                             p50fbmnru.c.
+
+  ==========================================================================
+*/
+int MNRU_valid_q_format (char *fmt) {
+  int nconv = 0;
+
+  for (; *fmt; fmt++) {
+    if (*fmt != '%' || *++fmt == '%')
+      continue;
+    fmt += strspn (fmt, "-+ #0");       /* flags */
+    fmt += strspn (fmt, "0123456789");  /* width */
+    if (*fmt == '.')                    /* precision */
+      fmt += 1 + strspn (fmt + 1, "0123456789");
+    if (*fmt == '\0' || strchr ("fge", *fmt) == NULL)
+      return 0;
+    nconv++;
+  }
+  return (nconv == 1);
+}
+
+/*  .................... End of MNRU_valid_q_format() ....................... */
+
 #undef NOISE_GAIN
 #undef DNULL
 #undef ALPHA
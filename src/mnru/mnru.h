@@ -25,8 +25,9 @@ typedef struct {
 
 /* Definition of type for random_MNRU state variables */
 typedef struct {
-  float *gauss;
-
+  float *gauss;                 /* gaussian table */
+  unsigned long vax;            /* generator of the table */
+  unsigned long run;            /* generator of the table indices (24 bits) */
 } new_RANDOM_state;
 
 /* Definitions for the MNRU state variable */
@@ -38,6 +39,9 @@ typedef struct {
   long seed, clip;
   double signal_gain, noise_gain;
   double *vet, last_xk, last_yk, last_y20k_lp;
+  double *blk;                  /* work buffer of the block filters */
+  long len;                     /* length of vet[] and blk[] */
+  double *dly_iir, *dly_fir;    /* P.50 noise filter delay lines (multi-Q) */
   RANDOM_state rnd_state;       /* for random_MNRU() */
   char rnd_mode;
 
@@ -50,8 +54,12 @@ typedef struct {
 /* Prototype for MNRU and random function(s) */
 double *MNRU_process ARGS ((char operation, MNRU_state * s, float *input, float *output, long n, long seed, char mode, double Q));
 double *P50_MNRU_process ARGS ((char operation, MNRU_state * s, double *input, double *output, long n, long seed, char mode, double Q, char dcRemoval));
+double *MNRU_process_multi ARGS ((char operation, MNRU_state * s, long nq, float *input, float **output, long n, long seed, char mode, double *Q));
+double *P50_MNRU_process_multi ARGS ((char operation, MNRU_state * s, long nq, double *input, double **output, long n, long seed, char mode, double *Q, char dcRemoval));
 
 float random_MNRU ARGS ((char *mode, RANDOM_state * r, long seed));
+void random_MNRU_block ARGS ((char *mode, RANDOM_state * r, long seed, double *noise, long n));
+int MNRU_valid_q_format ARGS ((char *fmt));
 
 /* Definitions for the MNRU algorithm */
 #define MOD_NOISE    1
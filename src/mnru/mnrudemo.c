@@ -1,4 +1,4 @@
-/*                                                Version: 2.2 - 02.Feb.2010
+/*                                                Version: 2.5 - 16.Oct.2026
   --------------------------------------------------------------------------
 
   MNRUDEMO.C
@@ -38,6 +38,10 @@
   -noise          define MNRU mode as noise-only
   -signal         define MNRU mode as signal-only
   -mod            define MNRU mode as modulated noise (default)
+  -sweep Q1,Q2,.. process the input for all the Q values given, in a
+                  single pass; fileout is then a printf() format for the
+                  Q value of each output file, with a single %f, %g or %e
+                  conversion, e.g. sine.q%02.0f
 
   History:
   ~~~~~~~~
@@ -53,6 +57,10 @@
                     are specified. <simao.campos@labs.comsat.com>
   02.Feb.2010  2.2  Modified maximum string length, implicit casting of
                     toupper() argument removed (y.hiwasaki)
+  16.Oct.2026  2.3  Report the MNRU_COMPAT_RNG compile option
+  16.Oct.2026  2.4  Added option -sweep, using MNRU_process_multi()
+  16.Oct.2026  2.5  The format of -sweep must have a single floating-point
+                    conversion
   --------------------------------------------------------------------------
 */
 
@@ -76,6 +84,9 @@
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
 
+/* ... Local definitions ... */
+#define MNRU_MAX_Q 64           /* max. number of Q values of -sweep */
+
 
 /*
  -------------------------------------------------------------------------
@@ -90,7 +101,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("MNRU.C - Version 2.2 of 02.Feb.2010 \n");
+  printf ("MNRU.C - Version 2.5 of 16.Oct.2026 \n");
   printf ("Demonstration program for generating files with modulated\n");
   printf ("noise added based on UGST's MNRU module, which is based in the\n");
   printf ("Recommendation P.81 (Blue Book).\n");
@@ -116,6 +127,9 @@ void display_usage () {
   printf (" -noise     define MNRU mode as noise-only\n");
   printf (" -signal    define MNRU mode as signal-only\n");
   printf (" -mod       define MNRU mode as modulated noise (default)\n");
+  printf (" -sweep Q1,Q2,...  process for all these Q values in one pass;\n");
+  printf ("            filout is then a printf() format for each Q, with a\n");
+  printf ("            single %%f, %%g or %%e conversion, e.g. sine.q%%02.0f\n");
 
   /* Quit program */
   exit (-128);
@@ -124,7 +138,6 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
-
 /*
    **************************************************************************
    ***                                                                    ***
@@ -137,19 +150,22 @@ int main (int argc, char *argv[]) {
   /* DECLARATIONS */
 
 /* File variables */
-  char FileIn[80], FileOut[80];
-  FILE *Fi, *Fo;
-  int fhi, fho;
+  char FileIn[80], FileOut[80], name[MAX_STRLEN];
+  FILE *Fi, *Fo[MNRU_MAX_Q];
+  int fhi;
 #ifdef VMS
   char mrs[15];
 #endif
 
 /* Algorithm variables */
-  MNRU_state state;
+  MNRU_state state[MNRU_MAX_Q];
 
   short *Buf;
-  float *inp, *out;
+  float *inp, *out[MNRU_MAX_Q];
   double QdB = 100;             /* defaults to a high value */
+  double Q[MNRU_MAX_Q];
+  long nq = 0, q;
+  char *p, sweep = 0;
   long cur_frame, l, N, N1, N2;
   char MNRU_mode = MOD_NOISE, operation;
   long size, over = 0;
@@ -161,6 +177,8 @@ int main (int argc, char *argv[]) {
   fprintf (stderr, "Compiling options: \n\t%s\n\t%s\n\t%s\n\n",
 #ifdef STL92_RNG
            "- Using STL92 random number generator",
+#elif defined(MNRU_COMPAT_RNG)
+           "- Using new random number generator, shared by all states",
 #else
            "- Using new random number generator",
 #endif
@@ -185,6 +203,18 @@ int main (int argc, char *argv[]) {
         /* No reset */
         QdB = atof (argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-sweep") == 0) {
+        /* List of Q values */
+        for (p = argv[2]; *p && nq < MNRU_MAX_Q; p += (*p == ','))
+          Q[nq++] = strtod (p, &p);
+        if (*p) {
+          fprintf (stderr, "Bad list of Q values, or more than %d: %s\n", MNRU_MAX_Q, argv[2]);
+          exit (2);
+        }
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -233,6 +263,17 @@ int main (int argc, char *argv[]) {
   FIND_PAR_L (5, "_No. of Blocks: .............. ", N2, 0);
   FIND_PAR_D (6, "_Desired Q: .................. ", QdB, QdB);
 
+  /* A single Q, unless -sweep is used */
+  if (nq == 0)
+    Q[nq++] = QdB;
+  else {
+    sweep = 1;
+    if (!MNRU_valid_q_format (FileOut)) {
+      fprintf (stderr, "With -sweep, the output file must be a format with one %%f, %%g or %%e, e.g. %s.q%%02.0f\n", FileOut);
+      exit (2);
+    }
+  }
+
   /* Check for parameter 7 to change MNRU operation mode - OBSOLETE! */
   if (argc > 7) {
     MNRU_mode = toupper ((int) argv[7][0]);
@@ -272,8 +313,9 @@ int main (int argc, char *argv[]) {
   /* Allocate memory for data vectors */
   if ((inp = (float *) calloc (N, sizeof (float))) == NULL)
     KILL ("Error allocating input buffer\n", 10);
-  if ((out = (float *) calloc (N, sizeof (float))) == NULL)
-    KILL ("Error allocating output buffer\n", 10);
+  for (q = 0; q < nq; q++)
+    if ((out[q] = (float *) calloc (N, sizeof (float))) == NULL)
+      KILL ("Error allocating output buffer\n", 10);
 
   /* Opening input file; abort if there's any problem */
 #ifdef VMS
@@ -283,10 +325,15 @@ int main (int argc, char *argv[]) {
     KILL (FileIn, 2);
   fhi = fileno (Fi);
 
-  /* Creates output file */
-  if ((Fo = fopen (FileOut, WB)) == NULL)
-    KILL (FileOut, 3);
-  fho = fileno (Fo);
+  /* Creates output file(s) */
+  for (q = 0; q < nq; q++) {
+    if (sweep)
+      snprintf (name, sizeof (name), FileOut, Q[q]);
+    else
+      strcpy (name, FileOut);
+    if ((Fo[q] = fopen (name, WB)) == NULL)
+      KILL (name, 3);
+  }
 
   /* Move pointer to 1st block of interest */
   if (fseek (Fi, start_byte, 0) < 0l)
@@ -322,14 +369,16 @@ int main (int argc, char *argv[]) {
       operation = MNRU_CONTINUE;
 
     /* MNRU processing */
-    MNRU_process (operation, &state, inp, out, (long) l, (long) 314159265, MNRU_mode, QdB);
+    MNRU_process_multi (operation, state, nq, inp, out, (long) l, (long) 314159265, MNRU_mode, Q);
 
-    /* Convert from float to short with hard clip and truncation */
-    over += fl2sh_16bit ((long) l, out, Buf, 1);
+    for (q = 0; q < nq; q++) {
+      /* Convert from float to short with hard clip and truncation */
+      over += fl2sh_16bit ((long) l, out[q], Buf, 1);
 
-    /* Save data to file */
-    if ((l = fwrite (Buf, sizeof (short), l, Fo)) <= 0)
-      KILL (FileOut, 4);
+      /* Save data to file */
+      if (fwrite (Buf, sizeof (short), l, Fo[q]) != (size_t) l)
+        KILL (FileOut, 4);
+    }
   }
 
 
@@ -337,10 +386,15 @@ int main (int argc, char *argv[]) {
    * ........ FINALIZATIONS .........
    */
   fprintf (stderr, "\nOverflow samples: %ld", over);
-  fprintf (stderr, "\nClipped noise samples: %ld", state.clip);
+  for (q = 0; q < nq; q++)
+    if (sweep)
+      fprintf (stderr, "\nClipped noise samples for Q=%g: %ld", Q[q], state[q].clip);
+    else
+      fprintf (stderr, "\nClipped noise samples: %ld", state[q].clip);
   fprintf (stderr, "\n");
   fclose (Fi);
-  fclose (Fo);
+  for (q = 0; q < nq; q++)
+    fclose (Fo[q]);
 #ifndef VMS
   return (0);
 #endif
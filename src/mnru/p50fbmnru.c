@@ -12,6 +12,7 @@
 
 #define RANDOM_state new_RANDOM_state
 #define random_MNRU new_random_MNRU
+#define MAX_Q 64                /* max. number of Q values in a sweep */
 
 void show_use(void)
 {
@@ -25,6 +26,9 @@ void show_use(void)
 	 printf("\n      Mode M:   Modulated Noise");
 	 printf("\n           N:   Noise only");
 	 printf("\n           S:   Signal only\n");
+	 printf("\n      Q/dB may be a comma-separated list of values, processed in a single pass; the");
+	 printf("\n      output file is then a printf() format for the Q of each file, with a single");
+	 printf("\n      %%f, %%g or %%e conversion, e.g. out_Q%%02.0f.pcm\n");
 	 printf("\n      Options:");
      printf("\n         dcFilterOn  1 for enable DC Filter (for compatibility with P.50 MNRU prior 2023)");
      printf("\n                     0 to disable DC Filter (default, and recommended)\n\n");
@@ -33,8 +37,8 @@ void show_use(void)
 
 int main(int argc, char *argv[])
 {
-    MNRU_state      state;
-    FILE            *In, *Out;
+    MNRU_state      state, mstate[MAX_Q];
+    FILE            *In, *Out, *MOut[MAX_Q];
     char            applyDcRemoval ;
     short           B_Len, BuffLen;
     long            lFileLen = 0;
@@ -43,6 +47,10 @@ int main(int argc, char *argv[])
     short           operation, MNRU_mode;
 	static short 	Buf[512];
 	static double	In_Buf[512], Out_Buf[512];
+	static double	MOut_Buf[MAX_Q][512];
+	double          *MOut_ptr[MAX_Q], MQ[MAX_Q];
+	int             nq = 0, q;
+	char            *p, name[1024];
 
 	//Do inits to prevent crashing when option 'S' is selected
 	state.rnd_state.gauss = NULL;
@@ -68,11 +76,34 @@ int main(int argc, char *argv[])
 		  exit(1);
 	 }
 
+	 /* A comma-separated list of Q values: one output file per Q, named from the format argv[2] */
+	 if (strchr(argv[3], ',') != NULL)
+	 {
+		 for (p = argv[3]; *p && nq < MAX_Q; p += (*p == ','))
+			 MQ[nq++] = strtod(p, &p);
+		 if (*p || !MNRU_valid_q_format(argv[2]))
+		 {   printf(" bad list of Q values, or output file not a format: %s %s\n", argv[3], argv[2]);
+			  exit(1);
+		 }
+		 for (q = 0; q < nq; q++)
+		 {
+			 snprintf(name, sizeof(name), argv[2], MQ[q]);
+			 if ((MOut[q] = fopen(name, "wb")) == NULL)
+			 {   printf(" can't open output file: %s \n", name);
+				  exit(1);
+			 }
+			 MOut_ptr[q] = MOut_Buf[q];
+		 }
+		 Out = NULL;
+	 }
+	 else
+	 {
 	 Out = fopen( argv[2], "wb");
 	 if( Out == NULL )
 	 {   printf(" can't open output file: %s \n", argv[2]);
 		  exit(1);
 	 }
+	 }
 
 	 Q 	= 	(float)atof( argv[3]);
 
@@ -99,6 +130,12 @@ int main(int argc, char *argv[])
 	 /* +++++++++++++++++++++++++  initialize  +++++++++++++++++++++++++ */
 	 printf(" Input file ............ %s ", argv[1]);
 	 printf("\n Output file ........... %s ", argv[2]);
+	 if (nq > 0)
+	 {   printf("\n Q ..................... ");
+		 for (q = 0; q < nq; q++)
+			 printf("%g%s", MQ[q], (q < nq - 1) ? ", " : " dB");
+	 }
+	 else
 	 printf("\n Q ..................... %g dB", Q);
 	 if( MNRU_mode == MOD_NOISE) printf("\n Mode .................. Mod-Noise");
 	 if( MNRU_mode == NOISE_ONLY) printf("\n Mode .................. Noise only");
@@ -120,6 +157,24 @@ int main(int argc, char *argv[])
 			Out_Buf[i]	=	0;
 		}
 
+		if (nq > 0)
+		{
+			/* All the Q values at once */
+			P50_MNRU_process_multi( operation, mstate, nq, In_Buf, MOut_ptr, (long) BuffLen, (long) 314159265,
+			    (char) MNRU_mode, MQ, applyDcRemoval);
+
+			for (q = 0; q < nq; q++)
+			{
+				for( i=0; i<BuffLen; i++)
+				{
+					if( MOut_Buf[q][i]>0)	Buf[i]	=	(short) ( MOut_Buf[q][i] +0.5);
+					else					Buf[i]	=	(short) ( MOut_Buf[q][i] -0.5);
+				}
+				fwrite(Buf, sizeof(short), BuffLen, MOut[q]);
+			}
+		}
+		else
+		{
 		P50_MNRU_process( operation, &state, In_Buf, Out_Buf, (long) BuffLen, (long) 314159265, (char) MNRU_mode, Q,
 		    applyDcRemoval);
 
@@ -130,6 +185,7 @@ int main(int argc, char *argv[])
 		}
 
 		fwrite(Buf, sizeof(short), BuffLen, Out);
+		}
 
 		if( operation==MNRU_START)	operation	=	MNRU_CONTINUE;
 
@@ -139,10 +195,20 @@ int main(int argc, char *argv[])
 
 	operation	=	MNRU_STOP;
 
-	P50_MNRU_process( operation, &state, In_Buf, Out_Buf, (long) 0, (long) 0, (char)0, 0, 0);
+	if (nq > 0)
+	{
+		P50_MNRU_process_multi( operation, mstate, nq, In_Buf, MOut_ptr, (long) 0, (long) 0, (char)0, MQ, 0);
+		for (q = 0; q < nq; q++)
+			fclose(MOut[q]);
+	}
+	else
+	{
+		P50_MNRU_process( operation, &state, In_Buf, Out_Buf, (long) 0, (long) 0, (char)0, 0, 0);
+		fclose(Out);
+	}
 
     printf("\n Done\n");
-	fclose(In); fclose(Out);
+	fclose(In);
 
 	return 0;
 }
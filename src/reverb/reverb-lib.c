@@ -27,10 +27,18 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_fft_init(...)	:		Prepares the partitioned FFT convolution of an impulse response
+		conv_fft(...)	:		Same as conv(), with the partitioned FFT convolution
+		conv_fft_free(...)	:		Releases the partitioned FFT convolution
+		conv_stream_init(...)	:	Prepares the zero-latency streaming convolution
+		conv_stream(...)	:		Same as conv_fft(), with bounded work per call
+		conv_stream_free(...)	:	Releases the streaming convolution
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
     10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+    16.Oct.26   v1.02   Added uniformly partitioned FFT convolution (conv_fft)
+    16.Oct.26   v1.03   Added non-uniform partitioned streaming convolution (conv_stream)
 
   AUTHORS :
 	v1.0 Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -38,6 +46,12 @@
 
 */
 
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "reverb-lib.h"
+#include "fft.h"                /* actrdft() */
 
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
@@ -97,3 +111,406 @@ void conv_old (float *IR, short *buffIn, short *buffRvb, float alignFact, long N
     buffRvb[k] = (short) (alignFact * tmpRvb + 0.5);    /* +0.5 : rounding during the 'short' truncation */
   }
 }
+
+
+/* ..................... PARTITIONED FFT CONVOLUTION ..................... */
+
+/* The convolution with an impulse response of N samples is split in
+   P = ceil(N/B) partitions of B samples. Each block of B input samples,
+   together with the previous one, is transformed with a real FFT of 2B
+   points (actrdft() of the frequency response tool) and stored in the
+   frequency-domain delay line; the output block is the last half of the
+   inverse transform of sum_p X[n-p].H[p] (overlap-save). The sum over the
+   past blocks (p>0) is computed once per block, so that an incomplete
+   block only costs the transforms and one spectral product: conv_fft()
+   accepts any number of samples and has no delay with respect to conv().
+   Results differ from conv() by float rounding (at most 1 on the 16 bit
+   output for the shipped responses). */
+
+/* this routine accumulates the product of two spectra in the actrdft() format into Y */
+static void conv_fft_mac (float *Y, float *X, float *H, long nfft) {
+  long k;
+
+  Y[0] += X[0] * H[0];          /* DC */
+  Y[1] += X[1] * H[1];          /* Nyquist frequency */
+  for (k = 2; k < nfft; k += 2) {
+    Y[k] += X[k] * H[k] - X[k + 1] * H[k + 1];
+    Y[k + 1] += X[k] * H[k + 1] + X[k + 1] * H[k];
+  }
+}
+
+
+/* this routine prepares IR for the partitioned FFT convolution, with partitions of B samples */
+CONV_IR *conv_ir_init (float *IR, long N, long B) {
+  CONV_IR *ir;
+  long p, n, nfft;
+
+  /* default partition length: CONV_FFT_BLOCK, or less for a short response */
+  if (B == 0)
+    for (B = 4; B < CONV_FFT_BLOCK && B < N; B <<= 1);
+  for (n = B; n > 1 && n % 2 == 0; n >>= 1);
+  if (B < 4 || n != 1 || N < 1)
+    return NULL;
+  nfft = 2 * B;
+
+  if ((ir = (CONV_IR *) calloc (1, sizeof (CONV_IR))) == NULL)
+    return NULL;
+  ir->N = N;
+  ir->B = B;
+  ir->P = (N + B - 1) / B;
+  ir->H = (float *) calloc (ir->P * nfft, sizeof (float));
+  ir->ip = (int *) calloc (3 + (long) sqrt (nfft / 2.0), sizeof (int));
+  ir->w = (float *) calloc (nfft / 2, sizeof (float));
+  if (ir->H == NULL || ir->ip == NULL || ir->w == NULL) {
+    conv_ir_free (ir);
+    return NULL;
+  }
+
+  /* spectra of the zero-padded partitions; this also fills the FFT tables:
+     actrdft() only reads w afterwards for transforms of nfft points, but
+     uses ip as a work area, so each convolution has its own copy */
+  for (p = 0; p < ir->P; p++) {
+    n = (N - p * B < B) ? N - p * B : B;
+    memcpy (&ir->H[p * nfft], &IR[p * B], n * sizeof (float));
+    actrdft ((int) nfft, 1, &ir->H[p * nfft], ir->ip, ir->w);
+  }
+
+  return ir;
+}
+
+
+/* this routine releases a prepared impulse response */
+void conv_ir_free (CONV_IR * ir) {
+  free (ir->H);
+  free (ir->ip);
+  free (ir->w);
+  free (ir);
+}
+
+
+/* this routine prepares a partitioned FFT convolution with the prepared impulse response ir */
+CONV_FFT *conv_fft_open (CONV_IR * ir) {
+  CONV_FFT *rvb;
+  long nfft = 2 * ir->B;
+
+  if ((rvb = (CONV_FFT *) calloc (1, sizeof (CONV_FFT))) == NULL)
+    return NULL;
+  rvb->N = ir->N;
+  rvb->B = ir->B;
+  rvb->P = ir->P;
+  rvb->ir = ir;
+  rvb->fdl = (float *) calloc (rvb->P * nfft, sizeof (float));
+  rvb->tail = (float *) calloc (nfft, sizeof (float));
+  rvb->x = (float *) calloc (nfft, sizeof (float));
+  rvb->Y = (float *) calloc (nfft, sizeof (float));
+  rvb->ip = (int *) malloc ((3 + (long) sqrt (nfft / 2.0)) * sizeof (int));
+  if (rvb->fdl == NULL || rvb->tail == NULL || rvb->x == NULL || rvb->Y == NULL || rvb->ip == NULL) {
+    conv_fft_free (rvb);
+    return NULL;
+  }
+  memcpy (rvb->ip, ir->ip, (3 + (long) sqrt (nfft / 2.0)) * sizeof (int));
+  return rvb;
+}
+
+
+/* this routine prepares the partitioned FFT convolution of IR, with partitions of B samples */
+CONV_FFT *conv_fft_init (float *IR, long N, long B) {
+  CONV_IR *ir;
+  CONV_FFT *rvb;
+
+  if ((ir = conv_ir_init (IR, N, B)) == NULL)
+    return NULL;
+  if ((rvb = conv_fft_open (ir)) == NULL) {
+    conv_ir_free (ir);
+    return NULL;
+  }
+  rvb->own_ir = 1;
+  return rvb;
+}
+
+
+/* this routine convolves buffIn with the impulse response and stores the processed data into buffRvb */
+long conv_fft (CONV_FFT * rvb, short *buffIn, short *buffRvb, float alignFact, long L) {
+  const CONV_IR *ir = rvb->ir;
+  long B = rvb->B, P = rvb->P, nfft = 2 * rvb->B;
+  long k, j, n, p;
+  float *X, tmpRvb;
+  long sat_warning;
+
+  sat_warning = -1;
+  for (k = 0; k < L; k += n) {
+    /* append the new samples to the current block */
+    n = (L - k < B - rvb->fill) ? L - k : B - rvb->fill;
+    for (j = 0; j < n; j++)
+      rvb->x[B + rvb->fill + j] = buffIn[k + j];
+
+    /* spectrum of the previous and current (zero-padded) blocks */
+    X = &rvb->fdl[rvb->cur * nfft];
+    memcpy (X, rvb->x, nfft * sizeof (float));
+    actrdft ((int) nfft, 1, X, rvb->ip, ir->w);
+
+    /* add its contribution to the past ones, and back to time domain */
+    memcpy (rvb->Y, rvb->tail, nfft * sizeof (float));
+    conv_fft_mac (rvb->Y, X, ir->H, nfft);
+    actrdft ((int) nfft, -1, rvb->Y, rvb->ip, ir->w);
+
+    for (j = 0; j < n; j++) {
+      tmpRvb = (float) (alignFact * rvb->Y[B + rvb->fill + j] + 0.5);  /* +0.5 : rounding for the 'short' truncation */
+
+      /* perform 16 bit saturation */
+      if (tmpRvb < -32768.0) {
+        buffRvb[k + j] = -32768;
+        sat_warning = k + j;
+      } else {
+        if (tmpRvb > 32767.0) {
+          buffRvb[k + j] = 32767;
+          sat_warning = k + j;
+        } else {
+          buffRvb[k + j] = (short) tmpRvb;
+        }
+      }
+    }
+    rvb->fill += n;
+
+    /* complete block: its spectrum stays in the FDL, the oldest slot is reused */
+    if (rvb->fill == B) {
+      rvb->fill = 0;
+      rvb->cur = (rvb->cur + P - 1) % P;
+      memcpy (rvb->x, &rvb->x[B], B * sizeof (float));
+      memset (&rvb->x[B], 0, B * sizeof (float));
+
+      memset (rvb->tail, 0, nfft * sizeof (float));
+      for (p = 1; p < P; p++)
+        conv_fft_mac (rvb->tail, &rvb->fdl[((rvb->cur + p) % P) * nfft], &ir->H[p * nfft], nfft);
+    }
+  }
+  return sat_warning;
+}
+
+
+/* this routine releases the partitioned FFT convolution */
+void conv_fft_free (CONV_FFT * rvb) {
+  if (rvb->own_ir)
+    conv_ir_free (rvb->ir);
+  free (rvb->fdl);
+  free (rvb->tail);
+  free (rvb->x);
+  free (rvb->Y);
+  free (rvb->ip);
+  free (rvb);
+}
+
+
+/* ................... ZERO-LATENCY STREAMING CONVOLUTION ................... */
+
+/* The first D samples of the impulse response are convolved in direct form,
+   so that each output is available as soon as its input sample. The rest is
+   split in stages of uniformly partitioned overlap-save convolution, with
+   partitions growing from D to Bmax:
+
+     stage 0: partitions of D samples,   response samples [D, 4D)
+     stage i: partitions of B=D*2^i,     response samples [2B, 4B)
+     last:    partitions of Bmax,        response samples [2*Bmax, N)
+
+   The output of a stage for an input block of B samples is only needed
+   o-B samples after the block is complete (o being the offset of the
+   stage in the response). Stage 0 (o=D=B) computes it at once, every D
+   samples. The other stages (o=2B) have a whole block of slack: the work
+   (one forward FFT, P spectral products, one inverse FFT) is cut in
+   P+2 steps, run in proportion to the samples received until the next
+   block is complete. The work per call is thus about proportional to the
+   number of samples, the largest single step being a FFT of 2*Bmax points.
+   Stage outputs are added into a circular accumulator, read out when the
+   output samples are due. */
+
+/* this routine prepares one stage of the streaming convolution, for IR[o..end-1] with partitions of B samples */
+static int conv_stage_init (CONV_STAGE * st, float *IR, long o, long end, long B) {
+  long p, n, nfft = 2 * B;
+
+  st->B = B;
+  st->o = o;
+  st->P = (end - o + B - 1) / B;
+  st->cur = 0;
+  st->step = -1;
+  st->t0 = 0;
+  st->H = (float *) calloc (st->P * nfft, sizeof (float));
+  st->fdl = (float *) calloc (st->P * nfft, sizeof (float));
+  st->x = (float *) calloc (nfft, sizeof (float));
+  st->xj = (float *) calloc (nfft, sizeof (float));
+  st->Y = (float *) calloc (nfft, sizeof (float));
+  st->ip = (int *) calloc (3 + (long) sqrt (nfft / 2.0), sizeof (int));
+  st->w = (float *) calloc (nfft / 2, sizeof (float));
+  if (st->H == NULL || st->fdl == NULL || st->x == NULL || st->xj == NULL || st->Y == NULL || st->ip == NULL || st->w == NULL)
+    return 0;
+
+  /* spectra of the zero-padded partitions */
+  for (p = 0; p < st->P; p++) {
+    n = (end - o - p * B < B) ? end - o - p * B : B;
+    memcpy (&st->H[p * nfft], &IR[o + p * B], n * sizeof (float));
+    actrdft ((int) nfft, 1, &st->H[p * nfft], st->ip, st->w);
+  }
+  return 1;
+}
+
+
+/* this routine runs the steps of the pending block of a stage, up to (not including) step upto */
+/* step 0 is the forward FFT, steps 1..P the spectral products, step P+1 the inverse FFT */
+static void conv_stage_run (CONV_STAGE * st, long upto, float *acc, long A) {
+  long nfft = 2 * st->B, P = st->P, i;
+  float *X;
+
+  for (; st->step >= 0 && st->step < upto; st->step++) {
+    if (st->step == 0) {
+      X = &st->fdl[st->cur * nfft];
+      memcpy (X, st->xj, nfft * sizeof (float));
+      actrdft ((int) nfft, 1, X, st->ip, st->w);
+    } else if (st->step <= P) {
+      conv_fft_mac (st->Y, &st->fdl[((st->cur + st->step - 1) % P) * nfft], &st->H[(st->step - 1) * nfft], nfft);
+    } else {
+      /* last half of the inverse transform, due at t0+o */
+      actrdft ((int) nfft, -1, st->Y, st->ip, st->w);
+      for (i = 0; i < st->B; i++)
+        acc[(st->t0 + st->o + i) & (A - 1)] += st->Y[st->B + i];
+      st->step = -2;            /* -1 after the increment: done */
+    }
+  }
+}
+
+
+/* this routine releases the buffers of one stage */
+static void conv_stage_free (CONV_STAGE * st) {
+  free (st->H);
+  free (st->fdl);
+  free (st->x);
+  free (st->xj);
+  free (st->Y);
+  free (st->ip);
+  free (st->w);
+}
+
+
+/* this routine prepares the zero-latency streaming convolution of IR */
+CONV_STREAM *conv_stream_init (float *IR, long N, long D, long Bmax) {
+  CONV_STREAM *rvb;
+  long n, o, end, B;
+
+  if (D == 0)
+    D = CONV_STREAM_HEAD;
+  if (Bmax == 0)
+    Bmax = (CONV_STREAM_MAXBLOCK > D) ? CONV_STREAM_MAXBLOCK : D;
+  for (n = D; n > 1 && n % 2 == 0; n >>= 1);
+  if (D < 4 || n != 1 || N < 1)
+    return NULL;
+  for (n = Bmax / D; n > 1 && n % 2 == 0; n >>= 1);
+  if (Bmax % D != 0 || n != 1)
+    return NULL;
+
+  if ((rvb = (CONV_STREAM *) calloc (1, sizeof (CONV_STREAM))) == NULL)
+    return NULL;
+  rvb->N = N;
+  rvb->D = D;
+  for (rvb->A = 4; rvb->A < 4 * Bmax; rvb->A <<= 1);
+  rvb->h = (float *) calloc (D, sizeof (float));
+  rvb->hx = (float *) calloc (2 * D - 1, sizeof (float));
+  rvb->acc = (float *) calloc (rvb->A, sizeof (float));
+  if (rvb->h == NULL || rvb->hx == NULL || rvb->acc == NULL) {
+    conv_stream_free (rvb);
+    return NULL;
+  }
+  memcpy (rvb->h, IR, ((N < D) ? N : D) * sizeof (float));
+
+  /* stages of growing partition length, until the end of the response */
+  for (o = D, B = D; o < N && rvb->nstages < CONV_STREAM_MAXSTAGES; o = end, B *= 2) {
+    end = (B == Bmax) ? N : 4 * B;
+    if (end > N)
+      end = N;
+    if (!conv_stage_init (&rvb->stage[rvb->nstages++], IR, o, end, B)) {
+      conv_stream_free (rvb);
+      return NULL;
+    }
+  }
+
+  return rvb;
+}
+
+
+/* this routine convolves buffIn with the impulse response and stores the processed data into buffRvb */
+long conv_stream (CONV_STREAM * rvb, short *buffIn, short *buffRvb, float alignFact, long L) {
+  long D = rvb->D, A = rvb->A;
+  long k, j, i, n, s, nsteps;
+  CONV_STAGE *st;
+  float tmpRvb;
+  long sat_warning;
+
+  sat_warning = -1;
+  for (k = 0; k < L; k += n) {
+    /* chunks never cross a block boundary of any stage */
+    n = (L - k < D - rvb->t % D) ? L - k : D - rvb->t % D;
+
+    for (j = 0; j < n; j++)
+      rvb->hx[D - 1 + j] = buffIn[k + j];
+    for (s = 0; s < rvb->nstages; s++) {
+      st = &rvb->stage[s];
+      for (j = 0; j < n; j++)
+        st->x[st->B + rvb->t % st->B + j] = buffIn[k + j];
+    }
+    rvb->t += n;
+
+    for (s = 0; s < rvb->nstages; s++) {
+      st = &rvb->stage[s];
+      nsteps = st->P + 2;
+      if (rvb->t % st->B == 0) {
+        /* complete block: finish the previous one, and start this one */
+        conv_stage_run (st, nsteps, rvb->acc, A);
+        st->cur = (st->cur + st->P - 1) % st->P;
+        memcpy (st->xj, st->x, 2 * st->B * sizeof (float));
+        memcpy (st->x, &st->x[st->B], st->B * sizeof (float));
+        memset (st->Y, 0, 2 * st->B * sizeof (float));
+        st->t0 = rvb->t - st->B;
+        st->step = 0;
+        if (s == 0)             /* stage 0 is due at once */
+          conv_stage_run (st, nsteps, rvb->acc, A);
+      } else if (st->step >= 0) {
+        /* steps in proportion to the samples received since the block was complete */
+        conv_stage_run (st, (nsteps * (rvb->t - st->t0 - st->B) + st->B - 1) / st->B, rvb->acc, A);
+      }
+    }
+
+    /* direct-form head plus the stages' contributions */
+    for (j = 0; j < n; j++) {
+      tmpRvb = rvb->acc[(rvb->t - n + j) & (A - 1)];
+      rvb->acc[(rvb->t - n + j) & (A - 1)] = 0;
+      for (i = 0; i < D; i++)
+        tmpRvb += rvb->h[i] * rvb->hx[D - 1 + j - i];
+      tmpRvb = (float) (alignFact * tmpRvb + 0.5);    /* +0.5 : rounding for the 'short' truncation */
+
+      /* perform 16 bit saturation */
+      if (tmpRvb < -32768.0) {
+        buffRvb[k + j] = -32768;
+        sat_warning = k + j;
+      } else {
+        if (tmpRvb > 32767.0) {
+          buffRvb[k + j] = 32767;
+          sat_warning = k + j;
+        } else {
+          buffRvb[k + j] = (short) tmpRvb;
+        }
+      }
+    }
+    memmove (rvb->hx, &rvb->hx[n], (D - 1) * sizeof (float));
+  }
+  return sat_warning;
+}
+
+
+/* this routine releases the streaming convolution */
+void conv_stream_free (CONV_STREAM * rvb) {
+  long s;
+
+  for (s = 0; s < rvb->nstages; s++)
+    conv_stage_free (&rvb->stage[s]);
+  free (rvb->h);
+  free (rvb->hx);
+  free (rvb->acc);
+  free (rvb);
+}
@@ -28,10 +28,22 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_ir_init(...)	:		Prepares an impulse response for the partitioned FFT convolution
+		conv_ir_free(...)	:		Releases a prepared impulse response
+		conv_fft_open(...)	:		Prepares a partitioned FFT convolution with a shared impulse response
+		conv_fft_init(...)	:		Prepares the partitioned FFT convolution of an impulse response
+		conv_fft(...)	:		Same as conv(), with the partitioned FFT convolution
+		conv_fft_free(...)	:		Releases the partitioned FFT convolution
+		conv_stream_init(...)	:	Prepares the zero-latency streaming convolution
+		conv_stream(...)	:		Same as conv_fft(), with bounded work per call
+		conv_stream_free(...)	:	Releases the streaming convolution
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
 	10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+	16.Oct.26   v1.02   Added uniformly partitioned FFT convolution (conv_fft)
+	16.Oct.26   v1.03   Added non-uniform partitioned streaming convolution (conv_stream)
+	16.Oct.26   v1.04   Impulse response spectra in a shareable object (CONV_IR)
 
 
   AUTHORS :
@@ -40,6 +52,84 @@
 */
 
 
+/* default partition length of the FFT convolution (power of 2) */
+#define CONV_FFT_BLOCK 1024
+
+/* impulse response prepared for the partitioned FFT convolution: P
+   partitions of B samples and their spectra. conv_fft() only reads it, so
+   that one object may be shared by several convolutions running at the
+   same time (e.g. one per file or channel, in different threads) */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long B;                       /* partition length, power of 2 */
+  long P;                       /* number of partitions */
+  float *H;                     /* spectra of the partitions, P x 2B */
+  int *ip;                      /* FFT bit-reversal table, copied by each convolution */
+  float *w;                     /* FFT cos/sin table */
+} CONV_IR;
+
+/* state of the uniformly partitioned overlap-save convolution: the spectra
+   of the last P input blocks are kept in a frequency-domain delay line (FDL) */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long B;                       /* partition length, power of 2 */
+  long P;                       /* number of partitions */
+  long fill;                    /* input samples in the current block */
+  long cur;                     /* FDL slot of the current block */
+  CONV_IR *ir;                  /* impulse response, read only */
+  int own_ir;                   /* ir was allocated by conv_fft_init() */
+  float *fdl;                   /* spectra of the last P input blocks, P x 2B */
+  float *tail;                  /* sum of the past blocks' contributions, 2B */
+  float *x;                     /* previous and current input block, 2B */
+  float *Y;                     /* work buffer, 2B */
+  int *ip;                      /* FFT bit-reversal table (actrdft() writes into it) */
+} CONV_FFT;
+
+
+/* defaults of the streaming convolution: length of the direct-form head,
+   which is also the smallest partition, and the largest partition */
+#define CONV_STREAM_HEAD 64
+#define CONV_STREAM_MAXBLOCK 4096
+
+/* maximum number of partition sizes of the streaming convolution */
+#define CONV_STREAM_MAXSTAGES 24
+
+/* one partition size of the streaming convolution: the impulse response
+   samples [o, o+P*B) are convolved by uniformly partitioned overlap-save
+   with blocks of B samples; the work for an input block is done in steps,
+   spread over the following block */
+typedef struct {
+  long B;                       /* partition length, power of 2 */
+  long P;                       /* number of partitions */
+  long o;                       /* offset of the first partition in the response */
+  long cur;                     /* FDL slot of the newest block */
+  long step;                    /* next step of the pending block, -1 if none */
+  long t0;                      /* time of the first sample of the pending block */
+  float *H;                     /* spectra of the partitions, P x 2B */
+  float *fdl;                   /* spectra of the last P input blocks, P x 2B */
+  float *x;                     /* previous and current input block, 2B */
+  float *xj;                    /* copy of x for the pending block, 2B */
+  float *Y;                     /* output spectrum of the pending block, 2B */
+  int *ip;                      /* FFT bit-reversal table */
+  float *w;                     /* FFT cos/sin table */
+} CONV_STAGE;
+
+/* state of the zero-latency streaming convolution: the first D samples of the
+   impulse response are convolved in direct form, the following ones by
+   stages of increasing partition length (non-uniform partitioning) */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long D;                       /* length of the direct-form head */
+  long nstages;                 /* number of partition sizes */
+  long t;                       /* number of samples processed */
+  long A;                       /* length of the output accumulator, power of 2 */
+  float *h;                     /* head of the impulse response, D */
+  float *hx;                    /* D-1 past samples followed by up to D new ones */
+  float *acc;                   /* contributions of the stages to the next outputs */
+  CONV_STAGE stage[CONV_STREAM_MAXSTAGES];
+} CONV_STREAM;
+
+
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
 void shift (short *buff, long N);
 
@@ -54,3 +144,70 @@ long conv (float *IR,           /* impulse response buffer */
            long N,              /* length of the impulse response */
            long L               /* length of the input buffer to process */
   );
+
+
+/* previous version of conv(), without saturation; kept for comparison */
+void conv_old (float *IR, short *buffIn, short *buffRvb, float alignFact, long N, long L);
+
+
+/* this routine prepares IR for the partitioned FFT convolution, with partitions of B samples */
+/* B must be a power of 2 (0 for the default, CONV_FFT_BLOCK or less for short responses) */
+/* the output is NULL if B is invalid or there is not enough memory */
+CONV_IR *conv_ir_init (float *IR,       /* impulse response buffer */
+                       long N,          /* length of the impulse response */
+                       long B           /* partition length */
+  );
+
+/* this routine releases a prepared impulse response, once no convolution uses it */
+void conv_ir_free (CONV_IR * ir);
+
+/* this routine prepares a partitioned FFT convolution with the prepared impulse response ir */
+/* ir is only read, and must be kept until conv_fft_free(); the output is NULL if there is not enough memory */
+CONV_FFT *conv_fft_open (CONV_IR * ir);
+
+/* this routine prepares the partitioned FFT convolution of IR, with partitions of B samples */
+/* same as conv_ir_init() and conv_fft_open(), the prepared response being released by conv_fft_free() */
+/* B must be a power of 2 (0 for the default, CONV_FFT_BLOCK or less for short responses) */
+/* the output is NULL if B is invalid or there is not enough memory */
+CONV_FFT *conv_fft_init (float *IR,     /* impulse response buffer */
+                         long N,        /* length of the impulse response */
+                         long B         /* partition length */
+  );
+
+/* this routine convolves buffIn with the impulse response and stores the processed data into buffRvb */
+/* unlike conv(), buffIn only holds the L new samples: the past ones are kept in the state */
+/* rounding, saturation and the return value are the same as for conv() */
+long conv_fft (CONV_FFT * rvb,  /* state of the FFT convolution */
+               short *buffIn,   /* input buffer */
+               short *buffRvb,  /* reverberated data */
+               float alignFact, /* energy alignment factor */
+               long L           /* length of the input buffer to process */
+  );
+
+/* this routine releases the partitioned FFT convolution */
+void conv_fft_free (CONV_FFT * rvb);
+
+
+/* this routine prepares the zero-latency streaming convolution of IR */
+/* D is the length of the direct-form head and of the smallest partition, Bmax the largest partition, */
+/* both powers of 2 (0 for the defaults, CONV_STREAM_HEAD and CONV_STREAM_MAXBLOCK) */
+/* the output is NULL if D or Bmax is invalid or there is not enough memory */
+CONV_STREAM *conv_stream_init (float *IR,       /* impulse response buffer */
+                               long N,  /* length of the impulse response */
+                               long D,  /* length of the direct-form head */
+                               long Bmax        /* largest partition length */
+  );
+
+/* this routine convolves buffIn with the impulse response and stores the processed data into buffRvb */
+/* the output of each input sample is available in the same call (no delay), and the work per call is */
+/* about proportional to L: the largest single piece of work is one FFT of 2*Bmax points */
+/* rounding, saturation and the return value are the same as for conv() */
+long conv_stream (CONV_STREAM * rvb,    /* state of the streaming convolution */
+                  short *buffIn,        /* input buffer */
+                  short *buffRvb,       /* reverberated data */
+                  float alignFact,      /* energy alignment factor */
+                  long L        /* length of the input buffer to process */
+  );
+
+/* this routine releases the streaming convolution */
+void conv_stream_free (CONV_STREAM * rvb);
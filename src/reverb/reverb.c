@@ -1,4 +1,4 @@
-/*                                                         02/Feb/2010 v1.02 */
+/*                                                         16/Oct/2026 v1.05 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -26,6 +26,9 @@
 	02.Feb.05	v1.0	First Beta version
 	10.Jul.08 v1.01 Added 16 bit saturation and saturation warning
 	02.Feb.10 v1.02 Modified maximum string length to avoid buffer overrun
+	16.Oct.26 v1.03 Added options -fft and -part for the partitioned FFT convolution
+	16.Oct.26 v1.04 Added option -stream for the zero-latency streaming convolution
+	16.Oct.26 v1.05 Added option -jobs for the batch processing of a file list
 
   AUTHORS :
 	v1.0  Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -42,8 +45,12 @@
 
 #include "reverb-lib.h"
 
+#ifdef REVERB_THREADS
+#include <pthread.h>
+#endif
+
 static void display_usage () {
-  printf ("REVERB.C - Version 1.02 of 02.Feb.2010 \n\n");
+  printf ("REVERB.C - Version 1.05 of 16.Oct.2026 \n\n");
 
   printf (" Program to add reverberation to a signal\n");
   printf (" This program convolves a signal with the impulse response of a room\n");
@@ -53,24 +60,259 @@ static void display_usage () {
   printf ("\n");
   printf (" Usage:\n");
   printf (" $ reverb   [-options] FileIn FileIR FileOut\n");
+  printf (" $ reverb   -jobs N [-options] FileList FileIR\n");
   printf (" where:\n");
   printf ("  FileIn       is the file to be processed;\n");
   printf ("  FileIR       is the file containing the impulse response;\n");
   printf ("  FileOut      is the file with the processed data;\n");
+  printf ("  FileList     is a text file with one \"FileIn FileOut [FileIR]\" line per file\n");
+  printf ("               to process (FileIR by default);\n");
   printf ("\n");
   printf (" Options:\n");
   printf ("  -align A...... multiplicative factor to apply to the reverberated sound\n");
   printf ("				   in order to align its energy level with a second file\n");
+  printf ("  -fft.......... use the uniformly partitioned FFT convolution (much faster\n");
+  printf ("				   for long impulse responses; differs by float rounding)\n");
+  printf ("  -part B....... partition length of the FFT convolution, a power of 2\n");
+  printf ("				   (default: %d, or less for short impulse responses)\n", CONV_FFT_BLOCK);
+  printf ("  -stream L..... process blocks of L samples with the zero-latency streaming\n");
+  printf ("				   convolution (direct-form head of %d samples, then FFT\n", CONV_STREAM_HEAD);
+  printf ("				   partitions of up to %d samples), as for live signals;\n", CONV_STREAM_MAXBLOCK);
+  printf ("				   not with -fft or -part\n");
+  printf ("  -jobs N....... process the files of FileList with the FFT convolution,\n");
+  printf ("				   N at a time; each impulse response is loaded and\n");
+  printf ("				   transformed once, and shared by the N threads\n");
+#ifndef REVERB_THREADS
+  printf ("				   (this build has no threads: one file at a time)\n");
+#endif
   printf ("\n");
 }
 
 #define tmpIRlength	512
 
+/* one file of the batch mode */
+typedef struct {
+  char FileIn[MAX_STRLEN];
+  char FileOut[MAX_STRLEN];
+  CONV_IR *ir;                  /* shared impulse response */
+  long count;                   /* samples processed; -1: file not opened, -2: not enough memory */
+  long sat_pos;                 /* position of the last saturation, -1 if none */
+} RVB_JOB;
+
+/* list of files of the batch mode, shared by the threads */
+typedef struct {
+  RVB_JOB *job;
+  long njobs;
+  long next;                    /* next file to process */
+  float alignFact;
+#ifdef REVERB_THREADS
+  pthread_mutex_t lock;         /* protects next */
+#endif
+} RVB_BATCH;
+
+
+/* this routine loads an impulse response file; the output is NULL if it cannot be opened
+   (*N is then -1), if it holds no sample (*N is then 0) or if there is not enough memory for it */
+static float *load_ir (char *FileIR, long *N) {
+  FILE *ptr_fileIR;
+  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  float *IR;
+
+  ptr_fileIR = fopen (FileIR, "rb");
+  if (ptr_fileIR == NULL) {
+    *N = -1;
+    return NULL;
+  }
+  /* determine the length of the impulse response */
+  *N = 0;
+  while (!feof (ptr_fileIR)) {
+    *N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
+  }
+  if (*N == 0) {
+    fclose (ptr_fileIR);
+    return NULL;
+  }
+  /* allocate memory for the impulse response buffer */
+  IR = (float *) calloc (*N, sizeof (float));
+  rewind (ptr_fileIR);
+  /* read the impulse response */
+  if (IR != NULL)
+    *N = (long) fread (IR, sizeof (float), *N, ptr_fileIR);
+  /* close file */
+  fclose (ptr_fileIR);
+  return IR;
+}
+
+
+/* this routine reverberates one file of the batch mode, with its own convolution state */
+static void reverb_job (RVB_JOB * job, float alignFact) {
+  FILE *ptr_fileIn, *ptr_fileOut;
+  CONV_FFT *rvb;
+  short *buffIn, *buffRvb;
+  long B = job->ir->B, count, pos;
+
+  job->count = -1;
+  job->sat_pos = -1;
+  if ((ptr_fileIn = fopen (job->FileIn, "rb")) == NULL)
+    return;
+  if ((ptr_fileOut = fopen (job->FileOut, "wb")) == NULL) {
+    fclose (ptr_fileIn);
+    return;
+  }
+  rvb = conv_fft_open (job->ir);
+  buffIn = (short *) malloc (B * sizeof (short));
+  buffRvb = (short *) malloc (B * sizeof (short));
+  if (rvb == NULL || buffIn == NULL || buffRvb == NULL)
+    job->count = -2;
+  else {
+    job->count = 0;
+    while ((count = (long) fread (buffIn, sizeof (short), B, ptr_fileIn)) > 0) {
+      if ((pos = conv_fft (rvb, buffIn, buffRvb, alignFact, count)) >= 0)
+        job->sat_pos = job->count + pos;
+      job->count += count;
+      fwrite (buffRvb, sizeof (short), count, ptr_fileOut);
+    }
+  }
+  if (rvb != NULL)
+    conv_fft_free (rvb);
+  free (buffIn);
+  free (buffRvb);
+  fclose (ptr_fileIn);
+  fclose (ptr_fileOut);
+}
+
+
+/* this routine processes the files of the batch one after the other, until none is left */
+static void *reverb_worker (void *arg) {
+  RVB_BATCH *batch = (RVB_BATCH *) arg;
+  long j;
+
+  for (;;) {
+#ifdef REVERB_THREADS
+    pthread_mutex_lock (&batch->lock);
+#endif
+    j = batch->next++;
+#ifdef REVERB_THREADS
+    pthread_mutex_unlock (&batch->lock);
+#endif
+    if (j >= batch->njobs)
+      return NULL;
+    reverb_job (&batch->job[j], batch->alignFact);
+  }
+}
+
+
+/* this routine reverberates the files of FileList with the FFT convolution, using up to "jobs" threads */
+/* the impulse responses are loaded and transformed once, before the threads start, and only read by them */
+/* the output is the number of files that could not be processed, or -1 if the list is invalid */
+static long reverb_batch (char *FileList, char *FileIR, long part, float alignFact, long jobs) {
+  FILE *ptr_list;
+  char line[3 * MAX_STRLEN], name[MAX_STRLEN];
+  char (*irname)[MAX_STRLEN] = NULL;
+  CONV_IR **ir = NULL;
+  RVB_BATCH batch;
+  float *IR;
+  long N, nir = 0, j, n, failed = 0;
+#ifdef REVERB_THREADS
+  pthread_t *thread;
+  long nthreads = 0;
+#endif
+
+  if ((ptr_list = fopen (FileList, "r")) == NULL) {
+    fprintf (stderr, "\nUnable to open file list %s\n", FileList);
+    return -1;
+  }
+  batch.job = NULL;
+  batch.njobs = 0;
+  batch.next = 0;
+  batch.alignFact = alignFact;
+
+  /* read the list; a given impulse response is only loaded once */
+  while (fgets (line, sizeof (line), ptr_list) != NULL) {
+    strcpy (name, FileIR);
+    if ((batch.job = (RVB_JOB *) realloc (batch.job, (batch.njobs + 1) * sizeof (RVB_JOB))) == NULL) {
+      fprintf (stderr, "\nUnable to allocate enough memory\n");
+      exit (-1);
+    }
+    n = sscanf (line, "%1023s %1023s %1023s", batch.job[batch.njobs].FileIn, batch.job[batch.njobs].FileOut, name);
+    if (n <= 0)
+      continue;                 /* empty line */
+    if (n == 1) {
+      fprintf (stderr, "\nNo output file for %s in %s\n", batch.job[batch.njobs].FileIn, FileList);
+      fclose (ptr_list);
+      return -1;
+    }
+    for (j = 0; j < nir && strcmp (irname[j], name) != 0; j++);
+    if (j == nir) {
+      irname = (char (*)[MAX_STRLEN]) realloc (irname, (nir + 1) * sizeof (*irname));
+      ir = (CONV_IR **) realloc (ir, (nir + 1) * sizeof (CONV_IR *));
+      if (irname == NULL || ir == NULL) {
+        fprintf (stderr, "\nUnable to allocate enough memory\n");
+        exit (-1);
+      }
+      if ((IR = load_ir (name, &N)) == NULL) {
+        if (N < 0)
+          fprintf (stderr, "\nUnable to open impulse response file %s\n", name);
+        else if (N == 0)
+          fprintf (stderr, "\nEmpty or invalid impulse response file %s\n", name);
+        else
+          fprintf (stderr, "\nUnable to allocate enough memory\n");
+        exit (-1);
+      }
+      if ((ir[nir] = conv_ir_init (IR, N, part)) == NULL) {
+        fprintf (stderr, "\nInvalid partition length or not enough memory for the FFT convolution\n");
+        exit (-1);
+      }
+      free (IR);
+      strcpy (irname[nir++], name);
+    }
+    batch.job[batch.njobs++].ir = ir[j];
+  }
+  fclose (ptr_list);
+
+  /* process the files */
+#ifdef REVERB_THREADS
+  if (jobs > batch.njobs)
+    jobs = batch.njobs;
+  pthread_mutex_init (&batch.lock, NULL);
+  if ((thread = (pthread_t *) malloc (jobs * sizeof (pthread_t))) != NULL)
+    for (; nthreads < jobs - 1; nthreads++)
+      if (pthread_create (&thread[nthreads], NULL, reverb_worker, &batch) != 0)
+        break;
+  reverb_worker (&batch);       /* the main thread is one of the workers */
+  for (j = 0; j < nthreads; j++)
+    pthread_join (thread[j], NULL);
+  free (thread);
+  pthread_mutex_destroy (&batch.lock);
+#else
+  reverb_worker (&batch);
+#endif
+
+  /* report in the order of the list */
+  for (j = 0; j < batch.njobs; j++) {
+    if (batch.job[j].count == -1) {
+      fprintf (stderr, "\nUnable to open file %s or %s\n", batch.job[j].FileIn, batch.job[j].FileOut);
+      failed++;
+    } else if (batch.job[j].count == -2) {
+      fprintf (stderr, "\nUnable to allocate enough memory for %s\n", batch.job[j].FileIn);
+      failed++;
+    } else if (batch.job[j].sat_pos >= 0)
+      fprintf (stderr, "\nWarning warning!! Saturation(s) in output file %s.  In  sample %ld\n", batch.job[j].FileOut, batch.job[j].sat_pos);
+  }
+
+  for (j = 0; j < nir; j++)
+    conv_ir_free (ir[j]);
+  free (ir);
+  free (irname);
+  free (batch.job);
+  return failed;
+}
+
+
 int main (int argc, char *argv[]) {
   /* File variables */
   FILE *ptr_fileIn;
   FILE *ptr_fileOut;
-  FILE *ptr_fileIR;
   char FileIn[MAX_STRLEN];
   char FileIR[MAX_STRLEN];
   char FileOut[MAX_STRLEN];
@@ -79,13 +321,19 @@ int main (int argc, char *argv[]) {
   float *IR;                    /* buffer for the impulse response */
   short *buffRvb;               /* buffer for the reverberated Sound */
   short *buffIn;                /* buffer for the input sound file */
-  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
 
   /* Algorithm variables */
   float alignFact = 1.0;        /* multiplicative factor for the reverberated sound (energy alignment with another file to compare) */
   long N;                       /* length of the impulse response */
   long count, global_count;
   long local_sat_pos;
+  int use_fft = 0;              /* partitioned FFT convolution instead of conv() */
+  long part = 0;                /* partition length, 0 for the default */
+  CONV_FFT *rvb = NULL;         /* state of the FFT convolution */
+  long stream = 0;              /* block length of the streaming convolution, 0 if not used */
+  CONV_STREAM *rvbs = NULL;     /* state of the streaming convolution */
+  long k, n, pos;
+  long jobs = 0;                /* number of threads of the batch mode, 0 if not used */
 
   global_count = 0;
   local_sat_pos = -1;           /* local position of last saturation */
@@ -102,6 +350,43 @@ int main (int argc, char *argv[]) {
         /* Set the energy alignment factor */
         alignFact = (float) atof (argv[2]);
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* Use the partitioned FFT convolution */
+        use_fft = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-part") == 0) {
+        /* Set the partition length of the FFT convolution */
+        part = atol (argv[2]);
+        use_fft = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-stream") == 0) {
+        /* Use the streaming convolution with blocks of L samples */
+        stream = atol (argv[2]);
+        if (stream < 1) {
+          fprintf (stderr, "ERROR! Invalid block length %ld for -stream\n\n", stream);
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Process a list of files, with N threads */
+        jobs = atol (argv[2]);
+        if (jobs < 1) {
+          fprintf (stderr, "ERROR! Invalid number of jobs %ld\n\n", jobs);
+          exit (-1);
+        }
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -116,6 +401,24 @@ int main (int argc, char *argv[]) {
       }
   }
 
+  /* The streaming convolution has its own FFT partitions */
+  if (stream && use_fft) {
+    fprintf (stderr, "ERROR! Options -stream and -fft (or -part) cannot be used together\n\n");
+    display_usage ();
+    exit (-1);
+  }
+
+  /* Batch mode: FileList FileIR */
+  if (jobs) {
+    if (stream) {
+      fprintf (stderr, "ERROR! Options -jobs and -stream cannot be used together\n\n");
+      exit (-1);
+    }
+    GET_PAR_S (1, "_File List: ................... ", FileIn);
+    GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR);
+    return (reverb_batch (FileIn, FileIR, part, alignFact, jobs) == 0) ? 0 : 1;
+  }
+
   /* Read parameters for processing */
   GET_PAR_S (1, "_Input File: .................. ", FileIn);
   GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR);
@@ -130,23 +433,15 @@ int main (int argc, char *argv[]) {
   /* ......... PREPARING FILES ......... */
 
   /* Load the Impulse Response */
-  ptr_fileIR = fopen (FileIR, "rb");
-  if (ptr_fileIR == NULL) {
-    fprintf (stderr, "\nUnable to open Input file\n");
+  if ((IR = load_ir (FileIR, &N)) == NULL) {
+    if (N < 0)
+      fprintf (stderr, "\nUnable to open Input file\n");
+    else if (N == 0)
+      fprintf (stderr, "\nEmpty or invalid impulse response file\n");
+    else
+      fprintf (stderr, "\nUnable to allocate enough memory\n");
     exit (-1);
   }
-  /* determine the length of the impulse response */
-  N = 0;
-  while (!feof (ptr_fileIR)) {
-    N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
-  }
-  /* allocate memory for the impulse response buffer */
-  IR = (float *) calloc (N, sizeof (float));
-  rewind (ptr_fileIR);
-  /* read the impulse response */
-  fread (IR, sizeof (float), N, ptr_fileIR);
-  /* close file */
-  fclose (ptr_fileIR);
 
   /* open the input file */
   ptr_fileIn = fopen (FileIn, "rb");
@@ -171,6 +466,18 @@ int main (int argc, char *argv[]) {
     exit (-1);
   }
 
+  /* prepare the partitioned FFT convolution */
+  if (use_fft && (rvb = conv_fft_init (IR, N, part)) == NULL) {
+    fprintf (stderr, "\nInvalid partition length or not enough memory for the FFT convolution\n");
+    exit (-1);
+  }
+
+  /* prepare the streaming convolution */
+  if (stream && (rvbs = conv_stream_init (IR, N, 0, 0)) == NULL) {
+    fprintf (stderr, "\nNot enough memory for the streaming convolution\n");
+    exit (-1);
+  }
+
 
 
 
@@ -181,7 +488,18 @@ int main (int argc, char *argv[]) {
   while (!feof (ptr_fileIn)) {
     count = (long) fread (buffIn + N - 1, sizeof (short), N, ptr_fileIn);       /* read a block of the input file */
 
-    local_sat_pos = conv (IR, buffIn, buffRvb, alignFact, N, count);    /* convolves a block of the input file with the impulse response */
+    if (stream) {
+      /* blocks of "stream" samples, as they would come from a live signal */
+      local_sat_pos = -1;
+      for (k = 0; k < count; k += n) {
+        n = (count - k < stream) ? count - k : stream;
+        if ((pos = conv_stream (rvbs, buffIn + N - 1 + k, buffRvb + k, alignFact, n)) >= 0)
+          local_sat_pos = k + pos;
+      }
+    } else if (use_fft)
+      local_sat_pos = conv_fft (rvb, buffIn + N - 1, buffRvb, alignFact, count);       /* same, the past samples are kept in rvb */
+    else
+      local_sat_pos = conv (IR, buffIn, buffRvb, alignFact, N, count);  /* convolves a block of the input file with the impulse response */
     if (local_sat_pos >= 0) {
       fprintf (stderr, "\nWarning warning!! Saturation(s) in output file.  In  sample %ld\n", local_sat_pos + global_count);
     }
@@ -200,6 +518,10 @@ int main (int argc, char *argv[]) {
   free (buffIn);
   free (buffRvb);
   free (IR);
+  if (rvb != NULL)
+    conv_fft_free (rvb);
+  if (rvbs != NULL)
+    conv_stream_free (rvbs);
   /* close the opened files */
   fclose (ptr_fileIn);
   fclose (ptr_fileOut);
@@ -0,0 +1,250 @@
+/*                                                         16/Oct/2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a benchmark of the convolution routines in reverb-lib.h:
+	conv_old(), conv() and conv_fft() process the same file in the blocks used
+	by reverb.c, and conv_stream() in blocks of L samples, as for a live signal.
+	The processing times, the longest conv_stream() call and the largest
+	differences of the outputs with respect to conv() are reported.
+
+  HISTORY :
+	16.Oct.26 v1.0 First version
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* UGST modules */
+#include "ugstdemo.h"
+
+#include "reverb-lib.h"
+
+static void display_usage () {
+  printf ("RVBBENCH.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Program to time the convolution routines of the reverberation tool\n");
+
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ rvbbench [-options] FileIn FileIR\n");
+  printf (" where:\n");
+  printf ("  FileIn       is the file to be processed (16 bit samples);\n");
+  printf ("  FileIR       is the file containing the impulse response;\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -n R.......... process the file R times [default: 1]\n");
+  printf ("  -part B....... partition length of the FFT convolution [default: see reverb]\n");
+  printf ("  -fs F......... sampling rate, to report the real-time factor [default: 32000]\n");
+  printf ("  -noold........ do not time conv_old() (as slow as conv())\n");
+  printf ("  -stream L..... block length for conv_stream() [default: 64]\n");
+  printf ("\n");
+}
+
+
+/* this routine reads a whole file into memory; the output is the number of items read */
+static long load_file (char *name, size_t size, void **buf) {
+  FILE *fp;
+  long n;
+
+  if ((fp = fopen (name, "rb")) == NULL) {
+    fprintf (stderr, "\nUnable to open file %s\n", name);
+    exit (-1);
+  }
+  fseek (fp, 0L, SEEK_END);
+  n = ftell (fp) / (long) size;
+  rewind (fp);
+  if ((*buf = malloc (n * size + 1)) == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+  n = (long) fread (*buf, size, n, fp);
+  fclose (fp);
+  return n;
+}
+
+
+int main (int argc, char *argv[]) {
+  char FileIn[MAX_STRLEN];
+  char FileIR[MAX_STRLEN];
+  float *IR;                    /* impulse response */
+  short *in;                    /* input file */
+  short *out[4];                /* output of conv_old(), conv(), conv_fft() and conv_stream() */
+  short *buffIn;                /* input block with N-1 past samples, as in reverb.c */
+  long N, len, k, j, count, r, part = 0, reps = 1, stream = 64, maxdiff, ndiff;
+  double fs = 32000, t[4], tcall, tmax = 0;
+  int skip_old = 0, m;
+  clock_t t0, t1;
+  CONV_FFT *rvb;
+  CONV_STREAM *rvbs;
+  static char *name[4] = { "conv_old", "conv", "conv_fft", "conv_stream" };
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  if (argc < 3) {
+    display_usage ();
+    exit (2);
+  }
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-n") == 0) {
+      reps = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-part") == 0) {
+      part = atol (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-fs") == 0) {
+      fs = atof (argv[2]);
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-stream") == 0) {
+      stream = atol (argv[2]);
+      if (stream < 1) {
+        fprintf (stderr, "ERROR! Invalid block length %ld for -stream\n\n", stream);
+        exit (-1);
+      }
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-noold") == 0) {
+      skip_old = 1;
+      argc--;
+      argv++;
+    } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+      display_usage ();
+      exit (2);
+    } else {
+      fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+      display_usage ();
+      exit (-1);
+    }
+
+  GET_PAR_S (1, "_Input File: .................. ", FileIn);
+  GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR);
+
+
+  /* ......... LOAD FILES ......... */
+
+  len = load_file (FileIn, sizeof (short), (void **) &in);
+  N = load_file (FileIR, sizeof (float), (void **) &IR);
+  if (len < 1 || N < 1) {
+    fprintf (stderr, "\nEmpty input or impulse response file\n");
+    exit (-1);
+  }
+  buffIn = (short *) calloc (2 * N - 1, sizeof (short));
+  for (m = 0; m < 4; m++)
+    out[m] = (short *) calloc (len, sizeof (short));
+  if (buffIn == NULL || out[0] == NULL || out[1] == NULL || out[2] == NULL || out[3] == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory\n");
+    exit (-1);
+  }
+  if ((rvb = conv_fft_init (IR, N, part)) == NULL) {
+    fprintf (stderr, "\nInvalid partition length or not enough memory for the FFT convolution\n");
+    exit (-1);
+  }
+  if ((rvbs = conv_stream_init (IR, N, 0, 0)) == NULL) {
+    fprintf (stderr, "\nNot enough memory for the streaming convolution\n");
+    exit (-1);
+  }
+
+
+  /* ......... TIMING ......... */
+
+  for (m = 0; m < 3; m++) {
+    t[m] = 0;
+    if (m == 0 && skip_old)
+      continue;
+    t0 = clock ();
+    for (r = 0; r < reps; r++) {
+      memset (buffIn, 0, (2 * N - 1) * sizeof (short));
+      if (m == 2) {
+        conv_fft_free (rvb);
+        rvb = conv_fft_init (IR, N, part);
+      }
+      for (k = 0; k < len; k += count) {
+        count = (len - k < N) ? len - k : N;
+        memcpy (buffIn + N - 1, &in[k], count * sizeof (short));
+        if (m == 0)
+          conv_old (IR, buffIn, &out[0][k], 1.0, N, count);
+        else if (m == 1)
+          conv (IR, buffIn, &out[1][k], 1.0, N, count);
+        else
+          conv_fft (rvb, buffIn + N - 1, &out[2][k], 1.0, count);
+        shift (buffIn, N);
+      }
+    }
+    t[m] = (double) (clock () - t0) / CLOCKS_PER_SEC;
+  }
+
+  /* streaming convolution, timing each call */
+  t[3] = 0;
+  for (r = 0; r < reps; r++) {
+    conv_stream_free (rvbs);
+    rvbs = conv_stream_init (IR, N, 0, 0);
+    for (k = 0; k < len; k += stream) {
+      t0 = clock ();
+      conv_stream (rvbs, &in[k], &out[3][k], 1.0, (len - k < stream) ? len - k : stream);
+      t1 = clock ();
+      tcall = (double) (t1 - t0) / CLOCKS_PER_SEC;
+      t[3] += tcall;
+      if (tcall > tmax)
+        tmax = tcall;
+    }
+  }
+
+
+  /* ......... REPORT ......... */
+
+  printf ("Impulse response: %ld samples; input: %ld samples x %ld\n", N, len, reps);
+  printf ("FFT convolution: %ld partitions of %ld samples\n", rvb->P, rvb->B);
+  printf ("Streaming convolution: head of %ld samples,", rvbs->D);
+  for (j = 0; j < rvbs->nstages; j++)
+    printf (" %ldx%ld", rvbs->stage[j].P, rvbs->stage[j].B);
+  printf ("; blocks of %ld samples\n", stream);
+  for (m = 0; m < 4; m++)
+    if (m > 0 || !skip_old)
+      printf ("%-11s %9.3f s  %8.2f x real time at %.0f Hz  speed-up %7.1f\n", name[m], t[m], (t[m] > 0) ? len * reps / fs / t[m] : 0, fs, (t[m] > 0) ? t[1] / t[m] : 0);
+  printf ("conv_stream: longest call %.3f ms, for blocks of %.3f ms\n", tmax * 1000, stream * 1000 / fs);
+
+  /* differences with respect to conv() */
+  for (m = 2; m < 4; m++) {
+    for (maxdiff = ndiff = k = 0; k < len; k++)
+      if (out[m][k] != out[1][k]) {
+        ndiff++;
+        if (labs ((long) out[m][k] - out[1][k]) > maxdiff)
+          maxdiff = labs ((long) out[m][k] - out[1][k]);
+      }
+    printf ("%s vs conv: %ld samples differ, by at most %ld\n", name[m], ndiff, maxdiff);
+  }
+
+  conv_fft_free (rvb);
+  conv_stream_free (rvbs);
+  free (buffIn);
+  for (m = 0; m < 4; m++)
+    free (out[m]);
+  free (in);
+  free (IR);
+  return (0);
+}
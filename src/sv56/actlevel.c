@@ -1,4 +1,4 @@
-/*                                                              V2.4 10.Jun.98
+/*                                                              V2.5 16.Oct.26
   ============================================================================
 
   ACTLEVEL.C
@@ -63,6 +63,13 @@
   -log file .. print the statistics log into file rather than stdout
   -q ......... quiet operation; don't print progress flag, results are
                printed all in one line.
+  -jobs n .... measure up to `n' files at the same time, each in its own
+               thread [default: 1]; the results are still reported in
+               the order of the command line.
+  -csv file .. also write the statistics of all files into `file', one
+               comma-separated line per input file (with a header line)
+  -json file . also write the statistics of all files into `file', as a
+               JSON array with one object per input file
 
 
   Modules used:
@@ -125,6 +132,10 @@
                            characters and changing strcpy() to
                            strncpy() in the filename copy process.
                            <simao>
+  16.Oct.26     2.5        Added option -jobs to measure several files
+                           concurrently (results reported in the order of
+                           the command line), and options -csv and -json
+                           for machine-readable reports.
   ============================================================================
 */
 
@@ -134,6 +145,7 @@
 /* ... Includes in general ... */
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <string.h>             /* for strstr() */
 #include <math.h>
 
@@ -150,6 +162,10 @@
 #include <sys/stat.h>
 #endif
 
+#ifdef ACTLEV_THREADS
+#include <pthread.h>
+#endif
+
 /* ... Include of speech-voltmeter-related routines ... */
 #include "sv-p56.h"
 
@@ -159,6 +175,29 @@
 /* ... Local definitions ... */
 #define DEF_BLK_LEN 256         /* samples per block */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define ACT_WINDOW 1024         /* files measured before reporting */
+
+/* ... Local types ... */
+typedef struct {
+  char *file;                   /* input file name */
+  SVP56_state state;            /* P.56 state after the file */
+  double ActiveLeveldB;         /* active level of the file */
+  long N2;                      /* number of blocks measured */
+  int err;                      /* exit value in case of error, or 0 */
+  int errnum;                   /* errno of the error, for perror() */
+} ACT_JOB;
+
+typedef struct {
+  ACT_JOB *job;                 /* files to be measured */
+  long njobs;                   /* number of files */
+  long next;                    /* next file to be measured */
+  long N, N2, start_byte, bitno;        /* as in main() */
+  double sf;                    /* sampling rate */
+  char progress;                /* print the progress flag */
+#ifdef ACTLEV_THREADS
+  pthread_mutex_t lock;         /* protects next */
+#endif
+} ACT_BATCH;
 
 
 /*
@@ -189,7 +228,7 @@
   ============================================================================
 */
 void display_usage () {
-  printf ("ACTLEVEL.C - Version 2.0 of 01/Feb/1995 \n");
+  printf ("ACTLEVEL.C - Version 2.5 of 16/Oct/2026 \n");
   printf (" Calculate the active speech level of a file, relative to the\n");
   printf (" system overload point [dBov], using the P.56 algorithm.\n");
   printf (" Reports positive and negative peaks, RMS and active level, \n");
@@ -221,6 +260,9 @@ void display_usage () {
   printf ("  -log file ... log statistics into file rather than stdout\n");
   printf ("  -q ......... quiet operation; don't print progress flag, results\n");
   printf ("               are printed all in one line.\n");
+  printf ("  -jobs n .... measure up to n files at the same time [default: 1]\n");
+  printf ("  -csv file .. also report the statistics as comma-separated values\n");
+  printf ("  -json file . also report the statistics as a JSON array\n");
 
   /* Quit program */
   exit (-128);
@@ -402,6 +444,221 @@ void print_act_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_act_short_summary() .................... */
 
 
+/*
+  ============================================================================
+
+       void print_act_record (FILE *out, char json, char *file,
+       ~~~~~~~~~~~~~~~~~~~~~  SVP56_state state, double al_dB,
+                              double ratio, double gain, long bitno);
+
+       Print the P.56 statistics of a file as one comma-separated line
+       (json=0) or as one JSON object (json=1), for use by other programs.
+       Undefined values (e.g. for empty files, or the gain when no level
+       was specified) are left empty, or are null.
+
+       Parameter:
+       ~~~~~~~~~~
+       out ...... File where to print
+       json ..... Format of the record
+       file ..... File name
+       state .... P.56 state variable
+       al_dB .... active level in dB
+       ratio .... ratio of maximum number representable in the system to
+                  the range of the input signal (see above)
+       gain ..... gain to equalize file to desired level, 0 if none
+       bitno .... number of bits per sample (input signal resolution)
+
+       Returns
+       ~~~~~~~
+       None
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void print_act_record (FILE * out, char json, char *file, SVP56_state state, double al_dB, double ratio, double gain, long bitno) {
+  static char *csv_name[] = { "", ",", ",", ",", ",", ",", ",", ",", "," };
+  static char *json_name[] = { "\"min\": ", ", \"max\": ", ", \"dc\": ", ", \"rms_dB\": ", ", \"act_dB\": ", ", \"activity\": ", ", \"rms_pkf_dB\": ", ", \"act_pkf_dB\": ", ", \"gain\": " };
+  char **name = json ? json_name : csv_name;
+  double value[9], abs_max_dB;
+  char *p;
+  int k;
+
+  /* File name, quoted; in CSV, quotes are doubled, in JSON escaped */
+  fputs (json ? "  {\"file\": \"" : "\"", out);
+  for (p = file; *p; p++) {
+    if (*p == '"')
+      fputc (json ? '\\' : '"', out);
+    else if (*p == '\\' && json)
+      fputc ('\\', out);
+    fputc (*p, out);
+  }
+  if (json)
+    fprintf (out, "\", \"samples\": %lu, \"bits\": %ld, \"fs\": %.0f, ", state.n, bitno, state.f);
+  else
+    fprintf (out, "\",%lu,%ld,%.0f,", state.n, bitno, state.f);
+
+  /* Statistics, as in the short summary */
+  abs_max_dB = 20 * log10 (SVP56_get_abs_max (state) + MIN_LOG_OFFSET)
+    - state.refdB;
+  value[0] = ratio * state.maxN;
+  value[1] = ratio * state.maxP;
+  value[2] = ratio * state.DClevel;
+  value[3] = state.rmsdB;
+  value[4] = al_dB;
+  value[5] = state.ActivityFactor * 100;
+  value[6] = abs_max_dB - SVP56_get_rms_dB (state);
+  value[7] = abs_max_dB - al_dB;
+  value[8] = gain;
+  for (k = 0; k < 9; k++) {
+    fputs (name[k], out);
+    if (state.n == 0 || (k == 8 && gain <= 0)) {
+      if (json)
+        fputs ("null", out);
+    } else
+      fprintf (out, "%.3f", value[k]);
+  }
+  fputs (json ? "}" : "\n", out);
+}
+
+/* ...................... End of print_act_record() ....................... */
+
+
+/*
+  ============================================================================
+
+       void measure_file (ACT_JOB *job, ACT_BATCH *batch);
+       ~~~~~~~~~~~~~~~~~
+
+       Measure the blocks of interest of one file with its own P.56
+       state variable. Errors are not fatal here, since other files may
+       be measured at the same time: the exit value is kept in job->err
+       (and errno in job->errnum) and reported by main(), in the order of
+       the command line.
+
+       Parameter:
+       ~~~~~~~~~~
+       job ...... File to be measured, and its results
+       batch .... Measurement parameters
+
+       Returns
+       ~~~~~~~
+       None
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation, from main().
+
+  ============================================================================
+*/
+void measure_file (ACT_JOB * job, ACT_BATCH * batch) {
+  static char funny[] = "|/-\\|/-\\", funny_size = sizeof (funny);
+  short buffer[4096];
+  float Buf[4096];
+  FILE *Fi;
+  long i, l, N = batch->N;
+
+  /* Reset variables for speech level measurements */
+  init_speech_voltmeter (&job->state, batch->sf);
+  job->ActiveLeveldB = 0;
+  job->err = 0;
+
+  /* Opening input file */
+  if ((Fi = fopen (job->file, RB)) == NULL) {
+    job->err = 2;
+    job->errnum = errno;
+    return;
+  }
+
+  /* Check if is to process the whole file */
+  job->N2 = batch->N2;
+  if (job->N2 == 0) {
+    struct stat st;
+    stat (job->file, &st);
+    job->N2 = ceil (st.st_size / (double) (N * sizeof (short)));
+  }
+
+  /* Move pointer to 1st block of interest */
+  if (fseek (Fi, batch->start_byte, 0) < 0l) {
+    job->err = 4;
+    job->errnum = errno;
+    fclose (Fi);
+    return;
+  }
+
+  /* Read samples ... */
+  if (batch->progress)
+    fprintf (stderr, "  Processing \r");
+  for (i = 0; i < job->N2; i++) {
+    if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
+      /* ... Convert samples to float */
+      sh2fl ((long) l, buffer, Buf, batch->bitno, 1);
+
+      /* ... Get the active level */
+      job->ActiveLeveldB = speech_voltmeter (Buf, (long) l, &job->state);
+
+      /* Print progress flag */
+      if (batch->progress)
+        fprintf (stderr, "%c\r", funny[i % funny_size]);
+    } else {
+      job->err = 5;
+      job->errnum = errno;
+      break;
+    }
+  }
+  if (batch->progress)
+    fprintf (stderr, "\n");
+
+  /* Close current file */
+  fclose (Fi);
+}
+
+/* ....................... End of measure_file() .......................... */
+
+
+/*
+  ============================================================================
+
+       void *measure_worker (void *arg);
+       ~~~~~~~~~~~~~~~~~~~~
+
+       Measure the files of a batch (an ACT_BATCH pointed by arg) one
+       after the other, until none is left. Several workers may run at
+       the same time, each taking the next file of the batch.
+
+       Returns
+       ~~~~~~~
+       NULL
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+void *measure_worker (void *arg) {
+  ACT_BATCH *batch = (ACT_BATCH *) arg;
+  long j;
+
+  for (;;) {
+#ifdef ACTLEV_THREADS
+    pthread_mutex_lock (&batch->lock);
+#endif
+    j = batch->next++;
+#ifdef ACTLEV_THREADS
+    pthread_mutex_unlock (&batch->lock);
+#endif
+    if (j >= batch->njobs)
+      return NULL;
+    measure_file (&batch->job[j], batch);
+  }
+}
+
+/* ...................... End of measure_worker() ......................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -413,7 +670,7 @@ void print_act_short_summary (FILE * out, char *file, SVP56_state state, double
 int main (int argc, char *argv[]) {
   /* Parameters for operation */
   double Overflow;              /* Max.positive value for AD_resolution bits */
-  long N = DEF_BLK_LEN, N1 = 1, N2 = 0, N2_ori, i, l;
+  long N = DEF_BLK_LEN, N1 = 1, N2 = 0, j;
 
   /* Intermediate storage variables for speech voltmeter */
   SVP56_state state;
@@ -422,20 +679,26 @@ int main (int argc, char *argv[]) {
 #endif
 
   /* File-related variables */
-  char FileIn[150];
-  FILE *Fi;                     /* input file pointer */
+  char *FileIn;
   FILE *out = stdout;           /* where to print the statistical results */
+  FILE *csv = NULL, *json = NULL;       /* machine-readable reports */
 #ifdef VMS
   char mrs[15];
 #endif
 
+  /* Files being measured */
+  ACT_BATCH batch;
+  long jobs = 1, nrep = 0;
+#ifdef ACTLEV_THREADS
+  pthread_t *thread;
+  long nthreads;
+#endif
+
   /* Other variables */
-  short buffer[4096];
-  float Buf[4096];
   long start_byte, bitno = 16;
   double sf = 16000;            /* Hz */
   double ActiveLeveldB, level = 0, gain = 0;
-  static char funny[] = "|/-\\|/-\\", funny_size = sizeof (funny), quiet = 0;
+  static char quiet = 0;
 #ifdef LOCAL_PRINT
   static char unity[5] = "dBov";
 #endif
@@ -511,6 +774,35 @@ int main (int argc, char *argv[]) {
         else
           fprintf (stderr, "Statistics will be logged in %s\n", argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-jobs") == 0) {
+        /* Number of files measured at the same time */
+        jobs = atol (argv[2]);
+        if (jobs < 1) {
+          fprintf (stderr, "ERROR! Invalid number of jobs \"%s\" in command line\n\n", argv[2]);
+          display_usage ();
+        }
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-csv") == 0) {
+        /* Comma-separated report */
+        if ((csv = fopen (argv[2], WT)) == NULL)
+          KILL (argv[2], 3);
+        fprintf (csv, "file,samples,bits,fs,min,max,dc,rms_dB,act_dB,activity,rms_pkf_dB,act_pkf_dB,gain\n");
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-json") == 0) {
+        /* JSON report */
+        if ((json = fopen (argv[2], WT)) == NULL)
+          KILL (argv[2], 3);
+        fprintf (json, "[");
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -538,71 +830,70 @@ int main (int argc, char *argv[]) {
 
 
   /* ......... SOME INITIALIZATIONS ......... */
-  /* funny_size = strlen(funny); */
   start_byte = --N1;
   start_byte *= N * sizeof (short);
-  N2_ori = N2;
 
   /* Overflow (saturation) point */
   Overflow = pow ((double) 2.0, (double) (bitno - 1));
 
-
-  /* REPEAT FOR ALL FILES IN THE COMMAND LINE */
-  while (argc > 1) {
-    /* Get new file name and update argument line pointer/counter */
-    strncpy (FileIn, argv[1], sizeof (FileIn));
-    argv++;
-    argc--;
-
-    /* Reset variables for speech level measurements */
-    init_speech_voltmeter (&state, sf);
-
-    /* ......... FILE PREPARATION ......... */
-
-    /* Opening input file; abort if there's any problem */
-#ifdef VMS
-    sprintf (mrs, "mrs=%d", 2 * N);
+  /* Measurement parameters, shared by all files */
+  batch.N = N;
+  batch.N2 = N2;
+  batch.start_byte = start_byte;
+  batch.bitno = bitno;
+  batch.sf = sf;
+  batch.progress = !quiet && jobs == 1;
+  if ((batch.job = (ACT_JOB *) calloc (ACT_WINDOW, sizeof (ACT_JOB))) == NULL)
+    HARAKIRI ("Can't allocate memory for the file list\n", 5);
+#ifdef ACTLEV_THREADS
+  pthread_mutex_init (&batch.lock, NULL);
+  if ((thread = (pthread_t *) malloc (jobs * sizeof (pthread_t))) == NULL)
+    jobs = 1;
+#else
+  jobs = 1;
 #endif
-    if ((Fi = fopen (FileIn, RB)) == NULL)
-      KILL (FileIn, 2);
 
-    /* Reinitialize number of blocks as specified initially */
-    N2 = N2_ori;
 
-    /* Check if is to process the whole file */
-    if (N2 == 0) {
-      struct stat st;
-      stat (FileIn, &st);
-      N2 = ceil (st.st_size / (double) (N * sizeof (short)));
+  /* REPEAT FOR ALL FILES IN THE COMMAND LINE, A WINDOW AT A TIME */
+  while (argc > 1) {
+    /* Take the next files from the command line */
+    for (batch.njobs = 0; argc > 1 && batch.njobs < ACT_WINDOW; batch.njobs++) {
+      batch.job[batch.njobs].file = argv[1];
+      argv++;
+      argc--;
     }
-
-    /* Move pointer to 1st block of interest */
-    if (fseek (Fi, start_byte, 0) < 0l)
-      KILL (FileIn, 4);
-
+    batch.next = 0;
 
     /* ... MEASUREMENT OF ACTIVE SPEECH LEVEL ACCORDING P.56 ... */
+#ifdef ACTLEV_THREADS
+    /* The main thread is one of the workers */
+    for (nthreads = 0; nthreads < jobs - 1 && nthreads < batch.njobs - 1; nthreads++)
+      if (pthread_create (&thread[nthreads], NULL, measure_worker, &batch) != 0)
+        break;
+    measure_worker (&batch);
+    for (j = 0; j < nthreads; j++)
+      pthread_join (thread[j], NULL);
+#else
+    measure_worker (&batch);
+#endif
 
-    /* Read samples ... */
-    if (!quiet)
-      fprintf (stderr, "  Processing \r");
-    for (i = 0; i < N2; i++) {
-      if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
-        /* ... Convert samples to float */
-        sh2fl ((long) l, buffer, Buf, bitno, 1);
-
-        /* ... Get the active level */
-        ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
-
-        /* Print progress flag */
-        if (!quiet)
-          fprintf (stderr, "%c\r", funny[i % funny_size]);
-      } else {
-        KILL (FileIn, 5);
+    /* REPORT IN THE ORDER OF THE COMMAND LINE */
+    for (j = 0; j < batch.njobs; j++) {
+      FileIn = batch.job[j].file;
+      state = batch.job[j].state;
+      ActiveLeveldB = batch.job[j].ActiveLeveldB;
+      N2 = batch.job[j].N2;
+      if (batch.job[j].err) {
+        /* Close the reports of the files measured so far before aborting */
+        if (csv)
+          fclose (csv);
+        if (json) {
+          fprintf (json, "\n]\n");
+          fclose (json);
+        }
+        errno = batch.job[j].errnum;
+        KILL (FileIn, batch.job[j].err);
       }
-    }
-    if (!quiet)
-      fprintf (stderr, "\n");
 
 #ifdef LOCAL_PRINT
     /* Convert absolute maximum sample to dB */
@@ -680,14 +971,32 @@ int main (int argc, char *argv[]) {
       print_act_short_summary (out, FileIn, state, ActiveLeveldB, Overflow, gain);
 #endif /* LOCAL_PRINT */
 
-    /* Close current file */
-    fclose (Fi);
+      /* ... and in the machine-readable formats */
+      if (csv)
+        print_act_record (csv, 0, FileIn, state, ActiveLeveldB, Overflow, gain, bitno);
+      if (json) {
+        fprintf (json, nrep++ ? ",\n" : "\n");
+        print_act_record (json, 1, FileIn, state, ActiveLeveldB, Overflow, gain, bitno);
+      }
+    }
   }
 
   /* FINALIZATIONS */
-  /* ... Close log file, if it is the case */
+#ifdef ACTLEV_THREADS
+  free (thread);
+  pthread_mutex_destroy (&batch.lock);
+#endif
+  free (batch.job);
+
+  /* ... Close log file and reports, if it is the case */
   if (out != stdout)
     fclose (out);
+  if (csv)
+    fclose (csv);
+  if (json) {
+    fprintf (json, "\n]\n");
+    fclose (json);
+  }
 
   /* ... Exit cleanly */
 #if !defined(VMS)
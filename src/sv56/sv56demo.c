@@ -1,4 +1,4 @@
-/*                                                              v3.5 02.Feb.10
+/*                                                              v3.6 16.Oct.26
   ============================================================================
 
   SV56DEMO.C
@@ -81,6 +81,15 @@
   -end eb ........ define `eb' as the last block to be measured
   -n nb .......... define `nb' as the number of blocks to be measured;
                    equivalent to parameter N2 above [default: whole file]
+  -mem ........... single-pass mode: the blocks of interest are mapped
+                   into memory (or read at once where mmap() is not
+                   available), measured, and equalized from memory,
+                   instead of reading the file twice. Same output.
+  -cache file .... implies -mem; the P.56 statistics of the input are
+                   looked up in (and, if not found, added to) the text
+                   file `file', keyed by a hash of the measured samples,
+                   the sampling rate and the resolution. Re-equalizing
+                   a corpus to another level thus skips the measurement.
 
   Modules used:
   ~~~~~~~~~~~~~
@@ -155,6 +164,9 @@
                            a multiple of the block size <simao>.
   02.Feb.10     3.5        Modified maximum string length to avoid
                            buffer overruns (y.hiwasaki)
+  16.Oct.26     3.6        Added options -mem (single pass over the input,
+                           mapped into memory) and -cache (measurements
+                           kept in a file, keyed by a hash of the samples)
 
   ============================================================================
 */
@@ -180,6 +192,14 @@
 #endif /* MSDOS */
 #endif /* !VMS */
 
+/* ... Memory-mapped input, where available ... */
+#if defined(unix) || defined(__unix__) || defined(__unix) || defined(__APPLE__)
+#define SV56_MMAP
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 /* ... Include of speech-voltmeter-related routines ... */
 #include "sv-p56.h"
 
@@ -202,7 +222,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("SV56DEMO.C: Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("SV56DEMO.C: Version 3.6 of 16.Oct.2026 \n\n");
   printf ("  Program to level-equalize a speech file \"NdB\" dBs below\n");
   printf ("  the overload point for a linear n-bit (default: 16 bit) system.\n");
   printf ("  using the P.56 speech voltmeter algorithm.\n");
@@ -240,6 +260,10 @@ void display_usage () {
   printf ("  -n nb ....... define `nb' as the number of blocks to be measured;\n");
   printf ("                equiv. to param.NoOfBlocks above [dft: whole file]\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
+  printf ("  -mem ........ single pass: the input is mapped (or read) into memory,\n");
+  printf ("                measured and equalized from there\n");
+  printf ("  -cache file . implies -mem; reuse (or store) the statistics of the\n");
+  printf ("                input kept in `file', keyed by a hash of the samples\n");
   printf ("  -q .......... quiet operation - does not print the progress flag.\n");
   printf ("                Saves time and avoids trash in batch processings.\n");
   printf ("  -qq ......... print short statistics summary; no progress flag.\n");
@@ -411,6 +435,193 @@ void print_p56_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_p56_short_summary() .................... */
 
 
+/*
+  ============================================================================
+
+       int load_input (char *file, long start_byte, long N, long N2,
+       ~~~~~~~~~~~~~~  SV56_INPUT *in);
+       void release_input (SV56_INPUT *in);
+
+       Map into memory the N2 blocks of N samples of a file, starting at
+       byte start_byte (the last block may be incomplete), or read them
+       at once where mmap() is not available; and release them.
+
+       Returns
+       ~~~~~~~
+       load_input() returns 0 on success, 2 if the file cannot be opened
+       and 5 if a block is empty or the samples cannot be mapped, read or
+       allocated (as the exit values of the program); nothing is left
+       allocated on failure
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+       16.Oct.26	v1.1	Errors are returned, and the buffer is freed.
+
+  ============================================================================
+*/
+typedef struct {
+  short *smp;                   /* samples of the blocks of interest */
+  long n;                       /* number of samples */
+  void *base;                   /* mapped or allocated memory */
+  size_t len;                   /* length of the mapping */
+} SV56_INPUT;
+
+int load_input (char *file, long start_byte, long N, long N2, SV56_INPUT * in) {
+  struct stat st;
+  long avail;
+#ifdef SV56_MMAP
+  int fd;
+#else
+  FILE *Fi;
+#endif
+
+  if (stat (file, &st) != 0)
+    return 2;
+  avail = (st.st_size - start_byte) / (long) sizeof (short);
+  in->n = (avail < N * N2) ? avail : N * N2;
+  if (in->n <= (N2 - 1) * N)
+    return 5;
+
+#ifdef SV56_MMAP
+  /* Map the file from its beginning, as the offset must be page-aligned */
+  in->len = start_byte + in->n * sizeof (short);
+  if ((fd = open (file, O_RDONLY)) < 0)
+    return 2;
+  in->base = mmap (NULL, in->len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (in->base == MAP_FAILED)
+    return 5;
+  in->smp = (short *) ((char *) in->base + start_byte);
+#else
+  if ((in->base = malloc (in->n * sizeof (short))) == NULL)
+    return 5;
+  if ((Fi = fopen (file, RB)) == NULL) {
+    free (in->base);
+    return 2;
+  }
+  if (fseek (Fi, start_byte, 0) < 0l || fread (in->base, sizeof (short), in->n, Fi) != (size_t) in->n) {
+    fclose (Fi);
+    free (in->base);
+    return 5;
+  }
+  fclose (Fi);
+  in->smp = (short *) in->base;
+#endif
+  return 0;
+}
+
+void release_input (SV56_INPUT * in) {
+#ifdef SV56_MMAP
+  munmap (in->base, in->len);
+#else
+  free (in->base);
+#endif
+}
+
+/* ...................... End of load_input() ............................. */
+
+
+/*
+  ============================================================================
+
+       unsigned long long hash_input (short *smp, long n, double sf,
+       ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long bitno);
+
+       64-bit FNV-1a hash of the samples, sampling rate and resolution,
+       used as key of the measurement cache.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+unsigned long long hash_input (short *smp, long n, double sf, long bitno) {
+  unsigned long long h = 0xCBF29CE484222325ULL;
+  unsigned char *p = (unsigned char *) smp;
+  long k;
+
+  for (k = 0; k < n * (long) sizeof (short); k++)
+    h = (h ^ p[k]) * 0x100000001B3ULL;
+  h = (h ^ (unsigned long long) (sf + 0.5)) * 0x100000001B3ULL;
+  h = (h ^ (unsigned long long) bitno) * 0x100000001B3ULL;
+  return h;
+}
+
+/* ...................... End of hash_input() ............................. */
+
+
+/*
+  ============================================================================
+
+       int read_cache (char *file, unsigned long long key, long n,
+       ~~~~~~~~~~~~~~  SVP56_state *state, double *ActiveLeveldB);
+       void write_cache (char *file, unsigned long long key, long n,
+       ~~~~~~~~~~~~~~~~  SVP56_state *state, double ActiveLeveldB);
+
+       Look up (or append) the statistics of the input in the measurement
+       cache: one text line per input, with the key, the number of
+       samples, the active level and the state variables, printed with
+       enough digits to be read back exactly. The state must have been
+       initialized with init_speech_voltmeter() before read_cache().
+
+       Returns
+       ~~~~~~~
+       read_cache() returns 1 if the input was found, 0 otherwise
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+#define SV56_CACHE_FMT "%016llx %ld %.17g %.17g %lu %.17g %.17g %.17g %.17g %.17g %.17g %.17g %.17g %.17g %.17g %.17g"
+
+int read_cache (char *file, unsigned long long key, long n, SVP56_state * state, double *ActiveLeveldB) {
+  FILE *F;
+  char line[1024], *p;
+  unsigned long long k;
+  long m, j;
+  double f;
+  SVP56_state st = *state;
+  int found = 0, off;
+
+  if ((F = fopen (file, RT)) == NULL)
+    return 0;
+  while (!found && fgets (line, sizeof (line), F) != NULL) {
+    if (sscanf (line, "%llx %ld %lg %lg %lu %lg %lg %lg %lg %lg %lg %lg %lg %lg %lg %lg%n", &k, &m, &f, ActiveLeveldB, &st.n, &st.s, &st.sq, &st.p, &st.q, &st.max, &st.refdB, &st.rmsdB, &st.maxP, &st.maxN, &st.DClevel, &st.ActivityFactor, &off) != 16)
+      continue;
+    if (k != key || m != n || (float) f != state->f)
+      continue;
+    for (p = line + off, j = 0; j < 15; j++, p += off)
+      if (sscanf (p, "%lu %lu%n", &st.a[j], &st.hang[j], &off) != 2)
+        break;
+    if (j == 15) {
+      *state = st;
+      found = 1;
+    }
+  }
+  fclose (F);
+  return found;
+}
+
+void write_cache (char *file, unsigned long long key, long n, SVP56_state * state, double ActiveLeveldB) {
+  FILE *F;
+  long j;
+
+  if ((F = fopen (file, "a")) == NULL)
+    KILL (file, 6);
+  fprintf (F, SV56_CACHE_FMT, key, n, (double) state->f, ActiveLeveldB, state->n, state->s, state->sq, state->p, state->q, state->max, state->refdB, state->rmsdB, state->maxP, state->maxN, state->DClevel, state->ActivityFactor);
+  for (j = 0; j < 15; j++)
+    fprintf (F, " %lu %lu", state->a[j], state->hang[j]);
+  fprintf (F, "\n");
+  fclose (F);
+}
+
+/* ...................... End of read_cache() ............................. */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -440,6 +651,10 @@ int main (int argc, char *argv[]) {
 
   /* Other variables */
   char quiet = 0, use_active_level = 1, long_summary = 1;
+  char in_memory = 0, *cache = NULL;
+  SV56_INPUT in;
+  unsigned long long key = 0;
+  int cached = 0;
   short buffer[4096];
   float Buf[4096];
   long NrSat = 0, start_byte, bitno = 16;
@@ -519,6 +734,21 @@ int main (int argc, char *argv[]) {
         else
           fprintf (stderr, "Statitics will be logged in %s\n", argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-mem") == 0) {
+        /* Measure and equalize in a single pass over the input */
+        in_memory = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-cache") == 0) {
+        /* Keep the measurements in a file; implies -mem */
+        cache = argv[2];
+        in_memory = 1;
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -582,21 +812,34 @@ int main (int argc, char *argv[]) {
  * ......... FILE PREPARATION .........
  */
 
+  /* Single pass: map the blocks of interest, and look up the cache */
+  if (in_memory) {
+    if ((i = load_input (FileIn, start_byte, N, N2, &in)) != 0)
+      KILL (FileIn, i);
+    if (cache) {
+      key = hash_input (in.smp, in.n, sf, bitno);
+      cached = read_cache (cache, key, in.n, &state, &ActiveLeveldB);
+    }
+    Fi = NULL;
+  }
+
   /* Opening input file; abort if there's any problem */
+  else {
 #ifdef VMS
   sprintf (mrs, "mrs=%d", 2 * N);
 #endif
-  if ((Fi = fopen (FileIn, RB)) == NULL)
-    KILL (FileIn, 2);
+    if ((Fi = fopen (FileIn, RB)) == NULL)
+      KILL (FileIn, 2);
+
+    /* Move pointer to 1st block of interest */
+    if (fseek (Fi, start_byte, 0) < 0l)
+      KILL (FileIn, 4);
+  }
 
   /* Creates output file */
   if ((Fo = fopen (FileOut, WB)) == NULL)
     KILL (FileOut, 3);
 
-  /* Move pointer to 1st block of interest */
-  if (fseek (Fi, start_byte, 0) < 0l)
-    KILL (FileIn, 4);
-
 
   /* ... MEASUREMENT OF ACTIVE SPEECH LEVEL ACCORDING P.56 ... */
 
@@ -604,12 +847,18 @@ int main (int argc, char *argv[]) {
   if (!quiet)
     printf ("  Processing \r");
 
-  /* Process selected blocks */
-  for (i = 0; i < N2; i++) {
-    /* Read samples ... */
-    if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
+  /* Process selected blocks (unless found in the cache) */
+  if (cached && !quiet)
+    printf ("  Statistics of %s taken from %s\n", FileIn, cache);
+  for (i = 0; i < N2 && !cached; i++) {
+    /* Read samples (or take them from memory) ... */
+    if (in_memory)
+      l = (in.n - i * N < N) ? in.n - i * N : N;
+    else
+      l = fread (buffer, sizeof (short), N, Fi);
+    if (l > 0) {
       /* ... Convert samples to float */
-      sh2fl ((long) l, buffer, Buf, bitno, 1);
+      sh2fl ((long) l, in_memory ? in.smp + i * N : buffer, Buf, bitno, 1);
 
       /* ... Get the active level */
       ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
@@ -626,6 +875,10 @@ int main (int argc, char *argv[]) {
   if (!quiet)
     printf ("\n");
 
+  /* Store the measurements for later runs */
+  if (cache && !cached)
+    write_cache (cache, key, in.n, &state, ActiveLeveldB);
+
 
   /* ... COMPUTE EQUALIZATION FACTOR ... */
 
@@ -645,14 +898,18 @@ int main (int argc, char *argv[]) {
   /* EQUALIZATION: hard clipping (with truncation) */
 
   /* Move pointer to 1st desired block */
-  if (fseek (Fi, start_byte, 0) < 0l)
+  if (!in_memory && fseek (Fi, start_byte, 0) < 0l)
     KILL (FileIn, 4);
 
   /* Get data of interest, equalize and de-normalize */
   for (i = 0; i < N2; i++) {
-    if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
+    if (in_memory)
+      l = (in.n - i * N < N) ? in.n - i * N : N;
+    else
+      l = fread (buffer, sizeof (short), N, Fi);
+    if (l > 0) {
       /* convert samples to float */
-      sh2fl ((long) l, buffer, Buf, bitno, 1);
+      sh2fl ((long) l, in_memory ? in.smp + i * N : buffer, Buf, bitno, 1);
 
       /* equalizes vector */
       scale (Buf, (long) l, (double) factor);
@@ -680,7 +937,10 @@ int main (int argc, char *argv[]) {
     printf ("---> DONE    \n");
 
   /* Close files ... */
-  fclose (Fi);
+  if (in_memory)
+    release_input (&in);
+  else
+    fclose (Fi);
   fclose (Fo);
   if (out != stdout)
     fclose (out);
@@ -0,0 +1,117 @@
+/*                                                            v1.0  16.Oct.26
+=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+
+MODULE:         UGST-CPU.C, RUN-TIME DETECTION OF x86 INSTRUCTION SETS
+
+PROTOTYPE:      in ugst-cpu.h
+
+FUNCTIONS:
+
+    ugst_cpu_supports: .. whether the CPU and the operating system
+                          support an instruction set, for the choice of
+                          the SIMD kernels of the FIR, G.711 and G.726
+                          modules
+
+HISTORY:
+
+  16.Oct.26 v1.0 Created, replacing the copies of the cpuid/xgetbv
+                 code in fir-simd.c, g711.c and g726multi.c
+
+=============================================================================
+*/
+
+#include "ugst-cpu.h"
+
+
+/*
+  ============================================================================
+
+        int ugst_cpu_supports (int isa);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Check whether the CPU supports the given UGST_CPU_xxx and, for
+        the instruction sets on the AVX registers, whether the
+        operating system saves these registers. Always 0 where
+        UGST_SIMD_X86 is not defined.
+
+        Parameters:
+        ~~~~~~~~~~~
+        isa: ..... (In) one of UGST_CPU_SSE2, UGST_CPU_AVX2, UGST_CPU_FMA
+                        or UGST_CPU_AVX512F
+
+        Return value:
+        ~~~~~~~~~~~~~
+        1 if supported, 0 otherwise.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int ugst_cpu_supports (int isa) {
+#if defined(UGST_SIMD_X86) && defined(_MSC_VER)
+  int r[4];
+  unsigned long long xcr0 = 0;
+  int has_sse2, has_fma, has_avx2, has_avx512, osxsave;
+
+  __cpuid (r, 1);
+  has_sse2 = (r[3] >> 26) & 1;
+  has_fma = (r[2] >> 12) & 1;
+  osxsave = (r[2] >> 27) & 1;
+  __cpuidex (r, 7, 0);
+  has_avx2 = (r[1] >> 5) & 1;
+  has_avx512 = (r[1] >> 16) & 1;
+  if (osxsave)
+    xcr0 = _xgetbv (0);
+
+  switch (isa) {
+  case UGST_CPU_SSE2:
+    return has_sse2;
+  case UGST_CPU_AVX2:
+    return has_avx2 && (xcr0 & 0x06) == 0x06;
+  case UGST_CPU_FMA:
+    return has_fma && (xcr0 & 0x06) == 0x06;
+  case UGST_CPU_AVX512F:
+    return has_avx512 && (xcr0 & 0xe6) == 0xe6;
+  }
+#elif defined(UGST_SIMD_X86)
+  __builtin_cpu_init ();
+  switch (isa) {
+  case UGST_CPU_SSE2:
+    return __builtin_cpu_supports ("sse2");
+  case UGST_CPU_AVX2:
+    return __builtin_cpu_supports ("avx2");
+  case UGST_CPU_FMA:
+    return __builtin_cpu_supports ("fma");
+  case UGST_CPU_AVX512F:
+    return __builtin_cpu_supports ("avx512f");
+  }
+#endif
+  return 0;
+}
+
+/* ..................... End of ugst_cpu_supports() ..................... */
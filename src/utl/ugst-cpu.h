@@ -0,0 +1,53 @@
+/*
+  ============================================================================
+   File: UGST-CPU.H                                                16.Oct.26
+  ============================================================================
+
+                         UGST/ITU-T UTILITIES MODULE
+
+                  RUN-TIME DETECTION OF x86 INSTRUCTION SETS
+
+   History:
+   16.Oct.26    v1.0    First version, from the detection code of the
+                        FIR, G.711 and G.726 SIMD kernels
+  ============================================================================
+*/
+#ifndef UGST_CPU_defined
+#define UGST_CPU_defined 100
+
+/* macros for smart prototypes */
+#ifndef ARGS
+#if (defined(__STDC__) || defined(VMS) || defined(__DECC)  || defined(MSDOS) || defined(__MSDOS__))
+#define ARGS(x) x
+#else /* Unix: no parameters in prototype! */
+#define ARGS(x) ()
+#endif
+#endif
+
+/* UGST_SIMD_X86 is defined where x86 SIMD kernels can be compiled. They
+   are marked UGST_TARGET("isa"): with GCC/Clang, this is a target
+   attribute, so that no module needs special compiler flags; MSVC
+   compiles the intrinsics without it */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define UGST_SIMD_X86
+#define UGST_TARGET(isa) __attribute__ ((target (isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define UGST_SIMD_X86
+#define UGST_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+/* Instruction sets for ugst_cpu_supports(); those using the AVX
+   registers also need the operating system to save them */
+#define UGST_CPU_SSE2    1
+#define UGST_CPU_AVX2    2
+#define UGST_CPU_FMA     3
+#define UGST_CPU_AVX512F 4
+
+/* Prototypes */
+int ugst_cpu_supports ARGS ((int isa));
+
+#endif
+/* ........................ End of UGST-CPU.H .......................... */